@@ -29,7 +29,8 @@ TF_DEBUG_CODES(
     USDMAYA_PROXYACCESSOR,
     USDMAYA_PLUG_INFO_VERSION,
     USDMAYA_UNDOSTACK,
-    USDMAYA_UNDOSTATEDELEGATE);
+    USDMAYA_UNDOSTATEDELEGATE,
+    USDMAYA_LAYERMANAGER);
 
 PXR_NAMESPACE_CLOSE_SCOPE
 
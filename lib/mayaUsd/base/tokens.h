@@ -60,6 +60,9 @@ PXR_NAMESPACE_OPEN_SCOPE
     /*       to be serialized to the Maya file.                     */ \
     /*    3: ignore all Usd edits.                                  */ \
     ((SerializedUsdEditsLocation, "mayaUsd_SerializedUsdEditsLocation")) \
+    /* When saving Usd edits to Maya string attributes, should the  */ \
+    /* layers be stored as compressed binary (usdc) data            */ \
+    ((SerializedUsdEditsBinaryFormat, "mayaUsd_SerializedUsdEditsBinaryFormat")) \
     /* optionVar to force a prompt on every save                    */ \
     ((SerializedUsdEditsLocationPrompt, "mayaUsd_SerializedUsdEditsLocationPrompt")) \
     /* optionVar to control if comfirmation dialog will be show when overriding file */ \
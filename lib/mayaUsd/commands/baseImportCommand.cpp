@@ -55,6 +55,10 @@ MSyntax MayaUSDImportCommand::createSyntax()
         kImportInstancesFlag,
         UsdMayaJobImportArgsTokens->importInstances.GetText(),
         MSyntax::kString);
+    syntax.addFlag(
+        kDeferredImportFlag,
+        UsdMayaJobImportArgsTokens->deferredImport.GetText(),
+        MSyntax::kBoolean);
     syntax.addFlag(
         kImportUSDZTexturesFlag,
         UsdMayaJobImportArgsTokens->importUSDZTextures.GetText(),
@@ -43,6 +43,7 @@ public:
     static constexpr auto kShadingModeFlag = "shd";
     static constexpr auto kPreferredMaterialFlag = "prm";
     static constexpr auto kImportInstancesFlag = "ii";
+    static constexpr auto kDeferredImportFlag = "dfi";
     static constexpr auto kImportUSDZTexturesFlag = "itx";
     static constexpr auto kImportUSDZTexturesFilePathFlag = "itf";
     static constexpr auto kMetadataFlag = "md";
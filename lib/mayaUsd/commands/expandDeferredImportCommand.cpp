@@ -0,0 +1,78 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "expandDeferredImportCommand.h"
+
+#include <maya/MArgDatabase.h>
+#include <maya/MSelectionList.h>
+#include <maya/MSyntax.h>
+
+namespace MAYAUSD_NS_DEF {
+
+const char ExpandDeferredImportCommand::commandName[] = "mayaUsdExpandDeferredImport";
+
+// plug-in callback to create the command object
+void* ExpandDeferredImportCommand::creator()
+{
+    return static_cast<MPxCommand*>(new ExpandDeferredImportCommand());
+}
+
+// plug-in callback to register the command syntax
+MSyntax ExpandDeferredImportCommand::createSyntax()
+{
+    MSyntax syntax;
+
+    // the placeholders to expand, the selected ones by default
+    syntax.setObjectType(MSyntax::kSelectionList);
+    syntax.useSelectionAsDefault(true);
+
+    return syntax;
+}
+
+// MPxCommand undo ability callback, nothing to undo if no placeholder was expanded
+bool ExpandDeferredImportCommand::isUndoable() const { return _expandedCount > 0; }
+
+// main MPxCommand execution point
+MStatus ExpandDeferredImportCommand::doIt(const MArgList& argList)
+{
+    clearResult();
+
+    MStatus      status;
+    MArgDatabase argData(syntax(), argList, &status);
+    if (status != MS::kSuccess) {
+        return MS::kInvalidParameter;
+    }
+
+    MSelectionList placeholders;
+    argData.getObjects(placeholders);
+
+    _expansion.reset(new UsdMaya_ReadJob::DeferredExpansion);
+    _expandedCount = _expansion->Expand(placeholders);
+
+    setResult(static_cast<int>(_expandedCount));
+    return MS::kSuccess;
+}
+
+MStatus ExpandDeferredImportCommand::undoIt()
+{
+    return _expansion && _expansion->Undo() ? MS::kSuccess : MS::kFailure;
+}
+
+MStatus ExpandDeferredImportCommand::redoIt()
+{
+    return _expansion && _expansion->Redo() ? MS::kSuccess : MS::kFailure;
+}
+
+} // namespace MAYAUSD_NS_DEF
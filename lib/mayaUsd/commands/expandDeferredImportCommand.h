@@ -0,0 +1,64 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef MAYAUSD_COMMANDS_EXPAND_DEFERRED_IMPORT_COMMAND_H
+#define MAYAUSD_COMMANDS_EXPAND_DEFERRED_IMPORT_COMMAND_H
+
+#include <mayaUsd/base/api.h>
+#include <mayaUsd/fileio/jobs/readJob.h>
+
+#include <maya/MPxCommand.h>
+
+#include <memory>
+
+namespace MAYAUSD_NS_DEF {
+
+/// Translates the subtrees of the placeholders created by a deferred import. The placeholders
+/// run it when they get selected, so that their expansion can be undone.
+class ExpandDeferredImportCommand : public MPxCommand
+{
+public:
+    // plugin registration requirements
+    MAYAUSD_CORE_PUBLIC
+    static const char commandName[];
+
+    MAYAUSD_CORE_PUBLIC
+    static void* creator();
+
+    MAYAUSD_CORE_PUBLIC
+    static MSyntax createSyntax();
+
+    // MPxCommand callbacks
+    MAYAUSD_CORE_PUBLIC
+    MStatus doIt(const MArgList& argList) override;
+
+    MAYAUSD_CORE_PUBLIC
+    MStatus undoIt() override;
+
+    MAYAUSD_CORE_PUBLIC
+    MStatus redoIt() override;
+
+    MAYAUSD_CORE_PUBLIC
+    bool isUndoable() const override;
+
+private:
+    std::unique_ptr<UsdMaya_ReadJob::DeferredExpansion> _expansion;
+    size_t                                              _expandedCount = 0;
+};
+
+} // namespace MAYAUSD_NS_DEF
+
+#endif // MAYAUSD_COMMANDS_EXPAND_DEFERRED_IMPORT_COMMAND_H
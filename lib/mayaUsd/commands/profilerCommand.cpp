@@ -0,0 +1,135 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "profilerCommand.h"
+
+#include <mayaUsd/utils/traceProfiler.h>
+
+#include <maya/MArgParser.h>
+#include <maya/MGlobal.h>
+#include <maya/MSyntax.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+const char kEnableFlag[] = "e";
+const char kEnableFlagL[] = "enable";
+const char kChromeTraceFlag[] = "ct";
+const char kChromeTraceFlagL[] = "chromeTrace";
+const char kStatisticsFlag[] = "st";
+const char kStatisticsFlagL[] = "statistics";
+const char kCategoryFlag[] = "cat";
+const char kCategoryFlagL[] = "category";
+const char kResetFlag[] = "r";
+const char kResetFlagL[] = "reset";
+const char kClearFlag[] = "cl";
+const char kClearFlagL[] = "clear";
+const char kDroppedEventsFlag[] = "de";
+const char kDroppedEventsFlagL[] = "droppedEvents";
+
+void reportError(const MString& errorString) { MGlobal::displayError(errorString); }
+
+} // namespace
+
+namespace MAYAUSD_NS_DEF {
+
+const char ProfilerCommand::commandName[] = "mayaUsdProfiler";
+
+// plug-in callback to create the command object
+void* ProfilerCommand::creator() { return static_cast<MPxCommand*>(new ProfilerCommand()); }
+
+// plug-in callback to register the command syntax
+MSyntax ProfilerCommand::createSyntax()
+{
+    MSyntax syntax;
+
+    syntax.enableQuery(true);
+
+    syntax.addFlag(kEnableFlag, kEnableFlagL, MSyntax::kBoolean);
+    syntax.addFlag(kChromeTraceFlag, kChromeTraceFlagL, MSyntax::kString);
+    syntax.addFlag(kStatisticsFlag, kStatisticsFlagL, MSyntax::kNoArg);
+    syntax.addFlag(kCategoryFlag, kCategoryFlagL, MSyntax::kString);
+    syntax.addFlag(kResetFlag, kResetFlagL, MSyntax::kNoArg);
+    syntax.addFlag(kClearFlag, kClearFlagL, MSyntax::kNoArg);
+    syntax.addFlag(kDroppedEventsFlag, kDroppedEventsFlagL, MSyntax::kNoArg);
+
+    return syntax;
+}
+
+// MPxCommand undo ability callback
+bool ProfilerCommand::isUndoable() const { return false; }
+
+// main MPxCommand execution point
+MStatus ProfilerCommand::doIt(const MArgList& argList)
+{
+    clearResult();
+
+    MStatus    status;
+    MArgParser argParser(syntax(), argList, &status);
+    if (status != MS::kSuccess) {
+        return MS::kInvalidParameter;
+    }
+
+    if (argParser.isQuery()) {
+        if (argParser.isFlagSet(kEnableFlag)) {
+            setResult(TraceProfiler::isEnabled());
+        } else if (argParser.isFlagSet(kDroppedEventsFlag)) {
+            setResult(static_cast<int>(TraceProfiler::droppedEventCount()));
+        }
+        return MS::kSuccess;
+    }
+
+    std::string category;
+    if (argParser.isFlagSet(kCategoryFlag)) {
+        category = argParser.flagArgumentString(kCategoryFlag, 0).asChar();
+    }
+    const char* categoryFilter = category.empty() ? nullptr : category.c_str();
+
+    if (argParser.isFlagSet(kEnableFlag)) {
+        TraceProfiler::setEnabled(argParser.flagArgumentBool(kEnableFlag, 0));
+    }
+
+    if (argParser.isFlagSet(kChromeTraceFlag)) {
+        const MString path = argParser.flagArgumentString(kChromeTraceFlag, 0);
+        std::ofstream file(path.asChar());
+        if (!file) {
+            reportError(MString("Cannot write the Chrome trace to \"") + path + "\"");
+            return MS::kFailure;
+        }
+        TraceProfiler::writeChromeTrace(file);
+    }
+
+    // the statistics are reported before being reset, so both flags can be combined
+    if (argParser.isFlagSet(kStatisticsFlag)) {
+        std::ostringstream report;
+        TraceProfiler::writeStatistics(report, categoryFilter);
+        setResult(MString(report.str().c_str()));
+    }
+
+    if (argParser.isFlagSet(kResetFlag)) {
+        TraceProfiler::resetStatistics(categoryFilter);
+    }
+
+    if (argParser.isFlagSet(kClearFlag)) {
+        TraceProfiler::clear();
+    }
+
+    return MS::kSuccess;
+}
+
+} //  namespace MAYAUSD_NS_DEF
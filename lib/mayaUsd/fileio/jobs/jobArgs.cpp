@@ -600,6 +600,7 @@ UsdMayaJobImportArgs::UsdMayaJobImportArgs(
           _String(userArgs, UsdMayaJobImportArgsTokens->importUSDZTexturesFilePath)))
     , importUSDZTextures(_Boolean(userArgs, UsdMayaJobImportArgsTokens->importUSDZTextures))
     , importInstances(_Boolean(userArgs, UsdMayaJobImportArgsTokens->importInstances))
+    , deferredImport(_Boolean(userArgs, UsdMayaJobImportArgsTokens->deferredImport))
     , useAsAnimationCache(_Boolean(userArgs, UsdMayaJobImportArgsTokens->useAsAnimationCache))
     , importWithProxyShapes(importWithProxyShapes)
     , timeInterval(timeInterval)
@@ -644,6 +645,7 @@ const VtDictionary& UsdMayaJobImportArgs::GetDefaultDictionary()
         d[UsdMayaJobImportArgsTokens->preferredMaterial]
             = UsdMayaPreferredMaterialTokens->none.GetString();
         d[UsdMayaJobImportArgsTokens->importInstances] = true;
+        d[UsdMayaJobImportArgsTokens->deferredImport] = false;
         d[UsdMayaJobImportArgsTokens->importUSDZTextures] = false;
         d[UsdMayaJobImportArgsTokens->importUSDZTexturesFilePath] = "";
         d[UsdMayaJobImportArgsTokens->useAsAnimationCache] = false;
@@ -729,6 +731,7 @@ std::ostream& operator<<(std::ostream& out, const UsdMayaJobImportArgs& importAr
     out << "preferredMaterial: " << importArgs.preferredMaterial << std::endl
         << "assemblyRep: " << importArgs.assemblyRep << std::endl
         << "importInstances: " << TfStringify(importArgs.importInstances) << std::endl
+        << "deferredImport: " << TfStringify(importArgs.deferredImport) << std::endl
         << "importUSDZTextures: " << TfStringify(importArgs.importUSDZTextures) << std::endl
         << "importUSDZTexturesFilePath: " << TfStringify(importArgs.importUSDZTexturesFilePath)
         << std::endl
@@ -118,6 +118,7 @@ TF_DECLARE_PUBLIC_TOKENS(
     /* Dictionary keys */ \
     (apiSchema) \
     (assemblyRep) \
+    (deferredImport) \
     (excludePrimvar) \
     (metadata) \
     (shadingMode) \
@@ -282,6 +283,10 @@ struct UsdMayaJobImportArgs
     const std::string importUSDZTexturesFilePath;
     const bool        importUSDZTextures;
     const bool        importInstances;
+    /// When true, component models are imported as placeholder transforms
+    /// showing their bounding box, and their subtree is only translated once
+    /// the placeholder gets selected.
+    const bool        deferredImport;
     const bool        useAsAnimationCache;
     const bool        importWithProxyShapes;
     /// The interval over which to import animated data.
@@ -18,6 +18,7 @@
 #include <mayaUsd/fileio/chaser/importChaserRegistry.h>
 #include <mayaUsd/fileio/primReaderRegistry.h>
 #include <mayaUsd/fileio/translators/translatorMaterial.h>
+#include <mayaUsd/fileio/translators/translatorUtil.h>
 #include <mayaUsd/fileio/translators/translatorXformable.h>
 #include <mayaUsd/fileio/utils/readUtil.h>
 #include <mayaUsd/nodes/stageNode.h>
@@ -26,18 +27,22 @@
 #include <mayaUsd/utils/utilFileSystem.h>
 
 #include <pxr/base/tf/debug.h>
+#include <pxr/base/tf/stopwatch.h>
 #include <pxr/base/tf/token.h>
+#include <pxr/usd/kind/registry.h>
 #include <pxr/usd/sdf/fileFormat.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/primFlags.h>
 #include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/stageCacheContext.h>
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usd/variantSets.h>
 #include <pxr/usd/usd/zipFile.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
 #include <pxr/usd/usdGeom/metrics.h>
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
@@ -45,14 +50,24 @@
 #include <pxr/usd/usdUtils/stageCache.h>
 
 #include <maya/MAnimControl.h>
+#include <maya/MCallbackIdArray.h>
+#include <maya/MComputation.h>
 #include <maya/MDGModifier.h>
 #include <maya/MDagModifier.h>
 #include <maya/MDagPathArray.h>
 #include <maya/MDistance.h>
+#include <maya/MDoubleArray.h>
 #include <maya/MFnDependencyNode.h>
+#include <maya/MFnNurbsCurve.h>
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MGlobal.h>
 #include <maya/MItDependencyGraph.h>
+#include <maya/MModelMessage.h>
 #include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
+#include <maya/MPointArray.h>
+#include <maya/MSceneMessage.h>
 #include <maya/MStatus.h>
 #include <maya/MTime.h>
 
@@ -66,6 +81,127 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+namespace {
+
+// Names of the attributes holding the file and prim path of a placeholder.
+const MString _deferredFilePathAttrName("USD_deferredFilePath");
+const MString _deferredPrimPathAttrName("USD_deferredPrimPath");
+
+// Corners of a box visited by a polyline going along its 12 edges, using the
+// corner indices of GfRange3d::GetCorner().
+const size_t _boxOutline[] = { 0, 1, 3, 2, 0, 4, 5, 7, 6, 4, 5, 1, 3, 7, 6, 2 };
+
+struct _ObjectHandleHash
+{
+    size_t operator()(const MObjectHandle& handle) const { return handle.hashCode(); }
+};
+
+MString _GetStringAttr(const MFnDependencyNode& depNodeFn, const MString& attrName)
+{
+    MStatus status;
+    MPlug   plug = depNodeFn.findPlug(attrName, true, &status);
+    return status ? plug.asString() : MString();
+}
+
+void _AddStringAttr(MFnDependencyNode& depNodeFn, const MString& attrName, const char* value)
+{
+    MFnTypedAttribute typedAttrFn;
+    MObject           attr = typedAttrFn.create(attrName, attrName, MFnData::kString);
+    if (depNodeFn.addAttribute(attr)) {
+        depNodeFn.findPlug(attr, true).setString(value);
+    }
+}
+
+} // namespace
+
+// State shared by the placeholders created by a deferred import.
+struct UsdMaya_ReadJob::_DeferredImport
+{
+    _DeferredImport(
+        const std::string&            filePath,
+        const UsdStageRefPtr&         stage,
+        const Usd_PrimFlagsPredicate& predicate,
+        const UsdMayaJobImportArgs&   args,
+        double                        timeSampleMultiplier)
+        : filePath(filePath)
+        , stage(stage)
+        , predicate(predicate)
+        , args(args)
+        , timeSampleMultiplier(timeSampleMultiplier)
+        , bboxCache(
+              UsdTimeCode::EarliestTime(),
+              { UsdGeomTokens->default_, UsdGeomTokens->render, UsdGeomTokens->proxy },
+              /*useExtentsHint*/ true)
+    {
+    }
+
+    std::string            filePath;
+    UsdStageRefPtr         stage;
+    Usd_PrimFlagsPredicate predicate;
+    UsdMayaJobImportArgs   args;
+    double                 timeSampleMultiplier;
+    UsdGeomBBoxCache       bboxCache;
+
+    // The nodes translated by the subtrees so far, which the next subtrees
+    // share rather than translating them again, like the materials.
+    UsdMayaPrimReaderContext::ObjectRegistry sharedNodes;
+};
+
+// Maps the placeholders to the prim of the subtree they stand for. Once its
+// callbacks are installed, it follows the selection to translate the subtrees
+// of the selected placeholders. Placeholders missing from the registry, e.g.
+// after the scene was reopened, are added back from their attributes.
+struct UsdMaya_ReadJob::_DeferredSubtreeRegistry
+{
+    struct Subtree
+    {
+        std::shared_ptr<_DeferredImport> import;
+        SdfPath                          primPath;
+    };
+
+    std::unordered_map<MObjectHandle, Subtree, _ObjectHandleHash> subtrees;
+
+    // The imports by file, to share them between the placeholders added back
+    // from their attributes.
+    std::map<std::string, std::weak_ptr<_DeferredImport>> imports;
+
+    MString          expandCommand;
+    MCallbackIdArray callbackIds;
+};
+
+// A subtree translated by a DeferredExpansion.
+struct UsdMaya_ReadJob::DeferredExpansion::_Subtree
+{
+    _Subtree(
+        const std::shared_ptr<_DeferredImport>& import,
+        const SdfPath&                          primPath,
+        const MObject&                          placeholder)
+        : import(import)
+        , primPath(primPath)
+        , placeholder(placeholder)
+        , importData(import->filePath)
+        , job(importData, import->args)
+    {
+        job.mTimeSampleMultiplier = import->timeSampleMultiplier;
+    }
+
+    // Released on undo, so that the stage isn't kept open by the undo queue.
+    std::shared_ptr<_DeferredImport> import;
+    SdfPath                          primPath;
+    MObject                          placeholder;
+
+    // Removes the bounding box and attributes of the placeholder.
+    MDagModifier placeholderModifier;
+
+    // The subtree is translated by a job of its own, which is not deferred.
+    // Its registry only keeps the nodes it created, to undo them.
+    MayaUsd::ImportData importData;
+    UsdMaya_ReadJob     job;
+
+    // The nodes of the subtree added to the shared nodes of the import.
+    std::vector<std::string> sharedNodePaths;
+};
+
 UsdMaya_ReadJob::UsdMaya_ReadJob(
     const MayaUsd::ImportData&  iImportData,
     const UsdMayaJobImportArgs& iArgs)
@@ -74,6 +210,7 @@ UsdMaya_ReadJob::UsdMaya_ReadJob(
     , mMayaRootDagPath()
     , mDagModifierUndo()
     , mDagModifierSeeded(false)
+    , mPlaceholderCount(0)
 {
 }
 
@@ -272,7 +409,31 @@ bool UsdMaya_ReadJob::Read(std::vector<MDagPath>* addedDagPaths)
         }
     }
 
+    if (mArgs.deferredImport) {
+        // The placeholders store the real path of the file, so that they can
+        // be expanded whatever the current directory.
+        const std::string& realPath = rootLayer->GetRealPath();
+        mDeferredImport = std::make_shared<_DeferredImport>(
+            realPath.empty() ? mImportData.filename() : realPath,
+            stage,
+            predicate,
+            mArgs,
+            mTimeSampleMultiplier);
+        _GetDeferredSubtreeRegistry().imports[mDeferredImport->filePath] = mDeferredImport;
+    }
+
+    TfStopwatch importWatch;
+    importWatch.Start();
     DoImport(range, usdRootPrim);
+    importWatch.Stop();
+
+    if (mDeferredImport) {
+        TF_STATUS(
+            "Deferred import of '%s': created %zu placeholders in %.3f s",
+            mImportData.filename().c_str(),
+            mPlaceholderCount,
+            importWatch.GetSeconds());
+    }
 
     // NOTE: (yliangsiew) Storage to later pass on to `PostImport` for import chasers.
     MDagPathArray currentAddedDagPaths;
@@ -421,10 +582,17 @@ void UsdMaya_ReadJob::_DoImportInstanceIt(
         return;
     }
     const auto primPath = prim.GetPath();
-    MObject    parentObject = readCtx.GetMayaNode(primPath.GetParentPath(), false);
     MFnDagNode duplicateNode;
-    MObject    duplicateObject
-        = duplicateNode.create("transform", primPath.GetName().c_str(), parentObject, &status);
+    // The transform of a deferred instance is its placeholder, which already
+    // exists when the instance gets expanded.
+    MObject duplicateObject = readCtx.GetMayaNode(primPath, false);
+    if (duplicateObject.isNull()) {
+        MObject parentObject = readCtx.GetMayaNode(primPath.GetParentPath(), false);
+        duplicateObject
+            = duplicateNode.create("transform", primPath.GetName().c_str(), parentObject, &status);
+    } else {
+        status = duplicateNode.setObject(duplicateObject);
+    }
     if (!status) {
         return;
     }
@@ -465,24 +633,65 @@ bool UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootP
 {
     const bool buildInstances = mArgs.importInstances;
 
+    auto subtreeRange = [buildInstances](const UsdPrim& rootPrim) {
+        return buildInstances ? UsdPrimRange::PreAndPostVisit(rootPrim)
+                              : UsdPrimRange::PreAndPostVisit(
+                                  rootPrim, UsdTraverseInstanceProxies(UsdPrimAllPrimsPredicate));
+    };
+
+    // Deferred imports report their progress over the prims translated up
+    // front, which are only the placeholders and their ancestors, and can be
+    // interrupted.
+    MComputation computation;
+    int          progress = 0;
+    bool         interrupted = false;
+    if (mDeferredImport) {
+        int primCount = 0;
+        for (auto rootIt = rootRange.begin(); rootIt != rootRange.end(); ++rootIt) {
+            rootIt.PruneChildren();
+            const UsdPrimRange range = subtreeRange(*rootIt);
+            for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
+                if (!primIt.IsPostVisit()) {
+                    ++primCount;
+                    if (_IsDeferred(*primIt, usdRootPrim)) {
+                        primIt.PruneChildren();
+                    }
+                }
+            }
+        }
+        computation.beginComputation(/*showProgressBar*/ true);
+        computation.setProgressRange(0, primCount);
+    }
+
     // We want both pre- and post- visit iterations over the prims in this
     // method. To do so, iterate over all the root prims of the input range,
     // and create new PrimRanges to iterate over their subtrees.
-    for (auto rootIt = rootRange.begin(); rootIt != rootRange.end(); ++rootIt) {
+    for (auto rootIt = rootRange.begin(); rootIt != rootRange.end() && !interrupted; ++rootIt) {
         const UsdPrim& rootPrim = *rootIt;
         rootIt.PruneChildren();
 
         _PrimReaderMap     primReaderMap;
-        const UsdPrimRange range = buildInstances
-            ? UsdPrimRange::PreAndPostVisit(rootPrim)
-            : UsdPrimRange::PreAndPostVisit(
-                rootPrim, UsdTraverseInstanceProxies(UsdPrimAllPrimsPredicate));
+        const UsdPrimRange range = subtreeRange(rootPrim);
         for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
             const UsdPrim&           prim = *primIt;
             UsdMayaPrimReaderContext readCtx(&mNewNodeRegistry);
             readCtx.SetTimeSampleMultiplier(mTimeSampleMultiplier);
 
-            if (buildInstances && prim.IsInstance()) {
+            if (mDeferredImport && !primIt.IsPostVisit()) {
+                computation.setProgress(++progress);
+                if (computation.isInterruptRequested()) {
+                    interrupted = true;
+                    break;
+                }
+            }
+
+            if (_IsDeferred(prim, usdRootPrim)) {
+                // The subtree is translated when the placeholder gets selected.
+                if (!primIt.IsPostVisit()) {
+                    _CreatePlaceholder(prim, readCtx);
+                    primIt.PruneChildren();
+                }
+            } else if (buildInstances && prim.IsInstance()) {
                 _DoImportInstanceIt(primIt, usdRootPrim, readCtx, primReaderMap);
             } else {
                 _DoImportPrimIt(primIt, usdRootPrim, readCtx, primReaderMap);
@@ -511,14 +720,402 @@ bool UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootP
                     }
                 }
                 deletePrototypeMod.deleteNode(prototypeObject);
+                // Forget the deleted prototype, so that the next subtrees of a
+                // deferred import translate it again.
+                mNewNodeRegistry.erase(prototypePath.GetString());
             }
         }
         deletePrototypeMod.doIt();
     }
 
+    if (mDeferredImport) {
+        computation.endComputation();
+    }
+
     return true;
 }
 
+bool UsdMaya_ReadJob::_IsDeferred(const UsdPrim& prim, const UsdPrim& usdRootPrim) const
+{
+    // The placeholder is the transform the Xform reader would create, so only
+    // Xform models are deferred. Deferring the root prim would leave nothing
+    // to import.
+    return mDeferredImport && prim != usdRootPrim && prim.IsA<UsdGeomXform>()
+        && UsdModelAPI(prim).IsKind(KindTokens->component);
+}
+
+void UsdMaya_ReadJob::_CreatePlaceholder(const UsdPrim& prim, UsdMayaPrimReaderContext& readCtx)
+{
+    MStatus               status;
+    MObject               parentNode = readCtx.GetMayaNode(prim.GetPath().GetParentPath(), true);
+    UsdMayaPrimReaderArgs args(prim, mArgs);
+    MObject               placeholder;
+    if (!UsdMayaTranslatorUtil::CreateTransformNode(
+            prim, parentNode, args, &readCtx, &status, &placeholder)) {
+        return;
+    }
+
+    // Outline the bounding box of the subtree with a curve.
+    const GfRange3d bbox
+        = mDeferredImport->bboxCache.ComputeUntransformedBound(prim).ComputeAlignedRange();
+    if (!bbox.IsEmpty()) {
+        MPointArray  cvs;
+        MDoubleArray knots;
+        for (const size_t corner : _boxOutline) {
+            const GfVec3d point = bbox.GetCorner(corner);
+            cvs.append(MPoint(point[0], point[1], point[2]));
+            knots.append(knots.length());
+        }
+
+        MFnNurbsCurve curveFn;
+        curveFn.create(cvs, knots, 1, MFnNurbsCurve::kOpen, false, false, placeholder, &status);
+        if (status) {
+            curveFn.setName(MString(prim.GetName().GetText()) + "BBoxShape");
+        }
+    }
+
+    MFnDependencyNode depNodeFn(placeholder);
+    _AddStringAttr(depNodeFn, _deferredFilePathAttrName, mDeferredImport->filePath.c_str());
+    _AddStringAttr(depNodeFn, _deferredPrimPathAttrName, prim.GetPath().GetText());
+
+    _GetDeferredSubtreeRegistry().subtrees[MObjectHandle(placeholder)]
+        = { mDeferredImport, prim.GetPath() };
+    ++mPlaceholderCount;
+}
+
+bool UsdMaya_ReadJob::_ExpandSubtree(
+    const UsdPrim&                prim,
+    const Usd_PrimFlagsPredicate& predicate,
+    const MObject&                placeholder,
+    MDagModifier&                 placeholderModifier)
+{
+    MStatus    status;
+    MFnDagNode placeholderFn(placeholder, &status);
+    CHECK_MSTATUS_AND_RETURN(status, false);
+
+    // The placeholder becomes the transform of the prim: remove its bounding
+    // box and attributes, and only translate the descendants of the prim.
+    for (unsigned int i = 0; i < placeholderFn.childCount(); ++i) {
+        MObject child = placeholderFn.child(i);
+        if (child.hasFn(MFn::kNurbsCurve)) {
+            placeholderModifier.deleteNode(child);
+        }
+    }
+    for (const MString& attrName : { _deferredFilePathAttrName, _deferredPrimPathAttrName }) {
+        MObject attr = placeholderFn.attribute(attrName);
+        if (!attr.isNull()) {
+            placeholderModifier.removeAttribute(placeholder, attr);
+        }
+    }
+    status = placeholderModifier.doIt();
+    CHECK_MSTATUS_AND_RETURN(status, false);
+
+    mNewNodeRegistry[prim.GetPath().GetString()] = placeholder;
+
+    // Instances have no children in the default traversal. When instances are
+    // built, the instance itself is imported, which adds the prototype under
+    // the placeholder. Otherwise, its children are traversed as instance
+    // proxies, as when the subtree isn't deferred.
+    if (prim.IsInstance() && mArgs.importInstances) {
+        UsdPrimRange range(prim, predicate);
+        return DoImport(range, prim);
+    }
+    UsdPrimRange range(
+        prim, mArgs.importInstances ? predicate : UsdTraverseInstanceProxies(predicate));
+    range.increment_begin();
+    return DoImport(range, prim);
+}
+
+UsdMaya_ReadJob::DeferredExpansion::DeferredExpansion() = default;
+
+UsdMaya_ReadJob::DeferredExpansion::~DeferredExpansion() = default;
+
+size_t UsdMaya_ReadJob::DeferredExpansion::Expand(const MSelectionList& placeholders)
+{
+    _DeferredSubtreeRegistry& registry = _GetDeferredSubtreeRegistry();
+
+    // Take the subtrees out of the registry first, so that they can't be
+    // expanded again while they are translated. Selecting the bounding box of
+    // a placeholder stands for the placeholder.
+    std::vector<std::unique_ptr<_Subtree>> subtrees;
+    for (unsigned int i = 0; i < placeholders.length(); ++i) {
+        MDagPath dagPath;
+        MObject  node;
+        if (placeholders.getDagPath(i, dagPath)) {
+            node = dagPath.transform();
+        } else if (!placeholders.getDependNode(i, node)) {
+            continue;
+        }
+
+        std::shared_ptr<_DeferredImport> import;
+        SdfPath                          primPath;
+        if (_FindDeferredSubtree(node, &import, &primPath)) {
+            registry.subtrees.erase(MObjectHandle(node));
+            subtrees.emplace_back(new _Subtree(import, primPath, node));
+        }
+    }
+    if (subtrees.empty()) {
+        return 0;
+    }
+
+    MComputation computation;
+    computation.beginComputation(/*showProgressBar*/ true);
+    computation.setProgressRange(0, subtrees.size());
+
+    TfStopwatch expandWatch;
+    expandWatch.Start();
+
+    size_t expanded = 0;
+    for (size_t i = 0; i < subtrees.size(); ++i) {
+        computation.setProgress(static_cast<int>(i));
+        if (computation.isInterruptRequested()) {
+            // Keep the remaining placeholders to expand them later.
+            for (; i < subtrees.size(); ++i) {
+                registry.subtrees[MObjectHandle(subtrees[i]->placeholder)]
+                    = { subtrees[i]->import, subtrees[i]->primPath };
+            }
+            break;
+        }
+
+        _Subtree&        subtree = *subtrees[i];
+        _DeferredImport& import = *subtree.import;
+        const UsdPrim    prim = import.stage->GetPrimAtPath(subtree.primPath);
+        if (!prim) {
+            TF_WARN(
+                "Deferred import: no prim at <%s> in '%s'",
+                subtree.primPath.GetText(),
+                import.filePath.c_str());
+            continue;
+        }
+
+        // Share the nodes of the previous subtrees, but only keep the new
+        // ones in the registry of the job, as Undo() deletes them.
+        UsdMaya_ReadJob& job = subtree.job;
+        for (const auto& sharedNode : import.sharedNodes) {
+            if (MObjectHandle(sharedNode.second).isValid()) {
+                job.mNewNodeRegistry.insert(sharedNode);
+            }
+        }
+        const UsdMayaPrimReaderContext::ObjectRegistry previousNodes = job.mNewNodeRegistry;
+        if (!job._ExpandSubtree(
+                prim, import.predicate, subtree.placeholder, subtree.placeholderModifier)) {
+            continue;
+        }
+
+        job.mNewNodeRegistry.erase(subtree.primPath.GetString());
+        for (auto it = job.mNewNodeRegistry.begin(); it != job.mNewNodeRegistry.end();) {
+            auto previous = previousNodes.find(it->first);
+            if (previous != previousNodes.end() && previous->second == it->second) {
+                it = job.mNewNodeRegistry.erase(it);
+            } else {
+                import.sharedNodes[it->first] = it->second;
+                subtree.sharedNodePaths.push_back(it->first);
+                ++it;
+            }
+        }
+
+        mSubtrees.push_back(std::move(subtrees[i]));
+        ++expanded;
+    }
+
+    expandWatch.Stop();
+    computation.endComputation();
+
+    TF_STATUS(
+        "Deferred import: translated %zu of %zu subtrees in %.3f s",
+        expanded,
+        subtrees.size(),
+        expandWatch.GetSeconds());
+
+    return expanded;
+}
+
+bool UsdMaya_ReadJob::DeferredExpansion::Undo()
+{
+    bool success = true;
+    for (auto it = mSubtrees.rbegin(); it != mSubtrees.rend(); ++it) {
+        _Subtree& subtree = **it;
+        success = subtree.job.Undo() && success;
+        success = subtree.placeholderModifier.undoIt() && success;
+
+        // The placeholder is added back to the registry from its attributes
+        // when it gets selected again, so release the import.
+        if (subtree.import) {
+            for (const std::string& nodePath : subtree.sharedNodePaths) {
+                subtree.import->sharedNodes.erase(nodePath);
+            }
+            subtree.import.reset();
+        }
+    }
+    return success;
+}
+
+bool UsdMaya_ReadJob::DeferredExpansion::Redo()
+{
+    _DeferredSubtreeRegistry& registry = _GetDeferredSubtreeRegistry();
+
+    bool success = true;
+    for (const std::unique_ptr<_Subtree>& subtree : mSubtrees) {
+        registry.subtrees.erase(MObjectHandle(subtree->placeholder));
+        success = subtree->placeholderModifier.doIt() && success;
+        success = subtree->job.Redo() && success;
+    }
+    return success;
+}
+
+/* static */
+void UsdMaya_ReadJob::InstallDeferredImportCallbacks(const MString& expandCommand)
+{
+    _DeferredSubtreeRegistry& registry = _GetDeferredSubtreeRegistry();
+    if (registry.callbackIds.length() > 0) {
+        return;
+    }
+    registry.expandCommand = expandCommand;
+
+    MStatus status;
+    registry.callbackIds.append(MModelMessage::addCallback(
+        MModelMessage::kActiveListModified, _OnSelectionChanged, nullptr, &status));
+    CHECK_MSTATUS(status);
+    registry.callbackIds.append(
+        MSceneMessage::addCallback(MSceneMessage::kBeforeNew, _OnSceneReset, nullptr, &status));
+    CHECK_MSTATUS(status);
+    registry.callbackIds.append(
+        MSceneMessage::addCallback(MSceneMessage::kBeforeOpen, _OnSceneReset, nullptr, &status));
+    CHECK_MSTATUS(status);
+}
+
+/* static */
+void UsdMaya_ReadJob::RemoveDeferredImportCallbacks()
+{
+    _DeferredSubtreeRegistry& registry = _GetDeferredSubtreeRegistry();
+    MMessage::removeCallbacks(registry.callbackIds);
+    registry.callbackIds.clear();
+    registry.expandCommand.clear();
+    _OnSceneReset(nullptr);
+}
+
+/* static */
+bool UsdMaya_ReadJob::_FindDeferredSubtree(
+    const MObject&                    placeholder,
+    std::shared_ptr<_DeferredImport>* import,
+    SdfPath*                          primPath)
+{
+    _DeferredSubtreeRegistry& registry = _GetDeferredSubtreeRegistry();
+
+    auto it = registry.subtrees.find(MObjectHandle(placeholder));
+    if (it != registry.subtrees.end()) {
+        *import = it->second.import;
+        *primPath = it->second.primPath;
+        return true;
+    }
+
+    MStatus           status;
+    MFnDependencyNode depNodeFn(placeholder, &status);
+    if (!status) {
+        return false;
+    }
+    const MString filePath = _GetStringAttr(depNodeFn, _deferredFilePathAttrName);
+    const MString primPathString = _GetStringAttr(depNodeFn, _deferredPrimPathAttrName);
+    if (filePath.length() == 0 || primPathString.length() == 0) {
+        return false;
+    }
+
+    std::weak_ptr<_DeferredImport>& cachedImport = registry.imports[filePath.asChar()];
+    *import = cachedImport.lock();
+    if (!*import) {
+        *import = _OpenDeferredImport(filePath.asChar());
+        if (!*import) {
+            TF_WARN("Deferred import: cannot open '%s'", filePath.asChar());
+            return false;
+        }
+        cachedImport = *import;
+    }
+    *primPath = SdfPath(primPathString.asChar());
+
+    registry.subtrees[MObjectHandle(placeholder)] = { *import, *primPath };
+    return true;
+}
+
+/* static */
+std::shared_ptr<UsdMaya_ReadJob::_DeferredImport>
+UsdMaya_ReadJob::_OpenDeferredImport(const std::string& filePath)
+{
+    SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(filePath);
+    if (!rootLayer) {
+        return nullptr;
+    }
+
+    // The arguments of the import aren't stored on the placeholders, so the
+    // subtrees of a reopened scene are translated with the default ones.
+    UsdStageCacheContext stageCacheContext(UsdMayaStageCache::Get(true));
+    UsdStageRefPtr       stage = UsdStage::Open(rootLayer);
+    if (!stage) {
+        return nullptr;
+    }
+
+    const UsdMayaJobImportArgs args
+        = UsdMayaJobImportArgs::CreateFromDictionary(UsdMayaJobImportArgs::GetDefaultDictionary());
+    const double timeSampleMultiplier
+        = UsdMayaUtil::GetSceneMTimeUnitAsDouble() / stage->GetTimeCodesPerSecond();
+    return std::make_shared<_DeferredImport>(
+        filePath, stage, UsdPrimDefaultPredicate, args, timeSampleMultiplier);
+}
+
+/* static */
+UsdMaya_ReadJob::_DeferredSubtreeRegistry& UsdMaya_ReadJob::_GetDeferredSubtreeRegistry()
+{
+    static _DeferredSubtreeRegistry registry;
+    return registry;
+}
+
+/* static */
+void UsdMaya_ReadJob::_OnSelectionChanged(void* /*clientData*/)
+{
+    // The expansions are undone and redone by their command, and not
+    // triggered again by the selection it restores.
+    if (MGlobal::isUndoing() || MGlobal::isRedoing()) {
+        return;
+    }
+
+    // Selecting the bounding box of a placeholder selects the placeholder.
+    MSelectionList selection;
+    MGlobal::getActiveSelectionList(selection);
+    MString command = _GetDeferredSubtreeRegistry().expandCommand;
+    bool    hasPlaceholders = false;
+    for (unsigned int i = 0; i < selection.length(); ++i) {
+        MDagPath dagPath;
+        if (!selection.getDagPath(i, dagPath)) {
+            continue;
+        }
+        MObject           transform = dagPath.transform();
+        MFnDependencyNode depNodeFn(transform);
+        if (depNodeFn.hasAttribute(_deferredPrimPathAttrName)) {
+            command += " \"" + MFnDagNode(transform).fullPathName() + "\"";
+            hasPlaceholders = true;
+        }
+    }
+    if (!hasPlaceholders) {
+        return;
+    }
+
+    // The subtrees are translated by an undoable command, on idle rather than
+    // in the middle of the selection change, except in batch mode where there
+    // may be no idle time.
+    if (MGlobal::mayaState() != MGlobal::kInteractive) {
+        MGlobal::executeCommand(command, /*displayEnabled*/ false, /*undoEnabled*/ true);
+    } else {
+        MGlobal::executeCommandOnIdle(command);
+    }
+}
+
+/* static */
+void UsdMaya_ReadJob::_OnSceneReset(void* /*clientData*/)
+{
+    _DeferredSubtreeRegistry& registry = _GetDeferredSubtreeRegistry();
+    registry.subtrees.clear();
+    registry.imports.clear();
+}
+
 void UsdMaya_ReadJob::PreImport(Usd_PrimFlagsPredicate& returnPredicate) { }
 
 bool UsdMaya_ReadJob::SkipRootPrim(bool isImportingPseudoRoot) { return isImportingPseudoRoot; }
@@ -542,6 +1139,16 @@ bool UsdMaya_ReadJob::Redo()
 
 bool UsdMaya_ReadJob::Undo()
 {
+    // The placeholders are added back to the registry from their attributes
+    // if the import is redone, so release the stage.
+    if (mDeferredImport) {
+        _DeferredSubtreeRegistry& registry = _GetDeferredSubtreeRegistry();
+        for (auto it = registry.subtrees.begin(); it != registry.subtrees.end();) {
+            it = it->second.import == mDeferredImport ? registry.subtrees.erase(it) : ++it;
+        }
+        mDeferredImport.reset();
+    }
+
     // NOTE: (yliangsiew) All chasers need to have their Undo run as well.
     for (const UsdMayaImportChaserRefPtr& chaser : this->mImportChasers) {
         bool bStat = chaser->Undo();
@@ -28,8 +28,11 @@
 
 #include <maya/MDagModifier.h>
 #include <maya/MDagPath.h>
+#include <maya/MSelectionList.h>
+#include <maya/MString.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -69,6 +72,52 @@ public:
     MAYAUSD_CORE_PUBLIC
     double timeSampleMultiplier() const;
 
+    /// Translates the subtrees of placeholders, the transforms created for
+    /// component models by a deferred import (see
+    /// UsdMayaJobImportArgs::deferredImport). Each subtree is translated by a
+    /// job of its own, so that the expansion can be undone and redone by the
+    /// command running it.
+    class DeferredExpansion
+    {
+    public:
+        MAYAUSD_CORE_PUBLIC
+        DeferredExpansion();
+
+        MAYAUSD_CORE_PUBLIC
+        ~DeferredExpansion();
+
+        /// Translates the subtrees of the placeholders found in
+        /// \p placeholders, any other node is ignored. The placeholders
+        /// store the file and prim path of their subtree, so that they can
+        /// still be expanded once the scene is reopened.
+        /// Returns the number of subtrees translated.
+        MAYAUSD_CORE_PUBLIC
+        size_t Expand(const MSelectionList& placeholders);
+
+        /// Removes the translated subtrees and restores the placeholders.
+        MAYAUSD_CORE_PUBLIC
+        bool Undo();
+
+        /// Translates the subtrees again after Undo() has been called.
+        MAYAUSD_CORE_PUBLIC
+        bool Redo();
+
+    private:
+        struct _Subtree;
+        std::vector<std::unique_ptr<_Subtree>> mSubtrees;
+    };
+
+    /// Installs the callbacks translating the subtrees of the placeholders
+    /// when they get selected, by running \p expandCommand on them. The
+    /// command must run a DeferredExpansion, so that it can be undone.
+    MAYAUSD_CORE_PUBLIC
+    static void InstallDeferredImportCallbacks(const MString& expandCommand);
+
+    /// Removes the callbacks, and releases the stages of the deferred imports.
+    /// Called when the plug-in is unloaded.
+    MAYAUSD_CORE_PUBLIC
+    static void RemoveDeferredImportCallbacks();
+
 protected:
     // Types
     using _PrimReaderMap = std::unordered_map<SdfPath, UsdMayaPrimReaderSharedPtr, SdfPath::Hash>;
@@ -128,6 +177,34 @@ private:
 
     double _setTimeSampleMultiplierFrom(const double layerFPS);
 
+    // Deferred import. The state needed to translate the subtrees of the
+    // placeholders later on is shared by all the placeholders of an import,
+    // and the registry maps the placeholders to their prims.
+    struct _DeferredImport;
+    struct _DeferredSubtreeRegistry;
+
+    bool _IsDeferred(const UsdPrim& prim, const UsdPrim& usdRootPrim) const;
+
+    void _CreatePlaceholder(const UsdPrim& prim, UsdMayaPrimReaderContext& readCtx);
+
+    bool _ExpandSubtree(
+        const UsdPrim&                prim,
+        const Usd_PrimFlagsPredicate& predicate,
+        const MObject&                placeholder,
+        MDagModifier&                 placeholderModifier);
+
+    // Finds the import and prim of a placeholder, from the registry or from
+    // the file and prim path stored on the placeholder.
+    static bool _FindDeferredSubtree(
+        const MObject&                    placeholder,
+        std::shared_ptr<_DeferredImport>* import,
+        SdfPath*                          primPath);
+
+    static std::shared_ptr<_DeferredImport> _OpenDeferredImport(const std::string& filePath);
+    static _DeferredSubtreeRegistry&        _GetDeferredSubtreeRegistry();
+    static void                             _OnSelectionChanged(void* clientData);
+    static void                             _OnSceneReset(void* clientData);
+
     // Data
     MDagModifier mDagModifierUndo;
     bool         mDagModifierSeeded;
@@ -136,6 +213,10 @@ private:
     /// Cache of import chasers that were run. Currently used to aid in redo/undo operations
     /// This cache is cleared for every new Read() operation.
     UsdMayaImportChaserRefPtrVector mImportChasers;
+
+    /// Set by Read() for deferred imports, null otherwise.
+    std::shared_ptr<_DeferredImport> mDeferredImport;
+    size_t                           mPlaceholderCount;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -15,12 +15,15 @@
 //
 #include "writeJob.h"
 
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/fileUtils.h>
 #include <pxr/base/tf/hash.h>
 #include <pxr/base/tf/hashset.h>
 #include <pxr/base/tf/pathUtils.h>
 #include <pxr/base/tf/stl.h>
+#include <pxr/base/tf/stopwatch.h>
 #include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/resolver.h>
 #include <pxr/usd/kind/registry.h>
@@ -39,9 +42,12 @@
 #include <maya/MStatus.h>
 #include <maya/MUuid.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
+#include <string>
 #include <unordered_set>
+#include <vector>
 // Needed for directly removing a UsdVariant via Sdf
 //   Remove when UsdVariantSet::RemoveVariant() is exposed
 //   XXX [bug 75864]
@@ -70,6 +76,13 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_EXPORT_PARALLEL_CONVERT,
+    true,
+    "When exporting animation, convert the data pulled from Maya by the prim "
+    "writers in parallel. Set to false to do it serially, e.g. when debugging "
+    "a prim writer.");
+
 UsdMaya_WriteJob::UsdMaya_WriteJob(const UsdMayaJobExportArgs& iArgs)
     : mJobCtx(iArgs)
     , _modelKindProcessor(new UsdMaya_ModelKindProcessor(iArgs))
@@ -103,6 +116,52 @@ static TfToken _GetFallbackExtension(const TfToken& compatibilityMode)
     return UsdMayaTranslatorTokens->UsdFileExtensionDefault;
 }
 
+/// Orders full DAG path names so that the descendants of a DAG path immediately follow it,
+/// by sorting the '|' separator before any other character.
+static bool _DagPathNameLess(const std::string& lhs, const std::string& rhs)
+{
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, char b) {
+            const unsigned char keyA = a == '|' ? 0 : static_cast<unsigned char>(a);
+            const unsigned char keyB = b == '|' ? 0 : static_cast<unsigned char>(b);
+            return keyA < keyB;
+        });
+}
+
+/// Reports and returns true if one of \p dagPaths is an ancestor of another one.
+/// Once the paths are sorted by _DagPathNameLess(), some path has a selected ancestor if and only
+/// if a path directly follows one of its ancestors, so this takes O(n log n) comparisons instead
+/// of comparing every pair of paths.
+static bool _DagPathsOverlap(const UsdMayaUtil::MDagPathSet& dagPaths)
+{
+    std::vector<std::string> pathNames;
+    pathNames.reserve(dagPaths.size());
+    for (const MDagPath& dagPath : dagPaths) {
+        MStatus           status;
+        const std::string pathName(dagPath.fullPathName(&status).asChar());
+        if (status == MS::kSuccess && !pathName.empty()) {
+            pathNames.push_back(pathName);
+        }
+    }
+    std::sort(pathNames.begin(), pathNames.end(), _DagPathNameLess);
+
+    for (size_t i = 1; i < pathNames.size(); ++i) {
+        const std::string& ancestor = pathNames[i - 1];
+        const std::string& pathName = pathNames[i];
+        if (pathName.size() > ancestor.size() && pathName[ancestor.size()] == '|'
+            && pathName.compare(0, ancestor.size(), ancestor) == 0) {
+            TF_RUNTIME_ERROR(
+                "%s and %s are ancestors or descendants of each other. "
+                "Please specify export DAG paths that don't overlap. "
+                "Exiting.",
+                ancestor.c_str(),
+                pathName.c_str());
+            return true;
+        }
+    }
+    return false;
+}
+
 bool UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
 {
     const std::vector<double>& timeSamples = mJobCtx.mArgs.timeSamples;
@@ -118,12 +177,18 @@ bool UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
     }
 
     // Default-time export.
+    TfStopwatch beginWatch;
+    beginWatch.Start();
     if (!_BeginWriting(fileName, append)) {
         computation.endComputation();
         return false;
     }
+    beginWatch.Stop();
 
     // Time-sampled export.
+    TfStopwatch framesWatch;
+    framesWatch.Start();
+    size_t frameCount = 0;
     if (!timeSamples.empty()) {
         const MTime oldCurTime = MAnimControl::currentTime();
 
@@ -135,6 +200,7 @@ bool UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
             MGlobal::viewFrame(t);
             computation.setProgress(progress);
             progress++;
+            frameCount++;
 
             // Process per frame data.
             if (!_WriteFrame(t)) {
@@ -152,12 +218,27 @@ bool UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
         // Set the time back.
         MGlobal::viewFrame(oldCurTime);
     }
+    framesWatch.Stop();
 
     // Finalize the export, close the stage.
+    TfStopwatch finishWatch;
+    finishWatch.Start();
     if (!_FinishWriting()) {
         computation.endComputation();
         return false;
     }
+    finishWatch.Stop();
+
+    if (mJobCtx.mArgs.verbose) {
+        TF_STATUS(
+            "Export: setup and default time %.3fs, %zu frames %.3fs (%.3fs per frame), "
+            "finish %.3fs",
+            beginWatch.GetSeconds(),
+            frameCount,
+            framesWatch.GetSeconds(),
+            frameCount ? framesWatch.GetSeconds() / frameCount : 0.0,
+            finishWatch.GetSeconds());
+    }
 
     computation.endComputation();
     return true;
@@ -165,26 +246,18 @@ bool UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
 
 bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
 {
+    TfStopwatch setupWatch;
+    setupWatch.Start();
+
     // Check for DAG nodes that are a child of an already specified DAG node to export
     // if that's the case, report the issue and skip the export
-    UsdMayaUtil::MDagPathSet::const_iterator m, n;
-    UsdMayaUtil::MDagPathSet::const_iterator endPath = mJobCtx.mArgs.dagPaths.end();
-    for (m = mJobCtx.mArgs.dagPaths.begin(); m != endPath;) {
-        MDagPath path1 = *m;
-        m++;
-        for (n = m; n != endPath; n++) {
-            MDagPath path2 = *n;
-            if (UsdMayaUtil::isAncestorDescendentRelationship(path1, path2)) {
-                TF_RUNTIME_ERROR(
-                    "%s and %s are ancestors or descendants of each other. "
-                    "Please specify export DAG paths that don't overlap. "
-                    "Exiting.",
-                    path1.fullPathName().asChar(),
-                    path2.fullPathName().asChar());
-                return false;
-            }
-        } // for n
-    }     // for m
+    TfStopwatch overlapWatch;
+    overlapWatch.Start();
+    const bool dagPathsOverlap = _DagPathsOverlap(mJobCtx.mArgs.dagPaths);
+    overlapWatch.Stop();
+    if (dagPathsOverlap) {
+        return false;
+    }
 
     // Make sure the file name is a valid one with a proper USD extension.
     TfToken     fileExt(TfGetExtension(fileName));
@@ -275,12 +348,15 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
             false);
     }
 
+    TfStopwatch dagSetsWatch;
+    dagSetsWatch.Start();
+
     // Pre-process the argument dagPath path names into two sets. One set
     // contains just the arg dagPaths, and the other contains all parents of
     // arg dagPaths all the way up to the world root. Partial path names are
     // enough because Maya guarantees them to still be unique, and they require
     // less work to hash and compare than full path names.
-    TfHashSet<std::string, TfHash>           argDagPaths;
+    TfHashSet<std::string, TfHash>           argDagPaths(mJobCtx.mArgs.dagPaths.size());
     TfHashSet<std::string, TfHash>           argDagPathParents;
     UsdMayaUtil::MDagPathSet::const_iterator end = mJobCtx.mArgs.dagPaths.end();
     for (UsdMayaUtil::MDagPathSet::const_iterator it = mJobCtx.mArgs.dagPaths.begin(); it != end;
@@ -325,8 +401,13 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
         }
     }
 
+    dagSetsWatch.Stop();
+    setupWatch.Stop();
+
     // Now do a depth-first traversal of the Maya DAG from the world root.
     // We keep a reference to arg dagPaths as we encounter them.
+    TfStopwatch primWritersWatch;
+    primWritersWatch.Start();
     MDagPath curLeafDagPath;
     for (MItDag itDag(MItDag::kDepthFirst, MFn::kInvalid); !itDag.isDone(); itDag.next()) {
         MDagPath curDagPath;
@@ -380,12 +461,19 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
         }
     }
 
+    primWritersWatch.Stop();
+
     // Writing Materials/Shading
+    TfStopwatch shadingWatch;
+    shadingWatch.Start();
     UsdMayaTranslatorMaterial::ExportShadingEngines(mJobCtx, mDagPathToUsdPathMap);
+    shadingWatch.Stop();
 
     // Perform post-processing for instances, skel, etc.
     // We shouldn't be creating new instance masters after this point, and we
     // want to cleanup the MayaExportedInstanceSources prim before writing model hierarchy.
+    TfStopwatch postProcessWatch;
+    postProcessWatch.Start();
     if (!mJobCtx._PostProcess()) {
         return false;
     }
@@ -393,8 +481,11 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
     if (!_modelKindProcessor->MakeModelHierarchy(mJobCtx.mStage)) {
         return false;
     }
+    postProcessWatch.Stop();
 
     // now we populate the chasers and run export default
+    TfStopwatch chaserWatch;
+    chaserWatch.Start();
     mChasers.clear();
     UsdMayaExportChaserRegistry::FactoryContext ctx(
         mJobCtx.mStage, mDagPathToUsdPathMap, mJobCtx.mArgs);
@@ -412,6 +503,20 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
             return false;
         }
     }
+    chaserWatch.Stop();
+
+    if (mJobCtx.mArgs.verbose) {
+        TF_STATUS(
+            "Export setup %.3fs (overlap check %.3fs, DAG sets %.3fs), default time: prim writers "
+            "%.3fs, shading %.3fs, post-process %.3fs, chasers %.3fs",
+            setupWatch.GetSeconds(),
+            overlapWatch.GetSeconds(),
+            dagSetsWatch.GetSeconds(),
+            primWritersWatch.GetSeconds(),
+            shadingWatch.GetSeconds(),
+            postProcessWatch.GetSeconds(),
+            chaserWatch.GetSeconds());
+    }
 
     return true;
 }
@@ -420,18 +525,67 @@ bool UsdMaya_WriteJob::_WriteFrame(double iFrame)
 {
     const UsdTimeCode usdTime(iFrame);
 
-    for (const UsdMayaPrimWriterSharedPtr& primWriter : mJobCtx.mMayaPrimWriterList) {
+    const std::vector<UsdMayaPrimWriterSharedPtr>& primWriters = mJobCtx.mMayaPrimWriterList;
+
+    // Pull the data of the frame out of Maya. The Maya API can only be used
+    // from the main thread.
+    TfStopwatch pullWatch;
+    pullWatch.Start();
+    for (const UsdMayaPrimWriterSharedPtr& primWriter : primWriters) {
+        if (primWriter->GetUsdPrim()) {
+            primWriter->PullFrame(usdTime);
+        }
+    }
+    pullWatch.Stop();
+
+    // Convert the pulled data. Writers don't touch Maya nor the stage here, so
+    // this can be spread over all the available threads.
+    TfStopwatch convertWatch;
+    convertWatch.Start();
+    const auto convertFrames = [&primWriters, &usdTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (primWriters[i]->GetUsdPrim()) {
+                primWriters[i]->ConvertFrame(usdTime);
+            }
+        }
+    };
+    if (TfGetEnvSetting(MAYAUSD_EXPORT_PARALLEL_CONVERT)) {
+        WorkParallelForN(primWriters.size(), convertFrames);
+    } else {
+        convertFrames(0, primWriters.size());
+    }
+    convertWatch.Stop();
+
+    // Author the frame. A layer can only be edited from one thread at a time,
+    // so this stays serial.
+    TfStopwatch writeWatch;
+    writeWatch.Start();
+    for (const UsdMayaPrimWriterSharedPtr& primWriter : primWriters) {
         const UsdPrim& usdPrim = primWriter->GetUsdPrim();
         if (usdPrim) {
             primWriter->Write(usdTime);
         }
     }
+    writeWatch.Stop();
 
+    TfStopwatch chaserWatch;
+    chaserWatch.Start();
     for (UsdMayaExportChaserRefPtr& chaser : mChasers) {
         if (!chaser->ExportFrame(iFrame)) {
             return false;
         }
     }
+    chaserWatch.Stop();
+
+    if (mJobCtx.mArgs.verbose) {
+        TF_STATUS(
+            "Frame %f: pull %.3fs, convert %.3fs, write %.3fs, chasers %.3fs",
+            iFrame,
+            pullWatch.GetSeconds(),
+            convertWatch.GetSeconds(),
+            writeWatch.GetSeconds(),
+            chaserWatch.GetSeconds());
+    }
 
     _PerFrameCallback(iFrame);
 
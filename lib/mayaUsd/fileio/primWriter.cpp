@@ -217,6 +217,12 @@ bool UsdMayaPrimWriter::ExportsGprims() const { return false; }
 /* virtual */
 bool UsdMayaPrimWriter::ShouldPruneChildren() const { return false; }
 
+/* virtual */
+void UsdMayaPrimWriter::PullFrame(const UsdTimeCode&) { }
+
+/* virtual */
+void UsdMayaPrimWriter::ConvertFrame(const UsdTimeCode&) { }
+
 /* virtual */
 void UsdMayaPrimWriter::PostExport() { MakeSingleSamplesStatic(); }
 
@@ -252,7 +258,7 @@ const UsdMayaJobExportArgs& UsdMayaPrimWriter::_GetExportArgs() const
     return _writeJobCtx.GetArgs();
 }
 
-UsdUtilsSparseValueWriter* UsdMayaPrimWriter::_GetSparseValueWriter() { return &_valueWriter; }
+UsdMayaSparseValueWriter* UsdMayaPrimWriter::_GetSparseValueWriter() { return &_valueWriter; }
 
 void UsdMayaPrimWriter::MakeSingleSamplesStatic()
 {
@@ -18,6 +18,7 @@
 
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/fileio/jobs/jobArgs.h>
+#include <mayaUsd/fileio/utils/sparseValueWriter.h>
 #include <mayaUsd/utils/util.h>
 
 #include <pxr/base/vt/value.h>
@@ -75,6 +76,29 @@ public:
     MAYAUSD_CORE_PUBLIC
     virtual void Write(const UsdTimeCode& usdTime);
 
+    /// Optional first stage of a time-sampled Write(), for writers that can
+    /// separate pulling their data out of Maya from converting it.
+    ///
+    /// For each animated frame, the write job calls PullFrame() on every
+    /// writer on the main thread, then ConvertFrame() on all the writers in
+    /// parallel, and finally Write() on the main thread as usual.
+    /// PullFrame() is the only one of the two that may use the Maya API.
+    ///
+    /// The base implementation does nothing.
+    MAYAUSD_CORE_PUBLIC
+    virtual void PullFrame(const UsdTimeCode& usdTime);
+
+    /// Optional second stage of a time-sampled Write(), see PullFrame().
+    ///
+    /// This runs concurrently with the ConvertFrame() of other writers, so it
+    /// must neither use the Maya API nor author anything to the USD stage.
+    /// It should only turn the data stashed by PullFrame() into the USD values
+    /// that Write() will author.
+    ///
+    /// The base implementation does nothing.
+    MAYAUSD_CORE_PUBLIC
+    virtual void ConvertFrame(const UsdTimeCode& usdTime);
+
     /// Post export function that runs before saving the stage.
     ///
     /// Base implementation handles optional optimization of data.
@@ -184,7 +208,7 @@ protected:
     /// attributes. Access to this is provided so that attribute authoring
     /// happening inside non-member functions can make use of it.
     MAYAUSD_CORE_PUBLIC
-    UsdUtilsSparseValueWriter* _GetSparseValueWriter();
+    UsdMayaSparseValueWriter* _GetSparseValueWriter();
 
     UsdPrim                 _usdPrim;
     UsdMayaWriteJobContext& _writeJobCtx;
@@ -209,7 +233,7 @@ private:
     const SdfPath                           _usdPath;
     const UsdMayaUtil::MDagPathMap<SdfPath> _baseDagToUsdPaths;
 
-    UsdUtilsSparseValueWriter _valueWriter;
+    UsdMayaSparseValueWriter _valueWriter;
 
     bool _exportVisibility;
     bool _hasAnimCurves;
@@ -17,6 +17,7 @@
 
 #include <mayaUsd/fileio/primWriterRegistry.h>
 #include <mayaUsd/fileio/utils/adaptor.h>
+#include <mayaUsd/fileio/utils/writeUtil.h>
 #include <mayaUsd/fileio/utils/xformStack.h>
 #include <mayaUsd/fileio/writeJobContext.h>
 #include <mayaUsd/utils/util.h>
@@ -49,10 +50,10 @@ PXRUSDMAYA_REGISTER_ADAPTOR_SCHEMA(transform, UsdGeomXform);
 
 // Given an Op, value and time, set the Op value based on op type and precision
 static void setXformOp(
-    const UsdGeomXformOp&      op,
-    const GfVec3d&             value,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const UsdGeomXformOp&     op,
+    const GfVec3d&            value,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     if (!op) {
         TF_CODING_ERROR("Xform op is not valid");
@@ -64,7 +65,7 @@ static void setXformOp(
         shearXForm[1][0] = value[0]; // xyVal
         shearXForm[2][0] = value[1]; // xzVal
         shearXForm[2][1] = value[2]; // yzVal
-        valueWriter->SetAttribute(op.GetAttr(), shearXForm, usdTime);
+        UsdMayaWriteUtil::SetAttribute(op.GetAttr(), shearXForm, usdTime, valueWriter);
         return;
     }
 
@@ -75,7 +76,7 @@ static void setXformOp(
     } else { // float precision
         vtValue = VtValue(GfVec3f(value));
     }
-    valueWriter->SetAttribute(op.GetAttr(), vtValue, usdTime);
+    UsdMayaWriteUtil::SetAttribute(op.GetAttr(), &vtValue, usdTime, valueWriter);
 }
 
 /* static */
@@ -84,7 +85,7 @@ void UsdMayaTransformWriter::_ComputeXformOps(
     const UsdTimeCode&                         usdTime,
     const bool                                 eulerFilter,
     UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
-    UsdUtilsSparseValueWriter*                 valueWriter)
+    UsdMayaSparseValueWriter*                  valueWriter)
 {
     if (!TF_VERIFY(previousRotates)) {
         return;
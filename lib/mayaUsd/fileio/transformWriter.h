@@ -18,6 +18,7 @@
 
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/fileio/primWriter.h>
+#include <mayaUsd/fileio/utils/sparseValueWriter.h>
 #include <mayaUsd/fileio/writeJobContext.h>
 
 #include <pxr/base/gf/vec3d.h>
@@ -27,7 +28,6 @@
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usdGeom/xformOp.h>
 #include <pxr/usd/usdGeom/xformable.h>
-#include <pxr/usd/usdUtils/sparseValueWriter.h>
 
 #include <maya/MEulerRotation.h>
 #include <maya/MFnDependencyNode.h>
@@ -101,7 +101,7 @@ private:
         const UsdTimeCode&                         usdTime,
         const bool                                 eulerFilter,
         UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
-        UsdUtilsSparseValueWriter*                 valueWriter);
+        UsdMayaSparseValueWriter*                  valueWriter);
 
     // Creates an _AnimChannel from a Maya compound attribute if there is
     // meaningful data. This means we found data that is non-identity.
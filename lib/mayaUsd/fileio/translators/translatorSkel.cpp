@@ -21,6 +21,7 @@
 
 #include <pxr/base/tf/staticData.h>
 #include <pxr/base/tf/staticTokens.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/usd/usdSkel/skeleton.h>
 #include <pxr/usd/usdSkel/skeletonQuery.h>
 #include <pxr/usd/usdSkel/skinningQuery.h>
@@ -43,6 +44,10 @@
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 // There are a lot of nodes and connections that go into a basic skinning rig.
@@ -205,68 +210,63 @@ bool _SetAnimPlugData(
     return true;
 }
 
+/// Number of channels a transform is decomposed into: translate, rotate and
+/// scale, in this order, each with X, Y and Z.
+constexpr size_t _kNumTransformChannels = 9;
+
+/// Decompose \p xform into sample \p sampleIdx of \p channels, which holds
+/// _kNumTransformChannels consecutive arrays of \p numSamples values.
+void _DecomposeTransform(
+    const GfMatrix4d& xform,
+    size_t            sampleIdx,
+    size_t            numSamples,
+    double*           channels)
+{
+    GfVec3d t(0.0), r(0.0), s(1.0);
+    UsdMayaTranslatorXformable::ConvertUsdMatrixToComponents(xform, &t, &r, &s);
+    for (size_t c = 0; c < 3; ++c) {
+        channels[c * numSamples + sampleIdx] = t[c];
+        channels[(3 + c) * numSamples + sampleIdx] = r[c];
+        channels[(6 + c) * numSamples + sampleIdx] = s[c];
+    }
+}
+
 /// Set animation on \p transformNode.
-/// The \p xforms holds transforms at each time, while the \p times
-/// array holds the corresponding times.
+/// The \p channels hold the decomposed transforms, as filled by
+/// _DecomposeTransform(), at each of the \p times.
+/// Channels which keep the same value at all times are set to that value
+/// rather than keyed.
 bool _SetTransformAnim(
     MFnDependencyNode&              transformNode,
-    const std::vector<GfMatrix4d>&  xforms,
+    const double*                   channels,
     MTimeArray&                     times,
     const UsdMayaPrimReaderContext* context)
 {
-    if (xforms.size() != times.length()) {
-        TF_WARN("xforms size [%zu] != times size [%du].", xforms.size(), times.length());
-        return false;
-    }
-    if (xforms.empty())
-        return true;
-
-    MStatus status;
-
     const unsigned int numSamples = times.length();
+    if (numSamples == 0)
+        return true;
 
-    if (numSamples > 1) {
-        MDoubleArray translates[3]
-            = { MDoubleArray(numSamples), MDoubleArray(numSamples), MDoubleArray(numSamples) };
-        MDoubleArray rotates[3]
-            = { MDoubleArray(numSamples), MDoubleArray(numSamples), MDoubleArray(numSamples) };
-        MDoubleArray scales[3] = { MDoubleArray(numSamples, 1),
-                                   MDoubleArray(numSamples, 1),
-                                   MDoubleArray(numSamples, 1) };
-
-        // Decompose all transforms.
-        for (unsigned int i = 0; i < numSamples; ++i) {
-            const auto& xform = xforms[i];
-            GfVec3d     t, r, s;
-            if (UsdMayaTranslatorXformable::ConvertUsdMatrixToComponents(xform, &t, &r, &s)) {
-                for (int c = 0; c < 3; ++c) {
-                    translates[c][i] = t[c];
-                    rotates[c][i] = r[c];
-                    scales[c][i] = s[c];
-                }
-            }
-        }
-
-        for (int c = 0; c < 3; ++c) {
-            if (!_SetAnimPlugData(
-                    transformNode, _MayaTokens->translates[c], translates[c], times, context)
-                || !_SetAnimPlugData(
-                    transformNode, _MayaTokens->rotates[c], rotates[c], times, context)
-                || !_SetAnimPlugData(
-                    transformNode, _MayaTokens->scales[c], scales[c], times, context)) {
+    const MString* attrs[_kNumTransformChannels] = {
+        &_MayaTokens->translates[0], &_MayaTokens->translates[1], &_MayaTokens->translates[2],
+        &_MayaTokens->rotates[0],    &_MayaTokens->rotates[1],    &_MayaTokens->rotates[2],
+        &_MayaTokens->scales[0],     &_MayaTokens->scales[1],     &_MayaTokens->scales[2]
+    };
+
+    for (size_t c = 0; c < _kNumTransformChannels; ++c) {
+        const double* values = channels + c * numSamples;
+        const bool    isStatic
+            = std::all_of(values + 1, values + numSamples, [values](double value) {
+                  return value == values[0];
+              });
+
+        if (isStatic) {
+            if (!UsdMayaUtil::setPlugValue(transformNode, *attrs[c], values[0])) {
                 return false;
             }
-        }
-    } else {
-        const auto& xform = xforms.front();
-        GfVec3d     t, r, s;
-        if (UsdMayaTranslatorXformable::ConvertUsdMatrixToComponents(xform, &t, &r, &s)) {
-            for (int c = 0; c < 3; ++c) {
-                if (!UsdMayaUtil::setPlugValue(transformNode, _MayaTokens->translates[c], t[c])
-                    || !UsdMayaUtil::setPlugValue(transformNode, _MayaTokens->rotates[c], r[c])
-                    || !UsdMayaUtil::setPlugValue(transformNode, _MayaTokens->scales[c], s[c])) {
-                    return false;
-                }
+        } else {
+            MDoubleArray keys(values, numSamples);
+            if (!_SetAnimPlugData(transformNode, *attrs[c], keys, times, context)) {
+                return false;
             }
         }
     }
@@ -484,61 +484,77 @@ bool _CopyAnimFromSkel(
 
     MStatus status;
 
-    // Pre-sample the Skeleton's local transforms.
-    std::vector<GfMatrix4d>      skelLocalXforms(usdTimes.size());
+    const UsdSkelTopology& topology = skelQuery.GetTopology();
+    const size_t           numSamples = usdTimes.size();
+    const size_t           numJoints = std::min(jointNodes.size(), topology.GetNumJoints());
+    const size_t           jointStride = _kNumTransformChannels * numSamples;
+
+    // Sample and decompose the local transforms of the Skeleton and of all
+    // the joints in parallel over time. The channels are laid out per joint,
+    // so that each joint is keyed from contiguous arrays.
+    std::vector<double> skelChannels(jointContainerIsSkeleton ? jointStride : 0);
+    std::vector<double> jointChannels(numJoints * jointStride);
+
     UsdGeomXformable::XformQuery xfQuery(skelQuery.GetSkeleton());
-    for (size_t i = 0; i < usdTimes.size(); ++i) {
-        if (!xfQuery.GetLocalTransformation(&skelLocalXforms[i], usdTimes[i])) {
-            skelLocalXforms[i].SetIdentity();
+    std::atomic<bool>            sampled { true };
+    WorkParallelForN(numSamples, [&](size_t begin, size_t end) {
+        VtMatrix4dArray xforms;
+        for (size_t i = begin; i < end; ++i) {
+            GfMatrix4d skelLocalXform;
+            if (!xfQuery.GetLocalTransformation(&skelLocalXform, usdTimes[i])) {
+                skelLocalXform.SetIdentity();
+            }
+
+            if (jointContainerIsSkeleton) {
+                // The jointContainer is being used to represent the Skeleton.
+                // It holds the Skeleton's local transforms.
+                _DecomposeTransform(skelLocalXform, i, numSamples, skelChannels.data());
+            }
+
+            if (!sampled) {
+                continue;
+            }
+            if (!skelQuery.ComputeJointLocalTransforms(&xforms, usdTimes[i])
+                || xforms.size() < numJoints) {
+                sampled = false;
+                continue;
+            }
+
+            for (size_t j = 0; j < numJoints; ++j) {
+                GfMatrix4d xform = xforms[j];
+                if (!jointContainerIsSkeleton && topology.GetParent(j) < 0) {
+                    // We do not have a node to receive the local transforms of
+                    // the Skeleton, so any local transforms on the Skeleton
+                    // must be concatened onto the root joints instead.
+                    xform *= skelLocalXform;
+                }
+                _DecomposeTransform(xform, i, numSamples, jointChannels.data() + j * jointStride);
+            }
         }
-    }
+    });
 
     if (jointContainerIsSkeleton) {
-        // The jointContainer is being used to represent the Skeleton.
-        // Copy the Skeleton's local transforms onto the container.
-
         MFnDependencyNode skelXformDep(jointContainer, &status);
         CHECK_MSTATUS_AND_RETURN(status, false);
 
-        if (!_SetTransformAnim(skelXformDep, skelLocalXforms, mayaTimes, context)) {
+        if (!_SetTransformAnim(skelXformDep, skelChannels.data(), mayaTimes, context)) {
             return false;
         }
     }
 
-    // Pre-sample all joint animation.
-    std::vector<VtMatrix4dArray> samples(usdTimes.size());
-    for (size_t i = 0; i < samples.size(); ++i) {
-        if (!skelQuery.ComputeJointLocalTransforms(&samples[i], usdTimes[i])) {
-            return false;
-        }
-        if (!jointContainerIsSkeleton) {
-            // We do not have a node to receive the local transforms of the
-            // Skeleton, so any local transforms on the Skeleton must be
-            // concatened onto the root joints instead.
-            for (size_t j = 0; j < skelQuery.GetTopology().GetNumJoints(); ++j) {
-                if (skelQuery.GetTopology().GetParent(j) < 0) {
-                    // This is a root joint. Concat by the local skel xform.
-                    samples[i][j] *= skelLocalXforms[i];
-                }
-            }
-        }
+    if (!sampled) {
+        return false;
     }
 
     MFnDependencyNode jointDep;
 
-    std::vector<GfMatrix4d> xforms(samples.size());
-
-    for (size_t jointIdx = 0; jointIdx < jointNodes.size(); ++jointIdx) {
+    for (size_t jointIdx = 0; jointIdx < numJoints; ++jointIdx) {
 
         if (!jointDep.setObject(jointNodes[jointIdx]))
             continue;
 
-        // Get the transforms of just this joint.
-        for (size_t i = 0; i < samples.size(); ++i) {
-            xforms[i] = samples[i][jointIdx];
-        }
-
-        if (!_SetTransformAnim(jointDep, xforms, mayaTimes, context))
+        if (!_SetTransformAnim(
+                jointDep, jointChannels.data() + jointIdx * jointStride, mayaTimes, context))
             return false;
     }
     return true;
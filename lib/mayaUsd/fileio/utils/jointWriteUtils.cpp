@@ -388,12 +388,12 @@ MDagPath UsdMayaJointUtil::getRootJoint(const std::vector<MDagPath>& jointDagPat
 }
 
 MObject UsdMayaJointUtil::writeSkinningData(
-    UsdGeomMesh&               primSchema,
-    const SdfPath&             usdPath,
-    const MDagPath&            dagPath,
-    SdfPath&                   skelPath,
-    const bool                 stripNamespaces,
-    UsdUtilsSparseValueWriter* valueWriter)
+    UsdGeomMesh&              primSchema,
+    const SdfPath&            usdPath,
+    const MDagPath&           dagPath,
+    SdfPath&                  skelPath,
+    const bool                stripNamespaces,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     // Figure out if we even have a skin cluster in the first place.
     MObject skinClusterObj = UsdMayaJointUtil::getSkinCluster(dagPath);
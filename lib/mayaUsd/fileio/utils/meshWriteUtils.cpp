@@ -176,12 +176,12 @@ void compressCreases(
 /// In order to cleanup any extra values and reclaim the wasted memory, call
 /// cleanupPrimvars() at the end of the export process.
 void setPrimvar(
-    const UsdGeomPrimvar&      primvar,
-    const VtIntArray&          indices,
-    const VtValue&             values,
-    const VtValue&             defaultValue,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const UsdGeomPrimvar&     primvar,
+    const VtIntArray&         indices,
+    const VtValue&            values,
+    const VtValue&            defaultValue,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     // Simple case of non-indexed primvars.
     if (indices.empty()) {
@@ -244,13 +244,13 @@ void setPrimvar(
 }
 
 UsdGeomPrimvar createUVPrimVar(
-    UsdGeomGprim&              primSchema,
-    const TfToken&             name,
-    const UsdTimeCode&         usdTime,
-    const VtArray<GfVec2f>&    data,
-    const TfToken&             interpolation,
-    const VtIntArray&          assignmentIndices,
-    UsdUtilsSparseValueWriter* valueWriter)
+    UsdGeomGprim&             primSchema,
+    const TfToken&            name,
+    const UsdTimeCode&        usdTime,
+    const VtArray<GfVec2f>&   data,
+    const TfToken&            interpolation,
+    const VtIntArray&         assignmentIndices,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     const unsigned int numValues = data.size();
     if (numValues == 0) {
@@ -679,9 +679,9 @@ void UsdMayaMeshWriteUtils::exportReferenceMesh(UsdGeomMesh& primSchema, MObject
 }
 
 void UsdMayaMeshWriteUtils::assignSubDivTagsToUSDPrim(
-    MFnMesh&                   meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter)
+    MFnMesh&                  meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     // Vert Creasing
     MUintArray   mayaCreaseVertIds;
@@ -772,10 +772,10 @@ void UsdMayaMeshWriteUtils::assignSubDivTagsToUSDPrim(
 }
 
 void UsdMayaMeshWriteUtils::writePointsData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     MStatus status { MS::kSuccess };
 
@@ -798,25 +798,15 @@ void UsdMayaMeshWriteUtils::writePointsData(
 }
 
 void UsdMayaMeshWriteUtils::writeFaceVertexIndicesData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
-    const int numFaceVertices = meshFn.numFaceVertices();
-    const int numPolygons = meshFn.numPolygons();
-
-    VtIntArray   faceVertexCounts(numPolygons);
-    VtIntArray   faceVertexIndices(numFaceVertices);
-    MIntArray    mayaFaceVertexIndices; // used in loop below
-    unsigned int curFaceVertexIndex = 0;
-    for (int i = 0; i < numPolygons; i++) {
-        meshFn.getPolygonVertices(i, mayaFaceVertexIndices);
-        faceVertexCounts[i] = mayaFaceVertexIndices.length();
-        for (unsigned int j = 0; j < mayaFaceVertexIndices.length(); j++) {
-            faceVertexIndices[curFaceVertexIndex] = mayaFaceVertexIndices[j]; // push_back
-            curFaceVertexIndex++;
-        }
+    VtIntArray faceVertexCounts;
+    VtIntArray faceVertexIndices;
+    if (!getMeshFaceVertexData(meshFn, &faceVertexCounts, &faceVertexIndices)) {
+        return;
     }
     UsdMayaWriteUtil::SetAttribute(
         primSchema.GetFaceVertexCountsAttr(), &faceVertexCounts, usdTime, valueWriter);
@@ -824,10 +814,40 @@ void UsdMayaMeshWriteUtils::writeFaceVertexIndicesData(
         primSchema.GetFaceVertexIndicesAttr(), &faceVertexIndices, usdTime, valueWriter);
 }
 
+void UsdMayaMeshWriteUtils::writeFaceVertexIndicesData(
+    const VtIntArray&         faceVertexCounts,
+    const VtIntArray&         faceVertexIndices,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
+{
+    UsdMayaWriteUtil::SetAttribute(
+        primSchema.GetFaceVertexCountsAttr(), faceVertexCounts, usdTime, valueWriter);
+    UsdMayaWriteUtil::SetAttribute(
+        primSchema.GetFaceVertexIndicesAttr(), faceVertexIndices, usdTime, valueWriter);
+}
+
+bool UsdMayaMeshWriteUtils::getMeshFaceVertexData(
+    const MFnMesh& meshFn,
+    VtIntArray*    faceVertexCounts,
+    VtIntArray*    faceVertexIndices)
+{
+    MIntArray mayaFaceVertexCounts;
+    MIntArray mayaFaceVertexIndices;
+    MStatus   status = meshFn.getVertices(mayaFaceVertexCounts, mayaFaceVertexIndices);
+    CHECK_MSTATUS_AND_RETURN(status, false);
+
+    faceVertexCounts->resize(mayaFaceVertexCounts.length());
+    faceVertexIndices->resize(mayaFaceVertexIndices.length());
+    mayaFaceVertexCounts.get(faceVertexCounts->data());
+    mayaFaceVertexIndices.get(faceVertexIndices->data());
+    return true;
+}
+
 void UsdMayaMeshWriteUtils::writeInvisibleFacesData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     MUintArray     mayaHoles = meshFn.getInvisibleFaces();
     const uint32_t count = mayaHoles.length();
@@ -917,10 +937,10 @@ bool UsdMayaMeshWriteUtils::getMeshUVSetData(
 }
 
 bool UsdMayaMeshWriteUtils::writeUVSetsAsVec2fPrimvars(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     MStatus status { MS::kSuccess };
 
@@ -969,9 +989,9 @@ bool UsdMayaMeshWriteUtils::writeUVSetsAsVec2fPrimvars(
 }
 
 void UsdMayaMeshWriteUtils::writeSubdivInterpBound(
-    MFnMesh&                   meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter)
+    MFnMesh&                  meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     TfToken sdInterpBound = UsdMayaMeshWriteUtils::getSubdivInterpBoundary(meshFn);
     if (!sdInterpBound.IsEmpty()) {
@@ -984,9 +1004,9 @@ void UsdMayaMeshWriteUtils::writeSubdivInterpBound(
 }
 
 void UsdMayaMeshWriteUtils::writeSubdivFVLinearInterpolation(
-    MFnMesh&                   meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter)
+    MFnMesh&                  meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     TfToken sdFVLinearInterpolation = UsdMayaMeshWriteUtils::getSubdivFVLinearInterpolation(meshFn);
     if (!sdFVLinearInterpolation.IsEmpty()) {
@@ -999,10 +1019,10 @@ void UsdMayaMeshWriteUtils::writeSubdivFVLinearInterpolation(
 }
 
 void UsdMayaMeshWriteUtils::writeNormalsData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     VtVec3fArray meshNormals;
     TfToken      normalInterp;
@@ -1026,7 +1046,7 @@ bool UsdMayaMeshWriteUtils::addDisplayPrimvars(
     const VtIntArray&                   assignmentIndices,
     const bool                          clamped,
     const bool                          authored,
-    UsdUtilsSparseValueWriter*          valueWriter)
+    UsdMayaSparseValueWriter*           valueWriter)
 {
     // We are appending the default value to the primvar in the post export function
     // so if the dataset is empty and the assignment indices are not, we still
@@ -1097,14 +1117,14 @@ bool UsdMayaMeshWriteUtils::addDisplayPrimvars(
 }
 
 bool UsdMayaMeshWriteUtils::createRGBPrimVar(
-    UsdGeomGprim&              primSchema,
-    const TfToken&             name,
-    const UsdTimeCode&         usdTime,
-    const VtVec3fArray&        data,
-    const TfToken&             interpolation,
-    const VtIntArray&          assignmentIndices,
-    bool                       clamped,
-    UsdUtilsSparseValueWriter* valueWriter)
+    UsdGeomGprim&             primSchema,
+    const TfToken&            name,
+    const UsdTimeCode&        usdTime,
+    const VtVec3fArray&       data,
+    const TfToken&            interpolation,
+    const VtIntArray&         assignmentIndices,
+    bool                      clamped,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     const unsigned int numValues = data.size();
     if (numValues == 0) {
@@ -1135,15 +1155,15 @@ bool UsdMayaMeshWriteUtils::createRGBPrimVar(
 }
 
 bool UsdMayaMeshWriteUtils::createRGBAPrimVar(
-    UsdGeomGprim&              primSchema,
-    const TfToken&             name,
-    const UsdTimeCode&         usdTime,
-    const VtVec3fArray&        rgbData,
-    const VtFloatArray&        alphaData,
-    const TfToken&             interpolation,
-    const VtIntArray&          assignmentIndices,
-    bool                       clamped,
-    UsdUtilsSparseValueWriter* valueWriter)
+    UsdGeomGprim&             primSchema,
+    const TfToken&            name,
+    const UsdTimeCode&        usdTime,
+    const VtVec3fArray&       rgbData,
+    const VtFloatArray&       alphaData,
+    const TfToken&            interpolation,
+    const VtIntArray&         assignmentIndices,
+    bool                      clamped,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     const unsigned int numValues = rgbData.size();
     if (numValues == 0 || numValues != alphaData.size()) {
@@ -1179,14 +1199,14 @@ bool UsdMayaMeshWriteUtils::createRGBAPrimVar(
 }
 
 bool UsdMayaMeshWriteUtils::createAlphaPrimVar(
-    UsdGeomGprim&              primSchema,
-    const TfToken&             name,
-    const UsdTimeCode&         usdTime,
-    const VtFloatArray&        data,
-    const TfToken&             interpolation,
-    const VtIntArray&          assignmentIndices,
-    bool                       clamped,
-    UsdUtilsSparseValueWriter* valueWriter)
+    UsdGeomGprim&             primSchema,
+    const TfToken&            name,
+    const UsdTimeCode&        usdTime,
+    const VtFloatArray&       data,
+    const TfToken&            interpolation,
+    const VtIntArray&         assignmentIndices,
+    bool                      clamped,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     const unsigned int numValues = data.size();
     if (numValues == 0) {
@@ -1226,7 +1246,9 @@ bool UsdMayaMeshWriteUtils::getMeshColorSetData(
     TfToken*                       interpolation,
     VtIntArray*                    colorSetAssignmentIndices,
     MFnMesh::MColorRepresentation* colorSetRep,
-    bool*                          clamped)
+    bool*                          clamped,
+    const VtIntArray*              faceVertexCounts,
+    const VtIntArray*              faceVertexIndices)
 {
     // If there are no colors, return immediately as failure.
     if (mesh.numColors(colorSet) == 0) {
@@ -1364,7 +1386,17 @@ bool UsdMayaMeshWriteUtils::getMeshColorSetData(
 
     MergeEquivalentColorSetValues(colorSetRGBData, colorSetAlphaData, colorSetAssignmentIndices);
 
-    UsdMayaUtil::CompressFaceVaryingPrimvarIndices(mesh, interpolation, colorSetAssignmentIndices);
+    if (faceVertexCounts && faceVertexIndices) {
+        UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
+            *faceVertexCounts,
+            *faceVertexIndices,
+            static_cast<size_t>(mesh.numVertices()),
+            interpolation,
+            colorSetAssignmentIndices);
+    } else {
+        UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
+            mesh, interpolation, colorSetAssignmentIndices);
+    }
 
     return true;
 }
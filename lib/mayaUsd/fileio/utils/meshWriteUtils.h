@@ -19,6 +19,7 @@
 #define PXRUSDMAYA_MESH_WRITE_UTILS_H
 
 #include <mayaUsd/base/api.h>
+#include <mayaUsd/fileio/utils/sparseValueWriter.h>
 
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/tf/staticTokens.h>
@@ -27,7 +28,6 @@
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usdGeom/mesh.h>
-#include <pxr/usd/usdUtils/sparseValueWriter.h>
 
 #include <maya/MBoundingBox.h>
 #include <maya/MDagPath.h>
@@ -107,34 +107,53 @@ void exportReferenceMesh(UsdGeomMesh& primSchema, MObject obj);
 
 MAYAUSD_CORE_PUBLIC
 void assignSubDivTagsToUSDPrim(
-    MFnMesh&                   meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter);
+    MFnMesh&                  meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter);
 
 void assignSubDivTagsToUSDPrim(
-    MFnMesh&                   meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter);
+    MFnMesh&                  meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 void writePointsData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter);
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 void writeFaceVertexIndicesData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter);
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter);
+
+/// Same as above, writing the face vertex data returned by
+/// getMeshFaceVertexData(), so that it can be gathered once and shared with
+/// the primvars of the mesh.
+MAYAUSD_CORE_PUBLIC
+void writeFaceVertexIndicesData(
+    const VtIntArray&         faceVertexCounts,
+    const VtIntArray&         faceVertexIndices,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter);
+
+/// Gets the vertex count of each face of the Maya mesh, and the vertex of each
+/// of its face vertices, in the face vertex order.
+MAYAUSD_CORE_PUBLIC
+bool getMeshFaceVertexData(
+    const MFnMesh& meshFn,
+    VtIntArray*    faceVertexCounts,
+    VtIntArray*    faceVertexIndices);
 
 MAYAUSD_CORE_PUBLIC
 void writeInvisibleFacesData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter);
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 bool getMeshUVSetData(
@@ -146,29 +165,29 @@ bool getMeshUVSetData(
 
 MAYAUSD_CORE_PUBLIC
 bool writeUVSetsAsVec2fPrimvars(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter);
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 void writeSubdivInterpBound(
-    MFnMesh&                   mesh,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter);
+    MFnMesh&                  mesh,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 void writeSubdivFVLinearInterpolation(
-    MFnMesh&                   meshFn,
-    UsdGeomMesh&               primSchema,
-    UsdUtilsSparseValueWriter* valueWriter);
+    MFnMesh&                  meshFn,
+    UsdGeomMesh&              primSchema,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 void writeNormalsData(
-    const MFnMesh&             meshFn,
-    UsdGeomMesh&               primSchema,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter);
+    const MFnMesh&            meshFn,
+    UsdGeomMesh&              primSchema,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 bool addDisplayPrimvars(
@@ -181,41 +200,41 @@ bool addDisplayPrimvars(
     const VtIntArray&                   assignmentIndices,
     const bool                          clamped,
     const bool                          authored,
-    UsdUtilsSparseValueWriter*          valueWriter);
+    UsdMayaSparseValueWriter*           valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 bool createRGBPrimVar(
-    UsdGeomGprim&              primSchema,
-    const TfToken&             name,
-    const UsdTimeCode&         usdTime,
-    const VtVec3fArray&        data,
-    const TfToken&             interpolation,
-    const VtIntArray&          assignmentIndices,
-    bool                       clamped,
-    UsdUtilsSparseValueWriter* valueWriter);
+    UsdGeomGprim&             primSchema,
+    const TfToken&            name,
+    const UsdTimeCode&        usdTime,
+    const VtVec3fArray&       data,
+    const TfToken&            interpolation,
+    const VtIntArray&         assignmentIndices,
+    bool                      clamped,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 bool createRGBAPrimVar(
-    UsdGeomGprim&              primSchema,
-    const TfToken&             name,
-    const UsdTimeCode&         usdTime,
-    const VtVec3fArray&        rgbData,
-    const VtFloatArray&        alphaData,
-    const TfToken&             interpolation,
-    const VtIntArray&          assignmentIndices,
-    bool                       clamped,
-    UsdUtilsSparseValueWriter* valueWriter);
+    UsdGeomGprim&             primSchema,
+    const TfToken&            name,
+    const UsdTimeCode&        usdTime,
+    const VtVec3fArray&       rgbData,
+    const VtFloatArray&       alphaData,
+    const TfToken&            interpolation,
+    const VtIntArray&         assignmentIndices,
+    bool                      clamped,
+    UsdMayaSparseValueWriter* valueWriter);
 
 MAYAUSD_CORE_PUBLIC
 bool createAlphaPrimVar(
-    UsdGeomGprim&              primSchema,
-    const TfToken&             name,
-    const UsdTimeCode&         usdTime,
-    const VtFloatArray&        data,
-    const TfToken&             interpolation,
-    const VtIntArray&          assignmentIndices,
-    bool                       clamped,
-    UsdUtilsSparseValueWriter* valueWriter);
+    UsdGeomGprim&             primSchema,
+    const TfToken&            name,
+    const UsdTimeCode&        usdTime,
+    const VtFloatArray&       data,
+    const TfToken&            interpolation,
+    const VtIntArray&         assignmentIndices,
+    bool                      clamped,
+    UsdMayaSparseValueWriter* valueWriter);
 
 /// Collect values from the color set named \p colorSet.
 /// If \p isDisplayColor is true and this color set represents displayColor,
@@ -224,6 +243,9 @@ bool createAlphaPrimVar(
 /// Values are gathered per face vertex, but then the data is compressed to
 /// vertex, uniform, or constant interpolation if possible.
 /// Unauthored/unpainted values will be given the index -1.
+/// The compression uses \p faceVertexCounts and \p faceVertexIndices, as
+/// returned by getMeshFaceVertexData(), when given, so that they are gathered
+/// once for all the color sets of the mesh.
 MAYAUSD_CORE_PUBLIC
 bool getMeshColorSetData(
     MFnMesh&                       mesh,
@@ -237,7 +259,9 @@ bool getMeshColorSetData(
     TfToken*                       interpolation,
     VtIntArray*                    colorSetAssignmentIndices,
     MFnMesh::MColorRepresentation* colorSetRep,
-    bool*                          clamped);
+    bool*                          clamped,
+    const VtIntArray*              faceVertexCounts = nullptr,
+    const VtIntArray*              faceVertexIndices = nullptr);
 
 } // namespace UsdMayaMeshWriteUtils
 
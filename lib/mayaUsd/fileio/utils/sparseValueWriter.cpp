@@ -0,0 +1,202 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "sparseValueWriter.h"
+
+#include <mayaUsdUtils/DiffCore.h>
+
+#include <pxr/base/gf/half.h>
+#include <pxr/base/gf/matrix2d.h>
+#include <pxr/base/gf/matrix3d.h>
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/quatd.h>
+#include <pxr/base/gf/quatf.h>
+#include <pxr/base/gf/quath.h>
+#include <pxr/base/gf/vec2d.h>
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec2h.h>
+#include <pxr/base/gf/vec2i.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec3h.h>
+#include <pxr/base/gf/vec3i.h>
+#include <pxr/base/gf/vec4d.h>
+#include <pxr/base/gf/vec4f.h>
+#include <pxr/base/gf/vec4h.h>
+#include <pxr/base/gf/vec4i.h>
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/vt/array.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_EXPORT_HASH_SAMPLES,
+    false,
+    "When exporting animation, detect the time samples identical to the previous one from a hash "
+    "of their content, instead of keeping a copy of the previous sample of every attribute.");
+
+namespace {
+
+template <typename T>
+bool _GetArrayBytes(const VtValue& value, const void** data, size_t* bytes)
+{
+    if (!value.IsHolding<VtArray<T>>()) {
+        return false;
+    }
+    const VtArray<T>& array = value.UncheckedGet<VtArray<T>>();
+    *data = array.cdata();
+    *bytes = array.size() * sizeof(T);
+    return true;
+}
+
+// Hashes the arrays of plain values, whose bytes fully define the content. The type is mixed in,
+// so that e.g. float and int arrays with the same bytes don't match.
+bool _HashArray(const VtValue& value, uint64_t hash[2])
+{
+    if (!value.IsArrayValued()) {
+        return false;
+    }
+
+    const void* data = nullptr;
+    size_t      bytes = 0;
+    const bool  isPlainArray = _GetArrayBytes<float>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec3f>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec2f>(value, &data, &bytes)
+        || _GetArrayBytes<int>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec4f>(value, &data, &bytes)
+        || _GetArrayBytes<double>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec2d>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec3d>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec4d>(value, &data, &bytes)
+        || _GetArrayBytes<GfHalf>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec2h>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec3h>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec4h>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec2i>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec3i>(value, &data, &bytes)
+        || _GetArrayBytes<GfVec4i>(value, &data, &bytes)
+        || _GetArrayBytes<GfQuath>(value, &data, &bytes)
+        || _GetArrayBytes<GfQuatf>(value, &data, &bytes)
+        || _GetArrayBytes<GfQuatd>(value, &data, &bytes)
+        || _GetArrayBytes<GfMatrix2d>(value, &data, &bytes)
+        || _GetArrayBytes<GfMatrix3d>(value, &data, &bytes)
+        || _GetArrayBytes<GfMatrix4d>(value, &data, &bytes)
+        || _GetArrayBytes<unsigned int>(value, &data, &bytes)
+        || _GetArrayBytes<int64_t>(value, &data, &bytes)
+        || _GetArrayBytes<uint64_t>(value, &data, &bytes)
+        || _GetArrayBytes<unsigned char>(value, &data, &bytes)
+        || _GetArrayBytes<bool>(value, &data, &bytes);
+    if (!isPlainArray) {
+        return false;
+    }
+
+    MayaUsdUtils::hash128(data, bytes, value.GetTypeid().hash_code(), hash);
+    return true;
+}
+
+} // namespace
+
+UsdMayaSparseValueWriter::UsdMayaSparseValueWriter()
+    : UsdMayaSparseValueWriter(TfGetEnvSetting(MAYAUSD_EXPORT_HASH_SAMPLES))
+{
+}
+
+UsdMayaSparseValueWriter::UsdMayaSparseValueWriter(bool hashSamples)
+    : _hashSamples(hashSamples)
+{
+}
+
+bool UsdMayaSparseValueWriter::SetAttribute(
+    const UsdAttribute& attr,
+    VtValue*            value,
+    const UsdTimeCode   time)
+{
+    return _hashSamples ? _SetHashedSample(attr, value, time)
+                        : UsdUtilsSparseValueWriter::SetAttribute(attr, value, time);
+}
+
+bool UsdMayaSparseValueWriter::_SetHashedSample(
+    const UsdAttribute& attr,
+    VtValue*            value,
+    const UsdTimeCode   time)
+{
+    if (!attr) {
+        TF_CODING_ERROR("Invalid attribute <%s>.", attr.GetPath().GetText());
+        return false;
+    }
+
+    uint64_t   hash[2] = { 0, 0 };
+    const bool hashed = _HashArray(*value, hash);
+
+    auto it = _samples.find(attr.GetPath());
+    if (it == _samples.end()) {
+        // As UsdUtilsSparseValueWriter, start from the existing default value, or the fallback
+        // value, so that a default value or leading time samples matching it aren't authored.
+        VtValue existingDefault;
+        attr.Get(&existingDefault, UsdTimeCode::Default());
+
+        it = _samples.emplace(attr.GetPath(), _Sample()).first;
+        _Sample& sample = it->second;
+        sample.hashed = _HashArray(existingDefault, sample.hash);
+        if (!sample.hashed) {
+            sample.value.Swap(existingDefault);
+        }
+        sample.prevTime = UsdTimeCode::Default();
+        sample.lastWrittenTime = UsdTimeCode::Default();
+        sample.didWritePrevValue = true;
+    }
+
+    _Sample& sample = it->second;
+    if (time < sample.prevTime) {
+        TF_CODING_ERROR(
+            "Time samples must be set in increasing order on <%s>.", attr.GetPath().GetText());
+        return false;
+    }
+
+    const bool sameValue = hashed
+        ? sample.hashed && sample.hash[0] == hash[0] && sample.hash[1] == hash[1]
+        : !sample.hashed && sample.value == *value;
+    if (sameValue) {
+        // A default value matching the existing one needs no authoring later on.
+        sample.prevTime = time;
+        sample.didWritePrevValue = time.IsDefault();
+        return true;
+    }
+
+    // End the run of identical samples with the held value, which is the last one authored.
+    bool success = true;
+    if (!sample.didWritePrevValue) {
+        VtValue heldValue;
+        success = attr.Get(&heldValue, sample.lastWrittenTime)
+            && attr.Set(heldValue, sample.prevTime);
+    }
+    success = attr.Set(*value, time) && success;
+
+    sample.hash[0] = hash[0];
+    sample.hash[1] = hash[1];
+    sample.hashed = hashed;
+    if (hashed) {
+        sample.value = VtValue();
+    } else {
+        sample.value.Swap(*value);
+    }
+    sample.prevTime = time;
+    sample.lastWrittenTime = time;
+    sample.didWritePrevValue = true;
+    return success;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
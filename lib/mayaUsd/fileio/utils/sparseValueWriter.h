@@ -0,0 +1,112 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_SPARSE_VALUE_WRITER_H
+#define PXRUSDMAYA_SPARSE_VALUE_WRITER_H
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/timeCode.h>
+#include <pxr/usd/usdUtils/sparseValueWriter.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// A UsdUtilsSparseValueWriter that can detect redundant time samples from a 128 bit hash of
+/// their content, instead of comparing them to a copy of the previous sample.
+///
+/// Hashing is opt-in, through the MAYAUSD_EXPORT_HASH_SAMPLES environment setting or the
+/// constructor argument. When it is disabled, this behaves exactly like the base class.
+///
+/// When it is enabled, the arrays of plain values (points, normals, primvars...) are only kept
+/// as a hash, and two samples are considered identical when their bytes are. This is stricter
+/// than the comparison of UsdUtilsSparseValueWriter, which tolerates tiny differences between
+/// floating point values. Other values are small or shared with the layer, and are still
+/// compared by value. When a run of identical samples ends, the held sample is read back from
+/// the attribute to be authored at the end of the run, as UsdUtilsSparseValueWriter does from
+/// its own copy. As in UsdUtilsSparseValueWriter, the first value set on an attribute is
+/// compared to its existing default value, or its fallback value.
+///
+/// The samples are only hashed when set through the methods of this class, or through the
+/// UsdMayaWriteUtil::SetAttribute() overloads taking a UsdMayaSparseValueWriter. The methods of
+/// the base class, which are not virtual, always compare the samples by value.
+class UsdMayaSparseValueWriter : public UsdUtilsSparseValueWriter
+{
+public:
+    MAYAUSD_CORE_PUBLIC
+    UsdMayaSparseValueWriter();
+
+    MAYAUSD_CORE_PUBLIC
+    explicit UsdMayaSparseValueWriter(bool hashSamples);
+
+    bool IsHashingSamples() const { return _hashSamples; }
+
+    /// Sets the value of \p attr to \p value at \p time, unless it is the same as the previous
+    /// sample. The value held by \p value may be swapped out.
+    MAYAUSD_CORE_PUBLIC
+    bool SetAttribute(
+        const UsdAttribute& attr,
+        VtValue*            value,
+        const UsdTimeCode   time = UsdTimeCode::Default());
+
+    /// \overload
+    bool SetAttribute(
+        const UsdAttribute& attr,
+        const VtValue&      value,
+        const UsdTimeCode   time = UsdTimeCode::Default())
+    {
+        VtValue copy(value);
+        return SetAttribute(attr, &copy, time);
+    }
+
+    /// \overload
+    template <typename T>
+    bool SetAttribute(
+        const UsdAttribute& attr,
+        const T&            value,
+        const UsdTimeCode   time = UsdTimeCode::Default())
+    {
+        VtValue vtValue(value);
+        return SetAttribute(attr, &vtValue, time);
+    }
+
+private:
+    struct _Sample
+    {
+        // The hash of the previous sample, or the sample itself if it couldn't be hashed.
+        uint64_t    hash[2] = { 0, 0 };
+        bool        hashed = false;
+        VtValue     value;
+        UsdTimeCode prevTime;
+        UsdTimeCode lastWrittenTime;
+        bool        didWritePrevValue;
+    };
+
+    bool _SetHashedSample(const UsdAttribute& attr, VtValue* value, const UsdTimeCode time);
+
+    std::unordered_map<SdfPath, _Sample, SdfPath::Hash> _samples;
+
+    bool _hashSamples;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -616,10 +616,10 @@ VtValue UsdMayaWriteUtil::GetVtValue(
 }
 
 bool UsdMayaWriteUtil::SetUsdAttr(
-    const MPlug&               attrPlug,
-    const UsdAttribute&        usdAttr,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MPlug&              attrPlug,
+    const UsdAttribute&       usdAttr,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     if (!usdAttr || attrPlug.isNull()) {
         return false;
@@ -675,10 +675,10 @@ bool UsdMayaWriteUtil::SetUsdAttr(
 // visited and warning about subsequent attribute tags.
 //
 bool UsdMayaWriteUtil::WriteUserExportedAttributes(
-    const MObject&             mayaNode,
-    const UsdPrim&             usdPrim,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MObject&            mayaNode,
+    const UsdPrim&            usdPrim,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     std::vector<UsdMayaUserTaggedAttribute> exportedAttributes
         = UsdMayaUserTaggedAttribute::GetUserTaggedAttributesForNode(mayaNode);
@@ -752,9 +752,9 @@ bool UsdMayaWriteUtil::WriteMetadataToPrim(const MObject& mayaObject, const UsdP
 
 /* static */
 bool UsdMayaWriteUtil::WriteAPISchemaAttributesToPrim(
-    const MObject&             mayaObject,
-    const UsdPrim&             prim,
-    UsdUtilsSparseValueWriter* valueWriter)
+    const MObject&            mayaObject,
+    const UsdPrim&            prim,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     UsdMayaAdaptor adaptor(mayaObject);
     if (!adaptor) {
@@ -792,7 +792,7 @@ size_t UsdMayaWriteUtil::WriteSchemaAttributesToPrim(
     const TfType&               schemaType,
     const std::vector<TfToken>& attributeNames,
     const UsdTimeCode&          usdTime,
-    UsdUtilsSparseValueWriter*  valueWriter)
+    UsdMayaSparseValueWriter*   valueWriter)
 {
     UsdMayaAdaptor::SchemaAdaptor schema;
     if (UsdMayaAdaptor adaptor = UsdMayaAdaptor(object)) {
@@ -869,7 +869,7 @@ bool UsdMayaWriteUtil::WriteArrayAttrsToInstancer(
     const UsdGeomPointInstancer& instancer,
     const size_t                 numPrototypes,
     const UsdTimeCode&           usdTime,
-    UsdUtilsSparseValueWriter*   valueWriter)
+    UsdMayaSparseValueWriter*    valueWriter)
 {
     MStatus status;
 
@@ -17,6 +17,7 @@
 #define PXRUSDMAYA_WRITEUTIL_H
 
 #include <mayaUsd/base/api.h>
+#include <mayaUsd/fileio/utils/sparseValueWriter.h>
 #include <mayaUsd/fileio/utils/userTaggedAttribute.h>
 
 #include <pxr/base/tf/token.h>
@@ -138,20 +139,20 @@ struct UsdMayaWriteUtil
     /// name of the USD attribute.
     MAYAUSD_CORE_PUBLIC
     static bool SetUsdAttr(
-        const MPlug&               attrPlug,
-        const UsdAttribute&        usdAttr,
-        const UsdTimeCode&         usdTime,
-        UsdUtilsSparseValueWriter* valueWriter = nullptr);
+        const MPlug&              attrPlug,
+        const UsdAttribute&       usdAttr,
+        const UsdTimeCode&        usdTime,
+        UsdMayaSparseValueWriter* valueWriter = nullptr);
 
     /// Given a Maya node \p mayaNode, inspect it for attributes tagged by
     /// the user for export to USD and write them onto \p usdPrim at time
     /// \p usdTime.
     MAYAUSD_CORE_PUBLIC
     static bool WriteUserExportedAttributes(
-        const MObject&             mayaNode,
-        const UsdPrim&             usdPrim,
-        const UsdTimeCode&         usdTime,
-        UsdUtilsSparseValueWriter* valueWriter = nullptr);
+        const MObject&            mayaNode,
+        const UsdPrim&            usdPrim,
+        const UsdTimeCode&        usdTime,
+        UsdMayaSparseValueWriter* valueWriter = nullptr);
 
     /// Writes all of the adaptor metadata from \p mayaObject onto the \p prim.
     /// Returns true if successful (even if there was nothing to export).
@@ -165,9 +166,9 @@ struct UsdMayaWriteUtil
     /// \sa UsdMayaAdaptor::GetAppliedSchemas
     MAYAUSD_CORE_PUBLIC
     static bool WriteAPISchemaAttributesToPrim(
-        const MObject&             mayaObject,
-        const UsdPrim&             prim,
-        UsdUtilsSparseValueWriter* valueWriter = nullptr);
+        const MObject&            mayaObject,
+        const UsdPrim&            prim,
+        UsdMayaSparseValueWriter* valueWriter = nullptr);
 
     template <typename T>
     static size_t WriteSchemaAttributesToPrim(
@@ -175,7 +176,7 @@ struct UsdMayaWriteUtil
         const UsdPrim&              prim,
         const std::vector<TfToken>& attributeNames,
         const UsdTimeCode&          usdTime = UsdTimeCode::Default(),
-        UsdUtilsSparseValueWriter*  valueWriter = nullptr)
+        UsdMayaSparseValueWriter*   valueWriter = nullptr)
     {
         return WriteSchemaAttributesToPrim(
             object, prim, TfType::Find<T>(), attributeNames, usdTime, valueWriter);
@@ -193,7 +194,7 @@ struct UsdMayaWriteUtil
         const TfType&               schemaType,
         const std::vector<TfToken>& attributeNames,
         const UsdTimeCode&          usdTime = UsdTimeCode::Default(),
-        UsdUtilsSparseValueWriter*  valueWriter = nullptr);
+        UsdMayaSparseValueWriter*   valueWriter = nullptr);
 
     /// Authors class inherits on \p usdPrim.  \p inheritClassNames are
     /// specified as names (not paths).  For example, they should be
@@ -212,7 +213,7 @@ struct UsdMayaWriteUtil
         const UsdGeomPointInstancer& instancer,
         const size_t                 numPrototypes,
         const UsdTimeCode&           usdTime,
-        UsdUtilsSparseValueWriter*   valueWriter = nullptr);
+        UsdMayaSparseValueWriter*    valueWriter = nullptr);
 
     /// \}
 
@@ -309,6 +310,52 @@ struct UsdMayaWriteUtil
         return valueWriter ? valueWriter->SetAttribute(attr, VtValue::Take(*value), time)
                            : attr.Set(*value, time);
     }
+
+    /// \overload
+    /// The redundant time-samples are detected from a hash of their content
+    /// if \p valueWriter hashes its samples.
+    template <typename T>
+    static bool SetAttribute(
+        const UsdAttribute&       attr,
+        const T&                  value,
+        const UsdTimeCode         time,
+        UsdMayaSparseValueWriter* valueWriter)
+    {
+        if (!valueWriter) {
+            return attr.Set(value, time);
+        }
+        VtValue vtValue(value);
+        return valueWriter->SetAttribute(attr, &vtValue, time);
+    }
+
+    /// \overload
+    /// This overload swaps out the value held in \p value, leaving it in
+    /// default-constructed state (value-initialized).
+    template <typename T>
+    static bool SetAttribute(
+        const UsdAttribute&       attr,
+        T*                        value,
+        const UsdTimeCode         time,
+        UsdMayaSparseValueWriter* valueWriter)
+    {
+        if (!valueWriter) {
+            return attr.Set(*value, time);
+        }
+        VtValue vtValue = VtValue::Take(*value);
+        return valueWriter->SetAttribute(attr, &vtValue, time);
+    }
+
+    /// \overload
+    /// The value held by \p value may be swapped out.
+    static bool SetAttribute(
+        const UsdAttribute&       attr,
+        VtValue*                  value,
+        const UsdTimeCode         time,
+        UsdMayaSparseValueWriter* valueWriter)
+    {
+        return valueWriter ? valueWriter->SetAttribute(attr, value, time)
+                           : attr.Set(*value, time);
+    }
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -15,6 +15,7 @@
 //
 #include "layerManager.h"
 
+#include <mayaUsd/base/debugCodes.h>
 #include <mayaUsd/listeners/notice.h>
 #include <mayaUsd/listeners/proxyShapeNotice.h>
 #include <mayaUsd/nodes/proxyShapeBase.h>
@@ -23,8 +24,12 @@
 #include <mayaUsd/utils/utilFileSystem.h>
 #include <mayaUsd/utils/utilSerialization.h>
 
+#include <pxr/base/arch/fileSystem.h>
+#include <pxr/base/tf/fileUtils.h>
 #include <pxr/base/tf/instantiateType.h>
+#include <pxr/base/tf/stopwatch.h>
 #include <pxr/base/tf/weakBase.h>
+#include <pxr/usd/sdf/notice.h>
 #include <pxr/usd/sdf/textFileFormat.h>
 #include <pxr/usd/usd/editTarget.h>
 #include <pxr/usd/usd/usdFileFormat.h>
@@ -53,8 +58,11 @@
 #include <ufe/selectionNotification.h>
 
 #include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <set>
+#include <sstream>
+#include <unordered_map>
 
 namespace {
 static std::recursive_mutex findNodeMutex;
@@ -134,6 +142,49 @@ getFileFormatForLayer(const std::string& identifierVal, const std::string& seria
     return fileFormat;
 }
 
+// SdfLayer::ExportToString always produces usda text, so crate data has to go
+// through a temporary file.
+bool exportLayerToCrateString(const SdfLayerHandle& layer, std::string* bytes)
+{
+    const std::string tmpFileName = ArchMakeTmpFileName("mayaUsdLayer", ".usdc");
+
+    bool succeeded = layer->Export(tmpFileName);
+    if (succeeded) {
+        std::ifstream      stream(tmpFileName, std::ios::in | std::ios::binary);
+        std::ostringstream contents;
+        contents << stream.rdbuf();
+        succeeded = !stream.bad();
+        *bytes = contents.str();
+    }
+
+    TfDeleteFile(tmpFileName);
+    return succeeded;
+}
+
+bool importLayerFromCrateString(const SdfLayerHandle& layer, const std::string& bytes)
+{
+    const std::string tmpFileName = ArchMakeTmpFileName("mayaUsdLayer", ".usdc");
+
+    bool succeeded = false;
+    {
+        std::ofstream stream(tmpFileName, std::ios::out | std::ios::binary);
+        stream.write(bytes.data(), bytes.size());
+        succeeded = stream.good();
+    }
+
+    if (succeeded) {
+        // The crate layer may keep the file mapped, release it before deleting the file.
+        SdfLayerRefPtr crateLayer = SdfLayer::OpenAsAnonymous(tmpFileName);
+        succeeded = bool(crateLayer);
+        if (succeeded) {
+            layer->TransferContent(crateLayer);
+        }
+    }
+
+    TfDeleteFile(tmpFileName);
+    return succeeded;
+}
+
 MayaUsd::LayerManager* findNode()
 {
     MFnDependencyNode  fn;
@@ -230,12 +281,16 @@ public:
 
     SdfLayerHandle findLayer(std::string identifier) const;
 
+    bool serializeLayer(SdfLayerHandle layer, bool asBinary, std::string* serialized);
+    void readPreviousSerializations();
+
 private:
     void registerCallbacks();
     void unregisterCallbacks();
 
     void _addLayer(SdfLayerRefPtr layer, const std::string& identifier);
     void onStageSet(const MayaUsdProxyStageSetNotice& notice);
+    void onLayersDidChange(const SdfNotice::LayersDidChange& notice);
 
     bool            saveUsd(bool isExport);
     BatchSaveResult saveUsdToMayaFile();
@@ -243,8 +298,32 @@ private:
     void            convertAnonymousLayers(MayaUsdProxyShapeBase* pShape, UsdStageRefPtr stage);
     void            saveUsdLayerToMayaFile(SdfLayerRefPtr layer, bool asAnonymous);
 
+    void pruneSerializedLayers();
+
+    //! Hash of the last serialization of a layer, dropped as soon as the layer changes.
+    struct SerializedLayer
+    {
+        SdfLayerHandle _layer; //!< Keeps the key valid, and expires with the layer
+        bool           _binary { false };
+        size_t         _hash { 0 };
+    };
+
+    //! Serialization of a layer stored in the manager node.
+    struct StoredSerialization
+    {
+        bool        _binary { false };
+        std::string _data;
+    };
+
+    //! Indexed by the unique identifier of the layer handles.
+    std::unordered_map<const void*, SerializedLayer> _serializedLayers;
+
+    //! Serializations from the previous save, indexed by layer identifier, only during a save.
+    std::map<std::string, StoredSerialization> _previousSerializations;
+
     std::map<std::string, SdfLayerRefPtr> _idToLayer;
     TfNotice::Key                         _onStageSetKey;
+    TfNotice::Key                         _onLayersDidChangeKey;
     std::set<unsigned int>                _supportedTypes;
     MDagPathArray                         _proxiesToSave;
     MDagPathArray                         _internalProxiesToSave;
@@ -275,6 +354,7 @@ LayerDatabase::LayerDatabase()
 {
     TfWeakPtr<LayerDatabase> me(this);
     _onStageSetKey = TfNotice::Register(me, &LayerDatabase::onStageSet);
+    _onLayersDidChangeKey = TfNotice::Register(me, &LayerDatabase::onLayersDidChange);
 }
 
 LayerDatabase::~LayerDatabase()
@@ -282,6 +362,9 @@ LayerDatabase::~LayerDatabase()
     if (_onStageSetKey.IsValid()) {
         TfNotice::Revoke(_onStageSetKey);
     }
+    if (_onLayersDidChangeKey.IsValid()) {
+        TfNotice::Revoke(_onLayersDidChangeKey);
+    }
 
     unregisterCallbacks();
 }
@@ -337,6 +420,111 @@ void LayerDatabase::onStageSet(const MayaUsdProxyStageSetNotice& notice)
     }
 }
 
+void LayerDatabase::onLayersDidChange(const SdfNotice::LayersDidChange& notice)
+{
+    if (_serializedLayers.empty()) {
+        return;
+    }
+
+    for (const auto& layerAndChangeList : notice.GetChangeListVec()) {
+        _serializedLayers.erase(layerAndChangeList.first.GetUniqueIdentifier());
+    }
+    pruneSerializedLayers();
+}
+
+void LayerDatabase::pruneSerializedLayers()
+{
+    for (auto it = _serializedLayers.begin(); it != _serializedLayers.end();) {
+        if (!it->second._layer) {
+            it = _serializedLayers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void LayerDatabase::readPreviousSerializations()
+{
+    _previousSerializations.clear();
+    pruneSerializedLayers();
+
+    // Only the layers serialized in this session can reuse their previous serialization.
+    MayaUsd::LayerManager* lm = _serializedLayers.empty() ? nullptr : findNode();
+    if (!lm) {
+        return;
+    }
+
+    MStatus            status;
+    MPlug              allLayersPlug(lm->thisMObject(), lm->layers);
+    const unsigned int numElements = allLayersPlug.numElements();
+    for (unsigned int i = 0; i < numElements; ++i) {
+        MPlug singleLayerPlug = allLayersPlug.elementByPhysicalIndex(i, &status);
+        MPlug idPlug = singleLayerPlug.child(lm->identifier, &status);
+        MPlug serializedPlug = singleLayerPlug.child(lm->serialized, &status);
+        MPlug binaryPlug = singleLayerPlug.child(lm->binary, &status);
+
+        StoredSerialization stored;
+        stored._data = serializedPlug.asString(MDGContext::fsNormal, &status).asChar();
+        if (stored._data.empty()) {
+            continue;
+        }
+        stored._binary = binaryPlug.asBool(MDGContext::fsNormal, &status);
+
+        const std::string identifier = idPlug.asString(MDGContext::fsNormal, &status).asChar();
+        _previousSerializations[identifier] = std::move(stored);
+    }
+}
+
+bool LayerDatabase::serializeLayer(SdfLayerHandle layer, bool asBinary, std::string* serialized)
+{
+    // The previous save stored the serialization of the layer in the manager node. If the layer
+    // didn't change since it was serialized, and what is stored is what was serialized, reuse it.
+    auto found = _serializedLayers.find(layer.GetUniqueIdentifier());
+    auto previous = _previousSerializations.find(layer->GetIdentifier());
+    if (found != _serializedLayers.end() && previous != _previousSerializations.end()
+        && found->second._binary == asBinary && previous->second._binary == asBinary
+        && found->second._hash == std::hash<std::string>()(previous->second._data)) {
+        TF_DEBUG(USDMAYA_LAYERMANAGER)
+            .Msg(
+                "Reusing serialization of unchanged layer '%s'\n",
+                layer->GetIdentifier().c_str());
+        *serialized = previous->second._data;
+        return true;
+    }
+
+    TfStopwatch stopwatch;
+    stopwatch.Start();
+
+    bool succeeded = false;
+    if (asBinary) {
+        std::string bytes;
+        succeeded = exportLayerToCrateString(layer, &bytes);
+        if (succeeded) {
+            *serialized = MayaUsd::utils::encodeBase64(bytes);
+        }
+    } else {
+        succeeded = layer->ExportToString(serialized);
+    }
+
+    stopwatch.Stop();
+    TF_DEBUG(USDMAYA_LAYERMANAGER)
+        .Msg(
+            "Serialized layer '%s' as %s: %zu bytes in %.3f seconds\n",
+            layer->GetIdentifier().c_str(),
+            asBinary ? "usdc" : "usda",
+            serialized->size(),
+            stopwatch.GetSeconds());
+
+    if (succeeded) {
+        SerializedLayer& entry = _serializedLayers[layer.GetUniqueIdentifier()];
+        entry._layer = layer;
+        entry._binary = asBinary;
+        entry._hash = std::hash<std::string>()(*serialized);
+    }
+
+    return succeeded;
+}
+
 void LayerDatabase::setBatchSaveDelegate(BatchSaveDelegate delegate)
 {
     _batchSaveDelegate = delegate;
@@ -354,6 +542,8 @@ void LayerDatabase::prepareForExportCheck(bool* retCode, void*)
 
 void LayerDatabase::prepareForWriteCheck(bool* retCode, bool isExport)
 {
+    // Read the serializations of the previous save before the manager node is emptied.
+    LayerDatabase::instance().readPreviousSerializations();
     cleanUpNewScene(nullptr);
 
     if (LayerDatabase::instance().getProxiesToSave(isExport)) {
@@ -373,6 +563,8 @@ void LayerDatabase::prepareForWriteCheck(bool* retCode, bool isExport)
     } else {
         *retCode = true;
     }
+
+    LayerDatabase::instance()._previousSerializations.clear();
 }
 
 bool LayerDatabase::getProxiesToSave(bool isExport)
@@ -501,18 +693,21 @@ MStatus addLayerToBuilder(
     MDataHandle idHandle = layersElemHandle.child(lm->identifier);
     MDataHandle serializedHandle = layersElemHandle.child(lm->serialized);
     MDataHandle anonHandle = layersElemHandle.child(lm->anonymous);
+    MDataHandle binaryHandle = layersElemHandle.child(lm->binary);
 
     idHandle.setString(UsdMayaUtil::convert(layer->GetIdentifier()));
     anonHandle.setBool(isAnon);
 
+    const bool  asBinary = MayaUsd::utils::serializeUsdEditsAsBinaryOption();
     std::string temp;
     if (!stubOnly && ((exportOnlyIfDirty && layer->IsDirty()) || !exportOnlyIfDirty)) {
-        if (!layer->ExportToString(&temp)) {
+        if (!LayerDatabase::instance().serializeLayer(layer, asBinary, &temp)) {
             status = MS::kFailure;
         }
     }
 
     serializedHandle.setString(UsdMayaUtil::convert(temp));
+    binaryHandle.setBool(asBinary && !temp.empty());
 
     return status;
 }
@@ -604,6 +799,9 @@ BatchSaveResult LayerDatabase::saveUsdToMayaFile()
         return MayaUsd::kNotHandled;
     }
 
+    TfStopwatch stopwatch;
+    stopwatch.Start();
+
     MStatus           status;
     MDataBlock        dataBlock = lm->_forceCache();
     MArrayDataHandle  layersHandle = dataBlock.outputArrayValue(lm->layers, &status);
@@ -644,6 +842,10 @@ BatchSaveResult LayerDatabase::saveUsdToMayaFile()
     layersHandle.setAllClean();
     dataBlock.setClean(lm->layers);
 
+    stopwatch.Stop();
+    TF_DEBUG(USDMAYA_LAYERMANAGER)
+        .Msg("Saved the USD layers into the Maya file in %.3f seconds\n", stopwatch.GetSeconds());
+
     if (!atLeastOneDirty) {
         MDGModifier modifier;
         modifier.deleteNode(lm->thisMObject());
@@ -755,6 +957,7 @@ void LayerDatabase::loadLayersPostRead(void*)
     MPlug                       idPlug;
     MPlug                       anonymousPlug;
     MPlug                       serializedPlug;
+    MPlug                       binaryPlug;
     std::string                 identifierVal;
     std::string                 serializedVal;
     SdfLayerRefPtr              layer;
@@ -768,6 +971,7 @@ void LayerDatabase::loadLayersPostRead(void*)
         idPlug = singleLayerPlug.child(lm->identifier, &status);
         anonymousPlug = singleLayerPlug.child(lm->anonymous, &status);
         serializedPlug = singleLayerPlug.child(lm->serialized, &status);
+        binaryPlug = singleLayerPlug.child(lm->binary, &status);
 
         identifierVal = idPlug.asString(MDGContext::fsNormal, &status).asChar();
         if (identifierVal.empty()) {
@@ -782,6 +986,8 @@ void LayerDatabase::loadLayersPostRead(void*)
             layerContainsEdits = false;
         }
 
+        const bool isBinary = binaryPlug.asBool(MDGContext::fsNormal, &status);
+
         bool isAnon = anonymousPlug.asBool(MDGContext::fsNormal, &status);
         if (isAnon) {
             // Note that the new identifier will not match the old identifier - only the "tag"
@@ -798,8 +1004,9 @@ void LayerDatabase::loadLayersPostRead(void*)
                 // identifier, which could cause an error. This seems unlikely, but we have a
                 // discussion with Pixar to find a way to avoid this.
 
+                // Binary data is not text, the format can only come from the identifier.
                 SdfFileFormatConstPtr fileFormat
-                    = getFileFormatForLayer(identifierVal, serializedVal);
+                    = getFileFormatForLayer(identifierVal, isBinary ? std::string() : serializedVal);
 
                 if (layerContainsEdits) {
                     // In order to make the layer reloadable by SdfLayer::Reload(), we hack the
@@ -824,9 +1031,36 @@ void LayerDatabase::loadLayersPostRead(void*)
 
         if (layer) {
             if (layerContainsEdits) {
-                if (!layer->ImportFromString(serializedVal)) {
-                    MGlobal::displayError(
-                        MString("Failed to import serialized layer: ") + serializedVal.c_str());
+                TfStopwatch stopwatch;
+                stopwatch.Start();
+
+                bool        imported = false;
+                std::string bytes;
+                if (isBinary) {
+                    imported = MayaUsd::utils::decodeBase64(serializedVal, &bytes)
+                        && importLayerFromCrateString(layer, bytes);
+                } else {
+                    imported = layer->ImportFromString(serializedVal);
+                }
+
+                stopwatch.Stop();
+                TF_DEBUG(USDMAYA_LAYERMANAGER)
+                    .Msg(
+                        "Deserialized layer '%s' from %s: %zu bytes in %.3f seconds\n",
+                        identifierVal.c_str(),
+                        isBinary ? "usdc" : "usda",
+                        serializedVal.size(),
+                        stopwatch.GetSeconds());
+
+                if (!imported) {
+                    if (isBinary) {
+                        MGlobal::displayError(
+                            MString("Failed to import serialized binary layer: ")
+                            + identifierVal.c_str());
+                    } else {
+                        MGlobal::displayError(
+                            MString("Failed to import serialized layer: ") + serializedVal.c_str());
+                    }
                     continue;
                 }
             }
@@ -910,7 +1144,12 @@ bool LayerDatabase::removeLayer(SdfLayerRefPtr layer)
     return true;
 }
 
-void LayerDatabase::removeAllLayers() { _idToLayer.clear(); }
+void LayerDatabase::removeAllLayers()
+{
+    // The hashes of the serialized layers are kept: they are only used once checked against the
+    // serializations stored in the manager node, and are dropped when their layer expires.
+    _idToLayer.clear();
+}
 
 SdfLayerHandle LayerDatabase::findLayer(std::string identifier) const
 {
@@ -960,6 +1199,7 @@ MObject LayerManager::layers = MObject::kNullObj;
 MObject LayerManager::identifier = MObject::kNullObj;
 MObject LayerManager::serialized = MObject::kNullObj;
 MObject LayerManager::anonymous = MObject::kNullObj;
+MObject LayerManager::binary = MObject::kNullObj;
 
 /* static */
 void LayerManager::SetBatchSaveDelegate(BatchSaveDelegate delegate)
@@ -1006,6 +1246,15 @@ MStatus LayerManager::initialize()
         stat = addAttribute(anonymous);
         CHECK_MSTATUS_AND_RETURN_IT(stat);
 
+        binary = fn_bool.create("binary", "bin", MFnNumericData::kBoolean, false, &stat);
+        CHECK_MSTATUS_AND_RETURN_IT(stat);
+        fn_bool.setCached(true);
+        fn_bool.setReadable(true);
+        fn_bool.setStorable(true);
+        fn_bool.setHidden(true);
+        stat = addAttribute(binary);
+        CHECK_MSTATUS_AND_RETURN_IT(stat);
+
         MFnCompoundAttribute fn_cmp;
         layers = fn_cmp.create("layers", "lyr", &stat);
         CHECK_MSTATUS_AND_RETURN_IT(stat);
@@ -1019,6 +1268,9 @@ MStatus LayerManager::initialize()
         stat = fn_cmp.addChild(anonymous);
         CHECK_MSTATUS_AND_RETURN_IT(stat);
 
+        stat = fn_cmp.addChild(binary);
+        CHECK_MSTATUS_AND_RETURN_IT(stat);
+
         fn_cmp.setCached(true);
         fn_cmp.setReadable(true);
         fn_cmp.setWritable(true);
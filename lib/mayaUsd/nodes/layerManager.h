@@ -72,7 +72,9 @@ typedef std::function<BatchSaveResult(const MDagPathArray&)> BatchSaveDelegate;
     node will be created that stores the Usd identifiers of all layers under the parent Proxy Shape
     as well as the dirty Usd layer itself exported to a string.  Dirty layers will include any
     anonymous layers, a Session layer with edits, and any file-backed Usd layers with edits that
-   have not been saved to disk.
+   have not been saved to disk.  Layers are exported as usda text by default, or as base64
+    encoded usdc data when the mayaUsd_SerializedUsdEditsBinaryFormat optionVar is set.  Layers
+    that have not changed since they were last serialized reuse their previous serialization.
 
     3. Ignore all Usd edits.
     With this option, Maya will not attempt to save any dirty Usd layers, assuming the user is
@@ -116,6 +118,7 @@ public:
     static MObject identifier;
     static MObject serialized;
     static MObject anonymous;
+    static MObject binary;
 
 protected:
     LayerManager();
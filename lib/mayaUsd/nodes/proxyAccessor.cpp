@@ -17,6 +17,7 @@
 
 #include <mayaUsd/base/debugCodes.h>
 #include <mayaUsd/utils/converter.h>
+#include <mayaUsd/utils/traceProfiler.h>
 
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/resolverScopedCache.h>
@@ -272,7 +273,7 @@ void ProxyAccessor::collectAccessorItems(MObject node)
     if (_validAccessorItems)
         return;
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Generate acceleration structure");
 
     _accessorInputItems.clear();
@@ -379,7 +380,7 @@ MStatus ProxyAccessor::addDependentsDirty(const MPlug& plug, MPlugArray& plugArr
     if (inCompute())
         return MS::kUnknownParameter;
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Dirty accessor plugs");
 
     collectAccessorItems(plug.node());
@@ -412,7 +413,7 @@ MStatus ProxyAccessor::compute(const MPlug& plug, MDataBlock& dataBlock)
 {
     // Special handling for nested compute
     if (inCompute()) {
-        MProfilingScope profilingScope(
+        MayaUsd::ProfilingScope profilingScope(
             _accessorProfilerCategory, MProfiler::kColorB_L3, "Nested compute USD accessor");
 
         const auto* accessorItem = findAccessorItem(plug, false);
@@ -462,7 +463,7 @@ MStatus ProxyAccessor::compute(const MPlug& plug, MDataBlock& dataBlock)
         return MS::kSuccess;
     }
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Compute USD accessor");
 
     TF_DEBUG(USDMAYA_PROXYACCESSOR)
@@ -513,7 +514,7 @@ MStatus ProxyAccessor::computeInput(
     // We should cache UsdAttribute in here too and avoid expensive
     // searches (i.e. getting the prim, getting attribute, checking if defined)
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Write input", itemPath.GetText());
 
     evaluationId.sync(_evaluationId);
@@ -566,7 +567,7 @@ MStatus ProxyAccessor::computeOutput(
     // We should cache UsdAttribute in here too and avoid expensive
     // searches (i.e. getting the prim, getting attribute, checking if defined)
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Write output", itemPath.GetText());
 
     SdfPath        itemPrimPath = itemPath.GetPrimPath();
@@ -627,7 +628,7 @@ MStatus ProxyAccessor::syncCache(const MObject& node, MDataBlock& dataBlock)
     if (inCompute())
         return MS::kSuccess;
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Update USD cache");
 
     TF_DEBUG(USDMAYA_PROXYACCESSOR).Msg("Update USD cache\n");
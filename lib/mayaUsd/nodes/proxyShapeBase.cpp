@@ -21,7 +21,9 @@
 #include <mayaUsd/nodes/stageData.h>
 #include <mayaUsd/utils/customLayerData.h>
 #include <mayaUsd/utils/query.h>
+#include <mayaUsd/utils/stageBvh.h>
 #include <mayaUsd/utils/stageCache.h>
+#include <mayaUsd/utils/traceProfiler.h>
 #include <mayaUsd/utils/util.h>
 #include <mayaUsd/utils/utilFileSystem.h>
 
@@ -45,6 +47,7 @@
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/editContext.h>
 #include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/stageCacheContext.h>
 #include <pxr/usd/usd/timeCode.h>
@@ -52,7 +55,11 @@
 #include <pxr/usd/usdGeom/boundable.h>
 #include <pxr/usd/usdGeom/gprim.h>
 #include <pxr/usd/usdGeom/imageable.h>
+#include <pxr/usd/usdGeom/pointBased.h>
+#include <pxr/usd/usdGeom/pointInstancer.h>
 #include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformOp.h>
+#include <pxr/usd/usdGeom/xformable.h>
 #include <pxr/usd/usdUtils/stageCache.h>
 
 #include <maya/MBoundingBox.h>
@@ -90,6 +97,7 @@
 
 #include <ghc/filesystem.hpp>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <utility>
@@ -110,8 +118,15 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 TF_DEFINE_PUBLIC_TOKENS(MayaUsdProxyShapeBaseTokens, MAYAUSD_PROXY_SHAPE_BASE_TOKENS);
 
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_PROXY_SHAPE_BBOX_CACHE_SIZE,
+    256,
+    "Maximum number of time samples for which a proxy shape with time-varying "
+    "bounds keeps its bounding box cached. Stages with static bounds always "
+    "use a single entry.");
+
 MayaUsdProxyShapeBase::ClosestPointDelegate MayaUsdProxyShapeBase::_sharedClosestPointDelegate
-    = nullptr;
+    = MayaUsdProxyShapeBase::ClosestPointOnStageBvh;
 
 const std::string kAnonymousLayerName { "anonymousLayer1" };
 const std::string kSessionLayerPostfix { "-session" };
@@ -159,6 +174,96 @@ std::string extractAnonTagName(const std::string& identifier)
     return identifier.substr(found + 1);
 }
 
+// Returns true if any attribute of the prim may affect its bound: the instances of a point
+// instancer are placed by its attributes, and a boundable without an authored extent has it
+// computed from its schema attributes, e.g. the size of a cube or the widths of curves.
+bool boundsDependOnAllAttributes(const UsdPrim& prim)
+{
+    if (prim.IsA<UsdGeomPointInstancer>()) {
+        return true;
+    }
+
+    const UsdGeomBoundable boundable(prim);
+    return boundable && !boundable.GetExtentAttr().HasAuthoredValue();
+}
+
+// Returns true if any value feeding the untransformed bound of the subtree
+// rooted at root might change over time. The transform of root itself is not
+// part of its untransformed bound.
+bool boundsMightBeTimeVarying(const UsdPrim& root)
+{
+    TRACE_FUNCTION();
+
+    for (const UsdPrim& prim : UsdPrimRange(root, UsdTraverseInstanceProxies())) {
+        const UsdGeomImageable imageable(prim);
+        if (!imageable) {
+            continue;
+        }
+
+        if (imageable.GetVisibilityAttr().ValueMightBeTimeVarying()) {
+            return true;
+        }
+
+        if (prim != root) {
+            const UsdGeomXformable xformable(prim);
+            if (xformable && xformable.TransformMightBeTimeVarying()) {
+                return true;
+            }
+        }
+
+        if (boundsDependOnAllAttributes(prim)) {
+            for (const UsdAttribute& attr : prim.GetAuthoredAttributes()) {
+                if (attr.ValueMightBeTimeVarying()) {
+                    return true;
+                }
+            }
+            continue;
+        }
+
+        const UsdGeomBoundable boundable(prim);
+        if (boundable && boundable.GetExtentAttr().ValueMightBeTimeVarying()) {
+            return true;
+        }
+
+        const UsdGeomPointBased pointBased(prim);
+        if (pointBased && pointBased.GetPointsAttr().ValueMightBeTimeVarying()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// How a change to a property affects the bounds: a transform change only affects the bounds of
+// the ancestors of its prim, the other changes also affect the bounds of the prim's subtree.
+enum class BoundsEffect
+{
+    kNone,
+    kTransform,
+    kSubtree
+};
+
+// Returns how a change to the given property affects the bounds.
+BoundsEffect boundsEffectOfProperty(const UsdStageWeakPtr& stage, const SdfPath& propertyPath)
+{
+    static const TfToken::HashSet subtreeProperties { UsdGeomTokens->visibility,
+                                                      UsdGeomTokens->purpose,
+                                                      UsdGeomTokens->extent,
+                                                      UsdGeomTokens->points };
+
+    const TfToken& propertyName = propertyPath.GetNameToken();
+    if (subtreeProperties.count(propertyName)) {
+        return BoundsEffect::kSubtree;
+    }
+    if (propertyName == UsdGeomTokens->xformOpOrder || UsdGeomXformOp::IsXformOp(propertyName)) {
+        return BoundsEffect::kTransform;
+    }
+
+    const UsdPrim prim = stage ? stage->GetPrimAtPath(propertyPath.GetPrimPath()) : UsdPrim();
+    return prim && boundsDependOnAllAttributes(prim) ? BoundsEffect::kSubtree
+                                                     : BoundsEffect::kNone;
+}
+
 // recursive function to create new anonymous Sublayer(s)
 // and set the edit target accordingly.
 void createNewAnonSubLayerRecursive(
@@ -470,6 +575,51 @@ void MayaUsdProxyShapeBase::SetClosestPointDelegate(ClosestPointDelegate delegat
     _sharedClosestPointDelegate = delegate;
 }
 
+/* static */
+bool MayaUsdProxyShapeBase::ClosestPointOnStageBvh(
+    const MayaUsdProxyShapeBase& shape,
+    const GfRay&                 ray,
+    GfVec3d*                     outClosestPoint,
+    GfVec3d*                     outClosestNormal)
+{
+    MayaUsd::ProfilingScope profilingScope(
+        _shapeBaseProfilerCategory, MProfiler::kColorB_L1, "Intersect USD stage BVH");
+
+    const UsdPrim root = shape.usdPrim();
+    if (!root) {
+        return false;
+    }
+
+    bool drawRenderPurpose = false;
+    bool drawProxyPurpose = true;
+    bool drawGuidePurpose = false;
+    shape.getDrawPurposeToggles(&drawRenderPurpose, &drawProxyPurpose, &drawGuidePurpose);
+    TfTokenVector purposes { UsdGeomTokens->default_ };
+    if (drawRenderPurpose) {
+        purposes.push_back(UsdGeomTokens->render);
+    }
+    if (drawProxyPurpose) {
+        purposes.push_back(UsdGeomTokens->proxy);
+    }
+    if (drawGuidePurpose) {
+        purposes.push_back(UsdGeomTokens->guide);
+    }
+
+    if (!shape._stageBvh) {
+        shape._stageBvh = std::make_unique<UsdMayaStageBvh>();
+    }
+    // The proxy shape's local space is the stage's world space.
+    shape._stageBvh->Update(root, shape.getTime(), purposes, shape.getExcludePrimPaths());
+
+    UsdMayaStageBvh::Hit hit;
+    if (!shape._stageBvh->Intersect(ray, &hit)) {
+        return false;
+    }
+    *outClosestPoint = hit.point;
+    *outClosestNormal = hit.normal;
+    return true;
+}
+
 /* virtual */
 bool MayaUsdProxyShapeBase::GetObjectSoftSelectEnabled() const { return false; }
 
@@ -916,6 +1066,9 @@ MStatus MayaUsdProxyShapeBase::computeOutStageData(MDataBlock& dataBlock)
     const bool isNormalContext = dataBlock.context().isNormal();
     if (isNormalContext) {
         TfReset(_boundingBoxCache);
+        TfReset(_boundingBoxCacheLru);
+        _boundsVariability = BoundsVariability::kUnknown;
+        _subtreeBoundsCache.Clear();
 
         // Reset the stage listener until we determine that everything is valid.
         _stageNoticeListener.SetStage(UsdStageWeakPtr());
@@ -1177,43 +1330,70 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
     dataBlock.inputValue(outStageDataAttr, &status);
     CHECK_MSTATUS_AND_RETURN(status, MBoundingBox());
 
-    // XXX:
-    // If we could cheaply determine whether a stage only has static geometry,
-    // we could make this value a constant one for that case, avoiding the
-    // memory overhead of a cache entry per frame
-    UsdTimeCode currTime = GetOutputTime(dataBlock);
+    UsdPrim prim = _GetUsdPrim(dataBlock);
+    if (!prim) {
+        return MBoundingBox();
+    }
 
-    std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup
-        = _boundingBoxCache.find(currTime);
+    if (prim.GetPath() != _boundingBoxCacheRoot) {
+        nonConstThis->clearBoundingBoxCache();
+        nonConstThis->_boundingBoxCacheRoot = prim.GetPath();
+    }
 
-    if (cacheLookup != _boundingBoxCache.end()) {
-        return cacheLookup->second;
+    // Stages with static bounds share a single cache entry for all times,
+    // avoiding the memory overhead and bound computation of an entry per frame.
+    if (_boundsVariability == BoundsVariability::kUnknown) {
+        nonConstThis->_boundsVariability = boundsMightBeTimeVarying(prim)
+            ? BoundsVariability::kTimeVarying
+            : BoundsVariability::kStatic;
     }
 
-    MProfilingScope profilingScope(
-        _shapeBaseProfilerCategory, MProfiler::kColorB_L1, "Compute USD Stage BoundingBox");
+    const UsdTimeCode currTime = GetOutputTime(dataBlock);
+    const UsdTimeCode cacheTime
+        = _boundsVariability == BoundsVariability::kStatic ? UsdTimeCode::Default() : currTime;
 
-    UsdPrim prim = _GetUsdPrim(dataBlock);
-    if (!prim) {
-        return MBoundingBox();
+    auto cacheLookup = nonConstThis->_boundingBoxCache.find(cacheTime);
+    if (cacheLookup != _boundingBoxCache.end()) {
+        nonConstThis->_boundingBoxCacheLru.splice(
+            nonConstThis->_boundingBoxCacheLru.begin(),
+            nonConstThis->_boundingBoxCacheLru,
+            cacheLookup->second.lruPos);
+        return cacheLookup->second.bbox;
     }
 
-    const UsdGeomImageable imageablePrim(prim);
+    MayaUsd::ProfilingScope profilingScope(
+        _shapeBaseProfilerCategory, MProfiler::kColorB_L1, "Compute USD Stage BoundingBox");
 
     bool drawRenderPurpose = false;
     bool drawProxyPurpose = true;
     bool drawGuidePurpose = false;
     _GetDrawPurposeToggles(dataBlock, &drawRenderPurpose, &drawProxyPurpose, &drawGuidePurpose);
 
-    const TfToken purpose1 = UsdGeomTokens->default_;
-    const TfToken purpose2 = drawRenderPurpose ? UsdGeomTokens->render : TfToken();
-    const TfToken purpose3 = drawProxyPurpose ? UsdGeomTokens->proxy : TfToken();
-    const TfToken purpose4 = drawGuidePurpose ? UsdGeomTokens->guide : TfToken();
+    TfTokenVector purposes { UsdGeomTokens->default_ };
+    if (drawRenderPurpose) {
+        purposes.push_back(UsdGeomTokens->render);
+    }
+    if (drawProxyPurpose) {
+        purposes.push_back(UsdGeomTokens->proxy);
+    }
+    if (drawGuidePurpose) {
+        purposes.push_back(UsdGeomTokens->guide);
+    }
+
+    const GfBBox3d allBox = nonConstThis->_subtreeBoundsCache.ComputeUntransformedBound(
+        prim, currTime, purposes, _boundsVariability == BoundsVariability::kTimeVarying);
 
-    const GfBBox3d allBox
-        = imageablePrim.ComputeUntransformedBound(currTime, purpose1, purpose2, purpose3, purpose4);
+    static const size_t maxCacheSize
+        = std::max(TfGetEnvSetting(MAYAUSD_PROXY_SHAPE_BBOX_CACHE_SIZE), 1);
+    while (_boundingBoxCache.size() >= maxCacheSize) {
+        nonConstThis->_boundingBoxCache.erase(_boundingBoxCacheLru.back());
+        nonConstThis->_boundingBoxCacheLru.pop_back();
+    }
 
-    MBoundingBox& retval = nonConstThis->_boundingBoxCache[currTime];
+    nonConstThis->_boundingBoxCacheLru.push_front(cacheTime);
+    BoundingBoxCacheEntry& entry = nonConstThis->_boundingBoxCache[cacheTime];
+    entry.lruPos = nonConstThis->_boundingBoxCacheLru.begin();
+    MBoundingBox& retval = entry.bbox;
 
     const GfRange3d boxRange = allBox.ComputeAlignedBox();
 
@@ -1230,7 +1410,84 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
     return retval;
 }
 
-void MayaUsdProxyShapeBase::clearBoundingBoxCache() { _boundingBoxCache.clear(); }
+void MayaUsdProxyShapeBase::clearBoundingBoxCache()
+{
+    _boundingBoxCache.clear();
+    _boundingBoxCacheLru.clear();
+    _boundsVariability = BoundsVariability::kUnknown;
+    _subtreeBoundsCache.Clear();
+}
+
+void MayaUsdProxyShapeBase::invalidateBoundingBoxCache(
+    const UsdStageWeakPtr& stage,
+    const SdfPathVector&   resyncedPaths,
+    const SdfPathVector&   changedOnlyPaths)
+{
+    _InvalidateBoundingBoxCache(stage, resyncedPaths, changedOnlyPaths);
+}
+
+template <typename PathRange>
+void MayaUsdProxyShapeBase::_InvalidateBoundingBoxCache(
+    const UsdStageWeakPtr& stage,
+    const PathRange&       resyncedPaths,
+    const PathRange&       changedOnlyPaths)
+{
+    if (_boundingBoxCache.empty() && _boundsVariability == BoundsVariability::kUnknown
+        && _subtreeBoundsCache.GetCachedBoundCount() == 0) {
+        return;
+    }
+
+    // Only changes within the subtree of the proxy's prim, to one of its
+    // ancestors, or to the prototype of one of its instances, can affect the bound.
+    const SdfPath& root = _boundingBoxCacheRoot;
+    auto           isRelevant = [this, &root](const SdfPath& path) {
+        const SdfPath primPath = path.GetPrimPath();
+        return root.IsEmpty() || primPath.HasPrefix(root) || root.HasPrefix(primPath)
+            || _subtreeBoundsCache.DependsOnPrototypeOf(primPath);
+    };
+
+    bool boundsChanged = false;
+    for (const SdfPath& resyncedPath : resyncedPaths) {
+        if (isRelevant(resyncedPath)) {
+            _subtreeBoundsCache.InvalidateSubtree(resyncedPath.GetPrimPath());
+            _boundsVariability = BoundsVariability::kUnknown;
+            boundsChanged = true;
+        }
+    }
+
+    for (const SdfPath& changedPath : changedOnlyPaths) {
+        if (!changedPath.IsPrimPropertyPath() || !isRelevant(changedPath)) {
+            continue;
+        }
+
+        const BoundsEffect effect = boundsEffectOfProperty(stage, changedPath);
+        if (effect == BoundsEffect::kNone) {
+            continue;
+        }
+        if (effect == BoundsEffect::kTransform) {
+            _subtreeBoundsCache.InvalidateTransform(changedPath.GetPrimPath());
+        } else {
+            _subtreeBoundsCache.InvalidateSubtree(changedPath.GetPrimPath());
+        }
+
+        // The edit may also have added time samples. Bounds that were time-varying are
+        // conservatively kept as such.
+        if (_boundsVariability == BoundsVariability::kStatic) {
+            const UsdAttribute attr
+                = stage ? stage->GetAttributeAtPath(changedPath) : UsdAttribute();
+            if (attr && attr.ValueMightBeTimeVarying()) {
+                _boundsVariability = BoundsVariability::kTimeVarying;
+            }
+        }
+        boundsChanged = true;
+    }
+
+    // The bounding boxes of the other times are not kept per subtree.
+    if (boundsChanged) {
+        _boundingBoxCache.clear();
+        _boundingBoxCacheLru.clear();
+    }
+}
 
 bool MayaUsdProxyShapeBase::isStageValid() const
 {
@@ -1635,13 +1892,17 @@ void MayaUsdProxyShapeBase::_OnStageContentsChanged(const UsdNotice::StageConten
 
 void MayaUsdProxyShapeBase::_OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice)
 {
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         _shapeBaseProfilerCategory, MProfiler::kColorB_L1, "Process USD objects changed");
 
-    // This will definitely force a BBox recomputation on "Frame All" or when framing a selected
-    // stage. Computing bounds in USD is expensive, so if it pops up in other frequently used
-    // scenarios we will have to investigate ways to make this cache clearing less expensive.
-    clearBoundingBoxCache();
+    // Computing bounds in USD is expensive, so only drop the cached bounds when
+    // the change touches the proxy's subtree and can affect its extent.
+    _InvalidateBoundingBoxCache(
+        notice.GetStage(), notice.GetResyncedPaths(), notice.GetChangedInfoOnlyPaths());
+
+    if (_stageBvh) {
+        _stageBvh->OnObjectsChanged(notice);
+    }
 
     ProxyAccessor::stageChanged(_usdAccessor, thisMObject(), notice);
 
@@ -39,7 +39,9 @@
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
 
+#include <list>
 #include <map>
+#include <memory>
 
 #if defined(WANT_UFE_BUILD)
 #include <ufe/ufe.h>
@@ -57,6 +59,7 @@ constexpr char USD_UFE_SEPARATOR = '/';
 #include <mayaUsd/nodes/proxyAccessor.h>
 #include <mayaUsd/nodes/proxyStageProvider.h>
 #include <mayaUsd/nodes/usdPrimProvider.h>
+#include <mayaUsd/utils/subtreeBoundsCache.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -70,6 +73,8 @@ TF_DECLARE_PUBLIC_TOKENS(
     MAYAUSD_CORE_PUBLIC,
     MAYAUSD_PROXY_SHAPE_BASE_TOKENS);
 
+class UsdMayaStageBvh;
+
 class MayaUsdProxyShapeBase
     : public MPxSurfaceShape
     , public ProxyStageProvider
@@ -152,6 +157,16 @@ public:
     MAYAUSD_CORE_PUBLIC
     static void SetClosestPointDelegate(ClosestPointDelegate delegate);
 
+    /// Default closest point delegate, intersecting the ray with the meshes
+    /// of the stage on the CPU, through a bounding volume hierarchy built
+    /// lazily and refit when the time changes.
+    MAYAUSD_CORE_PUBLIC
+    static bool ClosestPointOnStageBvh(
+        const MayaUsdProxyShapeBase& shape,
+        const GfRay&                 ray,
+        GfVec3d*                     outClosestPoint,
+        GfVec3d*                     outClosestNormal);
+
     // UsdMayaUsdPrimProvider overrides:
     /**
      * accessor to get the usdprim
@@ -248,6 +263,16 @@ public:
     MAYAUSD_CORE_PUBLIC
     void clearBoundingBoxCache();
 
+    /// \brief  Invalidates the cached bounds affected by changes to the given paths of \p stage.
+    ///         Only the ancestors of a prim whose transform changed are computed again, along
+    ///         with the subtree of a prim that was resynced or whose geometry, visibility or
+    ///         purpose changed.
+    MAYAUSD_CORE_PUBLIC
+    void invalidateBoundingBoxCache(
+        const UsdStageWeakPtr& stage,
+        const SdfPathVector&   resyncedPaths,
+        const SdfPathVector&   changedOnlyPaths);
+
     // returns the shape's parent transform
     MAYAUSD_CORE_PUBLIC
     MDagPath parentTransform();
@@ -358,9 +383,40 @@ private:
     void _OnStageContentsChanged(const UsdNotice::StageContentsChanged& notice);
     void _OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice);
 
+    template <typename PathRange>
+    void _InvalidateBoundingBoxCache(
+        const UsdStageWeakPtr& stage,
+        const PathRange&       resyncedPaths,
+        const PathRange&       changedOnlyPaths);
+
     UsdMayaStageNoticeListener _stageNoticeListener;
 
-    std::map<UsdTimeCode, MBoundingBox> _boundingBoxCache;
+    //! Whether the bound of the subtree rooted at _boundingBoxCacheRoot can
+    //! change over time.
+    enum class BoundsVariability
+    {
+        kUnknown,
+        kStatic,
+        kTimeVarying
+    };
+
+    struct BoundingBoxCacheEntry
+    {
+        MBoundingBox                     bbox;
+        std::list<UsdTimeCode>::iterator lruPos;
+    };
+
+    //! Bounding boxes keyed by time. Static stages only hold a single entry
+    //! keyed by UsdTimeCode::Default(), time-varying ones evict their least
+    //! recently used entries past a fixed budget.
+    std::map<UsdTimeCode, BoundingBoxCacheEntry> _boundingBoxCache;
+    std::list<UsdTimeCode>                       _boundingBoxCacheLru;
+    SdfPath                                      _boundingBoxCacheRoot;
+    BoundsVariability _boundsVariability { BoundsVariability::kUnknown };
+    //! Bounds of the subtrees of _boundingBoxCacheRoot, at the time of the
+    //! last computed bounding box, so that edits only recompute the bounds of
+    //! the edited prims' ancestors.
+    UsdMayaSubtreeBoundsCache _subtreeBoundsCache;
     size_t                              _excludePrimPathsVersion { 1 };
     size_t                              _UsdStageVersion { 1 };
 
@@ -368,6 +424,10 @@ private:
 
     static ClosestPointDelegate _sharedClosestPointDelegate;
 
+    // Acceleration structure of the default closest point delegate, created on
+    // its first use.
+    mutable std::unique_ptr<UsdMayaStageBvh> _stageBvh;
+
     // Whether or not the proxy shape has enabled UFE/subpath selection
     const bool _isUfeSelectionEnabled;
 
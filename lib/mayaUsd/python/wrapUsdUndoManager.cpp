@@ -66,6 +66,12 @@ void _trackLayerStates(const SdfLayerHandle& layer)
     MayaUsd::UsdUndoManager::instance().trackLayerStates(layer);
 }
 
+size_t _memoryUsage() { return MayaUsd::UsdUndoManager::instance().memoryUsage(); }
+
+size_t _memoryBudget() { return MayaUsd::UsdUndoManager::instance().memoryBudget(); }
+
+void _setMemoryBudget(size_t bytes) { MayaUsd::UsdUndoManager::instance().setMemoryBudget(bytes); }
+
 } // namespace
 
 void wrapUsdUndoManager()
@@ -75,7 +81,13 @@ void wrapUsdUndoManager()
         typedef MayaUsd::UsdUndoManager This;
         class_<This, boost::noncopyable>("UsdUndoManager", no_init)
             .def("trackLayerStates", &_trackLayerStates)
-            .staticmethod("trackLayerStates");
+            .staticmethod("trackLayerStates")
+            .def("memoryUsage", &_memoryUsage)
+            .staticmethod("memoryUsage")
+            .def("memoryBudget", &_memoryBudget)
+            .staticmethod("memoryBudget")
+            .def("setMemoryBudget", &_setMemoryBudget)
+            .staticmethod("setMemoryBudget");
     }
 
     // UsdUndoBlock
@@ -28,6 +28,7 @@
 #include <mayaUsd/render/px_vp20/utils_legacy.h>
 #include <mayaUsd/render/pxrUsdMayaGL/debugCodes.h>
 #include <mayaUsd/render/pxrUsdMayaGL/userData.h>
+#include <mayaUsd/utils/traceProfiler.h>
 
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/gf/vec2i.h>
@@ -138,7 +139,7 @@ bool UsdMayaGLBatchRenderer::AddShapeAdapter(PxrMayaHdShapeAdapter* shapeAdapter
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorE_L3, "Batch Renderer Adding Shape Adapter");
 
     if (!TF_VERIFY(shapeAdapter, "Cannot add invalid shape adapter")) {
@@ -245,7 +246,7 @@ bool UsdMayaGLBatchRenderer::RemoveShapeAdapter(PxrMayaHdShapeAdapter* shapeAdap
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorE_L3, "Batch Renderer Removing Shape Adapter");
 
     if (!TF_VERIFY(shapeAdapter, "Cannot remove invalid shape adapter")) {
@@ -543,7 +544,7 @@ void UsdMayaGLBatchRenderer::Draw(const MDrawRequest& request, M3dView& view)
 
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorC_L2, "Batch Renderer Draw() (Legacy Viewport)");
 
     MDrawData drawData = request.drawData();
@@ -577,7 +578,7 @@ void UsdMayaGLBatchRenderer::Draw(const MHWRender::MDrawContext& context, const
 
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorC_L2, "Batch Renderer Draw() (Viewport 2.0)");
 
     const PxrMayaHdUserData* hdUserData = dynamic_cast<const PxrMayaHdUserData*>(userData);
@@ -634,7 +635,7 @@ void UsdMayaGLBatchRenderer::DrawBoundingBox(const MDrawRequest& request, M3dVie
 
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory,
         MProfiler::kColorC_L2,
         "Batch Renderer DrawBoundingBox() (Legacy Viewport)");
@@ -675,7 +676,7 @@ void UsdMayaGLBatchRenderer::DrawBoundingBox(
 
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorC_L2, "Batch Renderer DrawBoundingBox() (Viewport 2.0)");
 
     const PxrMayaHdUserData* hdUserData = dynamic_cast<const PxrMayaHdUserData*>(userData);
@@ -723,7 +724,7 @@ const HdxPickHitVector* UsdMayaGLBatchRenderer::TestIntersection(
 
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory,
         MProfiler::kColorE_L3,
         "Batch Renderer Testing Intersection (Legacy Viewport)");
@@ -801,7 +802,7 @@ const HdxPickHitVector* UsdMayaGLBatchRenderer::TestIntersection(
 
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory,
         MProfiler::kColorE_L3,
         "Batch Renderer Testing Intersection (Viewport 2.0)");
@@ -996,7 +997,7 @@ bool UsdMayaGLBatchRenderer::_TestIntersection(
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorE_L3, "Batch Renderer Testing Intersection");
 
     if (!result) {
@@ -1050,7 +1051,7 @@ void UsdMayaGLBatchRenderer::_ComputeSelection(
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorE_L3, "Batch Renderer Computing Selection");
 
     // If depth selection has not been turned on, then we can optimize
@@ -1146,7 +1147,7 @@ void UsdMayaGLBatchRenderer::_Render(
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorC_L2, "Batch Renderer Rendering Batch");
 
     _taskDelegate->SetCameraState(worldToViewMatrix, projectionMatrix, viewport);
@@ -1205,7 +1206,7 @@ void UsdMayaGLBatchRenderer::_Render(
     {
         TRACE_SCOPE("Executing Hydra Tasks");
 
-        MProfilingScope hydraProfilingScope(
+        MayaUsd::ProfilingScope hydraProfilingScope(
             ProfilerCategory, MProfiler::kColorC_L3, "Batch Renderer Executing Hydra Tasks");
 
         _hdEngine.Execute(_renderIndex.get(), &tasks);
@@ -1226,7 +1227,7 @@ void UsdMayaGLBatchRenderer::_RenderBatches(
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         ProfilerCategory, MProfiler::kColorC_L2, "Batch Renderer Rendering Batches");
 
     _ShapeAdapterBucketsMap& bucketsMap
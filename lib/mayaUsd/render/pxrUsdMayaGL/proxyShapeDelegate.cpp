@@ -23,12 +23,19 @@
 #include <pxr/base/gf/ray.h>
 #include <pxr/base/gf/rotation.h>
 #include <pxr/base/gf/vec3d.h>
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/registryManager.h>
 
 #include <maya/MFnDagNode.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_GL_CLOSEST_POINT,
+    false,
+    "Compute the closest point on proxy shapes by drawing them with Hydra, "
+    "instead of intersecting the stage's meshes on the CPU.");
+
 static PxrMayaHdPrimFilter _sharedPrimFilter = {
     nullptr,
     HdRprimCollection(
@@ -117,7 +124,9 @@ bool UsdMayaGL_ClosestPointOnProxyShape(
 
 TF_REGISTRY_FUNCTION(MayaUsdProxyShapeBase)
 {
-    MayaUsdProxyShapeBase::SetClosestPointDelegate(UsdMayaGL_ClosestPointOnProxyShape);
+    if (TfGetEnvSetting(MAYAUSD_GL_CLOSEST_POINT)) {
+        MayaUsdProxyShapeBase::SetClosestPointDelegate(UsdMayaGL_ClosestPointOnProxyShape);
+    }
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -20,6 +20,7 @@
 #include <mayaUsd/render/pxrUsdMayaGL/batchRenderer.h>
 #include <mayaUsd/render/pxrUsdMayaGL/renderParams.h>
 #include <mayaUsd/render/pxrUsdMayaGL/usdProxyShapeAdapter.h>
+#include <mayaUsd/utils/traceProfiler.h>
 
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/gf/vec4f.h>
@@ -64,7 +65,7 @@ void UsdMayaProxyShapeUI::getDrawRequests(
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         UsdMayaGLBatchRenderer::ProfilerCategory,
         MProfiler::kColorE_L2,
         "USD Proxy Shape getDrawRequests() (Legacy Viewport)");
@@ -96,7 +97,7 @@ void UsdMayaProxyShapeUI::draw(const MDrawRequest& request, M3dView& view) const
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         UsdMayaGLBatchRenderer::ProfilerCategory,
         MProfiler::kColorC_L1,
         "USD Proxy Shape draw() (Legacy Viewport)");
@@ -125,7 +126,7 @@ bool UsdMayaProxyShapeUI::select(
 {
     TRACE_FUNCTION();
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         UsdMayaGLBatchRenderer::ProfilerCategory,
         MProfiler::kColorE_L2,
         "USD Proxy Shape select() (Legacy Viewport)");
@@ -24,6 +24,8 @@
 #include "render_delegate.h"
 #include "tokens.h"
 
+#include <mayaUsd/utils/traceProfiler.h>
+
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/gf/matrix4f.h>
 #include <pxr/base/vt/value.h>
@@ -553,7 +555,7 @@ void HdVP2BasisCurves::Sync(
         return;
     }
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorC_L2,
         _rprimId.asChar(),
@@ -644,7 +646,7 @@ void HdVP2BasisCurves::Sync(
 
             _delegate->GetVP2ResourceRegistry().EnqueueCommit(
                 [positionsBuffer, bufferData, rprimId]() {
-                    MProfilingScope profilingScope(
+                    MayaUsd::ProfilingScope profilingScope(
                         HdVP2RenderDelegate::sProfilerCategory,
                         MProfiler::kColorC_L2,
                         rprimId.asChar(),
@@ -696,7 +698,7 @@ void HdVP2BasisCurves::_CommitMVertexBuffer(
     const MString& rprimId = _rprimId;
 
     _delegate->GetVP2ResourceRegistry().EnqueueCommit([buffer, bufferData, rprimId]() {
-        MProfilingScope profilingScope(
+        MayaUsd::ProfilingScope profilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorC_L2,
             "CommitBuffer",
@@ -1160,7 +1162,8 @@ void HdVP2BasisCurves::_UpdateDrawItem(
     // If the prim is instanced, create one new instance per transform.
     // The current instancer invalidation tracking makes it hard for
     // us to tell whether transforms will be dirty, so this code
-    // pulls them every time something changes.
+    // pulls them every time something changes. The instancer composes them
+    // once per sync of its primvars, so pulling them only looks them up.
     // If the mesh is instanced but has 0 instance transforms remember that
     // so the render item can be hidden.
 
@@ -1353,7 +1356,7 @@ void HdVP2BasisCurves::_UpdateDrawItem(
         if (ARCH_UNLIKELY(!renderItem))
             return;
 
-        MProfilingScope profilingScope(
+        MayaUsd::ProfilingScope profilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorC_L2,
             drawItem->GetDrawItemName().asChar(),
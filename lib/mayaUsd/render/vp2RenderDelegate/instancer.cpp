@@ -25,8 +25,13 @@
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/gf/vec4f.h>
 #include <pxr/base/tf/staticTokens.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 // Define local tokens for the names of the primvars the instancer
@@ -43,6 +48,59 @@ TF_DEFINE_PRIVATE_TOKENS(
 );
 // clang-format on
 
+namespace {
+
+//! Number of instances from which transforms are computed in parallel.
+constexpr size_t _kParallelThreshold = 8192;
+
+//! Calls fn(begin, end) over [0, count), in parallel for large ranges.
+template <typename Fn> void _ForEachRange(size_t count, Fn&& fn)
+{
+    if (count < _kParallelThreshold) {
+        fn(size_t(0), count);
+    } else {
+        WorkParallelForN(count, std::forward<Fn>(fn));
+    }
+}
+
+/*! \brief  The elements of an instance primvar as a plain array of T.
+
+    The buffer is read in place when it holds T values, which is the common
+    case. Otherwise each element is converted once by HdVP2BufferSampler, so
+    that composing the transforms doesn't switch on the type per instance.
+    Elements which can't be converted get the identity value.
+*/
+template <typename T> struct _TypedPrimvar
+{
+    const T*       data { nullptr };
+    size_t         size { 0 };
+    std::vector<T> converted;
+
+    _TypedPrimvar(const HdVtBufferSource* buffer, const T& identity)
+    {
+        if (!buffer) {
+            return;
+        }
+
+        size = buffer->GetNumElements();
+        if (buffer->GetTupleType() == HdVP2TypeHelper::GetTupleType<T>()) {
+            data = static_cast<const T*>(buffer->GetData());
+            return;
+        }
+
+        HdVP2BufferSampler sampler(*buffer);
+        converted.resize(size, identity);
+        for (size_t i = 0; i < size; ++i) {
+            if (!sampler.Sample(static_cast<int>(i), &converted[i])) {
+                converted[i] = identity;
+            }
+        }
+        data = converted.data();
+    }
+};
+
+} // namespace
+
 /*! \brief  Constructor.
 
     \param delegate     The scene delegate backing this instancer's data.
@@ -107,7 +165,7 @@ void HdVP2Instancer::_SyncPrimvars()
             // If this instancer has dirty primvars, get the list of
             // primvar names and then cache each one.
 
-            TfTokenVector             primvarNames;
+            bool                      transformsDirty = false;
             HdPrimvarDescriptorVector primvars
                 = GetDelegate()->GetPrimvarDescriptors(id, HdInterpolationInstance);
 
@@ -119,9 +177,19 @@ void HdVP2Instancer::_SyncPrimvars()
                             delete _primvarMap[pv.name];
                         }
                         _primvarMap[pv.name] = new HdVtBufferSource(pv.name, value);
+
+                        if (pv.name == _tokens->translate || pv.name == _tokens->rotate
+                            || pv.name == _tokens->scale
+                            || pv.name == _tokens->instanceTransform) {
+                            transformsDirty = true;
+                        }
                     }
                 }
             }
+
+            if (transformsDirty) {
+                _ComposeInstanceTransforms();
+            }
         }
 
         // Mark the instancer as clean
@@ -129,12 +197,101 @@ void HdVP2Instancer::_SyncPrimvars()
     }
 }
 
+/*! \brief  Composes the transform of each element of the instance primvars.
+
+    The transform of an element is computed by:
+        instanceTransform * scale * rotate * translate
+    where any transform which isn't provided is assumed to be the identity.
+    Rather than multiplying 4x4 matrices, the rotation rows are built from the
+    quaternion and scaled, and the translation is written as the last row, so
+    only "instanceTransform" needs a full product.
+
+    Called by _SyncPrimvars() under _instanceLock, when one of the transform
+    primvars was synced.
+*/
+void HdVP2Instancer::_ComposeInstanceTransforms()
+{
+    HD_TRACE_FUNCTION();
+    HF_MALLOC_TAG_FUNCTION();
+
+    auto getPrimvar = [this](const TfToken& name) -> const HdVtBufferSource* {
+        auto it = _primvarMap.find(name);
+        return it != _primvarMap.end() ? it->second : nullptr;
+    };
+
+    // "translate" holds a translation vector for each index.
+    const _TypedPrimvar<GfVec3f> translates(getPrimvar(_tokens->translate), GfVec3f(0.0f));
+    // "rotate" holds a quaternion in <real, i, j, k> format for each index.
+    const _TypedPrimvar<GfVec4f> rotates(
+        getPrimvar(_tokens->rotate), GfVec4f(1.0f, 0.0f, 0.0f, 0.0f));
+    // "scale" holds an axis-aligned scale vector for each index.
+    const _TypedPrimvar<GfVec3f> scales(getPrimvar(_tokens->scale), GfVec3f(1.0f));
+    // "instanceTransform" holds a 4x4 transform matrix for each index.
+    const _TypedPrimvar<GfMatrix4d> instanceTransforms(
+        getPrimvar(_tokens->instanceTransform), GfMatrix4d(1));
+
+    const size_t count = std::max(
+        std::max(translates.size, rotates.size), std::max(scales.size, instanceTransforms.size));
+
+    _instanceTransforms.resize(count);
+    GfMatrix4d* transforms = _instanceTransforms.data();
+
+    _ForEachRange(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            double m[4][4] = { { 1.0, 0.0, 0.0, 0.0 },
+                               { 0.0, 1.0, 0.0, 0.0 },
+                               { 0.0, 0.0, 1.0, 0.0 },
+                               { 0.0, 0.0, 0.0, 1.0 } };
+
+            // Same rows as GfMatrix4d::SetRotate(GfQuatd).
+            if (i < rotates.size) {
+                const GfVec4f& q = rotates.data[i];
+                const double   r = q[0], x = q[1], y = q[2], z = q[3];
+                m[0][0] = 1.0 - 2.0 * (y * y + z * z);
+                m[0][1] = 2.0 * (x * y + z * r);
+                m[0][2] = 2.0 * (z * x - y * r);
+                m[1][0] = 2.0 * (x * y - z * r);
+                m[1][1] = 1.0 - 2.0 * (z * z + x * x);
+                m[1][2] = 2.0 * (y * z + x * r);
+                m[2][0] = 2.0 * (z * x + y * r);
+                m[2][1] = 2.0 * (y * z - x * r);
+                m[2][2] = 1.0 - 2.0 * (x * x + y * y);
+            }
+
+            if (i < scales.size) {
+                const GfVec3f& s = scales.data[i];
+                for (int row = 0; row < 3; ++row) {
+                    for (int col = 0; col < 3; ++col) {
+                        m[row][col] *= s[row];
+                    }
+                }
+            }
+
+            if (i < translates.size) {
+                const GfVec3f& t = translates.data[i];
+                m[3][0] = t[0];
+                m[3][1] = t[1];
+                m[3][2] = t[2];
+            }
+
+            transforms[i] = GfMatrix4d(m);
+            if (i < instanceTransforms.size) {
+                transforms[i] = instanceTransforms.data[i] * transforms[i];
+            }
+        }
+    });
+}
+
 /*! \brief  Computes all instance transforms for the provided prototype id.
 
     Taking into account the scene delegate's instancerTransform and the
     instance primvars "instanceTransform", "translate", "rotate", "scale".
     Computes and flattens nested transforms, if necessary.
 
+    The transforms of the instance primvars are composed once per sync of the
+    primvars and cached, so this only looks up those of the prototype's
+    instances.
+
     \param prototypeId The prototype to compute transforms for.
 
     \return One transform per instance, to apply when drawing.
@@ -148,68 +305,33 @@ VtMatrix4dArray HdVP2Instancer::ComputeInstanceTransforms(SdfPath const& prototy
 
     // The transforms for this level of instancer are computed by:
     // foreach(index : indices) {
-    //     instancerTransform * translate(index) * rotate(index) *
-    //     scale(index) * instanceTransform(index)
+    //     instanceTransforms[index] * instancerTransform
     // }
-    // If any transform isn't provided, it's assumed to be the identity.
-
-    GfMatrix4d instancerTransform = GetDelegate()->GetInstancerTransform(GetId());
-    VtIntArray instanceIndices = GetDelegate()->GetInstanceIndices(GetId(), prototypeId);
-
-    VtMatrix4dArray transforms(instanceIndices.size());
-    for (size_t i = 0; i < instanceIndices.size(); ++i) {
-        transforms[i] = instancerTransform;
-    }
+    // Indices without a composed transform only get the instancerTransform.
 
-    // "translate" holds a translation vector for each index.
-    if (_primvarMap.count(_tokens->translate) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->translate]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfVec3f translate;
-            if (sampler.Sample(instanceIndices[i], &translate)) {
-                GfMatrix4d translateMat(1);
-                translateMat.SetTranslate(GfVec3d(translate));
-                transforms[i] = translateMat * transforms[i];
-            }
-        }
-    }
+    const GfMatrix4d instancerTransform = GetDelegate()->GetInstancerTransform(GetId());
+    const VtIntArray instanceIndices = GetDelegate()->GetInstanceIndices(GetId(), prototypeId);
+    const bool       identityInstancerTransform = (instancerTransform == GfMatrix4d(1));
 
-    // "rotate" holds a quaternion in <real, i, j, k> format for each index.
-    if (_primvarMap.count(_tokens->rotate) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->rotate]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfVec4f quat;
-            if (sampler.Sample(instanceIndices[i], &quat)) {
-                GfMatrix4d rotateMat(1);
-                rotateMat.SetRotate(GfQuatd(quat[0], quat[1], quat[2], quat[3]));
-                transforms[i] = rotateMat * transforms[i];
-            }
-        }
-    }
+    const GfMatrix4d* instanceTransforms = _instanceTransforms.cdata();
+    const size_t      numInstanceTransforms = _instanceTransforms.size();
 
-    // "scale" holds an axis-aligned scale vector for each index.
-    if (_primvarMap.count(_tokens->scale) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->scale]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfVec3f scale;
-            if (sampler.Sample(instanceIndices[i], &scale)) {
-                GfMatrix4d scaleMat(1);
-                scaleMat.SetScale(GfVec3d(scale));
-                transforms[i] = scaleMat * transforms[i];
-            }
-        }
-    }
-
-    // "instanceTransform" holds a 4x4 transform matrix for each index.
-    if (_primvarMap.count(_tokens->instanceTransform) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->instanceTransform]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfMatrix4d instanceTransform;
-            if (sampler.Sample(instanceIndices[i], &instanceTransform)) {
-                transforms[i] = instanceTransform * transforms[i];
+    VtMatrix4dArray transforms(instanceIndices.size());
+    GfMatrix4d*     transformsData = transforms.data();
+
+    _ForEachRange(instanceIndices.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Negative indices become larger than any valid one.
+            const size_t index = static_cast<unsigned int>(instanceIndices[i]);
+            if (index >= numInstanceTransforms) {
+                transformsData[i] = instancerTransform;
+            } else if (identityInstancerTransform) {
+                transformsData[i] = instanceTransforms[index];
+            } else {
+                transformsData[i] = instanceTransforms[index] * instancerTransform;
             }
         }
-    }
+    });
 
     if (GetParentId().IsEmpty()) {
         return transforms;
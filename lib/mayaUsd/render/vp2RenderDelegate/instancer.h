@@ -20,6 +20,7 @@
 
 #include <pxr/base/tf/hashmap.h>
 #include <pxr/base/tf/token.h>
+#include <pxr/base/vt/types.h>
 #include <pxr/imaging/hd/instancer.h>
 #include <pxr/imaging/hd/vtBufferSource.h>
 #include <pxr/pxr.h>
@@ -50,6 +51,7 @@ public:
 
 private:
     void _SyncPrimvars();
+    void _ComposeInstanceTransforms();
 
     //! Mutex guard for _SyncPrimvars().
     std::mutex _instanceLock;
@@ -59,6 +61,13 @@ private:
         interpreted at consumption time (here, in ComputeInstanceTransforms).
     */
     TfHashMap<TfToken, HdVtBufferSource*, TfToken::HashFunctor> _primvarMap;
+
+    /*! Transform of each element of the instance primvars, composed from
+        "translate", "rotate", "scale" and "instanceTransform" when one of them
+        is synced, and shared by all the prototypes. The instancer transform
+        isn't included, so that it can change without recomposing them.
+    */
+    VtMatrix4dArray _instanceTransforms;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -23,15 +23,19 @@
 
 #include <mayaUsd/render/vp2ShaderFragments/shaderFragments.h>
 #include <mayaUsd/utils/hash.h>
+#include <mayaUsd/utils/traceProfiler.h>
 
+#include <pxr/base/arch/fileSystem.h>
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/gf/matrix4f.h>
 #include <pxr/base/gf/vec2f.h>
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/gf/vec4f.h>
 #include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/getenv.h>
 #include <pxr/base/tf/pathUtils.h>
+#include <pxr/base/work/detachedTask.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
 #ifdef WANT_MATERIALX_BUILD
 #include <pxr/imaging/hdMtlx/hdMtlx.h>
@@ -44,6 +48,7 @@
 #include <pxr/usdImaging/usdImaging/textureUtils.h>
 #include <pxr/usdImaging/usdImaging/tokens.h>
 
+#include <maya/M3dView.h>
 #include <maya/MFragmentManager.h>
 #include <maya/MGlobal.h>
 #include <maya/MProfiler.h>
@@ -76,7 +81,12 @@
 #include <ghc/filesystem.hpp>
 #include <tbb/parallel_for.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -98,6 +108,18 @@ namespace mx = MaterialX;
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_VP2_ASYNC_TEXTURE_LOADING,
+    true,
+    "Decode textures on background threads in interactive sessions, showing a placeholder color "
+    "until they are ready.");
+
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_VP2_TEXTURE_CACHE_SIZE,
+    512,
+    "Size in megabytes of the cache of decoded images shared by all VP2 render delegate "
+    "materials.");
+
 namespace {
 
 // clang-format off
@@ -856,28 +878,35 @@ _LoadUdimTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& u
     return texture;
 }
 
-//! Load texture from the specified path
-MHWRender::MTexture*
-_LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvScaleOffset)
+//! Returns whether the path is the one of a UDIM texture
+bool _IsUdimTexture(const std::string& path)
 {
-    MProfilingScope profilingScope(
-        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "LoadTexture", path.c_str());
-
-    // If it is a UDIM texture we need to modify the path before calling OpenForReading
 #if PXR_VERSION >= 2102
-    if (HdStIsSupportedUdimTexture(path))
-        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
+    return HdStIsSupportedUdimTexture(path);
 #else
-    if (GlfIsSupportedUdimTexture(path))
-        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
+    return GlfIsSupportedUdimTexture(path);
 #endif
+}
 
-    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
-    MHWRender::MTextureManager* const textureMgr
-        = renderer ? renderer->getTextureManager() : nullptr;
-    if (!TF_VERIFY(textureMgr)) {
-        return nullptr;
-    }
+/*! \brief  Texels of an image, converted to a pixel format supported by VP2.
+
+    Decoding an image doesn't involve VP2, so it can be done by any thread. Only the creation of
+    the texture from the texels has to happen on the main thread.
+*/
+struct _DecodedImage
+{
+    MHWRender::MTextureDescription _desc;   //!< Description of the texture
+    std::vector<unsigned char>     _texels; //!< Texels matching the description
+    bool _isColorSpaceSRGB { false };       //!< Whether sRGB linearization is needed
+};
+
+using _DecodedImageSharedPtr = std::shared_ptr<const _DecodedImage>;
+
+//! Decode the image at the specified path, returns nullptr if it can't be read or converted
+_DecodedImageSharedPtr _DecodeImage(const std::string& path)
+{
+    MayaUsd::ProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "DecodeImage", path.c_str());
 
 #if PXR_VERSION >= 2102
     HioImageSharedPtr image = HioImage::OpenForReading(path);
@@ -921,15 +950,18 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
         return nullptr;
     }
 
-    MHWRender::MTexture* texture = nullptr;
+    auto decoded = std::make_shared<_DecodedImage>();
 
-    MHWRender::MTextureDescription desc;
+    MHWRender::MTextureDescription& desc = decoded->_desc;
     desc.setToDefault2DTexture();
     desc.fWidth = spec.width;
     desc.fHeight = spec.height;
     desc.fBytesPerRow = bytesPerRow;
     desc.fBytesPerSlice = bytesPerSlice;
 
+    // Formats which VP2 supports natively use the storage as is, others are converted
+    std::vector<unsigned char>& texels = decoded->_texels;
+
 #if PXR_VERSION > 2008
 #if PXR_VERSION >= 2102
     auto specFormat = spec.format;
@@ -940,21 +972,21 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
     // Single Channel
     case HioFormatFloat32:
         desc.fFormat = MHWRender::kR32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
     case HioFormatFloat16:
         desc.fFormat = MHWRender::kR16_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
     case HioFormatUNorm8:
         desc.fFormat = MHWRender::kR8_UNORM;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
 
     // Dual channel (quite rare, but seen with mono + alpha files)
     case HioFormatFloat32Vec2:
         desc.fFormat = MHWRender::kR32G32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
     case HioFormatFloat16Vec2: {
         // R16G16 is not supported by VP2. Converted to R16G16B16A16.
@@ -964,7 +996,7 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
         desc.fBytesPerRow = spec.width * bpp_8;
         desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
 
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+        texels.resize(desc.fBytesPerSlice);
 
         for (int y = 0; y < spec.height; y++) {
             for (int x = 0; x < spec.width; x++) {
@@ -979,8 +1011,6 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
                 texels[t * bpp_8 + 7] = storage[t * bpp + 3];
             }
         }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
         break;
     }
     case HioFormatUNorm8Vec2:
@@ -992,7 +1022,7 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
         desc.fBytesPerRow = spec.width * bpp_4;
         desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
 
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+        texels.resize(desc.fBytesPerSlice);
 
         for (int y = 0; y < spec.height; y++) {
             for (int x = 0; x < spec.width; x++) {
@@ -1003,16 +1033,14 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
                 texels[t * bpp_4 + 3] = storage[t * bpp + 1];
             }
         }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        decoded->_isColorSpaceSRGB = image->IsColorSpaceSRGB();
         break;
     }
 
     // 3-Channel
     case HioFormatFloat32Vec3:
         desc.fFormat = MHWRender::kR32G32B32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
     case HioFormatFloat16Vec3: {
         // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
@@ -1027,7 +1055,7 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
         const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
         const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
 
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+        texels.resize(desc.fBytesPerSlice);
 
         for (int y = 0; y < spec.height; y++) {
             for (int x = 0; x < spec.width; x++) {
@@ -1042,13 +1070,11 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
                 texels[t * bpp_8 + 7] = highAlpha;
             }
         }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
         break;
     }
     case HioFormatFloat16Vec4:
         desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
     case HioFormatUNorm8Vec3:
     case HioFormatUNorm8Vec3srgb: {
@@ -1059,7 +1085,7 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
         desc.fBytesPerRow = spec.width * bpp_4;
         desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
 
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+        texels.resize(desc.fBytesPerSlice);
 
         for (int y = 0; y < spec.height; y++) {
             for (int x = 0; x < spec.width; x++) {
@@ -1070,29 +1096,27 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
                 texels[t * bpp_4 + 3] = 255;
             }
         }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        decoded->_isColorSpaceSRGB = image->IsColorSpaceSRGB();
         break;
     }
 
     // 4-Channel
     case HioFormatFloat32Vec4:
         desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
     case HioFormatUNorm8Vec4:
     case HioFormatUNorm8Vec4srgb:
         desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        decoded->_isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        texels = std::move(storage);
         break;
     default:
         TF_WARN(
             "VP2 renderer delegate: unsupported pixel format (%d) in texture file %s.",
             (int)specFormat,
             path.c_str());
-        break;
+        return nullptr;
     }
 #else
     switch (spec.format) {
@@ -1102,12 +1126,12 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
             desc.fFormat = MHWRender::kR32_FLOAT;
         else if (spec.type == GL_HALF_FLOAT)
             desc.fFormat = MHWRender::kR16_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
     case GL_RGB:
         if (spec.type == GL_FLOAT) {
             desc.fFormat = MHWRender::kR32G32B32_FLOAT;
-            texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+            texels = std::move(storage);
         } else if (spec.type == GL_HALF_FLOAT) {
             // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
             constexpr int bpp_8 = 8;
@@ -1121,7 +1145,7 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
             const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
             const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
 
-            std::vector<unsigned char> texels(desc.fBytesPerSlice);
+            texels.resize(desc.fBytesPerSlice);
 
             for (int y = 0; y < spec.height; y++) {
                 for (int x = 0; x < spec.width; x++) {
@@ -1136,8 +1160,6 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
                     texels[t * bpp_8 + 7] = highAlpha;
                 }
             }
-
-            texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
         } else {
             // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
             constexpr int bpp_4 = 4;
@@ -1146,7 +1168,7 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
             desc.fBytesPerRow = spec.width * bpp_4;
             desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
 
-            std::vector<unsigned char> texels(desc.fBytesPerSlice);
+            texels.resize(desc.fBytesPerSlice);
 
             for (int y = 0; y < spec.height; y++) {
                 for (int x = 0; x < spec.width; x++) {
@@ -1157,9 +1179,7 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
                     texels[t * bpp_4 + 3] = 255;
                 }
             }
-
-            texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
+            decoded->_isColorSpaceSRGB = image->IsColorSpaceSRGB();
         }
         break;
     case GL_RGBA:
@@ -1169,15 +1189,289 @@ _LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvSca
             desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
         } else {
             desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
+            decoded->_isColorSpaceSRGB = image->IsColorSpaceSRGB();
         }
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
+        texels = std::move(storage);
         break;
-    default: break;
+    default: return nullptr;
     }
 #endif
 
-    return texture;
+    return decoded;
+}
+
+
+//! Returns the modification time of the file, or of the package holding it
+double _GetModificationTime(const std::string& path)
+{
+    const std::string filePath
+        = ArIsPackageRelativePath(path) ? ArSplitPackageRelativePathOuter(path).first : path;
+
+    double modificationTime = 0.0;
+    ArchGetModificationTime(filePath.c_str(), &modificationTime);
+    return modificationTime;
+}
+
+//! Schedule a refresh of all the viewports, requests made before it happens are merged
+void _ScheduleViewportRefresh()
+{
+    static std::atomic<bool> refreshScheduled { false };
+    if (refreshScheduled.exchange(true)) {
+        return;
+    }
+
+    // Idle tasks can be added from any thread and run on the main thread.
+    MGlobal::executeTaskOnIdle(
+        [](void*) {
+            refreshScheduled = false;
+            M3dView::scheduleRefreshAllViews();
+        },
+        nullptr);
+}
+
+/*! \brief  Decoded images shared by all materials, keyed by path and modification time.
+
+    Images are decoded by background workers. A decoded image stays pinned in the cache until
+    all the materials waiting for it either picked it up or released it, even if it is larger
+    than the budget, so that it is never decoded again before being shown. Only then does it
+    become evictable, and the least recently used evictable images are evicted when the cache
+    grows beyond MAYAUSD_VP2_TEXTURE_CACHE_SIZE.
+*/
+class _DecodedImageCache
+{
+public:
+    //! Returns the cache shared by all materials.
+    static _DecodedImageCache& Get()
+    {
+        // Intentionally leaked, background workers could still be decoding images at exit.
+        static _DecodedImageCache* cache = new _DecodedImageCache;
+        return *cache;
+    }
+
+    /*! \brief  Returns true if the image is available, decoding it on a background worker if not.
+
+        When the image is available, it is returned in \p image and the pointer is null if the
+        image can't be decoded. Otherwise a background worker is decoding it, all viewports will
+        be refreshed once it's done, and the caller waits for the image: it must request it
+        again with \p isWaiting set to true, or call Release().
+    */
+    bool RequestAsync(const std::string& path, bool isWaiting, _DecodedImageSharedPtr& image)
+    {
+        const double modificationTime = _GetModificationTime(path);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(path);
+        if (it != _entries.end() && it->second._modificationTime == modificationTime) {
+            _Entry& entry = it->second;
+            if (entry._pending) {
+                entry._waiters += isWaiting ? 0 : 1;
+                return false;
+            }
+            image = entry._image;
+            if (isWaiting) {
+                _Unpin(path, entry);
+            } else if (entry._evictable) {
+                _Touch(entry);
+            }
+            return true;
+        }
+
+        // The file changed or the image was never requested: the waiters of an out of date
+        // image keep waiting for the new one.
+        _Entry& entry = (it != _entries.end()) ? _Reset(it->second) : _entries[path];
+        entry._modificationTime = modificationTime;
+        entry._pending = true;
+        entry._waiters += isWaiting ? 0 : 1;
+
+        WorkRunDetachedTask([this, path, modificationTime]() {
+            _Store(path, modificationTime, _DecodeImage(path));
+            _ScheduleViewportRefresh();
+        });
+        return false;
+    }
+
+    //! Returns whether a background worker is decoding the image.
+    bool IsPending(const std::string& path) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(path);
+        return it != _entries.end() && it->second._pending;
+    }
+
+    //! Stops waiting for an image requested with RequestAsync() which wasn't picked up.
+    void Release(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(path);
+        if (it != _entries.end()) {
+            _Unpin(path, it->second);
+        }
+    }
+
+private:
+    _DecodedImageCache() = default;
+
+    //! Cached image and its bookkeeping
+    struct _Entry
+    {
+        _DecodedImageSharedPtr _image;                    //!< Null if decoding failed
+        double                 _modificationTime { 0.0 }; //!< Modification time of the file
+        size_t                 _waiters { 0 };      //!< Materials which didn't pick it up yet
+        bool                   _pending { false };  //!< Whether a background worker decodes it
+        bool                   _evictable { false }; //!< Whether it is in _lru
+        std::list<std::string>::iterator _lruIt;     //!< Position in _lru when evictable
+    };
+
+    static size_t _Size(const _DecodedImageSharedPtr& image)
+    {
+        return image ? image->_texels.size() : 0;
+    }
+
+    //! Stores the image decoded by a background worker, unless the request became obsolete
+    void _Store(const std::string& path, double modificationTime, _DecodedImageSharedPtr image)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(path);
+        if (it == _entries.end() || !it->second._pending
+            || it->second._modificationTime != modificationTime) {
+            return;
+        }
+
+        _Entry& entry = it->second;
+        entry._image = std::move(image);
+        entry._pending = false;
+        _size += _Size(entry._image);
+        if (entry._waiters == 0) {
+            // Nobody waits for the image anymore, keep it for later requests.
+            _MakeEvictable(path, entry);
+        }
+        _Evict();
+    }
+
+    //! Makes the image of an evictable entry the most recently used one
+    void _Touch(_Entry& entry) { _lru.splice(_lru.begin(), _lru, entry._lruIt); }
+
+    //! Makes a decoded image evictable, as the most recently used one
+    void _MakeEvictable(const std::string& path, _Entry& entry)
+    {
+        entry._lruIt = _lru.insert(_lru.begin(), path);
+        entry._evictable = true;
+    }
+
+    //! Removes a waiter of the entry, the decoded image becomes evictable after the last one
+    void _Unpin(const std::string& path, _Entry& entry)
+    {
+        if (entry._waiters == 0) {
+            return;
+        }
+        if (--entry._waiters == 0 && !entry._pending) {
+            _MakeEvictable(path, entry);
+            _Evict();
+        }
+    }
+
+    //! Drops the content of an entry which is out of date, keeping its waiters
+    _Entry& _Reset(_Entry& entry)
+    {
+        if (entry._evictable) {
+            _lru.erase(entry._lruIt);
+        }
+        _size -= _Size(entry._image);
+        const size_t waiters = entry._waiters;
+        entry = _Entry();
+        entry._waiters = waiters;
+        return entry;
+    }
+
+    //! Evicts the least recently used evictable images until the cache fits in its budget
+    void _Evict()
+    {
+        static const size_t budget
+            = size_t(std::max(0, TfGetEnvSetting(MAYAUSD_VP2_TEXTURE_CACHE_SIZE))) << 20;
+
+        while (_size > budget && !_lru.empty()) {
+            auto it = _entries.find(_lru.back());
+            _size -= _Size(it->second._image);
+            _entries.erase(it);
+            _lru.pop_back();
+        }
+    }
+
+    mutable std::mutex                      _mutex;    //!< Protects all the members below
+    std::unordered_map<std::string, _Entry> _entries;  //!< Cached images indexed by path
+    std::list<std::string>                  _lru;      //!< Evictable paths, most recent first
+    size_t                                  _size = 0; //!< Total size of the cached texels,
+                                                       //!< including the pinned ones
+};
+
+//! Returns whether textures are decoded by background workers
+bool _IsAsyncTextureLoadingEnabled()
+{
+    // Batch and command-line renders must produce final images from the first frame.
+    static const bool enabled = TfGetEnvSetting(MAYAUSD_VP2_ASYNC_TEXTURE_LOADING)
+        && MGlobal::mayaState() == MGlobal::kInteractive;
+    return enabled;
+}
+
+//! Create a VP2 texture from the decoded image, must be called from the main thread
+MHWRender::MTexture* _CreateTexture(const std::string& path, const _DecodedImage& image)
+{
+    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr
+        = renderer ? renderer->getTextureManager() : nullptr;
+    if (!TF_VERIFY(textureMgr)) {
+        return nullptr;
+    }
+
+    return textureMgr->acquireTexture(path.c_str(), image._desc, image._texels.data());
+}
+
+//! Acquire the constant color texture shown while the actual texture is being loaded
+MHWRender::MTexture* _AcquirePlaceholderTexture()
+{
+    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr
+        = renderer ? renderer->getTextureManager() : nullptr;
+    if (!TF_VERIFY(textureMgr)) {
+        return nullptr;
+    }
+
+    MHWRender::MTextureDescription desc;
+    desc.setToDefault2DTexture();
+    desc.fWidth = 1;
+    desc.fHeight = 1;
+    desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+    desc.fBytesPerRow = 4;
+    desc.fBytesPerSlice = 4;
+
+    const unsigned char mediumGray[4] = { 128, 128, 128, 255 };
+    return textureMgr->acquireTexture("HdVP2PlaceholderTexture", desc, mediumGray);
+}
+
+//! Load texture from the specified path
+MHWRender::MTexture*
+_LoadTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvScaleOffset)
+{
+    MayaUsd::ProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "LoadTexture", path.c_str());
+
+    // If it is a UDIM texture we need to modify the path before calling OpenForReading
+    if (_IsUdimTexture(path))
+        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
+
+    // The cache only serves the background workers: synchronous loads, e.g. in batch renders,
+    // decode the image on the calling thread and don't keep it.
+    _DecodedImageSharedPtr image = _DecodeImage(path);
+    if (!image) {
+        return nullptr;
+    }
+
+    isColorSpaceSRGB = image->_isColorSpaceSRGB;
+    return _CreateTexture(path, *image);
 }
 
 } // anonymous namespace
@@ -1202,6 +1496,15 @@ HdVP2Material::HdVP2Material(HdVP2RenderDelegate* renderDelegate, const SdfPath&
 {
 }
 
+/*! \brief  Releases the textures which are still being loaded.
+ */
+HdVP2Material::~HdVP2Material()
+{
+    for (const std::string& path : _pendingTextures) {
+        _DecodedImageCache::Get().Release(path);
+    }
+}
+
 /*! \brief  Synchronize VP2 state with scene delegate state based on dirty bits
  */
 void HdVP2Material::Sync(
@@ -1212,7 +1515,7 @@ void HdVP2Material::Sync(
     if (*dirtyBits & (HdMaterial::DirtyResource | HdMaterial::DirtyParams)) {
         const SdfPath& id = GetId();
 
-        MProfilingScope profilingScope(
+        MayaUsd::ProfilingScope profilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorC_L2,
             "HdVP2Material::Sync",
@@ -1273,7 +1576,7 @@ void HdVP2Material::Sync(
                 // to implement fine-grain dirty bit in Hydra for the same purpose:
                 // https://groups.google.com/g/usd-interest/c/xytT2azlJec/m/22Tnw4yXAAAJ
                 if (_surfaceNetworkToken != token) {
-                    MProfilingScope subProfilingScope(
+                    MayaUsd::ProfilingScope subProfilingScope(
                         HdVP2RenderDelegate::sProfilerCategory,
                         MProfiler::kColorD_L2,
                         "CreateShaderInstance");
@@ -2106,9 +2409,12 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
         return;
     }
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "UpdateShaderInstance");
 
+    // Paths of the textures used by the network, to forget the ones no longer used while loading
+    std::unordered_set<std::string> texturePaths;
+
     for (const HdMaterialNode& node : mat.nodes) {
         MString nodeName = "";
 #ifdef WANT_MATERIALX_BUILD
@@ -2203,8 +2509,10 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
                 const std::string&  resolvedPath = val.GetResolvedPath();
                 const std::string&  assetPath = val.GetAssetPath();
                 if (_IsUsdUVTexture(node) && token == _tokens->file) {
-                    const HdVP2TextureInfo& info
-                        = _AcquireTexture(!resolvedPath.empty() ? resolvedPath : assetPath);
+                    const std::string& texturePath
+                        = !resolvedPath.empty() ? resolvedPath : assetPath;
+                    texturePaths.insert(texturePath);
+                    const HdVP2TextureInfo& info = _AcquireTexture(texturePath);
 
                     MHWRender::MTextureAssignment assignment;
                     assignment.texture = info._texture.get();
@@ -2279,20 +2587,61 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
             }
         }
     }
+
+    // A texture whose path changed while it was loading is no longer waited for, and its
+    // placeholder is released.
+    for (auto it = _pendingTextures.begin(); it != _pendingTextures.end();) {
+        if (texturePaths.count(*it) == 0) {
+            _DecodedImageCache::Get().Release(*it);
+            _textureMap.erase(*it);
+            it = _pendingTextures.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 /*! \brief  Acquires a texture for the given image path.
- */
+
+    When textures are loaded asynchronously, a placeholder texture is returned until the image
+    has been decoded. The material is then synced again by the render delegate to acquire the
+    actual texture.
+*/
 const HdVP2TextureInfo& HdVP2Material::_AcquireTexture(const std::string& path)
 {
     const auto it = _textureMap.find(path);
-    if (it != _textureMap.end()) {
+    if (it != _textureMap.end() && _pendingTextures.count(path) == 0) {
         return it->second;
     }
 
     bool                 isSRGB = false;
     MFloatArray          uvScaleOffset;
-    MHWRender::MTexture* texture = _LoadTexture(path, isSRGB, uvScaleOffset);
+    MHWRender::MTexture* texture = nullptr;
+
+    if (_IsAsyncTextureLoadingEnabled() && !_IsUdimTexture(path)) {
+        _DecodedImageSharedPtr image;
+        const bool             isWaiting = _pendingTextures.count(path) > 0;
+        if (!_DecodedImageCache::Get().RequestAsync(path, isWaiting, image)) {
+            _pendingTextures.insert(path);
+            _renderDelegate->AddMaterialWithPendingTextures(GetId());
+
+            if (it != _textureMap.end()) {
+                return it->second;
+            }
+
+            HdVP2TextureInfo& info = _textureMap[path];
+            info._texture.reset(_AcquirePlaceholderTexture());
+            return info;
+        }
+
+        _pendingTextures.erase(path);
+        if (image) {
+            isSRGB = image->_isColorSpaceSRGB;
+            texture = _CreateTexture(path, *image);
+        }
+    } else {
+        texture = _LoadTexture(path, isSRGB, uvScaleOffset);
+    }
 
     HdVP2TextureInfo& info = _textureMap[path];
     info._texture.reset(texture);
@@ -2306,6 +2655,19 @@ const HdVP2TextureInfo& HdVP2Material::_AcquireTexture(const std::string& path)
     return info;
 }
 
+/*! \brief  Returns whether any of the textures shown as placeholders has finished loading.
+ */
+bool HdVP2Material::HasLoadedPendingTextures() const
+{
+    const _DecodedImageCache& cache = _DecodedImageCache::Get();
+    for (const std::string& path : _pendingTextures) {
+        if (!cache.IsPending(path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
 
 void HdVP2Material::SubscribeForMaterialUpdates(const SdfPath& rprimId)
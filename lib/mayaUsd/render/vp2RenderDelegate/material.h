@@ -27,6 +27,7 @@
 #include <mutex>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 
 // Workaround for a material consolidation update issue in VP2. Before USD 0.20.11, a Rprim will be
 // recreated if its material has any change, so everything gets refreshed and the update issue gets
@@ -76,7 +77,7 @@ public:
     HdVP2Material(HdVP2RenderDelegate*, const SdfPath&);
 
     //! Destructor.
-    ~HdVP2Material() override = default;
+    ~HdVP2Material() override;
 
     void Sync(HdSceneDelegate*, HdRenderParam*, HdDirtyBits*) override;
 
@@ -92,6 +93,9 @@ public:
     //! Get primvar tokens required by this material.
     const TfTokenVector& GetRequiredPrimvars() const { return _requiredPrimvars; }
 
+    //! Whether any texture shown as a placeholder has finished loading.
+    bool HasLoadedPendingTextures() const;
+
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
     //! The specified Rprim starts listening to changes on this material.
     void SubscribeForMaterialUpdates(const SdfPath& rprimId);
@@ -129,6 +133,10 @@ private:
     SdfPath              _surfaceShaderId;  //!< Path of the surface shader
     HdVP2TextureMap      _textureMap;       //!< Textures used by this material
     TfTokenVector        _requiredPrimvars; //!< primvars required by this material
+
+    //! Textures shown as placeholders while they are being loaded
+    std::unordered_set<std::string> _pendingTextures;
+
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
     //! Mutex protecting concurrent access to the Rprim set
     std::mutex _materialSubscriptionsMutex;
@@ -19,13 +19,18 @@
 #include "debugCodes.h"
 #include "instancer.h"
 #include "material.h"
+#include "meshTriangleOrder.h"
+#include "meshVertexLayout.h"
 #include "render_delegate.h"
 #include "tokens.h"
+#include "vertexBufferFill.h"
 
 #include <mayaUsd/render/vp2RenderDelegate/proxyRenderDelegate.h>
 #include <mayaUsd/utils/colorSpace.h>
+#include <mayaUsd/utils/traceProfiler.h>
 
 #include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/getenv.h>
 #include <pxr/imaging/hd/meshUtil.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
@@ -41,10 +46,21 @@
 #include <maya/MSelectionMask.h>
 
 #include <numeric>
-#include <type_traits>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_VP2_WELDED_VERTEX_LAYOUT,
+    true,
+    "With uniform or face-varying primvars, share the rendering vertices of the face vertices "
+    "having the same point and primvar values, instead of one rendering vertex per face vertex.");
+
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_VP2_OPTIMIZE_TRIANGLE_ORDER,
+    false,
+    "Reorder the triangles of meshes for the post-transform vertex cache of the GPU when their "
+    "topology changes, instead of drawing them in authored face order.");
+
 namespace {
 
 //! Required primvars when there is no material binding.
@@ -117,41 +133,40 @@ void _FillPrimvarData(
     size_t                   numVertices,
     size_t                   channelOffset,
     const VtIntArray&        renderingToSceneFaceVtxIds,
+    const VtIntArray&        renderingToSceneFaceVaryingIds,
+    const VtIntArray&        renderingToSceneFaceIds,
     const MString&           rprimId,
     const HdMeshTopology&    topology,
     const TfToken&           primvarName,
     const VtArray<SRC_TYPE>& primvarData,
     const HdInterpolation&   primvarInterp)
 {
+    namespace Fill = HdVP2VertexBufferFill;
+
     switch (primvarInterp) {
     case HdInterpolationConstant:
-        for (size_t v = 0; v < numVertices; v++) {
-            SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
-                reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
-            *pointer = primvarData[0];
-        }
+        Fill::Broadcast(vertexBuffer, numVertices, channelOffset, primvarData[0]);
         break;
     case HdInterpolationVarying:
     case HdInterpolationVertex:
         if (numVertices <= renderingToSceneFaceVtxIds.size()) {
-            const unsigned int dataSize = primvarData.size();
-            for (size_t v = 0; v < numVertices; v++) {
-                unsigned int index = renderingToSceneFaceVtxIds[v];
-                if (index < dataSize) {
-                    SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
-                        reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
-                    *pointer = primvarData[index];
-                } else {
-                    TF_DEBUG(HDVP2_DEBUG_MESH)
-                        .Msg(
-                            "Invalid Hydra prim '%s': "
-                            "primvar %s has %u elements, while its topology "
-                            "references face vertex index %u.\n",
-                            rprimId.asChar(),
-                            primvarName.GetText(),
-                            dataSize,
-                            index);
-                }
+            const size_t numSkipped = Fill::Gather(
+                vertexBuffer,
+                numVertices,
+                channelOffset,
+                primvarData.cdata(),
+                primvarData.size(),
+                renderingToSceneFaceVtxIds.cdata());
+            if (numSkipped > 0) {
+                TF_DEBUG(HDVP2_DEBUG_MESH)
+                    .Msg(
+                        "Invalid Hydra prim '%s': "
+                        "primvar %s has %zu elements, while its topology "
+                        "references %zu face vertex indices out of range.\n",
+                        rprimId.asChar(),
+                        primvarName.GetText(),
+                        primvarData.size(),
+                        numSkipped);
             }
         } else {
             TF_CODING_ERROR(
@@ -183,13 +198,25 @@ void _FillPrimvarData(
                         numFaces);
             }
 
-            for (size_t f = 0, v = 0; f < numFaces; f++) {
-                const size_t faceVertexCount = faceVertexCounts[f];
-                const size_t faceVertexEnd = v + faceVertexCount;
-                for (; v < faceVertexEnd; v++) {
-                    SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
-                        reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
-                    *pointer = primvarData[f];
+            if (!renderingToSceneFaceIds.empty()) {
+                // With the welded vertex layout, the faces sharing a rendering
+                // vertex have the same value, that of the face it was created for.
+                const size_t numSkipped = Fill::Gather(
+                    vertexBuffer,
+                    numVertices,
+                    channelOffset,
+                    primvarData.cdata(),
+                    primvarData.size(),
+                    renderingToSceneFaceIds.cdata());
+                TF_VERIFY(numSkipped == 0);
+            } else {
+                char* const channel = Fill::Channel(vertexBuffer, channelOffset);
+                for (size_t f = 0, v = 0; f < numFaces; f++) {
+                    const size_t faceVertexCount = faceVertexCounts[f];
+                    const size_t faceVertexEnd = v + faceVertexCount;
+                    for (; v < faceVertexEnd; v++) {
+                        memcpy(channel + v * sizeof(DEST_TYPE), &primvarData[f], sizeof(SRC_TYPE));
+                    }
                 }
             }
         } else {
@@ -209,17 +236,20 @@ void _FillPrimvarData(
         }
         break;
     }
-    case HdInterpolationFaceVarying:
-        // Unshared vertex layout is required for face-varying primvars, in
-        // this case renderingToSceneFaceVtxIds is a natural sequence starting
-        // from 0, thus we can save a lookup into the table. If the assumption
-        // about the natural sequence is changed, we will need the lookup and
-        // remap indices.
-        if (numVertices <= primvarData.size()) {
+    case HdInterpolationFaceVarying: {
+        // Unshared or welded vertex layout is required for face-varying
+        // primvars. With the unshared layout, rendering vertices are the
+        // scene face vertices in order, thus we can save a lookup into the
+        // table. With the welded layout, renderingToSceneFaceVaryingIds gives
+        // the face vertex each rendering vertex was created for.
+        const size_t numFaceVertices = renderingToSceneFaceVaryingIds.empty()
+            ? numVertices
+            : topology.GetFaceVertexIndices().size();
+        if (numFaceVertices <= primvarData.size()) {
             // If the primvar has more data than needed, we issue a warning,
             // but don't skip the primvar update. Truncate the buffer to the
             // expected length.
-            if (numVertices < primvarData.size()) {
+            if (numFaceVertices < primvarData.size()) {
                 TF_DEBUG(HDVP2_DEBUG_MESH)
                     .Msg(
                         "Invalid Hydra prim '%s': "
@@ -228,18 +258,20 @@ void _FillPrimvarData(
                         rprimId.asChar(),
                         primvarName.GetText(),
                         primvarData.size(),
-                        numVertices);
+                        numFaceVertices);
             }
 
-            if (channelOffset == 0 && std::is_same<DEST_TYPE, SRC_TYPE>::value) {
-                const void* source = static_cast<const void*>(primvarData.cdata());
-                memcpy(vertexBuffer, source, sizeof(DEST_TYPE) * numVertices);
+            if (!renderingToSceneFaceVaryingIds.empty()) {
+                const size_t numSkipped = Fill::Gather(
+                    vertexBuffer,
+                    numVertices,
+                    channelOffset,
+                    primvarData.cdata(),
+                    primvarData.size(),
+                    renderingToSceneFaceVaryingIds.cdata());
+                TF_VERIFY(numSkipped == 0);
             } else {
-                for (size_t v = 0; v < numVertices; v++) {
-                    SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
-                        reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
-                    *pointer = primvarData[v];
-                }
+                Fill::Copy(vertexBuffer, numVertices, channelOffset, primvarData.cdata());
             }
         } else {
             // It is unexpected to have less data than we index into. Issue
@@ -252,11 +284,12 @@ void _FillPrimvarData(
                     rprimId.asChar(),
                     primvarName.GetText(),
                     primvarData.size(),
-                    numVertices);
+                    numFaceVertices);
 
             memset(vertexBuffer, 0, sizeof(DEST_TYPE) * numVertices);
         }
         break;
+    }
     default:
         TF_CODING_ERROR(
             "Invalid Hydra prim '%s': "
@@ -283,6 +316,52 @@ bool _IsUnsharedVertexLayoutRequired(const PrimvarInfoMap& primvarInfo)
     return false;
 }
 
+template <typename T>
+bool _GetArrayBytes(const VtValue& value, HdVP2WeldedPrimvar* primvar, size_t* size)
+{
+    if (!value.IsHolding<VtArray<T>>()) {
+        return false;
+    }
+    const VtArray<T>& array = value.UncheckedGet<VtArray<T>>();
+    primvar->data = reinterpret_cast<const char*>(array.cdata());
+    primvar->elementSize = sizeof(T);
+    *size = array.size();
+    return true;
+}
+
+//! Collects the uniform and face-varying primvars which the welded vertex
+//! layout depends on. Returns false if one of them has an unsupported type or
+//! less data than the topology requires, the unshared layout is used instead.
+bool _GetWeldedPrimvars(
+    const PrimvarInfoMap&            primvarInfo,
+    const HdMeshTopology&            topology,
+    std::vector<HdVP2WeldedPrimvar>* primvars)
+{
+    for (const auto& it : primvarInfo) {
+        const HdInterpolation interp = it.second->_source.interpolation;
+        if (interp != HdInterpolationUniform && interp != HdInterpolationFaceVarying) {
+            continue;
+        }
+
+        const VtValue&     value = it.second->_source.data;
+        HdVP2WeldedPrimvar primvar;
+        size_t             size = 0;
+        const bool         supported = _GetArrayBytes<float>(value, &primvar, &size)
+            || _GetArrayBytes<GfVec2f>(value, &primvar, &size)
+            || _GetArrayBytes<GfVec3f>(value, &primvar, &size)
+            || _GetArrayBytes<GfVec4f>(value, &primvar, &size)
+            || _GetArrayBytes<int>(value, &primvar, &size);
+        primvar.uniform = (interp == HdInterpolationUniform);
+        const size_t requiredSize = primvar.uniform ? topology.GetFaceVertexCounts().size()
+                                                    : topology.GetFaceVertexIndices().size();
+        if (!supported || size < requiredSize) {
+            return false;
+        }
+        primvars->push_back(primvar);
+    }
+    return true;
+}
+
 //! Helper utility function to get number of edge indices
 unsigned int _GetNumOfEdgeIndices(const HdMeshTopology& topology)
 {
@@ -437,7 +516,7 @@ void HdVP2Mesh::_CommitMVertexBuffer(MHWRender::MVertexBuffer* const buffer, voi
     const MString& rprimId = _rprimId;
 
     _delegate->GetVP2ResourceRegistry().EnqueueCommit([buffer, bufferData, rprimId]() {
-        MProfilingScope profilingScope(
+        MayaUsd::ProfilingScope profilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorC_L2,
             "CommitBuffer",
@@ -492,18 +571,35 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
             }
             if (computeCPUNormals) {
                 // note: normals gets dirty when points are marked as dirty,
-                // at change tracker.
-                Hd_VertexAdjacencySharedPtr adjacency(new Hd_VertexAdjacency());
-                HdBufferSourceSharedPtr     adjacencyComputation
-                    = adjacency->GetSharedAdjacencyBuilderComputation(&_meshSharedData->_topology);
-                adjacencyComputation->Resolve();
+                // at change tracker. Adjacency only depends on topology, so it
+                // is cached in the shared data and reused for deforming meshes.
+                if (!_meshSharedData->_adjacency) {
+                    MayaUsd::ProfilingScope profilingScope(
+                        HdVP2RenderDelegate::sProfilerCategory,
+                        MProfiler::kColorC_L2,
+                        _rprimId.asChar(),
+                        "HdVP2Mesh::BuildVertexAdjacency");
+
+                    Hd_VertexAdjacencySharedPtr adjacency(new Hd_VertexAdjacency());
+                    HdBufferSourceSharedPtr     adjacencyComputation
+                        = adjacency->GetSharedAdjacencyBuilderComputation(
+                            &_meshSharedData->_topology);
+                    adjacencyComputation->Resolve();
+                    _meshSharedData->_adjacency = adjacency;
+                }
+
+                MayaUsd::ProfilingScope profilingScope(
+                    HdVP2RenderDelegate::sProfilerCategory,
+                    MProfiler::kColorC_L2,
+                    _rprimId.asChar(),
+                    "HdVP2Mesh::ComputeSmoothNormals");
 
                 // Only the points referenced by the topology are used to compute
-                // smooth normals.
-                VtValue normals(Hd_SmoothNormals::ComputeSmoothNormals(
-                    adjacency.get(),
-                    _points(_meshSharedData->_primvarInfo).size(),
-                    _points(_meshSharedData->_primvarInfo).cdata()));
+                // smooth normals. The computation is split over the points with
+                // WorkParallelForN by Hd_SmoothNormals.
+                const VtVec3fArray points = _points(_meshSharedData->_primvarInfo);
+                VtValue            normals(Hd_SmoothNormals::ComputeSmoothNormals(
+                    _meshSharedData->_adjacency.get(), points.size(), points.cdata()));
 
                 if (!normalsInfo) {
                     _meshSharedData->_primvarInfo[HdTokens->normals]
@@ -603,6 +699,8 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
                     _meshSharedData->_numVertices,
                     0,
                     _meshSharedData->_renderingToSceneFaceVtxIds,
+                    _meshSharedData->_renderingToSceneFaceVaryingIds,
+                    _meshSharedData->_renderingToSceneFaceIds,
                     _rprimId,
                     _meshSharedData->_topology,
                     HdTokens->displayColor,
@@ -614,6 +712,8 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
                     _meshSharedData->_numVertices,
                     3,
                     _meshSharedData->_renderingToSceneFaceVtxIds,
+                    _meshSharedData->_renderingToSceneFaceVaryingIds,
+                    _meshSharedData->_renderingToSceneFaceIds,
                     _rprimId,
                     _meshSharedData->_topology,
                     HdTokens->displayOpacity,
@@ -679,6 +779,8 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
                             _meshSharedData->_numVertices,
                             0,
                             _meshSharedData->_renderingToSceneFaceVtxIds,
+                            _meshSharedData->_renderingToSceneFaceVaryingIds,
+                            _meshSharedData->_renderingToSceneFaceIds,
                             _rprimId,
                             _meshSharedData->_topology,
                             token,
@@ -705,6 +807,8 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
                             _meshSharedData->_numVertices,
                             0,
                             _meshSharedData->_renderingToSceneFaceVtxIds,
+                            _meshSharedData->_renderingToSceneFaceVaryingIds,
+                            _meshSharedData->_renderingToSceneFaceIds,
                             _rprimId,
                             _meshSharedData->_topology,
                             token,
@@ -731,6 +835,8 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
                             _meshSharedData->_numVertices,
                             0,
                             _meshSharedData->_renderingToSceneFaceVtxIds,
+                            _meshSharedData->_renderingToSceneFaceVaryingIds,
+                            _meshSharedData->_renderingToSceneFaceIds,
                             _rprimId,
                             _meshSharedData->_topology,
                             token,
@@ -757,6 +863,8 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
                             _meshSharedData->_numVertices,
                             0,
                             _meshSharedData->_renderingToSceneFaceVtxIds,
+                            _meshSharedData->_renderingToSceneFaceVaryingIds,
+                            _meshSharedData->_renderingToSceneFaceIds,
                             _rprimId,
                             _meshSharedData->_topology,
                             token,
@@ -791,6 +899,8 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
                             _meshSharedData->_numVertices,
                             0,
                             _meshSharedData->_renderingToSceneFaceVtxIds,
+                            _meshSharedData->_renderingToSceneFaceVaryingIds,
+                            _meshSharedData->_renderingToSceneFaceIds,
                             _rprimId,
                             _meshSharedData->_topology,
                             token,
@@ -855,7 +965,7 @@ void HdVP2Mesh::Sync(
         return;
     }
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorC_L2,
         _rprimId.asChar(),
@@ -884,6 +994,9 @@ void HdVP2Mesh::Sync(
 
         _meshSharedData->_topology = GetMeshTopology(delegate);
 
+        // The cached adjacency refers to the previous topology.
+        _meshSharedData->_adjacency.reset();
+
         // subscribe to material updates from the new geom subset materials
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
         for (const auto& geomSubset : _meshSharedData->_topology.GetGeomSubsets()) {
@@ -976,7 +1089,34 @@ void HdVP2Mesh::Sync(
         _UpdatePrimvarSources(delegate, *dirtyBits, _meshSharedData->_allRequiredPrimvars);
     }
 
-    if (HdChangeTracker::IsTopologyDirty(*dirtyBits, id)) {
+    // The welded vertex layout depends on the values of the uniform and face-varying primvars.
+    // When they change, the layout is built again unless it still holds, and the draw items
+    // then need their index buffers to be updated as if the topology changed.
+    bool vertexLayoutDirty = HdChangeTracker::IsTopologyDirty(*dirtyBits, id);
+    if (!vertexLayoutDirty && !_meshSharedData->_renderingToSceneFaceVaryingIds.empty()
+        && (*dirtyBits & (HdChangeTracker::DirtyPrimvar | HdChangeTracker::DirtyNormals))) {
+        std::vector<HdVP2WeldedPrimvar> weldedPrimvars;
+        HdVP2WeldedVertexLayout         weldedLayout;
+        weldedLayout.renderingFaceVertexIndices
+            = _meshSharedData->_renderingTopology.GetFaceVertexIndices();
+        weldedLayout.renderingToSceneFaceVaryingIds
+            = _meshSharedData->_renderingToSceneFaceVaryingIds;
+        weldedLayout.renderingToSceneFaceIds = _meshSharedData->_renderingToSceneFaceIds;
+        vertexLayoutDirty = !_GetWeldedPrimvars(
+                                _meshSharedData->_primvarInfo,
+                                _meshSharedData->_topology,
+                                &weldedPrimvars)
+            || weldedPrimvars.empty()
+            || !weldedLayout.IsValid(_meshSharedData->_topology, weldedPrimvars);
+        if (vertexLayoutDirty) {
+            const HdDirtyBits vertexBufferBits = HdChangeTracker::DirtyPoints
+                | HdChangeTracker::DirtyNormals | HdChangeTracker::DirtyPrimvar;
+            *dirtyBits |= vertexBufferBits;
+            _SetDirtyRenderItems(vertexBufferBits | HdChangeTracker::DirtyTopology);
+        }
+    }
+
+    if (vertexLayoutDirty) {
         const HdMeshTopology& topology = _meshSharedData->_topology;
         const VtIntArray&     faceVertexIndices = topology.GetFaceVertexIndices();
         const size_t          numFaceVertexIndices = faceVertexIndices.size();
@@ -984,7 +1124,41 @@ void HdVP2Mesh::Sync(
         VtIntArray newFaceVertexIndices;
         newFaceVertexIndices.resize(numFaceVertexIndices);
 
-        if (_IsUnsharedVertexLayoutRequired(_meshSharedData->_primvarInfo)) {
+        _meshSharedData->_renderingToSceneFaceVaryingIds.clear();
+        _meshSharedData->_renderingToSceneFaceIds.clear();
+
+        // The welded layout falls back to the unshared one when it is disabled,
+        // when a primvar can't be welded, or with GPU compute, which is written
+        // for the unshared layout.
+        const bool unsharedLayoutRequired
+            = _IsUnsharedVertexLayoutRequired(_meshSharedData->_primvarInfo);
+        bool useWeldedLayout
+            = unsharedLayoutRequired && TfGetEnvSetting(MAYAUSD_VP2_WELDED_VERTEX_LAYOUT);
+#ifdef HDVP2_ENABLE_GPU_COMPUTE
+        useWeldedLayout = useWeldedLayout && _gpuNormalsComputeThreshold == SIZE_MAX;
+#endif
+        std::vector<HdVP2WeldedPrimvar> weldedPrimvars;
+        useWeldedLayout = useWeldedLayout
+            && _GetWeldedPrimvars(_meshSharedData->_primvarInfo, topology, &weldedPrimvars);
+
+        if (useWeldedLayout) {
+            MayaUsd::ProfilingScope profilingScope(
+                HdVP2RenderDelegate::sProfilerCategory,
+                MProfiler::kColorC_L2,
+                _rprimId.asChar(),
+                "HdVP2Mesh::BuildWeldedVertexLayout");
+
+            HdVP2WeldedVertexLayout weldedLayout;
+            weldedLayout.Build(topology, weldedPrimvars);
+
+            _meshSharedData->_numVertices = weldedLayout.GetNumVertices();
+            _meshSharedData->_renderingToSceneFaceVtxIds = weldedLayout.renderingToScenePoints;
+            _meshSharedData->_sceneToRenderingFaceVtxIds.swap(weldedLayout.sceneToRenderingPoints);
+            _meshSharedData->_renderingToSceneFaceVaryingIds
+                = weldedLayout.renderingToSceneFaceVaryingIds;
+            _meshSharedData->_renderingToSceneFaceIds = weldedLayout.renderingToSceneFaceIds;
+            newFaceVertexIndices = weldedLayout.renderingFaceVertexIndices;
+        } else if (unsharedLayoutRequired) {
             _meshSharedData->_numVertices = numFaceVertexIndices;
             _meshSharedData->_renderingToSceneFaceVtxIds = faceVertexIndices;
             _meshSharedData->_sceneToRenderingFaceVtxIds.clear();
@@ -1054,6 +1228,29 @@ void HdVP2Mesh::Sync(
             &_meshSharedData->_primitiveParam,
             nullptr);
 
+        // Geom subsets pick their triangles from the full triangulation, so
+        // they keep the optimized order too.
+        if (TfGetEnvSetting(MAYAUSD_VP2_OPTIMIZE_TRIANGLE_ORDER)) {
+            MayaUsd::ProfilingScope profilingScope(
+                HdVP2RenderDelegate::sProfilerCategory,
+                MProfiler::kColorC_L2,
+                _rprimId.asChar(),
+                "HdVP2Mesh::OptimizeTriangleOrder");
+
+            const VtVec3iArray&    triangles = _meshSharedData->_trianglesFaceVertexIndices;
+            const VtIntArray&      primitiveParam = _meshSharedData->_primitiveParam;
+            const std::vector<int> order = HdVP2TriangleOrder::Compute(triangles);
+
+            VtVec3iArray orderedTriangles(order.size());
+            VtIntArray   orderedPrimitiveParam(order.size());
+            for (size_t i = 0; i < order.size(); i++) {
+                orderedTriangles[i] = triangles[order[i]];
+                orderedPrimitiveParam[i] = primitiveParam[order[i]];
+            }
+            _meshSharedData->_trianglesFaceVertexIndices.swap(orderedTriangles);
+            _meshSharedData->_primitiveParam.swap(orderedPrimitiveParam);
+        }
+
         // Decide if we should use GPU compute, and set up compute objects for later user
 #ifdef HDVP2_ENABLE_GPU_COMPUTE
         _gpuNormalsEnabled
@@ -1878,7 +2075,8 @@ void HdVP2Mesh::_UpdateDrawItem(
     // If the mesh is instanced, create one new instance per transform.
     // The current instancer invalidation tracking makes it hard for
     // us to tell whether transforms will be dirty, so this code
-    // pulls them every time something changes.
+    // pulls them every time something changes. The instancer composes them
+    // once per sync of its primvars, so pulling them only looks them up.
     // If the mesh is instanced but has 0 instance transforms remember that
     // so the render item can be hidden.
 
@@ -2044,7 +2242,7 @@ void HdVP2Mesh::_UpdateDrawItem(
             if (ARCH_UNLIKELY(!renderItem))
                 return;
 
-            MProfilingScope profilingScope(
+            MayaUsd::ProfilingScope profilingScope(
                 HdVP2RenderDelegate::sProfilerCategory,
                 MProfiler::kColorC_L2,
                 renderItem->name().asChar(),
@@ -2235,6 +2433,27 @@ void HdVP2Mesh::_HideAllDrawItems(const TfToken& reprToken)
     }
 }
 
+//! Adds dirty bits to the render items of every repr, for changes found during Sync.
+void HdVP2Mesh::_SetDirtyRenderItems(HdDirtyBits bits)
+{
+    for (const std::pair<TfToken, HdReprSharedPtr>& pair : _reprs) {
+        const HdReprSharedPtr& repr = pair.second;
+        const auto&            items = repr->GetDrawItems();
+#if HD_API_VERSION < 35
+        for (HdDrawItem* item : items) {
+            if (HdVP2DrawItem* drawItem = static_cast<HdVP2DrawItem*>(item)) {
+#else
+        for (const HdRepr::DrawItemUniquePtr& item : items) {
+            if (HdVP2DrawItem* const drawItem = static_cast<HdVP2DrawItem*>(item.get())) {
+#endif
+                for (auto& renderItemData : drawItem->GetRenderItems()) {
+                    renderItemData.SetDirtyBits(bits);
+                }
+            }
+        }
+    }
+}
+
 #ifdef HDVP2_ENABLE_GPU_COMPUTE
 /*! \brief  Save topology information for later GPGPU evaluation
 
@@ -2256,7 +2475,7 @@ void HdVP2Mesh::_CreateOSDTables()
 #if defined(DO_CPU_OSD) || defined(DO_OPENGL_OSD)
 
     assert(_meshSharedData->_viewportCompute);
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "createOSDTables");
 
     // create topology refiner
@@ -2294,7 +2513,7 @@ void HdVP2Mesh::_CreateOSDTables()
 
         // split trace scopes.
         {
-            MProfilingScope subProfilingScope(
+            MayaUsd::ProfilingScope subProfilingScope(
                 HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "refine");
             if (_meshSharedData->_viewportCompute->adaptive) {
                 OpenSubdiv::Far::TopologyRefiner::AdaptiveOptions adaptiveOptions(
@@ -2310,7 +2529,7 @@ void HdVP2Mesh::_CreateOSDTables()
 #define GENERATE_SOURCE_TABLES
 #ifdef GENERATE_SOURCE_TABLES
         {
-            MProfilingScope subProfilingScope(
+            MayaUsd::ProfilingScope subProfilingScope(
                 HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "stencilFactory");
             OpenSubdiv::Far::StencilTableFactory::Options options;
             options.generateOffsets = true;
@@ -2322,7 +2541,7 @@ void HdVP2Mesh::_CreateOSDTables()
             varyingStencils = OpenSubdiv::Far::StencilTableFactory::Create(*refiner, options);
         }
         {
-            MProfilingScope subProfilingScope(
+            MayaUsd::ProfilingScope subProfilingScope(
                 HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "patchFactory");
             patchTable = OpenSubdiv::Far::PatchTableFactory::Create(*refiner, patchOptions);
         }
@@ -24,6 +24,7 @@
 #include <mayaUsd/render/vp2RenderDelegate/proxyRenderDelegate.h>
 
 #include <pxr/imaging/hd/mesh.h>
+#include <pxr/imaging/hd/vertexAdjacency.h>
 #include <pxr/pxr.h>
 
 #include <maya/MHWGeometry.h>
@@ -60,6 +61,11 @@ struct HdVP2MeshSharedData
     //! face vertex index.
     std::vector<int> _sceneToRenderingFaceVtxIds;
 
+    //! With the welded vertex layout, the scene face vertex and the face each
+    //! rendering vertex was created for. Both are empty with the other layouts.
+    VtIntArray _renderingToSceneFaceVaryingIds;
+    VtIntArray _renderingToSceneFaceIds;
+
     //! triangulation of the _renderingTopology
     VtVec3iArray _trianglesFaceVertexIndices;
 
@@ -67,6 +73,11 @@ struct HdVP2MeshSharedData
     //! HdMeshUtil::DecodeFaceIndexFromCoarseFaceParam when accessing.
     VtIntArray _primitiveParam;
 
+    //! Vertex adjacency of _topology used to compute smooth normals on CPU. It
+    //! only depends on topology, so it is built lazily and released whenever
+    //! topology is dirty instead of being rebuilt each time points change.
+    Hd_VertexAdjacencySharedPtr _adjacency;
+
     //! Map from the original topology faceId to the void* pointer to
     //! the MRenderItem that face is a part of
     std::vector<void*> _faceIdToRenderItem;
@@ -147,6 +158,7 @@ private:
         const TfToken&        reprToken);
 
     void _HideAllDrawItems(const TfToken& reprToken);
+    void _SetDirtyRenderItems(HdDirtyBits bits);
 
     void _UpdatePrimvarSources(
         HdSceneDelegate*     sceneDelegate,
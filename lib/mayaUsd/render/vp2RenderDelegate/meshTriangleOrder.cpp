@@ -0,0 +1,281 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "meshTriangleOrder.h"
+
+#include <pxr/base/gf/vec3i.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+using HdVP2TriangleOrder::kCacheSize;
+
+// Scoring parameters from the paper.
+constexpr float _kCacheDecayPower = 1.5f;
+constexpr float _kLastTriangleScore = 0.75f;
+constexpr float _kValenceBoostScale = 2.0f;
+constexpr float _kValenceBoostPower = 0.5f;
+
+//! Number of triangles left from which the valence boost is computed rather
+//! than looked up.
+constexpr int _kValenceTableSize = 32;
+
+//! Scores of the positions in the cache and of the numbers of triangles left.
+struct _ScoreTables
+{
+    float cachePosition[kCacheSize];
+    float valence[_kValenceTableSize];
+
+    _ScoreTables()
+    {
+        for (size_t i = 0; i < kCacheSize; i++) {
+            if (i < 3) {
+                // The vertices of the last triangle get the same score, as
+                // the order they were used in within it doesn't matter.
+                cachePosition[i] = _kLastTriangleScore;
+            } else {
+                const float scaler = 1.0f / (kCacheSize - 3);
+                cachePosition[i] = std::pow(1.0f - (i - 3) * scaler, _kCacheDecayPower);
+            }
+        }
+        for (int i = 0; i < _kValenceTableSize; i++) {
+            valence[i] = _ValenceScore(i);
+        }
+    }
+
+    static float _ValenceScore(int numTrianglesLeft)
+    {
+        return _kValenceBoostScale * std::pow(float(numTrianglesLeft), -_kValenceBoostPower);
+    }
+
+    //! Returns the score of a vertex. Vertices with few triangles left get a
+    //! boost, so that they are finished rather than left as lone triangles.
+    float VertexScore(int cachePos, int numTrianglesLeft) const
+    {
+        if (numTrianglesLeft == 0) {
+            return -1.0f;
+        }
+
+        float score = cachePos < 0 ? 0.0f : cachePosition[cachePos];
+        score += numTrianglesLeft < _kValenceTableSize ? valence[numTrianglesLeft]
+                                                       : _ValenceScore(numTrianglesLeft);
+        return score;
+    }
+};
+
+bool _IsValid(const GfVec3i& triangle)
+{
+    return triangle[0] >= 0 && triangle[1] >= 0 && triangle[2] >= 0;
+}
+
+//! Returns one more than the largest vertex index of the valid triangles.
+size_t _GetNumVertices(const VtVec3iArray& triangles)
+{
+    int maxIndex = -1;
+    for (const GfVec3i& triangle : triangles) {
+        if (_IsValid(triangle)) {
+            maxIndex = std::max(
+                maxIndex, std::max(triangle[0], std::max(triangle[1], triangle[2])));
+        }
+    }
+    return static_cast<size_t>(maxIndex + 1);
+}
+
+} // namespace
+
+namespace HdVP2TriangleOrder {
+
+std::vector<int> Compute(const VtVec3iArray& triangles)
+{
+    static const _ScoreTables scoreTables;
+
+    const size_t numTriangles = triangles.size();
+    const size_t numVertices = _GetNumVertices(triangles);
+
+    // The triangles left to emit around each vertex, stored contiguously per
+    // vertex. A triangle is swapped to the end of the range of each of its
+    // vertices when it is emitted.
+    std::vector<int> adjacencyOffsets(numVertices + 1, 0);
+    size_t           numValidTriangles = 0;
+    for (const GfVec3i& triangle : triangles) {
+        if (_IsValid(triangle)) {
+            numValidTriangles++;
+            for (int k = 0; k < 3; k++) {
+                adjacencyOffsets[triangle[k] + 1]++;
+            }
+        }
+    }
+    for (size_t v = 0; v < numVertices; v++) {
+        adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+
+    std::vector<int> numTrianglesLeft(numVertices, 0);
+    std::vector<int> adjacency(adjacencyOffsets[numVertices]);
+    for (size_t t = 0; t < numTriangles; t++) {
+        const GfVec3i& triangle = triangles[t];
+        if (_IsValid(triangle)) {
+            for (int k = 0; k < 3; k++) {
+                const int v = triangle[k];
+                adjacency[adjacencyOffsets[v] + numTrianglesLeft[v]++] = static_cast<int>(t);
+            }
+        }
+    }
+
+    std::vector<float> vertexScores(numVertices);
+    for (size_t v = 0; v < numVertices; v++) {
+        vertexScores[v] = scoreTables.VertexScore(-1, numTrianglesLeft[v]);
+    }
+
+    std::vector<float> triangleScores(numTriangles, 0.0f);
+    std::vector<bool>  emitted(numTriangles, false);
+    for (size_t t = 0; t < numTriangles; t++) {
+        const GfVec3i& triangle = triangles[t];
+        if (_IsValid(triangle)) {
+            for (int k = 0; k < 3; k++) {
+                triangleScores[t] += vertexScores[triangle[k]];
+            }
+        } else {
+            emitted[t] = true;
+        }
+    }
+
+    std::vector<int> order;
+    order.reserve(numTriangles);
+
+    // The cache holds up to kCacheSize vertices, and the 3 vertices of a new
+    // triangle while they push the oldest ones out.
+    int    cache[kCacheSize + 3];
+    size_t cacheCount = 0;
+
+    size_t nextTriangle = 0;
+    int    bestTriangle = -1;
+    while (order.size() < numValidTriangles) {
+        if (bestTriangle < 0) {
+            // None of the vertices in the cache has triangles left, so carry
+            // on with the next triangle in the authored order.
+            while (emitted[nextTriangle]) {
+                nextTriangle++;
+            }
+            bestTriangle = static_cast<int>(nextTriangle);
+        }
+
+        const GfVec3i& triangle = triangles[bestTriangle];
+        order.push_back(bestTriangle);
+        emitted[bestTriangle] = true;
+
+        for (int k = 0; k < 3; k++) {
+            const int  v = triangle[k];
+            int* const begin = adjacency.data() + adjacencyOffsets[v];
+            int* const end = begin + numTrianglesLeft[v];
+            int* const it = std::find(begin, end, bestTriangle);
+            if (it != end) {
+                std::swap(*it, *(end - 1));
+                numTrianglesLeft[v]--;
+            }
+        }
+
+        // Move the vertices of the triangle to the front of the cache.
+        int    newCache[kCacheSize + 3];
+        size_t newCacheCount = 0;
+        for (int k = 0; k < 3; k++) {
+            const int v = triangle[k];
+            if (std::find(newCache, newCache + newCacheCount, v) == newCache + newCacheCount) {
+                newCache[newCacheCount++] = v;
+            }
+        }
+        for (size_t i = 0; i < cacheCount; i++) {
+            const int v = cache[i];
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                newCache[newCacheCount++] = v;
+            }
+        }
+
+        // Update the scores of the vertices whose position in the cache or
+        // number of triangles left changed, and of their triangles.
+        for (size_t i = 0; i < newCacheCount; i++) {
+            const int v = newCache[i];
+            const int cachePos = i < kCacheSize ? static_cast<int>(i) : -1;
+
+            const float score = scoreTables.VertexScore(cachePos, numTrianglesLeft[v]);
+            const float scoreDelta = score - vertexScores[v];
+            vertexScores[v] = score;
+
+            const int* const begin = adjacency.data() + adjacencyOffsets[v];
+            const int* const end = begin + numTrianglesLeft[v];
+            for (const int* t = begin; t < end; t++) {
+                triangleScores[*t] += scoreDelta;
+            }
+        }
+
+        cacheCount = std::min(newCacheCount, kCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        // Pick the best triangle around the cache.
+        float bestScore = -1.0f;
+        bestTriangle = -1;
+        for (size_t i = 0; i < cacheCount; i++) {
+            const int        v = cache[i];
+            const int* const begin = adjacency.data() + adjacencyOffsets[v];
+            const int* const end = begin + numTrianglesLeft[v];
+            for (const int* t = begin; t < end; t++) {
+                if (triangleScores[*t] > bestScore) {
+                    bestScore = triangleScores[*t];
+                    bestTriangle = *t;
+                }
+            }
+        }
+    }
+
+    for (size_t t = 0; t < numTriangles; t++) {
+        if (!_IsValid(triangles[t])) {
+            order.push_back(static_cast<int>(t));
+        }
+    }
+    return order;
+}
+
+double ComputeACMR(const VtVec3iArray& triangles, size_t cacheSize)
+{
+    // A vertex is in the FIFO cache if fewer than cacheSize vertices were
+    // loaded since it was.
+    constexpr size_t    kNotLoaded = std::numeric_limits<size_t>::max();
+    std::vector<size_t> loadedAt(_GetNumVertices(triangles), kNotLoaded);
+
+    size_t numMisses = 0;
+    size_t numValidTriangles = 0;
+    for (const GfVec3i& triangle : triangles) {
+        if (!_IsValid(triangle)) {
+            continue;
+        }
+
+        numValidTriangles++;
+        for (int k = 0; k < 3; k++) {
+            size_t& vertexLoadedAt = loadedAt[triangle[k]];
+            if (vertexLoadedAt == kNotLoaded || numMisses - vertexLoadedAt >= cacheSize) {
+                vertexLoadedAt = numMisses++;
+            }
+        }
+    }
+    return numValidTriangles > 0 ? double(numMisses) / numValidTriangles : 0.0;
+}
+
+} // namespace HdVP2TriangleOrder
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,130 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "meshVertexLayout.h"
+
+#include <algorithm>
+#include <cstring>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+//! Returns true if two face vertices, given with their faces, have bitwise
+//! identical values for all the primvars.
+bool _HaveSameValues(
+    const std::vector<HdVP2WeldedPrimvar>& primvars,
+    size_t                                 faceVertexA,
+    size_t                                 faceA,
+    size_t                                 faceVertexB,
+    size_t                                 faceB)
+{
+    for (const HdVP2WeldedPrimvar& primvar : primvars) {
+        const size_t a = primvar.uniform ? faceA : faceVertexA;
+        const size_t b = primvar.uniform ? faceB : faceVertexB;
+        if (a != b
+            && memcmp(
+                   primvar.data + a * primvar.elementSize,
+                   primvar.data + b * primvar.elementSize,
+                   primvar.elementSize)
+                != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void HdVP2WeldedVertexLayout::Build(
+    const HdMeshTopology&                  topology,
+    const std::vector<HdVP2WeldedPrimvar>& primvars)
+{
+    const VtIntArray& faceVertexCounts = topology.GetFaceVertexCounts();
+    const VtIntArray& faceVertexIndices = topology.GetFaceVertexIndices();
+    const size_t      numFaceVertexIndices = faceVertexIndices.size();
+
+    // The arrays are filled as std::vectors and copied once, so that the
+    // VtArrays kept with the layout don't hold any extra capacity.
+    std::vector<int> points;
+    std::vector<int> faceVaryingIds;
+    std::vector<int> faceIds;
+
+    // The rendering vertices of a point are chained, starting from the last
+    // one created, which is the one the point maps to.
+    sceneToRenderingPoints.assign(topology.GetNumPoints(), -1);
+    std::vector<int> nextRenderingVtxIds;
+
+    renderingFaceVertexIndices.assign(numFaceVertexIndices, 0);
+    int* renderingFaceVertexIds = renderingFaceVertexIndices.data();
+
+    for (size_t f = 0, i = 0; f < faceVertexCounts.size(); f++) {
+        const size_t faceVertexEnd = std::min(i + faceVertexCounts[f], numFaceVertexIndices);
+        for (; i < faceVertexEnd; i++) {
+            const int point = faceVertexIndices[i];
+
+            int renderingVtxId = sceneToRenderingPoints[point];
+            while (renderingVtxId >= 0
+                   && !_HaveSameValues(
+                       primvars, i, f, faceVaryingIds[renderingVtxId], faceIds[renderingVtxId])) {
+                renderingVtxId = nextRenderingVtxIds[renderingVtxId];
+            }
+
+            if (renderingVtxId < 0) {
+                renderingVtxId = static_cast<int>(points.size());
+                points.push_back(point);
+                faceVaryingIds.push_back(static_cast<int>(i));
+                faceIds.push_back(static_cast<int>(f));
+                nextRenderingVtxIds.push_back(sceneToRenderingPoints[point]);
+                sceneToRenderingPoints[point] = renderingVtxId;
+            }
+
+            renderingFaceVertexIds[i] = renderingVtxId;
+        }
+    }
+
+    renderingToScenePoints.assign(points.begin(), points.end());
+    renderingToSceneFaceVaryingIds.assign(faceVaryingIds.begin(), faceVaryingIds.end());
+    renderingToSceneFaceIds.assign(faceIds.begin(), faceIds.end());
+}
+
+bool HdVP2WeldedVertexLayout::IsValid(
+    const HdMeshTopology&                  topology,
+    const std::vector<HdVP2WeldedPrimvar>& primvars) const
+{
+    const VtIntArray& faceVertexCounts = topology.GetFaceVertexCounts();
+    const size_t      numFaceVertexIndices = renderingFaceVertexIndices.size();
+    if (numFaceVertexIndices != topology.GetFaceVertexIndices().size()) {
+        return false;
+    }
+
+    for (size_t f = 0, i = 0; f < faceVertexCounts.size(); f++) {
+        const size_t faceVertexEnd = std::min(i + faceVertexCounts[f], numFaceVertexIndices);
+        for (; i < faceVertexEnd; i++) {
+            const int renderingVtxId = renderingFaceVertexIndices[i];
+            if (!_HaveSameValues(
+                    primvars,
+                    i,
+                    f,
+                    renderingToSceneFaceVaryingIds[renderingVtxId],
+                    renderingToSceneFaceIds[renderingVtxId])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,87 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_MESH_VERTEX_LAYOUT
+#define HD_VP2_MESH_VERTEX_LAYOUT
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/vt/types.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/pxr.h>
+
+#include <cstddef>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/*! \brief  The data of a uniform or face-varying primvar, compared to weld face vertices.
+    \class  HdVP2WeldedPrimvar
+
+    Face vertices are only welded when their values are bitwise identical, so
+    the data is compared as raw bytes, one element of elementSize bytes per
+    face for uniform primvars and per face vertex for face-varying primvars.
+*/
+struct HdVP2WeldedPrimvar
+{
+    const char* data { nullptr };
+    size_t      elementSize { 0 };
+    bool        uniform { false };
+};
+
+/*! \brief  Rendering vertices of a mesh with uniform or face-varying primvars.
+    \class  HdVP2WeldedVertexLayout
+
+    Vertex buffers can't be indexed per primvar, so a mesh with uniform or
+    face-varying primvars needs more rendering vertices than points. The
+    unshared layout creates one rendering vertex per face vertex. The welded
+    layout shares the rendering vertex of the face vertices of a point as long
+    as they have the same values for all the primvars, so that only the face
+    vertices along UV, color or normal seams are split.
+*/
+struct HdVP2WeldedVertexLayout
+{
+    //! The rendering vertex of each scene face vertex.
+    VtIntArray renderingFaceVertexIndices;
+
+    //! The scene point of each rendering vertex.
+    VtIntArray renderingToScenePoints;
+
+    //! The scene face vertex and the face each rendering vertex was created
+    //! for, to read the face-varying and uniform primvars from.
+    VtIntArray renderingToSceneFaceVaryingIds;
+    VtIntArray renderingToSceneFaceIds;
+
+    //! A rendering vertex of each scene point, -1 for unused points.
+    std::vector<int> sceneToRenderingPoints;
+
+    //! Builds the layout of topology for primvars.
+    MAYAUSD_CORE_PUBLIC
+    void Build(const HdMeshTopology& topology, const std::vector<HdVP2WeldedPrimvar>& primvars);
+
+    //! Returns true if the layout built for topology still holds for primvars,
+    //! i.e. every face vertex has the same values as the one its rendering
+    //! vertex was created for. The primvars may have changed since the build.
+    MAYAUSD_CORE_PUBLIC
+    bool IsValid(const HdMeshTopology& topology, const std::vector<HdVP2WeldedPrimvar>& primvars)
+        const;
+
+    //! The number of rendering vertices.
+    size_t GetNumVertices() const { return renderingToScenePoints.size(); }
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // HD_VP2_MESH_VERTEX_LAYOUT
@@ -20,6 +20,7 @@
 #include "render_delegate.h"
 
 #include <mayaUsd/render/vp2RenderDelegate/proxyRenderDelegate.h>
+#include <mayaUsd/utils/traceProfiler.h>
 
 #include <pxr/imaging/hd/vertexAdjacency.h>
 #include <pxr/imaging/pxOsd/refinerFactory.h>
@@ -164,7 +165,7 @@ void MeshViewportCompute::findConsolidationMapping(MRenderItem& renderItem)
         return;
     }
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:MGeometryIndexMapping");
@@ -208,7 +209,7 @@ void MeshViewportCompute::createConsolidatedTopology(TopologyAccessor getTopolog
         return;
     _topologyDirty = false;
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:createConsolidatedTopology");
@@ -344,7 +345,7 @@ void MeshViewportCompute::createConsolidatedAdjacency()
     if (_adjacencyBufferSize > 0)
         return;
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:createConsolidatedAdjacency");
@@ -365,7 +366,7 @@ void MeshViewportCompute::createConsolidatedAdjacency()
 
 void MeshViewportCompute::findRenderGeometry(MRenderItem& renderItem)
 {
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:findRenderGeometry");
@@ -384,7 +385,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
 {
 #if defined(DO_CPU_OSD) || defined(DO_OPENGL_OSD)
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:consolidatedOSDTables");
@@ -400,7 +401,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
         // if this is a consolidated item then we won't have any stencils or tables.
         // If this is an unconsolidated item then we'll already have the tables we need.
         if (!_vertexStencils || !_varyingStencils || !_patchTable) {
-            MProfilingScope subsubProfilingScope(
+            MayaUsd::ProfilingScope subsubProfilingScope(
                 HdVP2RenderDelegate::sProfilerCategory,
                 MProfiler::kColorD_L2,
                 "MeshViewportCompute:createConsolidatedMeshTables");
@@ -432,7 +433,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
 
                 // split trace scopes.
                 {
-                    MProfilingScope subsubsubProfilingScope(
+                    MayaUsd::ProfilingScope subsubsubProfilingScope(
                         HdVP2RenderDelegate::sProfilerCategory,
                         MProfiler::kColorD_L2,
                         "MeshViewportCompute:refine");
@@ -447,7 +448,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
                     }
                 }
                 {
-                    MProfilingScope subsubsubProfilingScope(
+                    MayaUsd::ProfilingScope subsubsubProfilingScope(
                         HdVP2RenderDelegate::sProfilerCategory,
                         MProfiler::kColorD_L2,
                         "MeshViewportCompute:stencilFactory");
@@ -465,7 +466,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
                         = OpenSubdiv::Far::StencilTableFactory::Create(*refiner, options);
                 }
                 {
-                    MProfilingScope subsubsubProfilingScope(
+                    MayaUsd::ProfilingScope subsubsubProfilingScope(
                         HdVP2RenderDelegate::sProfilerCategory,
                         MProfiler::kColorD_L2,
                         "MeshViewportCompute:patchFactory");
@@ -503,7 +504,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
     }
 
     if (_geometryIndexMapping && _geometryIndexMapping->geometryCount() > 0) {
-        MProfilingScope subsubProfilingScope(
+        MayaUsd::ProfilingScope subsubProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L2,
             "MeshViewportCompute:updateIndexMapping");
@@ -540,7 +541,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
         renderItem.setSourceIndexMapping(*_geometryIndexMapping.get());
     }
 
-    MProfilingScope subsubProfilingScope(
+    MayaUsd::ProfilingScope subsubProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:triangulateSmoothPatchTable");
@@ -570,7 +571,7 @@ void MeshViewportCompute::createConsolidatedOSDTables(MRenderItem& renderItem)
         memcpy(indices.data(), firstIndex, ptableSize * sizeof(int));
 
         {
-            MProfilingScope subsubProfilingScope(
+            MayaUsd::ProfilingScope subsubProfilingScope(
                 HdVP2RenderDelegate::sProfilerCategory,
                 MProfiler::kColorD_L1,
                 "MeshViewportCompute:createTriangleIndexBuffer");
@@ -619,7 +620,7 @@ void MeshViewportCompute::findVertexBuffers(MRenderItem& renderItem)
         return;
     }
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:findVertexBuffers");
@@ -630,14 +631,14 @@ void MeshViewportCompute::findVertexBuffers(MRenderItem& renderItem)
         const MVertexBufferDescriptor& descriptor = renderBuffer->descriptor();
 
         if (MGeometry::kPosition == descriptor.semantic()) {
-            MProfilingScope subsubProfilingScope(
+            MayaUsd::ProfilingScope subsubProfilingScope(
                 HdVP2RenderDelegate::sProfilerCategory,
                 MProfiler::kColorD_L2,
                 "MeshViewportCompute:positionBufferResourceHandle");
             TF_VERIFY(renderBuffer->vertexCount() == _vertexCount);
             _positionVertexBufferGPU = renderBuffer;
         } else if (MGeometry::kNormal == descriptor.semantic()) {
-            MProfilingScope subsubProfilingScope(
+            MayaUsd::ProfilingScope subsubProfilingScope(
                 HdVP2RenderDelegate::sProfilerCategory,
                 MProfiler::kColorD_L2,
                 "MeshViewportCompute:normalBufferResourceHandle");
@@ -651,7 +652,7 @@ void MeshViewportCompute::findVertexBuffers(MRenderItem& renderItem)
     }
 
     if (nullptr == _normalVertexBufferGPU) {
-        MProfilingScope subsubProfilingScope(
+        MayaUsd::ProfilingScope subsubProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L1,
             "MeshViewportCompute:createNormalBuffer");
@@ -678,7 +679,7 @@ void MeshViewportCompute::prepareAdjacencyBuffer()
         return;
     _adjacencyBufferGPUDirty = false;
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:prepareAdjacencyBuffer");
@@ -778,7 +779,7 @@ void MeshViewportCompute::initializeOpenGL()
 void MeshViewportCompute::compileNormalsProgram()
 {
 #if defined(HDVP2_OPENGL_NORMALS)
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:compileNormalsProgram");
@@ -813,7 +814,7 @@ void MeshViewportCompute::computeNormals()
         return;
     _normalVertexBufferGPUDirty = false;
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:computeNormals");
@@ -875,7 +876,7 @@ void MeshViewportCompute::computeNormals()
     cl_int              err;
 
     {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L2,
             "MeshViewportCompute:copyAdjacencyToOpenCL");
@@ -897,7 +898,7 @@ void MeshViewportCompute::computeNormals()
     }
 
     {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L2,
             "MeshViewportCompute:attachToGLBuffers");
@@ -930,7 +931,7 @@ void MeshViewportCompute::computeNormals()
     // acquire the shared buffers
     MAutoCLEvent acquireEvent;
     {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L2,
             "MeshViewportCompute:acquireSharedBuffers");
@@ -978,7 +979,7 @@ void MeshViewportCompute::computeNormals()
 
     cl_event* events = new cl_event[consolidatedItems.size()];
     {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L2,
             "MeshViewportCompute:enqueueKernels");
@@ -1043,7 +1044,7 @@ void MeshViewportCompute::computeNormals()
     // release the shared buffers
     MAutoCLEvent releaseEvent;
     {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L2,
             "MeshViewportCompute:releaseSharedBuffers");
@@ -1066,7 +1067,7 @@ void MeshViewportCompute::computeNormals()
 #endif
     }
     {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L3,
             "MeshViewportCompute:syncOpenCL");
@@ -1074,7 +1075,7 @@ void MeshViewportCompute::computeNormals()
     }
     delete[] events;
 
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L2,
         "MeshViewportCompute:releaseOpenCLBuffers");
@@ -1099,7 +1100,7 @@ void MeshViewportCompute::computeNormals()
 void MeshViewportCompute::computeOSD()
 {
 #if defined(DO_CPU_OSD) || defined(DO_OPENGL_OSD)
-    MProfilingScope subProfilingScope(
+    MayaUsd::ProfilingScope subProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "MeshViewportCompute:doOSD");
     // Inspired by HdSt_Osd3TopologyComputation::Resolve()
 
@@ -1272,7 +1273,7 @@ bool MeshViewportCompute::execute(
         return false;
     }
 
-    MProfilingScope mainProfilingScope(
+    MayaUsd::ProfilingScope mainProfilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L1,
         "MeshViewportCompute::execute");
@@ -22,6 +22,7 @@
 #include <mayaUsd/base/tokens.h>
 #include <mayaUsd/nodes/proxyShapeBase.h>
 #include <mayaUsd/nodes/stageData.h>
+#include <mayaUsd/utils/traceProfiler.h>
 #include <mayaUsd/utils/util.h>
 
 #include <pxr/base/tf/diagnostic.h>
@@ -316,8 +317,14 @@ public:
             return;
         }
 
+        // Scene changes from a single USD edit are batched in a composite
+        // notification, which may contain object additions.
         if (dynamic_cast<const Ufe::SelectionChanged*>(&notification)
-            || dynamic_cast<const Ufe::ObjectAdd*>(&notification)) {
+            || dynamic_cast<const Ufe::ObjectAdd*>(&notification)
+#ifdef UFE_V2_FEATURES_AVAILABLE
+            || dynamic_cast<const Ufe::SceneCompositeNotification*>(&notification)
+#endif
+        ) {
             _proxyRenderDelegate.SelectionChanged();
         }
     }
@@ -510,7 +517,7 @@ void ProxyRenderDelegate::_InitRenderDelegate()
     _proxyShapeData->UsdStageUpdated();
 
     if (!_renderDelegate) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L1,
             "Allocate VP2RenderDelegate");
@@ -518,7 +525,7 @@ void ProxyRenderDelegate::_InitRenderDelegate()
     }
 
     if (!_renderIndex) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L1, "Allocate RenderIndex");
         _renderIndex.reset(HdRenderIndex::New(_renderDelegate.get(), HdDriverVector()));
 
@@ -528,7 +535,7 @@ void ProxyRenderDelegate::_InitRenderDelegate()
     }
 
     if (!_sceneDelegate) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorD_L1,
             "Allocate SceneDelegate");
@@ -596,7 +603,7 @@ bool ProxyRenderDelegate::_Populate()
         return false;
 
     if (_proxyShapeData->UsdStage() && !_isPopulated) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L1, "Populate");
 
         // Remove any excluded prims before populating
@@ -623,11 +630,11 @@ void ProxyRenderDelegate::_UpdateSceneDelegate()
     if (!_sceneDelegate)
         return;
 
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorC_L1, "UpdateSceneDelegate");
 
     {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorC_L1, "SetTime");
 
         const UsdTimeCode timeCode = _proxyShapeData->ProxyShape()->getTime();
@@ -654,14 +661,14 @@ void ProxyRenderDelegate::_UpdateSceneDelegate()
 
     constexpr double tolerance = 1e-9;
     if (!GfIsClose(transform, _sceneDelegate->GetRootTransform(), tolerance)) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorC_L1, "SetRootTransform");
         _sceneDelegate->SetRootTransform(transform);
     }
 
     const bool isVisible = _proxyShapeData->ProxyDagPath().isVisible();
     if (isVisible != _sceneDelegate->GetRootVisibility()) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorC_L1, "SetRootVisibility");
         _sceneDelegate->SetRootVisibility(isVisible);
 
@@ -673,7 +680,7 @@ void ProxyRenderDelegate::_UpdateSceneDelegate()
 
     const int refineLevel = _proxyShapeData->ProxyShape()->getComplexity();
     if (refineLevel != _sceneDelegate->GetRefineLevelFallback()) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory,
             MProfiler::kColorC_L1,
             "SetRefineLevelFallback");
@@ -685,7 +692,7 @@ void ProxyRenderDelegate::_UpdateSceneDelegate()
 //! \brief  Execute Hydra engine to perform minimal VP2 draw data update based on change tracker.
 void ProxyRenderDelegate::_Execute(const MHWRender::MFrameContext& frameContext)
 {
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorC_L1, "Execute");
 
     _UpdateRenderTags();
@@ -782,13 +789,18 @@ void ProxyRenderDelegate::_Execute(const MHWRender::MFrameContext& frameContext)
         _taskController->SetCollection(*_defaultCollection);
     }
 
+    // Materials waiting for textures decoded in the background have to be synced again once the
+    // textures are ready.
+    static_cast<HdVP2RenderDelegate*>(_renderDelegate.get())
+        ->DirtyMaterialsWithLoadedTextures(*_renderIndex);
+
     _engine.Execute(_renderIndex.get(), &_dummyTasks);
 }
 
 //! \brief  Main update entry from subscene override.
 void ProxyRenderDelegate::update(MSubSceneContainer& container, const MFrameContext& frameContext)
 {
-    MProfilingScope profilingScope(
+    MayaUsd::ProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorD_L1,
         "ProxyRenderDelegate::update");
@@ -1153,7 +1165,7 @@ void ProxyRenderDelegate::_UpdateRenderTags()
     _proxyShapeData->UpdatePurpose(
         &renderPurposeChanged, &proxyPurposeChanged, &guidePurposeChanged);
     if (renderPurposeChanged || proxyPurposeChanged || guidePurposeChanged) {
-        MProfilingScope subProfilingScope(
+        MayaUsd::ProfilingScope subProfilingScope(
             HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L1, "Update Purpose");
 
         // Build the list of render tags which were added or removed (changed)
@@ -25,10 +25,13 @@
 
 #include <mayaUsd/render/vp2ShaderFragments/shaderFragments.h>
 #include <mayaUsd/utils/hash.h>
+#include <mayaUsd/utils/traceProfiler.h>
 
 #include <pxr/imaging/hd/bprim.h>
 #include <pxr/imaging/hd/camera.h>
+#include <pxr/imaging/hd/changeTracker.h>
 #include <pxr/imaging/hd/instancer.h>
+#include <pxr/imaging/hd/renderIndex.h>
 #include <pxr/imaging/hd/resourceRegistry.h>
 #include <pxr/imaging/hd/rprim.h>
 #include <pxr/imaging/hd/tokens.h>
@@ -560,7 +563,7 @@ void HdVP2RenderDelegate::CommitResources(HdChangeTracker* tracker)
 {
     TF_UNUSED(tracker);
 
-    MProfilingScope profilingScope(sProfilerCategory, MProfiler::kColorC_L2, "Commit resources");
+    MayaUsd::ProfilingScope profilingScope(sProfilerCategory, MProfiler::kColorC_L2, "Commit resources");
 
     // --------------------------------------------------------------------- //
     // RESOLVE, COMPUTE & COMMIT PHASE
@@ -1004,4 +1007,42 @@ HdVP2RenderDelegate::GetSamplerState(const MHWRender::MSamplerStateDesc& desc) c
  */
 const HdVP2BBoxGeom& HdVP2RenderDelegate::GetSharedBBoxGeom() const { return *sSharedBBoxGeom; }
 
+/*! \brief  Remembers a material showing placeholders for textures loaded in the background.
+ */
+void HdVP2RenderDelegate::AddMaterialWithPendingTextures(const SdfPath& materialId)
+{
+    std::lock_guard<std::mutex> lock(_pendingTexturesMutex);
+
+    _materialsWithPendingTextures.insert(materialId);
+}
+
+/*! \brief  Marks dirty the materials for which textures have finished loading in the background.
+
+    Must be called before syncing the render index, so that the placeholder textures get replaced.
+*/
+void HdVP2RenderDelegate::DirtyMaterialsWithLoadedTextures(HdRenderIndex& renderIndex)
+{
+    std::lock_guard<std::mutex> lock(_pendingTexturesMutex);
+
+    if (_materialsWithPendingTextures.empty()) {
+        return;
+    }
+
+    HdChangeTracker& changeTracker = renderIndex.GetChangeTracker();
+
+    auto it = _materialsWithPendingTextures.begin();
+    while (it != _materialsWithPendingTextures.end()) {
+        auto* material = static_cast<HdVP2Material*>(
+            renderIndex.GetSprim(HdPrimTypeTokens->material, *it));
+        if (!material) {
+            it = _materialsWithPendingTextures.erase(it);
+        } else if (material->HasLoadedPendingTextures()) {
+            changeTracker.MarkSprimDirty(*it, HdMaterial::DirtyResource);
+            it = _materialsWithPendingTextures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -29,6 +29,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <set>
 
 constexpr char VP2_RENDER_DELEGATE_SEPARATOR = ';';
 
@@ -155,6 +156,9 @@ public:
 
     const HdVP2BBoxGeom& GetSharedBBoxGeom() const;
 
+    void AddMaterialWithPendingTextures(const SdfPath& materialId);
+    void DirtyMaterialsWithLoadedTextures(HdRenderIndex& renderIndex);
+
     static const int sProfilerCategory; //!< Profiler category
 
 private:
@@ -174,6 +178,10 @@ private:
     SdfPath _id;          //!< Render delegate ID
     HdVP2ResourceRegistry
         _resourceRegistryVP2; //!< VP2 resource registry used for enqueue and execution of commits
+
+    std::mutex _pendingTexturesMutex; //!< Mutex protecting the set of materials below
+    std::set<SdfPath>
+        _materialsWithPendingTextures; //!< Materials showing placeholders for loading textures
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,134 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_VERTEX_BUFFER_FILL
+#define HD_VP2_VERTEX_BUFFER_FILL
+
+#include <pxr/base/work/loops.h>
+#include <pxr/pxr.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/*! \brief  Kernels filling one channel of mapped vertex buffers from primvar data.
+
+    The destination is an array of DEST_TYPE vertices, whose channel starting
+    channelOffset floats into each vertex receives one SRC_TYPE value, e.g. the
+    opacity in the fourth float of a color vertex. The element sizes are known
+    at compile time, so each value is written with plain moves instead of
+    through casted pointers.
+
+    Copies and gathers are split over the worker threads from
+    HdVP2VertexBufferFill::kParallelThreshold vertices. Smaller buffers are
+    filled serially, the meshes themselves being synced in parallel. Broadcasts
+    only write and are kept serial, and copies between identical layouts are a
+    single memcpy, as in the loops these kernels replaced.
+*/
+namespace HdVP2VertexBufferFill {
+
+//! Number of vertices from which a buffer is filled in parallel.
+constexpr size_t kParallelThreshold = 32768;
+
+//! Calls fn(begin, end) over [0, numVertices), in parallel for large ranges.
+template <typename Fn> void ForEachRange(size_t numVertices, Fn&& fn)
+{
+    if (numVertices < kParallelThreshold) {
+        fn(size_t(0), numVertices);
+    } else {
+        WorkParallelForN(numVertices, std::forward<Fn>(fn));
+    }
+}
+
+//! Returns the address of the channel of the first vertex.
+template <class DEST_TYPE> char* Channel(DEST_TYPE* vertexBuffer, size_t channelOffset)
+{
+    return reinterpret_cast<char*>(vertexBuffer) + channelOffset * sizeof(float);
+}
+
+//! Writes value into the channel of all the vertices.
+template <class DEST_TYPE, class SRC_TYPE>
+void Broadcast(
+    DEST_TYPE*      vertexBuffer,
+    size_t          numVertices,
+    size_t          channelOffset,
+    const SRC_TYPE& value)
+{
+    char* const channel = Channel(vertexBuffer, channelOffset);
+    for (size_t v = 0; v < numVertices; v++) {
+        memcpy(channel + v * sizeof(DEST_TYPE), &value, sizeof(SRC_TYPE));
+    }
+}
+
+//! Writes source[v] into the channel of vertex v.
+template <class DEST_TYPE, class SRC_TYPE>
+void Copy(DEST_TYPE* vertexBuffer, size_t numVertices, size_t channelOffset, const SRC_TYPE* source)
+{
+    if (channelOffset == 0 && std::is_same<DEST_TYPE, SRC_TYPE>::value) {
+        memcpy(vertexBuffer, source, sizeof(DEST_TYPE) * numVertices);
+        return;
+    }
+
+    char* const channel = Channel(vertexBuffer, channelOffset);
+    ForEachRange(numVertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++) {
+            memcpy(channel + v * sizeof(DEST_TYPE), source + v, sizeof(SRC_TYPE));
+        }
+    });
+}
+
+//! Writes source[indices[v]] into the channel of vertex v, skipping the
+//! vertices whose index doesn't address one of the sourceSize elements.
+//! Returns the number of skipped vertices. The copy is bound by memory
+//! accesses, so checking each index as it is read costs less than a separate
+//! pass over the indices.
+template <class DEST_TYPE, class SRC_TYPE>
+size_t Gather(
+    DEST_TYPE*      vertexBuffer,
+    size_t          numVertices,
+    size_t          channelOffset,
+    const SRC_TYPE* source,
+    size_t          sourceSize,
+    const int*      indices)
+{
+    char* const         channel = Channel(vertexBuffer, channelOffset);
+    std::atomic<size_t> numSkipped { 0 };
+    ForEachRange(numVertices, [&](size_t begin, size_t end) {
+        size_t skipped = 0;
+        for (size_t v = begin; v < end; v++) {
+            // Negative indices become larger than any valid one.
+            const size_t index = static_cast<unsigned int>(indices[v]);
+            if (index < sourceSize) {
+                memcpy(channel + v * sizeof(DEST_TYPE), source + index, sizeof(SRC_TYPE));
+            } else {
+                skipped++;
+            }
+        }
+        if (skipped > 0) {
+            numSkipped += skipped;
+        }
+    });
+    return numSkipped;
+}
+
+} // namespace HdVP2VertexBufferFill
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // HD_VP2_VERTEX_BUFFER_FILL
@@ -52,7 +52,10 @@
 #include <ufe/object3d.h>
 #include <ufe/object3dNotification.h>
 
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #endif
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -118,6 +121,48 @@ namespace ufe {
 extern UsdStageMap g_StageMap;
 extern Ufe::Rtid   g_USDRtid;
 
+namespace {
+
+StagesSubject::NotificationCounts g_NotificationCounts;
+
+#ifdef UFE_V2_FEATURES_AVAILABLE
+//! Collect the scene notifications resulting from a single USD notice, to
+//! send them to the observers as one composite notification.
+class SceneChangedBatch
+{
+public:
+    template <class Notification, class... Args> void add(Args&&... args)
+    {
+        fNotifications.emplace_back(std::make_shared<Notification>(std::forward<Args>(args)...));
+    }
+
+    void send()
+    {
+        if (fNotifications.empty())
+            return;
+
+        // A lone notification is sent as is, observers need not unpack it.
+        if (fNotifications.size() == 1) {
+            Ufe::Scene::instance().notify(*fNotifications.front());
+        } else {
+            Ufe::SceneCompositeNotification composite;
+            for (const auto& notification : fNotifications) {
+                composite.appendSceneChanged(notification);
+            }
+            Ufe::Scene::instance().notify(composite);
+            ++g_NotificationCounts.composites;
+        }
+        g_NotificationCounts.sent += fNotifications.size();
+        fNotifications.clear();
+    }
+
+private:
+    std::vector<Ufe::SceneChanged::Ptr> fNotifications;
+};
+#endif
+
+} // namespace
+
 //------------------------------------------------------------------------------
 // StagesSubject
 //------------------------------------------------------------------------------
@@ -148,17 +193,32 @@ StagesSubject::StagesSubject()
     TfWeakPtr<StagesSubject> me(this);
     TfNotice::Register(me, &StagesSubject::onStageSet);
     TfNotice::Register(me, &StagesSubject::onStageInvalidate);
+
+    // Keep the stage map up to date as proxy shapes are added, removed,
+    // renamed and reparented.
+    g_StageMap.addCallbacks();
 }
 
 StagesSubject::~StagesSubject()
 {
     MMessage::removeCallbacks(fCbIds);
     fCbIds.clear();
+
+    g_StageMap.removeCallbacks();
 }
 
 /*static*/
 StagesSubject::Ptr StagesSubject::create() { return TfCreateWeakPtr(new StagesSubject); }
 
+/*static*/
+const StagesSubject::NotificationCounts& StagesSubject::notificationCounts()
+{
+    return g_NotificationCounts;
+}
+
+/*static*/
+void StagesSubject::resetNotificationCounts() { g_NotificationCounts = NotificationCounts(); }
+
 bool StagesSubject::beforeNewCallback() const { return fBeforeNewCallback; }
 
 void StagesSubject::beforeNewCallback(bool b)
@@ -202,6 +262,19 @@ void StagesSubject::afterOpenCallback(void* clientData)
 }
 
 void StagesSubject::afterOpen()
+{
+    revokeStageListeners();
+
+    // Set up our stage to proxy shape UFE path (and reverse)
+    // mapping.  We do this with the following steps:
+    // - get all proxyShape nodes in the scene.
+    // - get their Dag paths.
+    // - convert the Dag paths to UFE paths.
+    // - get their stage.
+    g_StageMap.setDirty();
+}
+
+void StagesSubject::revokeStageListeners()
 {
     // Observe stage changes, for all stages.  Return listener object can
     // optionally be used to call Revoke() to remove observation, but must
@@ -220,14 +293,6 @@ void StagesSubject::afterOpen()
             }
         });
     fStageListeners.clear();
-
-    // Set up our stage to proxy shape UFE path (and reverse)
-    // mapping.  We do this with the following steps:
-    // - get all proxyShape nodes in the scene.
-    // - get their Dag paths.
-    // - convert the Dag paths to UFE paths.
-    // - get their stage.
-    g_StageMap.setDirty();
 }
 
 void StagesSubject::stageChanged(
@@ -235,24 +300,46 @@ void StagesSubject::stageChanged(
     UsdStageWeakPtr const&           sender)
 {
     // If the stage path has not been initialized yet, do nothing
-    if (stagePath(sender).empty())
+    const Ufe::Path stageUfePath = stagePath(sender);
+    if (stageUfePath.empty())
         return;
 
-    auto stage = notice.GetStage();
+    ++g_NotificationCounts.notices;
+
+    auto primUfePath = [&stageUfePath](const SdfPath& path) {
+        return stageUfePath + Ufe::PathSegment(path.GetPrimPath().GetString(), g_USDRtid, '/');
+    };
+
+#ifdef UFE_V2_FEATURES_AVAILABLE
+    // A path can be reported more than once in a notice (e.g. both as
+    // resynced and as changed info only), only send its value change once.
+    std::unordered_set<SdfPath, SdfPath::Hash> valueChangedPaths;
+    auto notifyValueChanged = [&valueChangedPaths](const Ufe::Path& ufePath, const SdfPath& path) {
+        if (!valueChangedPaths.insert(path).second) {
+            ++g_NotificationCounts.suppressed;
+            return;
+        }
+        valueChanged(ufePath, path.GetNameToken());
+        ++g_NotificationCounts.sent;
+    };
+#endif
+
+    auto          stage = notice.GetStage();
+    SdfPathVector resyncedPrimPaths;
     for (const auto& changedPath : notice.GetResyncedPaths()) {
         if (changedPath.IsPrimPropertyPath()) {
             // Special case to detect when an xformop is added or removed from a prim.
             // We need to send some notifs so Maya can update (such as on undo
             // to move the transform manipulator back to original position).
             const TfToken nameToken = changedPath.GetNameToken();
-            auto          usdPrimPathStr = changedPath.GetPrimPath().GetString();
-            auto ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+            auto          ufePath = primUfePath(changedPath);
             if (nameToken == UsdGeomTokens->xformOpOrder) {
                 if (!InTransform3dChange::inTransform3dChange()) {
                     Ufe::Transform3d::notify(ufePath);
+                    ++g_NotificationCounts.sent;
                 }
             }
-            UFE_V2(valueChanged(ufePath, changedPath.GetNameToken());)
+            UFE_V2(notifyValueChanged(ufePath, changedPath);)
 
             // No further processing for this prim property path is required.
             continue;
@@ -263,6 +350,20 @@ void StagesSubject::stageChanged(
         if (changedPath.IsPropertyPath())
             continue;
 
+        resyncedPrimPaths.push_back(changedPath);
+    }
+
+    // According to USD docs for GetResyncedPaths(), resyncs imply entire
+    // subtree invalidation of all descendant prims and properties: the
+    // notifications for a resync of /A/B are redundant with those for /A.
+    const size_t nbResyncedPrimPaths = resyncedPrimPaths.size();
+    SdfPath::RemoveDescendentPaths(&resyncedPrimPaths);
+    g_NotificationCounts.suppressed += nbResyncedPrimPaths - resyncedPrimPaths.size();
+
+#ifdef UFE_V2_FEATURES_AVAILABLE
+    SceneChangedBatch sceneChanges;
+#endif
+    for (const auto& changedPath : resyncedPrimPaths) {
         // Assume proxy shapes (and thus stages) cannot be instanced.  We can
         // therefore map the stage to a single UFE path.  Lifting this
         // restriction would mean sending one add or delete notification for
@@ -270,11 +371,10 @@ void StagesSubject::stageChanged(
         Ufe::Path ufePath;
         UsdPrim   prim;
         if (changedPath == SdfPath::AbsoluteRootPath()) {
-            ufePath = stagePath(sender);
+            ufePath = stageUfePath;
             prim = stage->GetPseudoRoot();
         } else {
-            const std::string& usdPrimPathStr = changedPath.GetPrimPath().GetString();
-            ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+            ufePath = primUfePath(changedPath);
             prim = stage->GetPrimAtPath(changedPath);
         }
 
@@ -294,26 +394,27 @@ void StagesSubject::stageChanged(
             if (InAddOrDeleteOperation::inAddOrDeleteOperation()) {
                 if (prim.IsActive()) {
 #ifdef UFE_V2_FEATURES_AVAILABLE
-                    Ufe::Scene::instance().notify(Ufe::ObjectAdd(sceneItem));
+                    sceneChanges.add<Ufe::ObjectAdd>(sceneItem);
 #else
                     auto notification = Ufe::ObjectAdd(sceneItem);
                     Ufe::Scene::notifyObjectAdd(notification);
+                    ++g_NotificationCounts.sent;
 #endif
                 } else {
 #ifdef UFE_V2_FEATURES_AVAILABLE
-                    Ufe::Scene::instance().notify(Ufe::ObjectPostDelete(sceneItem));
+                    sceneChanges.add<Ufe::ObjectPostDelete>(sceneItem);
 #else
                     auto notification = Ufe::ObjectPostDelete(sceneItem);
                     Ufe::Scene::notifyObjectDelete(notification);
+                    ++g_NotificationCounts.sent;
 #endif
                 }
             }
 #ifdef UFE_V2_FEATURES_AVAILABLE
             else {
-                // According to USD docs for GetResyncedPaths():
-                // - Resyncs imply entire subtree invalidation of all descendant prims and
-                // properties. So we send the UFE subtree invalidate notif.
-                Ufe::Scene::instance().notify(Ufe::SubtreeInvalidate(sceneItem));
+                // Resyncs imply entire subtree invalidation of all descendant
+                // prims and properties. So we send the UFE subtree invalidate notif.
+                sceneChanges.add<Ufe::SubtreeInvalidate>(sceneItem);
             }
 #endif
         }
@@ -321,20 +422,22 @@ void StagesSubject::stageChanged(
         else if (!prim.IsValid() && !InPathChange::inPathChange()) {
             Ufe::SceneItem::Ptr sceneItem = Ufe::Hierarchy::createItem(ufePath);
             if (!sceneItem || InAddOrDeleteOperation::inAddOrDeleteOperation()) {
-                Ufe::Scene::instance().notify(Ufe::ObjectDestroyed(ufePath));
+                sceneChanges.add<Ufe::ObjectDestroyed>(ufePath);
             } else {
-                Ufe::Scene::instance().notify(Ufe::SubtreeInvalidate(sceneItem));
+                sceneChanges.add<Ufe::SubtreeInvalidate>(sceneItem);
             }
         }
 #endif
     }
+#ifdef UFE_V2_FEATURES_AVAILABLE
+    sceneChanges.send();
+#endif
 
     auto changedInfoOnlyPaths = notice.GetChangedInfoOnlyPaths();
     for (auto it = changedInfoOnlyPaths.begin(), end = changedInfoOnlyPaths.end(); it != end;
          ++it) {
         const auto& changedPath = *it;
-        auto        usdPrimPathStr = changedPath.GetPrimPath().GetString();
-        auto        ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+        auto        ufePath = primUfePath(changedPath);
 
 #ifdef UFE_V2_FEATURES_AVAILABLE
         bool sendValueChangedFallback = true;
@@ -343,7 +446,7 @@ void StagesSubject::stageChanged(
         // isPropertyPath() does consider relational attributes
         // isRelationalAttributePath() considers only relational attributes
         if (changedPath.IsPrimPropertyPath()) {
-            valueChanged(ufePath, changedPath.GetNameToken());
+            notifyValueChanged(ufePath, changedPath);
             sendValueChangedFallback = false;
         }
 
@@ -351,6 +454,7 @@ void StagesSubject::stageChanged(
         if (changedPath.GetNameToken() == UsdGeomTokens->visibility) {
             Ufe::VisibilityChanged vis(ufePath);
             Ufe::Object3d::notify(vis);
+            ++g_NotificationCounts.sent;
             sendValueChangedFallback = false;
         }
 #endif
@@ -361,6 +465,7 @@ void StagesSubject::stageChanged(
             const TfToken nameToken = changedPath.GetNameToken();
             if (nameToken == UsdGeomTokens->xformOpOrder || UsdGeomXformOp::IsXformOp(nameToken)) {
                 Ufe::Transform3d::notify(ufePath);
+                ++g_NotificationCounts.sent;
                 UFE_V2(sendValueChangedFallback = false;)
             } else if (prim && prim.IsA<UsdGeomPointInstancer>()) {
                 // If the prim at the changed path is a PointInstancer, check
@@ -404,10 +509,11 @@ void StagesSubject::stageChanged(
                         : std::numeric_limits<int>::max();
 
                     for (int instanceIndex = 0; instanceIndex < numIndices; ++instanceIndex) {
-                        const Ufe::Path instanceUfePath = stagePath(sender)
+                        const Ufe::Path instanceUfePath = stageUfePath
                             + usdPathToUfePathSegment(changedPath.GetPrimPath(), instanceIndex);
                         Ufe::Transform3d::notify(instanceUfePath);
                     }
+                    g_NotificationCounts.sent += numIndices;
                     UFE_V2(sendValueChangedFallback = false;)
                 }
             }
@@ -424,7 +530,7 @@ void StagesSubject::stageChanged(
                 if (entry->flags.didAddInertPrim || entry->flags.didRemoveInertPrim)
                     continue;
 
-                valueChanged(ufePath, changedPath.GetNameToken());
+                notifyValueChanged(ufePath, changedPath);
                 // just send one notification
                 break;
             }
@@ -435,9 +541,9 @@ void StagesSubject::stageChanged(
 #ifdef UFE_V2_FEATURES_AVAILABLE
     // Special case when we are notified, but no paths given.
     if (notice.GetResyncedPaths().empty() && notice.GetChangedInfoOnlyPaths().empty()) {
-        auto                       ufePath = stagePath(sender);
-        Ufe::AttributeValueChanged vc(ufePath, "/");
+        Ufe::AttributeValueChanged vc(stageUfePath, "/");
         Ufe::Attributes::notify(vc);
+        ++g_NotificationCounts.sent;
     }
 #endif
 }
@@ -500,7 +606,11 @@ void StagesSubject::onStageSet(const MayaUsdProxyStageSetNotice& notice)
 
 void StagesSubject::onStageInvalidate(const MayaUsdProxyStageInvalidateNotice& notice)
 {
-    afterOpen();
+    revokeStageListeners();
+
+    // Only the stage of this proxy shape is changing, the rest of the stage
+    // map is still valid.
+    g_StageMap.setDirty(notice.GetProxyShape().thisMObject());
 
     auto p = notice.GetProxyShape().ufePath();
     if (!p.empty()) {
@@ -64,6 +64,27 @@ public:
 
     void afterOpen();
 
+    //! \brief Counts of the UFE notifications resulting from USD stage changes.
+    /*!
+        A single USD edit, such as a variant switch or a payload load, can
+        resync a large number of paths.  Notifications made redundant by a
+        resync of one of their ancestors, or by an identical notification for
+        the same USD edit, are not sent and are counted as suppressed.
+     */
+    struct NotificationCounts
+    {
+        size_t notices = 0;    //!< USD ObjectsChanged notices processed.
+        size_t sent = 0;       //!< UFE notifications sent.
+        size_t suppressed = 0; //!< Redundant UFE notifications that were not sent.
+        size_t composites = 0; //!< Composite scene notifications sent.
+    };
+
+    //! Return the notification counts since the last reset.
+    static const NotificationCounts& notificationCounts();
+
+    //! Reset the notification counts to zero.
+    static void resetNotificationCounts();
+
 private:
     // Maya scene message callbacks
     static void beforeNewCallback(void* clientData);
@@ -71,6 +92,9 @@ private:
     static void afterNewCallback(void* clientData);
     static void afterOpenCallback(void* clientData);
 
+    //! Stop listening to changes on all stages.
+    void revokeStageListeners();
+
     //! Call the stageChanged() methods on stage observers.
     void stageChanged(
         PXR_NS::UsdNotice::ObjectsChanged const& notice,
@@ -21,7 +21,10 @@
 #include <mayaUsd/ufe/Utils.h>
 #include <mayaUsd/utils/util.h>
 
+#include <maya/MDGMessage.h>
 #include <maya/MFnDagNode.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MSelectionList.h>
 
 #include <cassert>
 
@@ -42,6 +45,22 @@ MObjectHandle nameLookup(const Ufe::Path& path)
     return handle;
 }
 
+// Quiet version of nameLookup, returning a null object if the path does not
+// exist or is not the one of a proxy shape.
+MObject proxyShapeLookup(const Ufe::Path& path)
+{
+    MSelectionList selection;
+    if (selection.add(MString(path.popHead().string().c_str())) != MS::kSuccess) {
+        return MObject();
+    }
+    MObject obj;
+    if (selection.getDependNode(0, obj) != MS::kSuccess) {
+        return MObject();
+    }
+    MFnDependencyNode fn(obj);
+    return dynamic_cast<MayaUsdProxyShapeBase*>(fn.userNode()) ? obj : MObject();
+}
+
 // Assuming proxy shape nodes cannot be instanced, simply return the first path.
 Ufe::Path firstPath(const MObjectHandle& handle)
 {
@@ -112,14 +131,91 @@ void UsdStageMap::addItem(const Ufe::Path& path)
         return;
     }
 
-    // Non-const MObject& requires an lvalue.  We've just done a name-based
-    // lookup of the proxy shape, so the stage cannot be null.
+    updateItem(proxyShape);
+}
+
+void UsdStageMap::updateItem(const MObjectHandle& proxyShape)
+{
+    removeItem(proxyShape);
+
+    // Deleted nodes are kept alive for undo, but are no longer valid.
+    if (!proxyShape.isValid()) {
+        return;
+    }
+
+    // Non-const MObject& requires an lvalue.
     auto obj = proxyShape.object();
     auto stage = objToStage(obj);
-    TF_AXIOM(stage);
+    auto path = firstPath(proxyShape);
+    if (path.empty()) {
+        return;
+    }
 
     fPathToObject[path] = proxyShape;
-    fStageToObject[stage] = proxyShape;
+    if (stage) {
+        fStageToObject[stage] = proxyShape;
+    }
+    fObjectToItem[proxyShape] = { path, stage };
+}
+
+void UsdStageMap::removeItem(const MObjectHandle& proxyShape)
+{
+    auto iter = fObjectToItem.find(proxyShape);
+    if (iter == std::end(fObjectToItem)) {
+        return;
+    }
+
+    const Item item = iter->second;
+    fObjectToItem.erase(iter);
+
+    auto pathIter = fPathToObject.find(item.path);
+    if (pathIter != std::end(fPathToObject) && pathIter->second == proxyShape) {
+        fPathToObject.erase(pathIter);
+    }
+
+    // Proxy shapes can share a stage, in which case the stage is now bound
+    // to one of the remaining ones.
+    auto stageIter = fStageToObject.find(item.stage);
+    if (stageIter != std::end(fStageToObject) && stageIter->second == proxyShape) {
+        fStageToObject.erase(stageIter);
+        for (const auto& entry : fObjectToItem) {
+            if (entry.second.stage == item.stage) {
+                fStageToObject[item.stage] = entry.first;
+                break;
+            }
+        }
+    }
+}
+
+void UsdStageMap::refreshPaths()
+{
+    // MObjectHandle values in the caches are stable against rename or
+    // reparent, so StageToObject is unchanged.  Only the stale Ufe::Path keys
+    // of PathToObject need to be replaced.
+    for (auto& entry : fObjectToItem) {
+        const auto& cachedObject = entry.first;
+        auto&       cachedPath = entry.second.path;
+        if (!cachedObject.isValid()) {
+            continue;
+        }
+        auto newPath = firstPath(cachedObject);
+        if (newPath != cachedPath) {
+            // Key is stale.  Remove it from our cache, unless another proxy
+            // shape has already been moved to it, and add the new entry.
+            auto iter = fPathToObject.find(cachedPath);
+            if (iter != std::end(fPathToObject) && iter->second == cachedObject) {
+                fPathToObject.erase(iter);
+            }
+            fPathToObject[newPath] = cachedObject;
+            cachedPath = newPath;
+        }
+    }
+    fPathsDirty = false;
+}
+
+bool UsdStageMap::isTracked(const MObjectHandle& handle) const
+{
+    return fObjectToItem.count(handle) > 0 || fDirtyObjects.count(handle) > 0;
 }
 
 UsdStageWeakPtr UsdStageMap::stage(const Ufe::Path& path)
@@ -141,31 +237,19 @@ MObject UsdStageMap::proxyShape(const Ufe::Path& path)
         return iter->second.object();
     }
 
-    // Caches are invalidated by DG dirtying, but not by renaming or
-    // reparenting.  We have not found the object in the PathToObject cache,
-    // either because the cache is stale, or because the object does not exist.
-    // MObjectHandle values in the caches are stable against rename or
-    // reparent, so StageToObject is unchanged.  We can iterate on the
-    // MObjectHandle values and refresh the stale Ufe::Path in PathToObject.
-    // Iterate on a copy of the map, as we may be updating some entries.
-    auto pathToObject = fPathToObject;
-    for (const auto& entry : pathToObject) {
-        const auto& cachedPath = entry.first;
-        const auto& cachedObject = entry.second;
-        // Get the UFE path from the map value.
-        auto newPath = firstPath(cachedObject);
-        if (newPath != cachedPath) {
-            // Key is stale.  Remove it from our cache, and add the new entry.
-            auto count = fPathToObject.erase(cachedPath);
-            TF_AXIOM(count);
-            fPathToObject[newPath] = cachedObject;
-        }
+    // We have not found the object in the PathToObject cache, either because
+    // the object is not a proxy shape, or because the rename or reparent
+    // callback has not been called yet.  Rather than refreshing every entry,
+    // look up the node in the Dag, and refresh its entry if it is a proxy
+    // shape.
+    MObjectHandle handle(proxyShapeLookup(singleSegmentPath));
+    if (!handle.isValid()) {
+        return MObject();
     }
 
-    // At this point the cache is rebuilt, so lookup failure means the object
-    // doesn't exist.
-    iter = fPathToObject.find(singleSegmentPath);
-    return iter == std::end(fPathToObject) ? MObject() : iter->second.object();
+    updateItem(handle);
+    fDirtyObjects.erase(handle);
+    return handle.object();
 }
 
 MayaUsdProxyShapeBase* UsdStageMap::proxyShapeNode(const Ufe::Path& path)
@@ -195,8 +279,8 @@ UsdStageMap::StageSet UsdStageMap::allStages()
     rebuildIfDirty();
 
     StageSet stages;
-    for (const auto& pair : fPathToObject) {
-        stages.insert(stage(pair.first));
+    for (const auto& pair : fStageToObject) {
+        stages.insert(pair.first);
     }
     return stages;
 }
@@ -205,18 +289,122 @@ void UsdStageMap::setDirty()
 {
     fPathToObject.clear();
     fStageToObject.clear();
+    fObjectToItem.clear();
+    fDirtyObjects.clear();
     fDirty = true;
+    fPathsDirty = false;
+}
+
+void UsdStageMap::setDirty(const MObject& proxyShape)
+{
+    if (!fDirty) {
+        fDirtyObjects.insert(MObjectHandle(proxyShape));
+    }
 }
 
 void UsdStageMap::rebuildIfDirty()
 {
-    if (!fDirty)
+    if (fDirty) {
+        for (const auto& psn : ProxyShapeHandler::getAllNames()) {
+            addItem(Ufe::Path(Ufe::PathSegment("|world" + psn, getMayaRunTimeId(), '|')));
+        }
+        fDirty = false;
+        return;
+    }
+
+    if (fPathsDirty) {
+        refreshPaths();
+    }
+
+    if (!fDirtyObjects.empty()) {
+        // Computing a stage can send notifications checking whether the map
+        // is dirty, so the dirty objects are only cleared once updated.
+        const ObjectSet dirtyObjects = fDirtyObjects;
+        for (const auto& proxyShape : dirtyObjects) {
+            updateItem(proxyShape);
+        }
+        for (const auto& proxyShape : dirtyObjects) {
+            fDirtyObjects.erase(proxyShape);
+        }
+    }
+}
+
+void UsdStageMap::addCallbacks()
+{
+    if (fCbIds.length() > 0) {
         return;
+    }
 
-    for (const auto& psn : ProxyShapeHandler::getAllNames()) {
-        addItem(Ufe::Path(Ufe::PathSegment("|world" + psn, getMayaRunTimeId(), '|')));
+    const MString proxyShapeType(ProxyShapeHandler::gatewayNodeType().c_str());
+
+    MStatus res;
+    fCbIds.append(
+        MDGMessage::addNodeAddedCallback(proxyShapeAddedCallback, proxyShapeType, this, &res));
+    CHECK_MSTATUS(res);
+    fCbIds.append(
+        MDGMessage::addNodeRemovedCallback(proxyShapeRemovedCallback, proxyShapeType, this, &res));
+    CHECK_MSTATUS(res);
+    fCbIds.append(
+        MNodeMessage::addNameChangedCallback(MObject::kNullObj, nodeRenamedCallback, this, &res));
+    CHECK_MSTATUS(res);
+    fCbIds.append(MDagMessage::addAllDagChangesCallback(dagChangedCallback, this, &res));
+    CHECK_MSTATUS(res);
+}
+
+void UsdStageMap::removeCallbacks()
+{
+    MMessage::removeCallbacks(fCbIds);
+    fCbIds.clear();
+    setDirty();
+}
+
+/*static*/
+void UsdStageMap::proxyShapeAddedCallback(MObject& node, void* clientData)
+{
+    // The node has no Dag path and no stage yet, resolve it on access.
+    auto stageMap = static_cast<UsdStageMap*>(clientData);
+    if (!stageMap->fDirty) {
+        stageMap->fDirtyObjects.insert(MObjectHandle(node));
+    }
+}
+
+/*static*/
+void UsdStageMap::proxyShapeRemovedCallback(MObject& node, void* clientData)
+{
+    auto          stageMap = static_cast<UsdStageMap*>(clientData);
+    MObjectHandle proxyShape(node);
+    stageMap->removeItem(proxyShape);
+    stageMap->fDirtyObjects.erase(proxyShape);
+}
+
+/*static*/
+void UsdStageMap::nodeRenamedCallback(MObject& node, const MString&, void* clientData)
+{
+    // Only renaming a proxy shape or one of its ancestors changes its path.
+    // Nodes are renamed when created, at which point they have no children.
+    auto stageMap = static_cast<UsdStageMap*>(clientData);
+    if (stageMap->fDirty || stageMap->fPathsDirty || !node.hasFn(MFn::kDagNode)) {
+        return;
+    }
+    if (stageMap->isTracked(MObjectHandle(node)) || MFnDagNode(node).childCount() > 0) {
+        stageMap->fPathsDirty = true;
+    }
+}
+
+/*static*/
+void UsdStageMap::dagChangedCallback(
+    MDagMessage::DagMessage,
+    MDagPath& child,
+    MDagPath&,
+    void* clientData)
+{
+    auto stageMap = static_cast<UsdStageMap*>(clientData);
+    if (stageMap->fDirty || stageMap->fPathsDirty) {
+        return;
+    }
+    if (stageMap->isTracked(MObjectHandle(child.node())) || child.childCount() > 0) {
+        stageMap->fPathsDirty = true;
     }
-    fDirty = false;
 }
 
 } // namespace ufe
@@ -22,10 +22,13 @@
 #include <pxr/base/tf/hashset.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagMessage.h>
 #include <maya/MObjectHandle.h>
 #include <ufe/path.h>
 
 #include <unordered_map>
+#include <unordered_set>
 
 // Pending rework of mayaUsd namespaces, MayaUsdProxyShapeBase is in the Pixar
 // namespace.  PPT, 9-Mar-2021.
@@ -44,14 +47,18 @@ namespace ufe {
     nothing in the data model prevents it).  To generalized access to the
     underlying node, we store an MObjectHandle in the maps.
 
-    The cache is refreshed on access to a stage given a path which cannot be
-    found.  In this way, the cache does not need to observe the Maya data
-    model, and we avoid order of notification problems where one observer would
-    need to access the cache before it is refreshed, since there is no
-    guarantee on the order of notification of Ufe observers.  An earlier
-    implementation with rename observation had the Maya Outliner (which
-    observes rename) access the UsdStageMap on rename before the UsdStageMap
-    had been updated.
+    The map is kept up to date incrementally.  Maya callbacks on proxy shape
+    addition and removal, and on renaming and reparenting of Dag nodes, only
+    record what changed.  The affected entries are refreshed on the next
+    access, so that a scene with many proxy shapes never needs to be scanned
+    again after the initial population.  Refreshing on access also avoids order
+    of notification problems where one observer would need to access the cache
+    before it is refreshed, since there is no guarantee on the order of
+    notification of Ufe observers.  An earlier implementation with rename
+    observation had the Maya Outliner (which observes rename) access the
+    UsdStageMap on rename before the UsdStageMap had been updated.  For the
+    same reason, a path which cannot be found is resolved directly in the Maya
+    Dag.
 */
 class MAYAUSD_CORE_PUBLIC UsdStageMap
 {
@@ -88,20 +95,63 @@ public:
     //! only repopulated when stage info is requested.
     void setDirty();
 
+    //! Set the entry of a single proxy shape as dirty, e.g. because its stage
+    //! was replaced.  Only that entry is refreshed when stage info is requested.
+    void setDirty(const MObject& proxyShape);
+
     //! Returns true if the stage map is dirty (meaning it needs to be filled in).
-    bool isDirty() const { return fDirty; }
+    bool isDirty() const { return fDirty || !fDirtyObjects.empty(); }
+
+    //! Start tracking proxy shapes added, removed, renamed and reparented.
+    void addCallbacks();
+
+    //! Stop tracking changes.  The stage map is set dirty, as it can no
+    //! longer be kept up to date.
+    void removeCallbacks();
 
 private:
     void addItem(const Ufe::Path& path);
+    void updateItem(const MObjectHandle& proxyShape);
+    void removeItem(const MObjectHandle& proxyShape);
+    void refreshPaths();
     void rebuildIfDirty();
 
+    static void proxyShapeAddedCallback(MObject& node, void* clientData);
+    static void proxyShapeRemovedCallback(MObject& node, void* clientData);
+    static void nodeRenamedCallback(MObject& node, const MString& prevName, void* clientData);
+    static void dagChangedCallback(
+        MDagMessage::DagMessage msgType,
+        MDagPath&               child,
+        MDagPath&               parent,
+        void*                   clientData);
+
+    bool isTracked(const MObjectHandle& handle) const;
+
 private:
+    struct ObjectHandleHash
+    {
+        size_t operator()(const MObjectHandle& handle) const { return handle.hashCode(); }
+    };
+
+    //! What is cached for each proxy shape, used to update the two maps.
+    struct Item
+    {
+        Ufe::Path               path;
+        PXR_NS::UsdStageWeakPtr stage;
+    };
+
     // We keep two maps for fast lookup when there are many proxy shapes.
     using PathToObject = std::unordered_map<Ufe::Path, MObjectHandle>;
     using StageToObject = PXR_NS::TfHashMap<PXR_NS::UsdStageWeakPtr, MObjectHandle, PXR_NS::TfHash>;
-    PathToObject  fPathToObject;
-    StageToObject fStageToObject;
-    bool          fDirty { true };
+    using ObjectToItem = std::unordered_map<MObjectHandle, Item, ObjectHandleHash>;
+    using ObjectSet = std::unordered_set<MObjectHandle, ObjectHandleHash>;
+    PathToObject     fPathToObject;
+    StageToObject    fStageToObject;
+    ObjectToItem     fObjectToItem;
+    ObjectSet        fDirtyObjects; // Proxy shapes added, or whose stage changed.
+    bool             fDirty { true };
+    bool             fPathsDirty { false }; // Proxy shapes may have been renamed or reparented.
+    MCallbackIdArray fCbIds;
 
 }; // UsdStageMap
 
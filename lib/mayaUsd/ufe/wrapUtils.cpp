@@ -14,6 +14,7 @@
 // limitations under the License.
 //
 #include <mayaUsd/ufe/Global.h>
+#include <mayaUsd/ufe/StagesSubject.h>
 #include <mayaUsd/ufe/UsdSceneItem.h>
 #include <mayaUsd/ufe/Utils.h>
 
@@ -216,6 +217,20 @@ PXR_NS::TfTokenVector getProxyShapePurposes(const std::string& ufePathString)
     return ufe::getProxyShapePurposes(path);
 }
 
+dict getNotificationCounts()
+{
+    const auto& counts = ufe::StagesSubject::notificationCounts();
+
+    dict result;
+    result["notices"] = counts.notices;
+    result["sent"] = counts.sent;
+    result["suppressed"] = counts.suppressed;
+    result["composites"] = counts.composites;
+    return result;
+}
+
+void resetNotificationCounts() { ufe::StagesSubject::resetNotificationCounts(); }
+
 void wrapUtils()
 {
 #ifdef UFE_V2_FEATURES_AVAILABLE
@@ -242,4 +257,6 @@ void wrapUtils()
     def("getProxyShapePurposes", getProxyShapePurposes);
     def("isAttributeEditAllowed", isAttributeEditAllowed);
     def("isEditTargetLayerModifiable", isEditTargetLayerModifiable);
+    def("getNotificationCounts", getNotificationCounts);
+    def("resetNotificationCounts", resetNotificationCounts);
 }
@@ -19,10 +19,35 @@
 #include "UsdUndoBlock.h"
 #include "UsdUndoStateDelegate.h"
 
+#include <mayaUsd/base/debugCodes.h>
+
+#include <pxr/base/tf/envSetting.h>
+
+#include <algorithm>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_UNDO_MEMORY_BUDGET_MB,
+    0,
+    "Maximum memory, in megabytes, held by the USD edits in Maya's undo queue. The edits of the "
+    "least recently used undoable items are discarded when it is exceeded. 0 means no limit.");
+
+namespace {
+// Set once the undo manager is destroyed. Being trivially destructible, it can still be read
+// by the undoable items destroyed after it.
+bool undoManagerDestroyed = false;
+} // namespace
+
 namespace MAYAUSD_NS_DEF {
 
+UsdUndoManager::UsdUndoManager()
+    : _memoryBudget(size_t(std::max(TfGetEnvSetting(MAYAUSD_UNDO_MEMORY_BUDGET_MB), 0)) << 20)
+{
+}
+
+UsdUndoManager::~UsdUndoManager() { undoManagerDestroyed = true; }
+
 UsdUndoManager& UsdUndoManager::instance()
 {
     static UsdUndoManager undoManager;
@@ -40,20 +65,110 @@ void UsdUndoManager::trackLayerStates(const SdfLayerHandle& layer)
     }
 }
 
-void UsdUndoManager::addInverse(InvertFunc func)
+void UsdUndoManager::setMemoryBudget(size_t bytes)
+{
+    _memoryBudget = bytes;
+    enforceMemoryBudget();
+}
+
+void UsdUndoManager::addInverse(InvertFunc func, size_t byteSize)
 {
     if (UsdUndoBlock::depth() == 0) {
         TF_CODING_ERROR("Collecting invert functions outside of undoblock is not allowed!");
         return;
     }
 
-    _invertFuncs.emplace_back(func);
+    _invertFuncs.emplace_back(std::move(func));
+    _byteSize += sizeof(InvertFunc) + byteSize;
 }
 
 void UsdUndoManager::transferEdits(UsdUndoableItem& undoableItem)
 {
-    // transfer the edits
-    undoableItem._invertFuncs = std::move(_invertFuncs);
+    // transfer the edits. Copies of the item keep the previous edits, so replace them
+    // rather than filling them in.
+    std::shared_ptr<UsdUndoableItem::Edits> edits(new UsdUndoableItem::Edits);
+    edits->invertFuncs = std::move(_invertFuncs);
+    edits->byteSize = _byteSize;
+    if (undoableItem._edits) {
+        // the item was undone or redone.
+        edits->sequence = undoableItem._edits->sequence;
+    } else {
+        // a new item truncates Maya's redo queue.
+        edits->sequence = _itemCount++;
+        _redoBarrier = SIZE_MAX;
+    }
+    undoableItem._edits = edits;
+
+    _invertFuncs.clear();
+    _byteSize = 0;
+    ++_transferCount;
+
+    _memoryUsage += edits->byteSize;
+    ++_itemEditsAlive;
+    _itemEdits.emplace_back(edits);
+
+    // forget the items deleted since, once they outnumber the ones alive.
+    if (_itemEdits.size() > 2 * _itemEditsAlive + 64) {
+        _itemEdits.erase(
+            std::remove_if(
+                _itemEdits.begin(),
+                _itemEdits.end(),
+                [](const std::weak_ptr<UsdUndoableItem::Edits>& e) { return e.expired(); }),
+            _itemEdits.end());
+    }
+
+    enforceMemoryBudget();
+}
+
+void UsdUndoManager::releaseItemEdits(size_t byteSize)
+{
+    if (undoManagerDestroyed) {
+        return;
+    }
+
+    UsdUndoManager& undoManager = instance();
+    undoManager._memoryUsage -= std::min(undoManager._memoryUsage, byteSize);
+    --undoManager._itemEditsAlive;
+}
+
+bool UsdUndoManager::canInvert(const UsdUndoableItem::Edits& edits, bool isUndo)
+{
+    const bool blocked = edits.expired
+        || (isUndo ? edits.sequence < _undoBarrier : edits.sequence >= _redoBarrier);
+    if (blocked) {
+        // Maya moves through its undo queue anyway, so an item whose undo was refused can't
+        // be redone either, and the other way around.
+        _undoBarrier = std::max(_undoBarrier, edits.sequence + 1);
+        _redoBarrier = std::min(_redoBarrier, edits.sequence);
+        TF_RUNTIME_ERROR(
+            "USD edits were discarded to stay within the undo memory budget, they and the "
+            "edits made %s them can't be %s.",
+            isUndo ? "before" : "after",
+            isUndo ? "undone" : "redone");
+    }
+    return !blocked;
+}
+
+void UsdUndoManager::enforceMemoryBudget()
+{
+    // the most recent edits are always kept, even when they are over budget alone.
+    while (_memoryBudget != 0 && _memoryUsage > _memoryBudget && _itemEdits.size() > 1) {
+        std::shared_ptr<UsdUndoableItem::Edits> edits = _itemEdits.front().lock();
+        _itemEdits.pop_front();
+        if (!edits || edits->expired) {
+            continue;
+        }
+
+        TF_DEBUG_MSG(
+            USDMAYA_UNDOSTACK,
+            "Discarding %zu bytes of edits to stay within the undo memory budget.\n",
+            edits->byteSize);
+
+        _memoryUsage -= std::min(_memoryUsage, edits->byteSize);
+        edits->invertFuncs = InvertFuncs();
+        edits->byteSize = 0;
+        edits->expired = true;
+    }
 }
 
 } // namespace MAYAUSD_NS_DEF
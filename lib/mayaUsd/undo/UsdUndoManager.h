@@ -23,7 +23,10 @@
 
 #include <pxr/usd/sdf/layer.h>
 
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -55,19 +58,59 @@ public:
     // tracks layer states by spawning a new UsdUndoStateDelegate
     void trackLayerStates(const SdfLayerHandle& layer);
 
+    // approximate number of bytes held by the undoable items alive, most of them
+    // being in Maya's undo queue.
+    size_t memoryUsage() const { return _memoryUsage; }
+
+    // maximum number of bytes held by the undoable items, 0 meaning no limit. The
+    // edits of the least recently done, undone or redone items are discarded when
+    // the budget is exceeded. Defaults to the MAYAUSD_UNDO_MEMORY_BUDGET_MB setting.
+    size_t memoryBudget() const { return _memoryBudget; }
+    void   setMemoryBudget(size_t bytes);
+
+    // number of times the collected edits were transferred to an undoable item. The
+    // edits collected between two transfers are those of a single undo block.
+    size_t transferCount() const { return _transferCount; }
+
 private:
     friend class UsdUndoStateDelegate;
     friend class UsdUndoBlock;
     friend class UsdUndoableItem;
 
-    UsdUndoManager() = default;
-    ~UsdUndoManager() = default;
+    UsdUndoManager();
+    ~UsdUndoManager();
 
-    void addInverse(InvertFunc func);
+    // byteSize is the approximate number of bytes held by the function.
+    void addInverse(InvertFunc func, size_t byteSize = 0);
     void transferEdits(UsdUndoableItem& undoableItem);
+    void enforceMemoryBudget();
+
+    // returns whether the edits can be undone or redone. Once an item with discarded edits
+    // is undone or redone, the items done before it can't be undone and the ones done after
+    // it can't be redone anymore, since they would apply to a different state than the one
+    // they were made on.
+    bool canInvert(const UsdUndoableItem::Edits& edits, bool isUndo);
+
+    // releases the edits of an undoable item, which can be destroyed after the undo
+    // manager when Maya's undo queue is flushed at exit.
+    static void releaseItemEdits(size_t byteSize);
 
 private:
     InvertFuncs _invertFuncs;
+    size_t      _byteSize { 0 };
+    size_t      _transferCount { 0 };
+    size_t      _itemCount { 0 };
+
+    // the items whose sequence is lower than _undoBarrier can't be undone, the ones whose
+    // sequence is greater than or equal to _redoBarrier can't be redone.
+    size_t _undoBarrier { 0 };
+    size_t _redoBarrier { SIZE_MAX };
+
+    // edits of the undoable items, from the least to the most recently transferred.
+    std::deque<std::weak_ptr<UsdUndoableItem::Edits>> _itemEdits;
+    size_t                                            _itemEditsAlive { 0 };
+    size_t                                            _memoryUsage { 0 };
+    size_t                                            _memoryBudget { 0 };
 };
 
 } // namespace MAYAUSD_NS_DEF
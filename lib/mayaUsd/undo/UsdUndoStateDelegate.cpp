@@ -20,11 +20,37 @@
 
 #include <mayaUsd/base/debugCodes.h>
 
+#include <pxr/usd/sdf/types.h>
+
+#include <algorithm>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace {
 
-void copySpecAtPath(const SdfAbstractData& src, SdfAbstractData* dst, const SdfPath& path)
+// Approximate number of bytes held by a value kept for an inverse edit. Only the
+// arrays, strings and time samples are worth accounting for.
+size_t estimateByteSize(const VtValue& value)
+{
+    size_t byteSize = sizeof(VtValue);
+    if (value.IsArrayValued()) {
+        const TfType elementType = SdfGetValueTypeNameForValue(value).GetScalarType().GetType();
+        byteSize += value.GetArraySize() * std::max<size_t>(elementType.GetSizeof(), 1);
+    } else if (value.IsHolding<std::string>()) {
+        byteSize += value.UncheckedGet<std::string>().size();
+    } else if (value.IsHolding<SdfTimeSampleMap>()) {
+        for (const auto& sample : value.UncheckedGet<SdfTimeSampleMap>()) {
+            byteSize += sizeof(sample.first) + estimateByteSize(sample.second);
+        }
+    }
+    return byteSize;
+}
+
+void copySpecAtPath(
+    const SdfAbstractData& src,
+    SdfAbstractData*       dst,
+    const SdfPath&         path,
+    size_t*                byteSize = nullptr)
 {
     // create a new spec at a path with the given specType
     dst->CreateSpec(path, src.GetSpecType(path));
@@ -34,7 +60,11 @@ void copySpecAtPath(const SdfAbstractData& src, SdfAbstractData* dst, const SdfP
 
     // set the value of dst at the given path and a fieldName
     for (const auto& token : tokens) {
-        dst->Set(path, token, src.Get(path, token));
+        const VtValue value = src.Get(path, token);
+        if (byteSize) {
+            *byteSize += estimateByteSize(value);
+        }
+        dst->Set(path, token, value);
     }
 }
 
@@ -69,6 +99,7 @@ namespace MAYAUSD_NS_DEF {
 UsdUndoStateDelegate::UsdUndoStateDelegate()
     : _dirty(false)
     , _setMessageAlreadyShowed(false)
+    , _coalescedTransferCount(0)
 {
     // TfDebug::Enable(USDMAYA_UNDOSTATEDELEGATE);
 }
@@ -269,14 +300,15 @@ void UsdUndoStateDelegate::_OnSetField(
             .Msg("Setting Field '%s' for Spec '%s'\n", fieldName.GetText(), path.GetText());
     }
 
-    if (!_layer) {
+    if (!_layer || _HasInverse(_EditKey(_EditKind::Field, path, fieldName, TfToken(), 0.0))) {
         return;
     }
 
     const VtValue inverseValue = _layer->GetField(path, fieldName);
 
     UsdUndoManager::instance().addInverse(
-        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue));
+        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue),
+        estimateByteSize(inverseValue));
 }
 
 void UsdUndoStateDelegate::_OnSetField(
@@ -296,7 +328,7 @@ void UsdUndoStateDelegate::_OnSetField(
             .Msg("Setting Field '%s' for Spec '%s'\n", fieldName.GetText(), path.GetText());
     }
 
-    if (!_layer) {
+    if (!_layer || _HasInverse(_EditKey(_EditKind::Field, path, fieldName, TfToken(), 0.0))) {
         return;
     }
 
@@ -304,7 +336,8 @@ void UsdUndoStateDelegate::_OnSetField(
 
     // add invert
     UsdUndoManager::instance().addInverse(
-        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue));
+        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue),
+        estimateByteSize(inverseValue));
 }
 
 void UsdUndoStateDelegate::_OnSetFieldDictValueByKey(
@@ -355,6 +388,8 @@ void UsdUndoStateDelegate::_OnCreateSpec(const SdfPath& path, SdfSpecType specTy
         return;
     }
 
+    _ResetCoalescing();
+
     UsdUndoManager::instance().addInverse(
         std::bind(&UsdUndoStateDelegate::invertCreateSpec, this, path, inert));
 }
@@ -376,19 +411,30 @@ void UsdUndoStateDelegate::_OnDeleteSpec(const SdfPath& path, bool inert)
         return;
     }
 
+    _ResetCoalescing();
+
     SdfDataRefPtr deletedData = TfCreateRefPtr(new SdfData());
 
     // traverse the hierarchy and call copySpecAtPath on each spec
-    auto layerDataPtr = std::cref(*get_pointer(_GetLayerData()));
-    auto deleteDataPtr = get_pointer(deletedData);
+    auto   layerDataPtr = std::cref(*get_pointer(_GetLayerData()));
+    auto   deleteDataPtr = get_pointer(deletedData);
+    size_t deletedByteSize = 0;
 
-    _GetLayer()->Traverse(
-        path, [&](const SdfPath& path) { copySpecAtPath(layerDataPtr, deleteDataPtr, path); });
+    _GetLayer()->Traverse(path, [&](const SdfPath& path) {
+        copySpecAtPath(layerDataPtr, deleteDataPtr, path, &deletedByteSize);
+    });
 
     const SdfSpecType deletedSpecType = _GetLayer()->GetSpecType(path);
 
-    UsdUndoManager::instance().addInverse(std::bind(
-        &UsdUndoStateDelegate::invertDeleteSpec, this, path, inert, deletedSpecType, deletedData));
+    UsdUndoManager::instance().addInverse(
+        std::bind(
+            &UsdUndoStateDelegate::invertDeleteSpec,
+            this,
+            path,
+            inert,
+            deletedSpecType,
+            deletedData),
+        deletedByteSize);
 }
 
 void UsdUndoStateDelegate::_OnMoveSpec(const SdfPath& oldPath, const SdfPath& newPath)
@@ -409,6 +455,8 @@ void UsdUndoStateDelegate::_OnMoveSpec(const SdfPath& oldPath, const SdfPath& ne
         return;
     }
 
+    _ResetCoalescing();
+
     UsdUndoManager::instance().addInverse(
         std::bind(&UsdUndoStateDelegate::invertMoveSpec, this, oldPath, newPath));
 }
@@ -534,19 +582,23 @@ void UsdUndoStateDelegate::_OnSetFieldDictValueByKeyImpl(
                 path.GetText());
     }
 
-    if (!_layer) {
+    // the inverse of an edit of the whole field restores the value of the key too
+    if (!_layer || _HasInverse(_EditKey(_EditKind::Field, path, fieldName, TfToken(), 0.0), false)
+        || _HasInverse(_EditKey(_EditKind::FieldDictValue, path, fieldName, keyPath, 0.0))) {
         return;
     }
 
     const VtValue inverseValue = _layer->GetFieldDictValueByKey(path, fieldName, keyPath);
 
-    UsdUndoManager::instance().addInverse(std::bind(
-        &UsdUndoStateDelegate::invertSetFieldDictValueByKey,
-        this,
-        path,
-        fieldName,
-        keyPath,
-        inverseValue));
+    UsdUndoManager::instance().addInverse(
+        std::bind(
+            &UsdUndoStateDelegate::invertSetFieldDictValueByKey,
+            this,
+            path,
+            fieldName,
+            keyPath,
+            inverseValue),
+        estimateByteSize(inverseValue));
 }
 
 void UsdUndoStateDelegate::_OnSetTimeSampleImpl(const SdfPath& path, double time)
@@ -561,7 +613,14 @@ void UsdUndoStateDelegate::_OnSetTimeSampleImpl(const SdfPath& path, double time
     TF_DEBUG(USDMAYA_UNDOSTATEDELEGATE)
         .Msg("Setting time sample '%f' for spec '%s'\n", time, path.GetText());
 
+    // the inverse of an edit of the whole field restores all the time samples
+    const _EditKey fieldKey(_EditKind::Field, path, SdfFieldKeys->TimeSamples, TfToken(), 0.0);
+
     if (!_GetLayer()->HasField(path, SdfFieldKeys->TimeSamples)) {
+        if (_HasInverse(fieldKey)) {
+            return;
+        }
+
         UsdUndoManager::instance().addInverse(std::bind(
             &UsdUndoStateDelegate::invertSetField,
             this,
@@ -570,15 +629,38 @@ void UsdUndoStateDelegate::_OnSetTimeSampleImpl(const SdfPath& path, double time
             VtValue()));
 
     } else {
+        if (_HasInverse(fieldKey, false)
+            || _HasInverse(_EditKey(_EditKind::TimeSample, path, TfToken(), TfToken(), time))) {
+            return;
+        }
+
         VtValue oldValue;
 
         _GetLayer()->QueryTimeSample(path, time, &oldValue);
 
         UsdUndoManager::instance().addInverse(
-            std::bind(&UsdUndoStateDelegate::invertSetTimeSample, this, path, time, oldValue));
+            std::bind(&UsdUndoStateDelegate::invertSetTimeSample, this, path, time, oldValue),
+            estimateByteSize(oldValue));
     }
 }
 
+bool UsdUndoStateDelegate::_HasInverse(const _EditKey& key, bool record)
+{
+    // the edits collected since the last transfer are those of the current undo block
+    const size_t transferCount = UsdUndoManager::instance().transferCount();
+    if (transferCount != _coalescedTransferCount) {
+        _coalescedEdits.clear();
+        _coalescedTransferCount = transferCount;
+    }
+
+    if (!record) {
+        return _coalescedEdits.count(key) != 0;
+    }
+    return !_coalescedEdits.insert(key).second;
+}
+
+void UsdUndoStateDelegate::_ResetCoalescing() { _coalescedEdits.clear(); }
+
 // We hit a wall when running testGroupCmd with the new Undo/Redo service.
 // Grouping involves two command operation (AddPrim, Parent) and during the parent::undo(), the
 // parented token (newGroup1) wasn't properly removed which caused the test to fail.
@@ -25,6 +25,9 @@
 // convenient way to bring in other headers
 #include <pxr/usd/usd/prim.h>
 
+#include <set>
+#include <tuple>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace MAYAUSD_NS_DEF {
@@ -123,10 +126,33 @@ private:
     template <class T>
     void _PopChild(const SdfPath& parentPath, const TfToken& fieldName, const T& oldValue);
 
+    // Edited values, identified by their kind, spec path, field name, dictionary key
+    // path and time.
+    enum class _EditKind
+    {
+        Field,
+        FieldDictValue,
+        TimeSample
+    };
+    using _EditKey = std::tuple<_EditKind, SdfPath, TfToken, TfToken, double>;
+
+    // Returns true if the inverse of an edit of the given value was already collected
+    // in the current undo block, and records it otherwise when record is true. Inverses
+    // restore the value before the edit and are invoked in reverse order, so only the
+    // first edit of a value in a block needs one.
+    bool _HasInverse(const _EditKey& key, bool record = true);
+
+    // Edits of the specs themselves can move values around: stop coalescing the
+    // edits of the values made before them with the ones made after.
+    void _ResetCoalescing();
+
 private:
     SdfLayerHandle _layer;
     bool           _dirty;
     bool           _setMessageAlreadyShowed;
+
+    std::set<_EditKey> _coalescedEdits;
+    size_t             _coalescedTransferCount;
 };
 
 } // namespace MAYAUSD_NS_DEF
@@ -17,28 +17,42 @@
 #include "UsdUndoableItem.h"
 
 #include <mayaUsd/undo/UsdUndoBlock.h>
+#include <mayaUsd/undo/UsdUndoManager.h>
 
 #include <pxr/usd/sdf/changeBlock.h>
 
 namespace MAYAUSD_NS_DEF {
 
-void UsdUndoableItem::undo() { doInvert(); }
+void UsdUndoableItem::undo() { doInvert(true); }
 
-void UsdUndoableItem::redo() { doInvert(); }
+void UsdUndoableItem::redo() { doInvert(false); }
 
-void UsdUndoableItem::doInvert()
+size_t UsdUndoableItem::byteSize() const { return _edits ? _edits->byteSize : 0; }
+
+bool UsdUndoableItem::expired() const { return _edits && _edits->expired; }
+
+UsdUndoableItem::Edits::~Edits() { UsdUndoManager::releaseItemEdits(byteSize); }
+
+void UsdUndoableItem::doInvert(bool isUndo)
 {
     if (UsdUndoBlock::depth() != 0) {
         TF_CODING_ERROR("Inversion during open edit block may result in corrupted undo "
                         "stack.");
     }
 
+    if (_edits && !UsdUndoManager::instance().canInvert(*_edits, isUndo)) {
+        return;
+    }
+
+    // hold on to the edits: the undo block replaces them with their inverse
+    const std::shared_ptr<Edits> edits = _edits;
+
     UsdUndoBlock undoBlock(this);
 
     // call invert functions in reverse order
-    {
+    if (edits) {
         SdfChangeBlock changeBlock;
-        for (auto it = _invertFuncs.rbegin(); it != _invertFuncs.rend(); ++it) {
+        for (auto it = edits->invertFuncs.rbegin(); it != edits->invertFuncs.rend(); ++it) {
             (*it)();
         }
     }
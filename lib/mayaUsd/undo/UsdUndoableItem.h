@@ -20,6 +20,7 @@
 #include <mayaUsd/base/api.h>
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace MAYAUSD_NS_DEF {
@@ -50,12 +51,34 @@ public:
     void undo();
     void redo();
 
+    // approximate number of bytes held by the inverse edits.
+    size_t byteSize() const;
+
+    // true when the inverse edits were discarded to stay within the undo memory budget
+    // (see UsdUndoManager::setMemoryBudget), in which case undo() and redo() report an
+    // error and do nothing, and so do the undo of the items done before it and the redo
+    // of the items done after it.
+    bool expired() const;
+
 private:
     friend class UsdUndoManager;
 
-    void doInvert();
+    // The edits are shared by the copies of the item, which lets the undo manager
+    // account for the memory they hold and discard them when over budget.
+    struct Edits
+    {
+        Edits() = default;
+        ~Edits();
+
+        InvertFuncs invertFuncs;
+        size_t      byteSize = 0;
+        bool        expired = false;
+        size_t      sequence = 0; // order in which the item was first done
+    };
+
+    void doInvert(bool isUndo);
 
-    InvertFuncs _invertFuncs;
+    std::shared_ptr<Edits> _edits;
 };
 
 } // namespace MAYAUSD_NS_DEF
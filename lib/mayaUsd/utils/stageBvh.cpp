@@ -0,0 +1,540 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "stageBvh.h"
+
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usdGeom/imageable.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformCache.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+// Maximum number of triangles in a leaf.
+constexpr uint32_t kMaxLeafSize = 4;
+
+// Enough for any tree built by median splits of up to 2^64 triangles.
+constexpr size_t kMaxStackSize = 64;
+
+bool _IsExcluded(const SdfPath& path, const SdfPathVector& excludePrimPaths)
+{
+    for (const SdfPath& excluded : excludePrimPaths) {
+        if (path.HasPrefix(excluded)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the distance along the ray at which it enters the box, or infinity if it misses it.
+inline float
+_IntersectBox(const GfVec3f& min, const GfVec3f& max, const GfVec3f& origin, const GfVec3f& invDir)
+{
+    float tMin = 0.0f;
+    float tMax = std::numeric_limits<float>::infinity();
+    for (int axis = 0; axis < 3; ++axis) {
+        float t0 = (min[axis] - origin[axis]) * invDir[axis];
+        float t1 = (max[axis] - origin[axis]) * invDir[axis];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+    }
+    return tMin <= tMax ? tMin : std::numeric_limits<float>::infinity();
+}
+
+// Moller-Trumbore ray / triangle intersection.
+inline bool _IntersectTriangle(
+    const GfVec3f& origin,
+    const GfVec3f& dir,
+    const GfVec3f& v0,
+    const GfVec3f& v1,
+    const GfVec3f& v2,
+    float*         t)
+{
+    const GfVec3f e1 = v1 - v0;
+    const GfVec3f e2 = v2 - v0;
+    const GfVec3f p = GfCross(dir, e2);
+    const float   det = GfDot(e1, p);
+    if (std::fabs(det) < std::numeric_limits<float>::min()) {
+        return false;
+    }
+    const float   invDet = 1.0f / det;
+    const GfVec3f s = origin - v0;
+    const float   u = GfDot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    const GfVec3f q = GfCross(s, e1);
+    const float   v = GfDot(dir, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    *t = GfDot(e2, q) * invDet;
+    return *t >= 0.0f;
+}
+
+// Returns whether the local to world transform of prim might vary over time, caching the result
+// of its ancestors in varyingByPath.
+bool _TransformMightBeTimeVarying(
+    const UsdPrim&                                   prim,
+    std::unordered_map<SdfPath, bool, SdfPath::Hash>* varyingByPath)
+{
+    if (!prim || prim.IsPseudoRoot()) {
+        return false;
+    }
+    const auto it = varyingByPath->find(prim.GetPath());
+    if (it != varyingByPath->end()) {
+        return it->second;
+    }
+    const UsdGeomXformable xformable(prim);
+    const bool             varying = (xformable && xformable.TransformMightBeTimeVarying())
+        || _TransformMightBeTimeVarying(prim.GetParent(), varyingByPath);
+    (*varyingByPath)[prim.GetPath()] = varying;
+    return varying;
+}
+
+} // namespace
+
+UsdMayaStageBvh::UsdMayaStageBvh() = default;
+
+void UsdMayaStageBvh::Update(
+    const UsdPrim&       root,
+    UsdTimeCode          time,
+    const TfTokenVector& purposes,
+    const SdfPathVector& excludePrimPaths)
+{
+    if (!root) {
+        _stage = UsdStageWeakPtr();
+        _meshes.clear();
+        _positions.clear();
+        _triangles.clear();
+        _nodes.clear();
+        _needsRebuild = true;
+        return;
+    }
+
+    if (root.GetStage() != _stage || root.GetPath() != _rootPath || purposes != _purposes
+        || excludePrimPaths != _excludePrimPaths) {
+        _stage = root.GetStage();
+        _rootPath = root.GetPath();
+        _purposes = purposes;
+        _excludePrimPaths = excludePrimPaths;
+        _needsRebuild = true;
+    }
+
+    const bool timeChanged = time != _time;
+    if (_needsRebuild || (timeChanged && _structureVarying)) {
+        _Build(root, time);
+    } else if (_needsRefit || (timeChanged && _hasVaryingMeshes)) {
+        _Refit(root, time);
+    }
+    _time = time;
+}
+
+void UsdMayaStageBvh::OnObjectsChanged(const UsdNotice::ObjectsChanged& notice)
+{
+    if (_needsRebuild || notice.GetStage() != _stage) {
+        return;
+    }
+
+    auto affectsRoot = [this](const SdfPath& primPath) {
+        return primPath.HasPrefix(_rootPath) || _rootPath.HasPrefix(primPath);
+    };
+
+    for (const SdfPath& path : notice.GetResyncedPaths()) {
+        if (affectsRoot(path.GetPrimPath())) {
+            _needsRebuild = true;
+            return;
+        }
+    }
+
+    for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+        if (!path.IsPropertyPath() || !affectsRoot(path.GetPrimPath())) {
+            continue;
+        }
+        const TfToken& name = path.GetNameToken();
+        if (name == UsdGeomTokens->points || name == UsdGeomTokens->xformOpOrder
+            || TfStringStartsWith(name.GetString(), "xformOp:")) {
+            // Moving geometry only needs the bounds to be refit.
+            _needsRefit = true;
+        } else if (
+            name == UsdGeomTokens->faceVertexCounts || name == UsdGeomTokens->faceVertexIndices
+            || name == UsdGeomTokens->visibility || name == UsdGeomTokens->purpose) {
+            _needsRebuild = true;
+            return;
+        }
+    }
+}
+
+void UsdMayaStageBvh::Invalidate() { _needsRebuild = true; }
+
+void UsdMayaStageBvh::_Build(const UsdPrim& root, UsdTimeCode time)
+{
+    _meshes.clear();
+    _positions.clear();
+    _triangles.clear();
+    _nodes.clear();
+    _structureVarying = false;
+    _hasVaryingMeshes = false;
+    _needsRebuild = false;
+    _needsRefit = false;
+
+    // The meshes move if any of the ancestors of the root does.
+    bool ancestorsVarying = false;
+    for (UsdPrim prim = root.GetParent(); prim; prim = prim.GetParent()) {
+        const UsdGeomXformable xformable(prim);
+        if (xformable && xformable.TransformMightBeTimeVarying()) {
+            ancestorsVarying = true;
+            break;
+        }
+    }
+
+    UsdGeomXformCache xformCache(time);
+    _CollectMeshes(root, time, xformCache, UsdGeomTokens->default_, ancestorsVarying);
+
+    if (_triangles.empty()) {
+        return;
+    }
+    _nodes.reserve(2 * (_triangles.size() / kMaxLeafSize + 1));
+    _nodes.emplace_back();
+    _BuildNode(0, 0, static_cast<uint32_t>(_triangles.size()));
+}
+
+void UsdMayaStageBvh::_CollectMeshes(
+    const UsdPrim&     prim,
+    UsdTimeCode        time,
+    UsdGeomXformCache& xformCache,
+    const TfToken&     inheritedPurpose,
+    bool               inheritedVarying)
+{
+    if (_IsExcluded(prim.GetPath(), _excludePrimPaths)) {
+        return;
+    }
+
+    TfToken purpose = inheritedPurpose;
+    bool    varying = inheritedVarying;
+    if (const UsdGeomImageable imageable = UsdGeomImageable(prim)) {
+        const UsdAttribute visibilityAttr = imageable.GetVisibilityAttr();
+        if (visibilityAttr.ValueMightBeTimeVarying()) {
+            _structureVarying = true;
+        }
+        TfToken visibility;
+        if (visibilityAttr.Get(&visibility, time) && visibility == UsdGeomTokens->invisible) {
+            return;
+        }
+
+        // A non-default purpose is inherited by the whole subtree.
+        if (purpose == UsdGeomTokens->default_) {
+            const UsdAttribute purposeAttr = imageable.GetPurposeAttr();
+            if (purposeAttr.HasAuthoredValue()) {
+                purposeAttr.Get(&purpose);
+            }
+        }
+        if (std::find(_purposes.begin(), _purposes.end(), purpose) == _purposes.end()) {
+            return;
+        }
+    }
+
+    if (const UsdGeomXformable xformable = UsdGeomXformable(prim)) {
+        varying = varying || xformable.TransformMightBeTimeVarying();
+    }
+
+    if (prim.IsA<UsdGeomMesh>()) {
+        _AddMesh(prim, time, xformCache, varying);
+    }
+
+    for (const UsdPrim& child : prim.GetFilteredChildren(UsdTraverseInstanceProxies())) {
+        _CollectMeshes(child, time, xformCache, purpose, varying);
+    }
+}
+
+void UsdMayaStageBvh::_AddMesh(
+    const UsdPrim&     prim,
+    UsdTimeCode        time,
+    UsdGeomXformCache& xformCache,
+    bool               xformVarying)
+{
+    const UsdGeomMesh  mesh(prim);
+    const UsdAttribute countsAttr = mesh.GetFaceVertexCountsAttr();
+    const UsdAttribute indicesAttr = mesh.GetFaceVertexIndicesAttr();
+    if (countsAttr.ValueMightBeTimeVarying() || indicesAttr.ValueMightBeTimeVarying()) {
+        _structureVarying = true;
+    }
+
+    VtIntArray   faceVertexCounts;
+    VtIntArray   faceVertexIndices;
+    VtVec3fArray points;
+    _Mesh        entry;
+    entry.prim = prim;
+    entry.points = UsdAttributeQuery(mesh.GetPointsAttr());
+    if (!countsAttr.Get(&faceVertexCounts, time) || !indicesAttr.Get(&faceVertexIndices, time)
+        || !entry.points.Get(&points, time) || points.empty()) {
+        return;
+    }
+    entry.varying = xformVarying || entry.points.ValueMightBeTimeVarying();
+    entry.firstPosition = static_cast<uint32_t>(_positions.size());
+    entry.positionCount = static_cast<uint32_t>(points.size());
+    _positions.resize(_positions.size() + points.size());
+    entry.localToWorld = xformCache.GetLocalToWorldTransform(prim);
+    _TransformPositions(entry, points);
+
+    // Fan triangulation of each face, skipping the invalid ones.
+    const uint32_t meshIndex = static_cast<uint32_t>(_meshes.size());
+    const int      pointCount = static_cast<int>(points.size());
+    const size_t   indexCount = faceVertexIndices.size();
+    const int*     indices = faceVertexIndices.cdata();
+    size_t         offset = 0;
+    for (const int count : static_cast<const VtIntArray&>(faceVertexCounts)) {
+        if (count < 0 || offset + count > indexCount) {
+            break;
+        }
+        const int a = indices[offset];
+        for (int i = 1; i + 1 < count; ++i) {
+            const int b = indices[offset + i];
+            const int c = indices[offset + i + 1];
+            if (a < 0 || b < 0 || c < 0 || a >= pointCount || b >= pointCount
+                || c >= pointCount) {
+                continue;
+            }
+            _triangles.push_back({ { entry.firstPosition + a,
+                                     entry.firstPosition + b,
+                                     entry.firstPosition + c },
+                                   meshIndex });
+        }
+        offset += count;
+    }
+
+    _hasVaryingMeshes = _hasVaryingMeshes || entry.varying;
+    _meshes.push_back(entry);
+}
+
+void UsdMayaStageBvh::_TransformPositions(const _Mesh& mesh, const VtVec3fArray& points)
+{
+    GfVec3f* dst = _positions.data() + mesh.firstPosition;
+    for (const GfVec3f& point : points) {
+        *dst++ = GfVec3f(mesh.localToWorld.Transform(GfVec3d(point)));
+    }
+}
+
+void UsdMayaStageBvh::_BuildNode(uint32_t nodeIndex, uint32_t first, uint32_t count)
+{
+    // Bounds of the triangles, and of their centroids to choose the split.
+    GfVec3f min(std::numeric_limits<float>::max());
+    GfVec3f max(-std::numeric_limits<float>::max());
+    GfVec3f centroidMin = min;
+    GfVec3f centroidMax = max;
+    for (uint32_t i = first; i < first + count; ++i) {
+        const _Triangle& triangle = _triangles[i];
+        GfVec3f          centroid(0.0f);
+        for (const uint32_t vertex : triangle.vertices) {
+            const GfVec3f& position = _positions[vertex];
+            for (int axis = 0; axis < 3; ++axis) {
+                min[axis] = std::min(min[axis], position[axis]);
+                max[axis] = std::max(max[axis], position[axis]);
+            }
+            centroid += position;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            centroidMin[axis] = std::min(centroidMin[axis], centroid[axis]);
+            centroidMax[axis] = std::max(centroidMax[axis], centroid[axis]);
+        }
+    }
+    _nodes[nodeIndex].min = min;
+    _nodes[nodeIndex].max = max;
+
+    const GfVec3f extent = centroidMax - centroidMin;
+    const int     axis = extent[0] > extent[1] ? (extent[0] > extent[2] ? 0 : 2)
+                                               : (extent[1] > extent[2] ? 1 : 2);
+    if (count <= kMaxLeafSize || extent[axis] <= 0.0f) {
+        _nodes[nodeIndex].index = first;
+        _nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // Median split along the largest axis of the centroids.
+    const uint32_t middle = first + count / 2;
+    auto           centroid = [this, axis](const _Triangle& triangle) {
+        return _positions[triangle.vertices[0]][axis] + _positions[triangle.vertices[1]][axis]
+            + _positions[triangle.vertices[2]][axis];
+    };
+    std::nth_element(
+        _triangles.begin() + first,
+        _triangles.begin() + middle,
+        _triangles.begin() + first + count,
+        [&centroid](const _Triangle& a, const _Triangle& b) {
+            return centroid(a) < centroid(b);
+        });
+
+    const uint32_t left = static_cast<uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+    _nodes.emplace_back();
+    _nodes[nodeIndex].index = left;
+    _nodes[nodeIndex].count = 0;
+    _BuildNode(left, first, middle - first);
+    _BuildNode(left + 1, middle, first + count - middle);
+}
+
+void UsdMayaStageBvh::_Refit(const UsdPrim& root, UsdTimeCode time)
+{
+    // An edit of the points or transforms may have made them time-varying, or constant, so
+    // which meshes are refit when the time changes is recomputed along with their positions.
+    const bool                                       edited = _needsRefit;
+    std::unordered_map<SdfPath, bool, SdfPath::Hash> xformVaryingByPath;
+    if (edited) {
+        _hasVaryingMeshes = false;
+    }
+
+    UsdGeomXformCache xformCache(time);
+    for (_Mesh& mesh : _meshes) {
+        if (edited) {
+            mesh.points = UsdAttributeQuery(UsdGeomMesh(mesh.prim).GetPointsAttr());
+            mesh.varying = _TransformMightBeTimeVarying(mesh.prim, &xformVaryingByPath)
+                || mesh.points.ValueMightBeTimeVarying();
+            _hasVaryingMeshes = _hasVaryingMeshes || mesh.varying;
+        } else if (!mesh.varying) {
+            continue;
+        }
+        VtVec3fArray points;
+        if (!mesh.points.Get(&points, time) || points.size() != mesh.positionCount) {
+            // The topology changed: the triangles are no longer valid.
+            _Build(root, time);
+            return;
+        }
+        mesh.localToWorld = xformCache.GetLocalToWorldTransform(mesh.prim);
+        _TransformPositions(mesh, points);
+    }
+    _needsRefit = false;
+
+    // Children are stored after their parent, so the bounds can be updated bottom-up in a
+    // single reverse pass.
+    for (size_t i = _nodes.size(); i-- > 0;) {
+        _Node&  node = _nodes[i];
+        GfVec3f min(std::numeric_limits<float>::max());
+        GfVec3f max(-std::numeric_limits<float>::max());
+        if (node.count > 0) {
+            for (uint32_t t = node.index; t < node.index + node.count; ++t) {
+                for (const uint32_t vertex : _triangles[t].vertices) {
+                    const GfVec3f& position = _positions[vertex];
+                    for (int axis = 0; axis < 3; ++axis) {
+                        min[axis] = std::min(min[axis], position[axis]);
+                        max[axis] = std::max(max[axis], position[axis]);
+                    }
+                }
+            }
+        } else {
+            for (uint32_t child = node.index; child < node.index + 2; ++child) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    min[axis] = std::min(min[axis], _nodes[child].min[axis]);
+                    max[axis] = std::max(max[axis], _nodes[child].max[axis]);
+                }
+            }
+        }
+        node.min = min;
+        node.max = max;
+    }
+}
+
+bool UsdMayaStageBvh::Intersect(const GfRay& ray, Hit* hit) const
+{
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    const GfVec3f origin(ray.GetStartPoint());
+    const GfVec3f dir(ray.GetDirection());
+    const GfVec3f invDir(1.0f / dir[0], 1.0f / dir[1], 1.0f / dir[2]);
+
+    float    closest = std::numeric_limits<float>::infinity();
+    uint32_t closestTriangle = 0;
+
+    uint32_t stack[kMaxStackSize];
+    size_t   stackSize = 0;
+    if (_IntersectBox(_nodes[0].min, _nodes[0].max, origin, invDir) < closest) {
+        stack[stackSize++] = 0;
+    }
+    while (stackSize > 0) {
+        const _Node& node = _nodes[stack[--stackSize]];
+        if (node.count > 0) {
+            for (uint32_t i = node.index; i < node.index + node.count; ++i) {
+                const _Triangle& triangle = _triangles[i];
+                float            t;
+                if (_IntersectTriangle(
+                        origin,
+                        dir,
+                        _positions[triangle.vertices[0]],
+                        _positions[triangle.vertices[1]],
+                        _positions[triangle.vertices[2]],
+                        &t)
+                    && t < closest) {
+                    closest = t;
+                    closestTriangle = i;
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearest child first, so that the farthest one can be culled by its hits.
+        uint32_t nearChild = node.index;
+        uint32_t farChild = node.index + 1;
+        float tNear = _IntersectBox(_nodes[nearChild].min, _nodes[nearChild].max, origin, invDir);
+        float tFar = _IntersectBox(_nodes[farChild].min, _nodes[farChild].max, origin, invDir);
+        if (tFar < tNear) {
+            std::swap(nearChild, farChild);
+            std::swap(tNear, tFar);
+        }
+        if (tFar < closest && stackSize < kMaxStackSize) {
+            stack[stackSize++] = farChild;
+        }
+        if (tNear < closest && stackSize < kMaxStackSize) {
+            stack[stackSize++] = nearChild;
+        }
+    }
+
+    if (closest == std::numeric_limits<float>::infinity()) {
+        return false;
+    }
+
+    if (hit) {
+        const _Triangle& triangle = _triangles[closestTriangle];
+        const GfVec3d    v0(_positions[triangle.vertices[0]]);
+        GfVec3d          normal = GfCross(
+            GfVec3d(_positions[triangle.vertices[1]]) - v0,
+            GfVec3d(_positions[triangle.vertices[2]]) - v0);
+        normal.Normalize();
+        if (GfDot(normal, ray.GetDirection()) > 0.0) {
+            normal = -normal;
+        }
+        hit->distance = closest;
+        hit->point = ray.GetPoint(closest);
+        hit->normal = normal;
+        hit->primPath = _meshes[triangle.mesh].prim.GetPath();
+    }
+    return true;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
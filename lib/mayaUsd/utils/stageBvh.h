@@ -0,0 +1,155 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_STAGE_BVH_H
+#define PXRUSDMAYA_STAGE_BVH_H
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/ray.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/attributeQuery.h>
+#include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/timeCode.h>
+
+#include <cstdint>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+class UsdGeomXformCache;
+
+/// Bounding volume hierarchy over the triangles of the UsdGeomMesh prims found under a root
+/// prim, used to intersect rays with a stage on the CPU, without drawing it.
+///
+/// The meshes are collected, in world space, for a given time, set of purposes and excluded
+/// paths, honoring the visibility. The hierarchy is built lazily by Update(), and only refit
+/// when the time changes and some meshes are deforming or moving. It is rebuilt when the
+/// topology, visibility, purpose or the prims change, as reported to OnObjectsChanged().
+class UsdMayaStageBvh
+{
+public:
+    struct Hit
+    {
+        GfVec3d point;
+        /// Geometric normal of the hit triangle, facing the ray origin.
+        GfVec3d normal;
+        /// Distance from the ray origin, in units of the ray direction length.
+        double  distance;
+        SdfPath primPath;
+    };
+
+    MAYAUSD_CORE_PUBLIC
+    UsdMayaStageBvh();
+
+    /// Makes the hierarchy match the meshes under \p root at \p time, building or refitting it
+    /// if needed.
+    MAYAUSD_CORE_PUBLIC
+    void Update(
+        const UsdPrim&       root,
+        UsdTimeCode          time,
+        const TfTokenVector& purposes,
+        const SdfPathVector& excludePrimPaths);
+
+    /// Marks the hierarchy for rebuild or refit, depending on the changes.
+    MAYAUSD_CORE_PUBLIC
+    void OnObjectsChanged(const UsdNotice::ObjectsChanged& notice);
+
+    /// Forces a rebuild on the next Update().
+    MAYAUSD_CORE_PUBLIC
+    void Invalidate();
+
+    /// Finds the closest intersection of \p ray, in world space, with the meshes.
+    MAYAUSD_CORE_PUBLIC
+    bool Intersect(const GfRay& ray, Hit* hit) const;
+
+    MAYAUSD_CORE_PUBLIC
+    size_t GetMeshCount() const { return _meshes.size(); }
+
+    MAYAUSD_CORE_PUBLIC
+    size_t GetTriangleCount() const { return _triangles.size(); }
+
+private:
+    struct _Mesh
+    {
+        UsdPrim           prim;
+        UsdAttributeQuery points;
+        GfMatrix4d        localToWorld;
+        uint32_t          firstPosition;
+        uint32_t          positionCount;
+        bool              varying;
+    };
+
+    struct _Triangle
+    {
+        uint32_t vertices[3];
+        uint32_t mesh;
+    };
+
+    // Inner nodes have their two children stored contiguously at index, leaves (count > 0)
+    // reference count triangles from index. Children are always stored after their parent.
+    struct _Node
+    {
+        GfVec3f  min;
+        GfVec3f  max;
+        uint32_t index;
+        uint32_t count;
+    };
+
+    void _Build(const UsdPrim& root, UsdTimeCode time);
+    void _CollectMeshes(
+        const UsdPrim&     prim,
+        UsdTimeCode        time,
+        UsdGeomXformCache& xformCache,
+        const TfToken&     inheritedPurpose,
+        bool               inheritedVarying);
+    void _AddMesh(
+        const UsdPrim&     prim,
+        UsdTimeCode        time,
+        UsdGeomXformCache& xformCache,
+        bool               xformVarying);
+    void _TransformPositions(const _Mesh& mesh, const VtVec3fArray& points);
+    void _BuildNode(uint32_t nodeIndex, uint32_t first, uint32_t count);
+    void _Refit(const UsdPrim& root, UsdTimeCode time);
+
+    UsdStageWeakPtr _stage;
+    SdfPath         _rootPath;
+    UsdTimeCode     _time;
+    TfTokenVector   _purposes;
+    SdfPathVector   _excludePrimPaths;
+
+    std::vector<_Mesh>     _meshes;
+    std::vector<GfVec3f>   _positions;
+    std::vector<_Triangle> _triangles;
+    std::vector<_Node>     _nodes;
+
+    bool _needsRebuild { true };
+    bool _needsRefit { false };
+    // Whether the set of meshes or their topology can change over time.
+    bool _structureVarying { false };
+    bool _hasVaryingMeshes { false };
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -0,0 +1,201 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "subtreeBoundsCache.h"
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/usd/usd/primFlags.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usd/typed.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
+#include <pxr/usd/usdGeom/boundable.h>
+#include <pxr/usd/usdGeom/imageable.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+// Like UsdGeomBBoxCache, the prims that are typeless or of an unknown type contribute to the
+// bound of their parent, as they may have imageable descendants. Of the typed prims, only the
+// imageable ones that are not invisible contribute.
+bool _ContributesToBound(const UsdPrim& prim, UsdTimeCode time)
+{
+    if (!prim.IsA<UsdTyped>()) {
+        return true;
+    }
+    const UsdGeomImageable imageable(prim);
+    if (!imageable) {
+        return false;
+    }
+    TfToken visibility;
+    return !imageable.GetVisibilityAttr().Get(&visibility, time)
+        || visibility != UsdGeomTokens->invisible;
+}
+
+// Returns the path of the root prim \p primPath is under, which is the prototype for the prims
+// in a prototype.
+SdfPath _GetRootPrimPath(const SdfPath& primPath)
+{
+    SdfPath path = primPath;
+    while (!path.IsEmpty() && !path.IsAbsoluteRootPath() && !path.IsRootPrimPath()) {
+        path = path.GetParentPath();
+    }
+    return path.IsRootPrimPath() ? path : SdfPath();
+}
+
+} // namespace
+
+GfBBox3d UsdMayaSubtreeBoundsCache::ComputeUntransformedBound(
+    const UsdPrim&       root,
+    UsdTimeCode          time,
+    const TfTokenVector& purposes,
+    bool                 timeVarying)
+{
+    if ((timeVarying && time != _time) || purposes != _purposes) {
+        Clear();
+    }
+    _time = time;
+    _purposes = purposes;
+
+    UsdGeomBBoxCache bboxCache(time, purposes);
+    if (!_ContributesToBound(root, time)) {
+        return bboxCache.ComputeUntransformedBound(root);
+    }
+    return _ComputeBound(root, bboxCache);
+}
+
+void UsdMayaSubtreeBoundsCache::InvalidateTransform(const SdfPath& primPath)
+{
+    _InvalidateAncestors(primPath);
+}
+
+void UsdMayaSubtreeBoundsCache::InvalidateSubtree(const SdfPath& primPath)
+{
+    auto it = _bounds.lower_bound(primPath);
+    while (it != _bounds.end() && it->first.HasPrefix(primPath)) {
+        it = _bounds.erase(it);
+    }
+    _InvalidateAncestors(primPath);
+}
+
+bool UsdMayaSubtreeBoundsCache::DependsOnPrototypeOf(const SdfPath& primPath) const
+{
+    return !_prototypeInstances.empty() && _prototypeInstances.count(_GetRootPrimPath(primPath));
+}
+
+void UsdMayaSubtreeBoundsCache::Clear()
+{
+    _bounds.clear();
+    _prototypeInstances.clear();
+}
+
+void UsdMayaSubtreeBoundsCache::_InvalidateAncestors(const SdfPath& primPath)
+{
+    for (SdfPath path = primPath.GetParentPath(); !path.IsEmpty(); path = path.GetParentPath()) {
+        _bounds.erase(path);
+    }
+
+    // An edit to a prototype affects the bounds of its instances. They were recorded when their
+    // bounds were computed, and may have moved or been removed since, in which case invalidating
+    // them is harmless.
+    if (_prototypeInstances.empty()) {
+        return;
+    }
+    const auto instances = _prototypeInstances.find(_GetRootPrimPath(primPath));
+    if (instances != _prototypeInstances.end()) {
+        // Instances nested in a prototype invalidate the instances of that prototype in turn.
+        const SdfPathSet instancePaths = instances->second;
+        for (const SdfPath& instancePath : instancePaths) {
+            InvalidateSubtree(instancePath);
+        }
+    }
+}
+
+void UsdMayaSubtreeBoundsCache::_AddInstances(const UsdPrim& prim)
+{
+    for (const UsdPrim& descendant : UsdPrimRange(prim)) {
+        if (!descendant.IsInstance()) {
+            continue;
+        }
+#if PXR_VERSION >= 2011
+        const UsdPrim prototype = descendant.GetPrototype();
+#else
+        const UsdPrim prototype = descendant.GetMaster();
+#endif
+        if (!prototype) {
+            continue;
+        }
+        auto inserted = _prototypeInstances.emplace(prototype.GetPath(), SdfPathSet());
+        inserted.first->second.insert(descendant.GetPath());
+        if (inserted.second) {
+            // The instances nested in the prototype are also computed by UsdGeomBBoxCache.
+            _AddInstances(prototype);
+        }
+    }
+}
+
+GfBBox3d
+UsdMayaSubtreeBoundsCache::_ComputeBound(const UsdPrim& prim, UsdGeomBBoxCache& bboxCache)
+{
+    const auto cached = _bounds.find(prim.GetPath());
+    if (cached != _bounds.end()) {
+        return cached->second;
+    }
+
+    // Prims that only group other prims accumulate the bounds of their children, the others are
+    // left to UsdGeomBBoxCache. So are the groups with a child resetting the transform stack.
+    bool isGroup = !prim.IsInstance() && !prim.IsA<UsdGeomBoundable>();
+    std::vector<std::pair<UsdPrim, GfMatrix4d>> children;
+    if (isGroup) {
+        for (const UsdPrim& child : prim.GetFilteredChildren(UsdTraverseInstanceProxies())) {
+            if (!_ContributesToBound(child, _time)) {
+                continue;
+            }
+            GfMatrix4d             localTransform(1.0);
+            bool                   resetsXformStack = false;
+            const UsdGeomXformable xformable(child);
+            if (xformable) {
+                xformable.GetLocalTransformation(&localTransform, &resetsXformStack, _time);
+            }
+            if (resetsXformStack) {
+                isGroup = false;
+                break;
+            }
+            children.emplace_back(child, localTransform);
+        }
+    }
+
+    GfBBox3d bound;
+    if (isGroup) {
+        for (const auto& child : children) {
+            GfBBox3d childBound = _ComputeBound(child.first, bboxCache);
+            childBound.Transform(child.second);
+            bound = GfBBox3d::Combine(bound, childBound);
+        }
+    } else {
+        bound = bboxCache.ComputeUntransformedBound(prim);
+        _AddInstances(prim);
+    }
+
+    _bounds.emplace(prim.GetPath(), bound);
+    return bound;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
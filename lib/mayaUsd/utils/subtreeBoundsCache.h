@@ -0,0 +1,95 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_SUBTREE_BOUNDS_CACHE_H
+#define PXRUSDMAYA_SUBTREE_BOUNDS_CACHE_H
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/gf/bbox3d.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/timeCode.h>
+
+#include <map>
+#include <unordered_map>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+class UsdGeomBBoxCache;
+
+/// Caches the untransformed bound of every transform subtree of a stage, so that an edit only
+/// requires the bounds of the edited prim and of its ancestors to be computed again.
+///
+/// The bounds are those of UsdGeomImageable::ComputeUntransformedBound(). They are accumulated
+/// from the children of the prims that only group other prims. Each gprim, point instancer or
+/// instance is computed by a UsdGeomBBoxCache, which can't be partially invalidated, and is
+/// therefore only used for the duration of one computation.
+///
+/// The bound of an instance depends on its prototype, whose edits are reported on the prototype
+/// paths. The instances whose bounds were computed are therefore recorded with their prototype,
+/// and are invalidated with it.
+class UsdMayaSubtreeBoundsCache
+{
+public:
+    /// Returns the bound of \p root at \p time for \p purposes, only computing the subtrees that
+    /// are not cached yet. The cache is cleared when \p purposes change, or when \p time changes
+    /// and the bounds are \p timeVarying.
+    MAYAUSD_CORE_PUBLIC
+    GfBBox3d ComputeUntransformedBound(
+        const UsdPrim&       root,
+        UsdTimeCode          time,
+        const TfTokenVector& purposes,
+        bool                 timeVarying = true);
+
+    /// The local transform of \p primPath changed: only the bounds of its ancestors are affected.
+    MAYAUSD_CORE_PUBLIC
+    void InvalidateTransform(const SdfPath& primPath);
+
+    /// \p primPath was resynced, or a property affecting its bound or the bounds of its
+    /// descendants changed: the bounds of its subtree and of its ancestors are affected.
+    MAYAUSD_CORE_PUBLIC
+    void InvalidateSubtree(const SdfPath& primPath);
+
+    /// Returns true if some cached bounds depend on the prototype \p primPath belongs to, so
+    /// that an edit to \p primPath affects them even though it is outside of their subtrees.
+    MAYAUSD_CORE_PUBLIC
+    bool DependsOnPrototypeOf(const SdfPath& primPath) const;
+
+    MAYAUSD_CORE_PUBLIC
+    void Clear();
+
+    MAYAUSD_CORE_PUBLIC
+    size_t GetCachedBoundCount() const { return _bounds.size(); }
+
+private:
+    GfBBox3d _ComputeBound(const UsdPrim& prim, UsdGeomBBoxCache& bboxCache);
+    void     _InvalidateAncestors(const SdfPath& primPath);
+    void     _AddInstances(const UsdPrim& prim);
+
+    // Ordered, so that the bounds of a subtree are contiguous.
+    std::map<SdfPath, GfBBox3d> _bounds;
+    UsdTimeCode                 _time;
+    TfTokenVector               _purposes;
+
+    // The instances in the subtrees computed by UsdGeomBBoxCache, by the path of their prototype.
+    std::unordered_map<SdfPath, SdfPathSet, SdfPath::Hash> _prototypeInstances;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
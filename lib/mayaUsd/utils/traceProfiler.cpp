@@ -0,0 +1,508 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "traceProfiler.h"
+
+#include <pxr/base/arch/threads.h>
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/envSetting.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_ENABLE_PROFILER,
+    false,
+    "Record the mayaUsd profiling scopes in the trace profiler from startup.");
+
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_PROFILER_BUFFER_SIZE,
+    65536,
+    "Number of events kept per thread by the trace profiler before the oldest are overwritten.");
+
+namespace {
+
+// Event names are truncated to fit the ring buffer entries.
+constexpr size_t kMaxEventNameLength = 64;
+
+struct Event
+{
+    char        name[kMaxEventNameLength];
+    const char* category;
+    int64_t     beginNs;
+    int64_t     durationNs;
+};
+
+constexpr size_t kEventWords = (sizeof(Event) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+// An entry of a ring buffer, which the exports may copy while its thread overwrites it. Its
+// sequence number is odd while event i is written into it, and 2 * (i + 1) once written, so
+// that a copy is only kept if the sequence number was the expected one before and after it. The
+// event is stored as atomic words, so that a torn copy is discarded rather than a data race.
+struct Slot
+{
+    std::atomic<uint64_t> sequence { 0 };
+    std::atomic<uint64_t> words[kEventWords];
+
+    void write(uint64_t index, const Event& event)
+    {
+        uint64_t eventWords[kEventWords] = {};
+        std::memcpy(eventWords, &event, sizeof(Event));
+
+        sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kEventWords; ++i) {
+            words[i].store(eventWords[i], std::memory_order_relaxed);
+        }
+        sequence.store(2 * index + 2, std::memory_order_release);
+    }
+
+    // Returns false if the slot doesn't hold event index, or if it was overwritten meanwhile.
+    bool read(uint64_t index, Event* event) const
+    {
+        const uint64_t expected = 2 * index + 2;
+        if (sequence.load(std::memory_order_acquire) != expected) {
+            return false;
+        }
+        uint64_t eventWords[kEventWords];
+        for (size_t i = 0; i < kEventWords; ++i) {
+            eventWords[i] = words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != expected) {
+            return false;
+        }
+        std::memcpy(event, eventWords, sizeof(Event));
+        return true;
+    }
+};
+
+// A call path of the per-thread call tree.
+struct Node
+{
+    std::string           name;
+    const char*           category;
+    std::vector<uint32_t> children;
+    uint64_t              count = 0;
+    int64_t               totalNs = 0;
+    int64_t               minNs = std::numeric_limits<int64_t>::max();
+    int64_t               maxNs = 0;
+
+    void reset()
+    {
+        count = 0;
+        totalNs = 0;
+        minNs = std::numeric_limits<int64_t>::max();
+        maxNs = 0;
+    }
+};
+
+struct OpenSection
+{
+    uint32_t node;
+    int64_t  beginNs;
+};
+
+// Everything recorded by one thread. Only the owning thread writes to it: the ring buffer is
+// published with the head counter and its slots are read by the exports without locking, while
+// the call tree is guarded by a mutex which is only contended while the statistics are being
+// reported.
+struct ThreadData
+{
+    ThreadData(uint32_t id, size_t capacity)
+        : threadId(id)
+        , isMainThread(ArchIsMainThread())
+        , capacity(std::max<size_t>(capacity, 1))
+        , events(new Slot[this->capacity])
+        , tree(1)
+    {
+        stack.reserve(32);
+    }
+
+    const uint32_t           threadId;
+    const bool               isMainThread;
+    const size_t             capacity;
+    std::unique_ptr<Slot[]>  events;
+    std::atomic<uint64_t>    head { 0 }; // number of events ever written
+    std::atomic<uint64_t>    tail { 0 }; // events before this one were discarded by clear()
+    std::vector<OpenSection> stack;      // only ever touched by the owning thread
+    std::mutex               treeMutex;
+    std::vector<Node>        tree; // tree[0] is the root, which is never recorded
+};
+
+struct Registry
+{
+    std::mutex                               mutex;
+    std::vector<std::shared_ptr<ThreadData>> threads;
+};
+
+Registry& registry()
+{
+    // Deliberately leaked: threads may still record while static objects are destroyed.
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+std::atomic<bool>& enabledFlag()
+{
+    static std::atomic<bool> enabled { TfGetEnvSetting(MAYAUSD_ENABLE_PROFILER) };
+    return enabled;
+}
+
+ThreadData& threadData()
+{
+    thread_local std::shared_ptr<ThreadData> data = [] {
+        Registry&                   reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        const int                   capacity = TfGetEnvSetting(MAYAUSD_PROFILER_BUFFER_SIZE);
+        reg.threads.push_back(std::make_shared<ThreadData>(
+            static_cast<uint32_t>(reg.threads.size()), static_cast<size_t>(capacity)));
+        return reg.threads.back();
+    }();
+    return *data;
+}
+
+std::vector<std::shared_ptr<ThreadData>> allThreads()
+{
+    Registry&                   reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.threads;
+}
+
+int64_t now()
+{
+    using clock = std::chrono::steady_clock;
+    static const clock::time_point epoch = clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - epoch).count();
+}
+
+bool matchCategory(const char* category, const char* filter)
+{
+    return !filter || (category && std::strcmp(category, filter) == 0);
+}
+
+// Copies the events still held by the ring buffer of a thread. The owning thread may keep
+// writing while they are copied, so the events it overwrote in the meantime are skipped.
+std::vector<Event> snapshot(const ThreadData& data)
+{
+    const uint64_t capacity = data.capacity;
+    const uint64_t head = data.head.load(std::memory_order_acquire);
+    const uint64_t tail = data.tail.load(std::memory_order_acquire);
+
+    const uint64_t first = std::max(tail, head > capacity ? head - capacity : 0);
+    if (first >= head) {
+        return {};
+    }
+    std::vector<Event> copy;
+    copy.reserve(head - first);
+    for (uint64_t i = first; i < head; ++i) {
+        Event event;
+        if (data.events[i % capacity].read(i, &event)) {
+            copy.push_back(event);
+        }
+    }
+    return copy;
+}
+
+void writeJsonString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for (; str && *str; ++str) {
+        const char c = *str;
+        switch (c) {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                os << escaped;
+            } else {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+// The call trees of all the threads, merged by name.
+struct MergedNode
+{
+    uint64_t                          count = 0;
+    int64_t                           totalNs = 0;
+    int64_t                           minNs = std::numeric_limits<int64_t>::max();
+    int64_t                           maxNs = 0;
+    std::map<std::string, MergedNode> children;
+};
+
+void merge(
+    MergedNode&              parent,
+    const std::vector<Node>& tree,
+    const Node&              node,
+    const char*              category)
+{
+    // The sections of other categories are skipped, their children are attached to the closest
+    // recorded ancestor.
+    MergedNode* target = &parent;
+    if (matchCategory(node.category, category)) {
+        target = &parent.children[node.name];
+        target->count += node.count;
+        target->totalNs += node.totalNs;
+        target->minNs = std::min(target->minNs, node.minNs);
+        target->maxNs = std::max(target->maxNs, node.maxNs);
+    }
+    for (uint32_t child : node.children) {
+        merge(*target, tree, tree[child], category);
+    }
+}
+
+// Removes the nodes without any call in their subtree, returns true if this one is empty.
+bool prune(MergedNode& node)
+{
+    for (auto it = node.children.begin(); it != node.children.end();) {
+        it = prune(it->second) ? node.children.erase(it) : std::next(it);
+    }
+    return node.count == 0 && node.children.empty();
+}
+
+void writeTime(std::ostream& os, int64_t ns)
+{
+    const double ms = ns * 1e-6;
+    if (ms > 20000.0) {
+        os << (ms * 0.001) << "s";
+    } else {
+        os << ms << "ms";
+    }
+}
+
+void writeNode(
+    std::ostream&      os,
+    const std::string& name,
+    const MergedNode&  node,
+    uint32_t           indent,
+    int64_t            total)
+{
+    for (uint32_t i = 0; i < indent; ++i) {
+        os << "  ";
+    }
+    const double percentage = total ? int(10000.0 * node.totalNs / total) * 0.01 : 0.0;
+    os << "[" << percentage << "%](";
+    writeTime(os, node.totalNs);
+    os << ") " << name;
+    if (node.count) {
+        os << " [" << node.count << (node.count > 1 ? " calls" : " call") << ", min ";
+        writeTime(os, node.minNs);
+        os << ", max ";
+        writeTime(os, node.maxNs);
+        os << "]";
+    }
+    os << std::endl;
+
+    std::vector<std::pair<const std::string*, const MergedNode*>> sorted;
+    for (const auto& child : node.children) {
+        sorted.emplace_back(&child.first, &child.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second->totalNs > b.second->totalNs;
+    });
+    for (const auto& child : sorted) {
+        writeNode(os, *child.first, *child.second, indent + 1, total);
+    }
+}
+
+} // namespace
+
+namespace MAYAUSD_NS_DEF {
+
+bool TraceProfiler::isEnabled() { return enabledFlag().load(std::memory_order_relaxed); }
+
+void TraceProfiler::setEnabled(bool enabled) { enabledFlag().store(enabled); }
+
+void TraceProfiler::begin(const char* name, const char* category)
+{
+    ThreadData& data = threadData();
+    if (!name) {
+        name = "";
+    }
+
+    // Only the owning thread grows its call tree, so it can be searched without locking.
+    const uint32_t parent = data.stack.empty() ? 0 : data.stack.back().node;
+    uint32_t       node = 0;
+    for (uint32_t child : data.tree[parent].children) {
+        const Node& candidate = data.tree[child];
+        if (candidate.category == category && candidate.name == name) {
+            node = child;
+            break;
+        }
+    }
+    if (!node) {
+        std::lock_guard<std::mutex> lock(data.treeMutex);
+        node = static_cast<uint32_t>(data.tree.size());
+        data.tree.emplace_back();
+        data.tree.back().name = name;
+        data.tree.back().category = category;
+        data.tree[parent].children.push_back(node);
+    }
+    data.stack.push_back({ node, now() });
+}
+
+void TraceProfiler::end()
+{
+    const int64_t endNs = now();
+    ThreadData&   data = threadData();
+    if (data.stack.empty()) {
+        TF_CODING_ERROR("TraceProfiler::end() called without a matching begin()");
+        return;
+    }
+    const OpenSection section = data.stack.back();
+    data.stack.pop_back();
+    const int64_t duration = endNs - section.beginNs;
+
+    const Node& node = data.tree[section.node];
+    {
+        std::lock_guard<std::mutex> lock(data.treeMutex);
+        Node& stats = data.tree[section.node];
+        ++stats.count;
+        stats.totalNs += duration;
+        stats.minNs = std::min(stats.minNs, duration);
+        stats.maxNs = std::max(stats.maxNs, duration);
+    }
+
+    Event event;
+    std::strncpy(event.name, node.name.c_str(), kMaxEventNameLength - 1);
+    event.name[kMaxEventNameLength - 1] = '\0';
+    event.category = node.category;
+    event.beginNs = section.beginNs;
+    event.durationNs = duration;
+
+    const uint64_t index = data.head.load(std::memory_order_relaxed);
+    data.events[index % data.capacity].write(index, event);
+    data.head.store(index + 1, std::memory_order_release);
+}
+
+void TraceProfiler::writeChromeTrace(std::ostream& os)
+{
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize    precision = os.precision();
+    os.setf(std::ios::fixed, std::ios::floatfield);
+    os.precision(3);
+
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& data : allThreads()) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << data->threadId
+           << ",\"args\":{\"name\":\"";
+        if (data->isMainThread) {
+            os << "Main thread";
+        } else {
+            os << "Worker thread " << data->threadId;
+        }
+        os << "\"}}";
+
+        for (const Event& event : snapshot(*data)) {
+            os << ",\n{\"name\":";
+            writeJsonString(os, event.name);
+            os << ",\"cat\":";
+            writeJsonString(os, event.category ? event.category : "");
+            os << ",\"ph\":\"X\",\"ts\":" << event.beginNs * 1e-3
+               << ",\"dur\":" << event.durationNs * 1e-3 << ",\"pid\":1,\"tid\":" << data->threadId
+               << "}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void TraceProfiler::writeStatistics(std::ostream& os, const char* category)
+{
+    MergedNode root;
+    for (const auto& data : allThreads()) {
+        std::lock_guard<std::mutex> lock(data->treeMutex);
+        for (uint32_t child : data->tree[0].children) {
+            merge(root, data->tree, data->tree[child], category);
+        }
+    }
+    prune(root);
+
+    int64_t total = 0;
+    for (const auto& child : root.children) {
+        total += child.second.totalNs;
+    }
+    root.totalNs = total;
+
+    std::vector<std::pair<const std::string*, const MergedNode*>> sorted;
+    for (const auto& child : root.children) {
+        sorted.emplace_back(&child.first, &child.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second->totalNs > b.second->totalNs;
+    });
+    for (const auto& child : sorted) {
+        writeNode(os, *child.first, *child.second, 0, total);
+    }
+}
+
+void TraceProfiler::resetStatistics(const char* category)
+{
+    // The nodes are kept, as the sections still open refer to them.
+    for (const auto& data : allThreads()) {
+        std::lock_guard<std::mutex> lock(data->treeMutex);
+        for (Node& node : data->tree) {
+            if (matchCategory(node.category, category)) {
+                node.reset();
+            }
+        }
+    }
+}
+
+void TraceProfiler::clear()
+{
+    resetStatistics();
+    for (const auto& data : allThreads()) {
+        data->tail.store(data->head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+size_t TraceProfiler::droppedEventCount()
+{
+    size_t dropped = 0;
+    for (const auto& data : allThreads()) {
+        const uint64_t recorded = data->head.load() - data->tail.load();
+        if (recorded > data->capacity) {
+            dropped += recorded - data->capacity;
+        }
+    }
+    return dropped;
+}
+
+} // namespace MAYAUSD_NS_DEF
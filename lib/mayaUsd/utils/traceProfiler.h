@@ -0,0 +1,124 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef MAYAUSD_UTILS_TRACE_PROFILER_H
+#define MAYAUSD_UTILS_TRACE_PROFILER_H
+
+#include <mayaUsd/base/api.h>
+
+#include <maya/MProfiler.h>
+
+#include <cstddef>
+#include <ostream>
+#include <utility>
+
+namespace MAYAUSD_NS_DEF {
+
+/// \class TraceProfiler
+///
+/// Hierarchical, thread-safe profiler recording timed sections without the Maya profiler UI.
+///
+/// Every thread records into its own buffers: completed sections go into a fixed-size ring
+/// buffer written without any lock (the oldest events are overwritten once it is full), and are
+/// accumulated into a per-thread call tree (count, total, min and max time per call path). The
+/// recorded data can be exported at any time as Chrome trace-event JSON, to be loaded in
+/// chrome://tracing or Perfetto, or as a text report of the statistics merged over all threads.
+///
+/// Sections must be properly nested on each thread. Section names are copied when recorded, so
+/// they do not need to outlive the section, but categories are stored by pointer and must be
+/// string literals or otherwise live as long as the profiler.
+///
+/// The ring buffer size, in events per thread, is set by the MAYAUSD_PROFILER_BUFFER_SIZE
+/// environment variable.
+class TraceProfiler
+{
+public:
+    /// Returns true if the ProfilingScope sites are recorded. Explicit begin() / end() calls are
+    /// always recorded. Off by default, unless MAYAUSD_ENABLE_PROFILER is set.
+    MAYAUSD_CORE_PUBLIC
+    static bool isEnabled();
+
+    MAYAUSD_CORE_PUBLIC
+    static void setEnabled(bool enabled);
+
+    /// Starts a section named \p name, on the calling thread.
+    MAYAUSD_CORE_PUBLIC
+    static void begin(const char* name, const char* category);
+
+    /// Ends the last section started on the calling thread.
+    MAYAUSD_CORE_PUBLIC
+    static void end();
+
+    /// Writes the events still held by the ring buffers, in the Chrome trace-event format.
+    MAYAUSD_CORE_PUBLIC
+    static void writeChromeTrace(std::ostream& os);
+
+    /// Writes the hierarchical statistics of the sections of \p category, or of all the sections
+    /// if \p category is null, merged over all threads and sorted by decreasing total time.
+    MAYAUSD_CORE_PUBLIC
+    static void writeStatistics(std::ostream& os, const char* category = nullptr);
+
+    /// Resets the statistics of the sections of \p category, or all of them if it is null.
+    MAYAUSD_CORE_PUBLIC
+    static void resetStatistics(const char* category = nullptr);
+
+    /// Discards all the recorded events and statistics.
+    MAYAUSD_CORE_PUBLIC
+    static void clear();
+
+    /// Returns the number of events overwritten in the ring buffers since the last clear().
+    MAYAUSD_CORE_PUBLIC
+    static size_t droppedEventCount();
+};
+
+/// \class ProfilingScope
+///
+/// Drop-in replacement for MProfilingScope which also records the scope in the TraceProfiler,
+/// when it is enabled.
+class ProfilingScope
+{
+public:
+    template <typename... Args>
+    ProfilingScope(
+        int                       categoryId,
+        MProfiler::ProfilingColor colorIndex,
+        const char*               eventName,
+        Args&&... args)
+        : _mayaScope(categoryId, colorIndex, eventName, std::forward<Args>(args)...)
+        , _recorded(TraceProfiler::isEnabled())
+    {
+        if (_recorded) {
+            TraceProfiler::begin(eventName, MProfiler::getCategoryName(categoryId));
+        }
+    }
+
+    ~ProfilingScope()
+    {
+        if (_recorded) {
+            TraceProfiler::end();
+        }
+    }
+
+    ProfilingScope(const ProfilingScope&) = delete;
+    ProfilingScope& operator=(const ProfilingScope&) = delete;
+
+private:
+    MProfilingScope _mayaScope;
+    const bool      _recorded;
+};
+
+} // namespace MAYAUSD_NS_DEF
+
+#endif // MAYAUSD_UTILS_TRACE_PROFILER_H
@@ -38,9 +38,9 @@
 #include <maya/MFnSingleIndexedComponent.h>
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MGlobal.h>
+#include <maya/MIntArray.h>
 #include <maya/MItDependencyGraph.h>
 #include <maya/MItDependencyNodes.h>
-#include <maya/MItMeshFaceVertex.h>
 #include <maya/MItMeshPolygon.h>
 #include <maya/MMatrix.h>
 #include <maya/MObject.h>
@@ -52,11 +52,17 @@
 #include <maya/MStringArray.h>
 #include <maya/MTime.h>
 
-#include <boost/functional/hash.hpp>
+#include <tbb/parallel_sort.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #if MAYA_API_VERSION >= 20200000
@@ -77,6 +83,7 @@
 #include <pxr/base/vt/array.h>
 #include <pxr/base/vt/types.h>
 #include <pxr/base/vt/value.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/sdf/tokens.h>
 #include <pxr/usd/usdGeom/mesh.h>
@@ -1005,23 +1012,49 @@ bool UsdMayaUtil::GetLinearShaderColor(
 
 namespace {
 
-template <typename T> struct _ValuesHash
+// Number of values from which they are sorted in parallel.
+constexpr size_t _kParallelSortThreshold = 1u << 15;
+
+template <typename T> struct _Components
 {
-    std::size_t operator()(const T& value) const { return hash_value(value); }
+    static constexpr size_t count = T::dimension;
+    static const float*     get(const T& value) { return value.data(); }
 };
 
-// There is no globally defined hash_value for numeric types
-// so we need an explicit opt-in here.
-template <> struct _ValuesHash<float>
+template <> struct _Components<float>
 {
-    std::size_t operator()(const float& value) const { return boost::hash_value(value); }
+    static constexpr size_t count = 1;
+    static const float*     get(const float& value) { return &value; }
 };
 
-template <typename T> struct _ValuesEqual
+// Bit pattern of a value, with -0 folded into +0 so that they still compare equal.
+template <typename T> struct _ValueKey
 {
-    bool operator()(const T& a, const T& b) const { return GfIsClose(a, b, 1e-9); }
+    std::array<uint32_t, _Components<T>::count> bits;
+    int                                         index;
+
+    explicit _ValueKey(const T& value = T(), int valueIndex = 0)
+        : index(valueIndex)
+    {
+        const float* components = _Components<T>::get(value);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            const float component = components[i] == 0.0f ? 0.0f : components[i];
+            std::memcpy(&bits[i], &component, sizeof(component));
+        }
+    }
+
+    bool operator<(const _ValueKey& other) const { return bits < other.bits; }
 };
 
+template <typename Iterator> void _Sort(Iterator begin, Iterator end)
+{
+    if (static_cast<size_t>(end - begin) >= _kParallelSortThreshold) {
+        tbb::parallel_sort(begin, end);
+    } else {
+        std::sort(begin, end);
+    }
+}
+
 } // anonymous namespace
 
 template <typename T>
@@ -1036,41 +1069,95 @@ static void _MergeEquivalentIndexedValues(VtArray<T>* valueData, VtIntArray* ass
         return;
     }
 
-    // We maintain a map of values to that value's index in our uniqueValues
-    // array.
-    std::unordered_map<T, size_t, _ValuesHash<T>, _ValuesEqual<T>> valuesMap;
-    VtArray<T>                                                     uniqueValues;
-    VtIntArray                                                     uniqueIndices;
-
-    for (int index : *assignmentIndices) {
-        if (index < 0 || static_cast<size_t>(index) >= numValues) {
-            // This is an unassigned or otherwise unknown index, so just keep it.
-            uniqueIndices.push_back(index);
-            continue;
-        }
+    const T*     values = valueData->cdata();
+    const int*   assignments = assignmentIndices->cdata();
+    const size_t numAssignments = assignmentIndices->size();
 
-        const T value = (*valueData)[index];
+    // Sorting the bit patterns of the values brings the equal ones together,
+    // so each group of equal values can be numbered without hashing them.
+    std::vector<int> groupOf(numValues);
+    size_t           numGroups = 0u;
+    {
+        std::vector<_ValueKey<T>> keys(numValues);
+        WorkParallelForN(numValues, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                keys[i] = _ValueKey<T>(values[i], static_cast<int>(i));
+            }
+        });
+        _Sort(keys.begin(), keys.end());
 
-        int uniqueIndex = -1;
+        for (size_t i = 0; i < numValues; ++i) {
+            if (i > 0 && keys[i].bits != keys[i - 1].bits) {
+                ++numGroups;
+            }
+            groupOf[keys[i].index] = static_cast<int>(numGroups);
+        }
+        ++numGroups;
+    }
 
-        auto inserted = valuesMap.insert(std::pair<T, size_t>(value, uniqueValues.size()));
-        if (inserted.second) {
-            // This is a new value, so add it to the array.
-            uniqueValues.push_back(value);
-            uniqueIndex = uniqueValues.size() - 1;
-        } else {
-            // This is an existing value, so re-use the original's index.
-            uniqueIndex = inserted.first->second;
+    // The merged values are ordered by their first assignment, so find it for
+    // each group. Unassigned groups are dropped.
+    constexpr size_t                       kUnassigned = std::numeric_limits<size_t>::max();
+    std::unique_ptr<std::atomic<size_t>[]> firstAssignment(new std::atomic<size_t>[numGroups]);
+    WorkParallelForN(numGroups, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            firstAssignment[i].store(kUnassigned, std::memory_order_relaxed);
+        }
+    });
+    WorkParallelForN(numAssignments, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const int index = assignments[i];
+            if (index < 0 || static_cast<size_t>(index) >= numValues) {
+                continue;
+            }
+            std::atomic<size_t>& first = firstAssignment[groupOf[index]];
+            size_t               current = first.load(std::memory_order_relaxed);
+            while (i < current
+                   && !first.compare_exchange_weak(current, i, std::memory_order_relaxed)) { }
         }
+    });
 
-        uniqueIndices.push_back(uniqueIndex);
+    std::vector<std::pair<size_t, int>> assignedGroups;
+    assignedGroups.reserve(numGroups);
+    for (size_t group = 0; group < numGroups; ++group) {
+        const size_t first = firstAssignment[group].load(std::memory_order_relaxed);
+        if (first != kUnassigned) {
+            assignedGroups.emplace_back(first, static_cast<int>(group));
+        }
     }
+    firstAssignment.reset();
 
-    // If we reduced the number of values by merging, copy the results back.
-    if (uniqueValues.size() < numValues) {
-        (*valueData) = uniqueValues;
-        (*assignmentIndices) = uniqueIndices;
+    const size_t numUniqueValues = assignedGroups.size();
+    if (numUniqueValues >= numValues) {
+        // Nothing to merge.
+        return;
     }
+    _Sort(assignedGroups.begin(), assignedGroups.end());
+
+    VtArray<T>       uniqueValues(numUniqueValues);
+    T*               uniqueValuesData = uniqueValues.data();
+    std::vector<int> uniqueIndexOfGroup(numGroups, -1);
+    WorkParallelForN(numUniqueValues, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uniqueValuesData[i] = values[assignments[assignedGroups[i].first]];
+            uniqueIndexOfGroup[assignedGroups[i].second] = static_cast<int>(i);
+        }
+    });
+
+    VtIntArray uniqueIndices(numAssignments);
+    int*       uniqueIndicesData = uniqueIndices.data();
+    WorkParallelForN(numAssignments, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const int index = assignments[i];
+            // Unassigned or otherwise unknown indices are kept as they are.
+            uniqueIndicesData[i] = index < 0 || static_cast<size_t>(index) >= numValues
+                ? index
+                : uniqueIndexOfGroup[groupOf[index]];
+        }
+    });
+
+    (*valueData) = uniqueValues;
+    (*assignmentIndices) = uniqueIndices;
 }
 
 void UsdMayaUtil::MergeEquivalentIndexedValues(
@@ -1110,59 +1197,130 @@ void UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
         return;
     }
 
+    MIntArray mayaFaceVertexCounts;
+    MIntArray mayaFaceVertexIndices;
+    if (!mesh.getVertices(mayaFaceVertexCounts, mayaFaceVertexIndices)) {
+        return;
+    }
+
+    VtIntArray faceVertexCounts(mayaFaceVertexCounts.length());
+    VtIntArray faceVertexIndices(mayaFaceVertexIndices.length());
+    mayaFaceVertexCounts.get(faceVertexCounts.data());
+    mayaFaceVertexIndices.get(faceVertexIndices.data());
+
+    CompressFaceVaryingPrimvarIndices(
+        faceVertexCounts,
+        faceVertexIndices,
+        static_cast<size_t>(mesh.numVertices()),
+        interpolation,
+        assignmentIndices);
+}
+
+void UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
+    const VtIntArray& faceVertexCounts,
+    const VtIntArray& faceVertexIndices,
+    size_t            numVertices,
+    TfToken*          interpolation,
+    VtIntArray*       assignmentIndices)
+{
+    if (!interpolation || !assignmentIndices || assignmentIndices->size() == 0u) {
+        return;
+    }
+
+    const size_t numFaceVertices = assignmentIndices->size();
+    if (faceVertexIndices.size() != numFaceVertices) {
+        return;
+    }
+
+    const size_t        numPolygons = faceVertexCounts.size();
+    std::vector<size_t> faceOffsets(numPolygons + 1, 0u);
+    for (size_t face = 0; face < numPolygons; ++face) {
+        faceOffsets[face + 1]
+            = faceOffsets[face] + static_cast<size_t>(std::max(faceVertexCounts[face], 0));
+    }
+    if (faceOffsets.back() != numFaceVertices) {
+        return;
+    }
+
+    const int* assignments = assignmentIndices->cdata();
+    const int* vertices = faceVertexIndices.cdata();
+
     // Use -2 as the initial "un-stored" sentinel value, since -1 is the
     // default unauthored value index for primvars.
-    int        numPolygons = mesh.numPolygons();
-    VtIntArray uniformAssignments;
-    uniformAssignments.assign((size_t)numPolygons, -2);
+    VtIntArray uniformAssignments(numPolygons, -2);
+    int*       uniformAssignmentsData = uniformAssignments.data();
 
-    int        numVertices = mesh.numVertices();
-    VtIntArray vertexAssignments;
-    vertexAssignments.assign((size_t)numVertices, -2);
+    std::unique_ptr<std::atomic<int>[]> vertexAssignments(new std::atomic<int>[numVertices]);
+    WorkParallelForN(numVertices, [&](size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+            vertexAssignments[vertex].store(-2, std::memory_order_relaxed);
+        }
+    });
 
     // We assume that the data is constant/uniform/vertex until we can
-    // prove otherwise that two components have differing values.
-    bool isConstant = true;
-    bool isUniform = true;
-    bool isVertex = true;
-
-    MItMeshFaceVertex itFV(mesh.object());
-    unsigned int      fvi = 0;
-    for (itFV.reset(); !itFV.isDone(); itFV.next(), ++fvi) {
-        int faceIndex = itFV.faceId();
-        int vertexIndex = itFV.vertId();
-
-        int assignedIndex = (*assignmentIndices)[fvi];
-
-        if (isConstant) {
-            if (assignedIndex != (*assignmentIndices)[0]) {
-                isConstant = false;
+    // prove otherwise that two components have differing values. Each range
+    // of faces shares what it proved, so that all of them stop as soon as no
+    // compression is possible.
+    std::atomic<bool> isConstant(true);
+    std::atomic<bool> isUniform(true);
+    std::atomic<bool> isVertex(true);
+    const int         constantAssignment = assignments[0];
+
+    WorkParallelForN(numPolygons, [&](size_t begin, size_t end) {
+        auto sync = [](bool& local, std::atomic<bool>& shared) {
+            if (!local) {
+                if (shared.load(std::memory_order_relaxed)) {
+                    shared.store(false, std::memory_order_relaxed);
+                }
+            } else {
+                local = shared.load(std::memory_order_relaxed);
             }
-        }
-
-        if (isUniform) {
-            if (uniformAssignments[faceIndex] < -1) {
-                // No value for this face yet, so store one.
-                uniformAssignments[faceIndex] = assignedIndex;
-            } else if (assignedIndex != uniformAssignments[faceIndex]) {
-                isUniform = false;
+        };
+
+        bool constant = true;
+        bool uniform = true;
+        bool vertex = true;
+        for (size_t face = begin; face < end; ++face) {
+            sync(constant, isConstant);
+            sync(uniform, isUniform);
+            sync(vertex, isVertex);
+            if (!constant && !uniform && !vertex) {
+                // No compression will be possible, so stop trying.
+                return;
             }
-        }
 
-        if (isVertex) {
-            if (vertexAssignments[vertexIndex] < -1) {
-                // No value for this vertex yet, so store one.
-                vertexAssignments[vertexIndex] = assignedIndex;
-            } else if (assignedIndex != vertexAssignments[vertexIndex]) {
-                isVertex = false;
+            const size_t faceBegin = faceOffsets[face];
+            const size_t faceEnd = faceOffsets[face + 1];
+            if (faceBegin == faceEnd) {
+                continue;
             }
-        }
 
-        if (!isConstant && !isUniform && !isVertex) {
-            // No compression will be possible, so stop trying.
-            break;
+            const int faceAssignment = assignments[faceBegin];
+            uniformAssignmentsData[face] = faceAssignment;
+            for (size_t fvi = faceBegin; fvi < faceEnd; ++fvi) {
+                const int assignedIndex = assignments[fvi];
+                constant = constant && assignedIndex == constantAssignment;
+                uniform = uniform && assignedIndex == faceAssignment;
+                if (vertex) {
+                    const int vertexIndex = vertices[fvi];
+                    if (vertexIndex < 0 || static_cast<size_t>(vertexIndex) >= numVertices) {
+                        vertex = false;
+                        continue;
+                    }
+                    // Store the first value for this vertex, or compare to it.
+                    int stored = -2;
+                    if (!vertexAssignments[vertexIndex].compare_exchange_strong(
+                            stored, assignedIndex, std::memory_order_relaxed)
+                        && stored != assignedIndex) {
+                        vertex = false;
+                    }
+                }
+            }
         }
-    }
+        sync(constant, isConstant);
+        sync(uniform, isUniform);
+        sync(vertex, isVertex);
+    });
 
     if (isConstant) {
         assignmentIndices->resize(1);
@@ -1171,7 +1329,15 @@ void UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
         *assignmentIndices = uniformAssignments;
         *interpolation = UsdGeomTokens->uniform;
     } else if (isVertex) {
-        *assignmentIndices = vertexAssignments;
+        VtIntArray vertexIndices(numVertices);
+        int*       vertexIndicesData = vertexIndices.data();
+        WorkParallelForN(numVertices, [&](size_t begin, size_t end) {
+            for (size_t vertex = begin; vertex < end; ++vertex) {
+                vertexIndicesData[vertex]
+                    = vertexAssignments[vertex].load(std::memory_order_relaxed);
+            }
+        });
+        *assignmentIndices = vertexIndices;
         *interpolation = UsdGeomTokens->vertex;
     } else {
         *interpolation = UsdGeomTokens->faceVarying;
@@ -364,6 +364,17 @@ void CompressFaceVaryingPrimvarIndices(
     PXR_NS::TfToken*    interpolation,
     PXR_NS::VtIntArray* assignmentIndices);
 
+/// Same as above, using the vertex count of each face of the mesh and the
+/// vertex of each of its face vertices, as returned by MFnMesh::getVertices(),
+/// so that they can be gathered once and shared by all the primvars of a mesh.
+MAYAUSD_CORE_PUBLIC
+void CompressFaceVaryingPrimvarIndices(
+    const PXR_NS::VtIntArray& faceVertexCounts,
+    const PXR_NS::VtIntArray& faceVertexIndices,
+    size_t                    numVertices,
+    PXR_NS::TfToken*          interpolation,
+    PXR_NS::VtIntArray*       assignmentIndices);
+
 /// Get whether \p plug is authored in the Maya scene.
 ///
 /// A plug is considered authored if its value has been changed from the
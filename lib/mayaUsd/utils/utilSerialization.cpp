@@ -28,7 +28,9 @@
 #include <maya/MGlobal.h>
 #include <maya/MString.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -100,6 +102,8 @@ bool saveRootLayer(SdfLayerRefPtr layer, const std::string& proxy)
     return true;
 }
 
+const char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
 } // namespace
 
 namespace MAYAUSD_NS_DEF {
@@ -174,6 +178,90 @@ USDUnsavedEditsOption serializeUsdEditsLocationOption()
     }
 } // namespace MAYAUSD_NS_DEF
 
+bool serializeUsdEditsAsBinaryOption()
+{
+    static const MString kSerializedUsdEditsBinaryFormat(
+        MayaUsdOptionVars->SerializedUsdEditsBinaryFormat.GetText());
+
+    // Default is to keep the usda text format, which older versions can read.
+    bool optVarExists = true;
+    int  binary = MGlobal::optionVarIntValue(kSerializedUsdEditsBinaryFormat, &optVarExists);
+    return optVarExists && binary != 0;
+}
+
+std::string encodeBase64(const std::string& bytes)
+{
+    std::string text;
+    text.reserve(((bytes.size() + 2) / 3) * 4);
+
+    size_t i = 0;
+    for (; i + 2 < bytes.size(); i += 3) {
+        const uint32_t triple = (uint32_t(uint8_t(bytes[i])) << 16)
+            | (uint32_t(uint8_t(bytes[i + 1])) << 8) | uint32_t(uint8_t(bytes[i + 2]));
+        text.push_back(kBase64Chars[(triple >> 18) & 0x3F]);
+        text.push_back(kBase64Chars[(triple >> 12) & 0x3F]);
+        text.push_back(kBase64Chars[(triple >> 6) & 0x3F]);
+        text.push_back(kBase64Chars[triple & 0x3F]);
+    }
+
+    const size_t remaining = bytes.size() - i;
+    if (remaining > 0) {
+        uint32_t triple = uint32_t(uint8_t(bytes[i])) << 16;
+        if (remaining > 1) {
+            triple |= uint32_t(uint8_t(bytes[i + 1])) << 8;
+        }
+        text.push_back(kBase64Chars[(triple >> 18) & 0x3F]);
+        text.push_back(kBase64Chars[(triple >> 12) & 0x3F]);
+        text.push_back(remaining > 1 ? kBase64Chars[(triple >> 6) & 0x3F] : '=');
+        text.push_back('=');
+    }
+
+    return text;
+}
+
+bool decodeBase64(const std::string& text, std::string* bytes)
+{
+    static const std::vector<int> kDecodeTable = []() {
+        std::vector<int> table(256, -1);
+        for (int i = 0; i < 64; ++i) {
+            table[uint8_t(kBase64Chars[i])] = i;
+        }
+        return table;
+    }();
+
+    if (text.size() % 4 != 0) {
+        return false;
+    }
+
+    bytes->clear();
+    bytes->reserve((text.size() / 4) * 3);
+
+    for (size_t i = 0; i < text.size(); i += 4) {
+        uint32_t quad = 0;
+        int      padding = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            const char c = text[i + j];
+            int        value = 0;
+            if (c == '=' && i + 4 == text.size() && j >= 2) {
+                ++padding;
+            } else if (padding > 0 || (value = kDecodeTable[uint8_t(c)]) < 0) {
+                return false;
+            }
+            quad = (quad << 6) | uint32_t(value);
+        }
+
+        bytes->push_back(char((quad >> 16) & 0xFF));
+        if (padding < 2) {
+            bytes->push_back(char((quad >> 8) & 0xFF));
+        }
+        if (padding < 1) {
+            bytes->push_back(char(quad & 0xFF));
+        }
+    }
+
+    return true;
+}
+
 void setNewProxyPath(const MString& proxyNodeName, const MString& newValue)
 {
     MString script;
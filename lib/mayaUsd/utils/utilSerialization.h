@@ -61,6 +61,24 @@ enum USDUnsavedEditsOption
 MAYAUSD_CORE_PUBLIC
 USDUnsavedEditsOption serializeUsdEditsLocationOption();
 
+/*! \brief Queries the Maya optionVar that decides if Usd edits serialized to
+    the Maya file are stored as binary (usdc) data instead of usda text.
+ */
+MAYAUSD_CORE_PUBLIC
+bool serializeUsdEditsAsBinaryOption();
+
+/*! \brief Encodes \p bytes in base64, as Maya string attributes cannot hold
+    arbitrary bytes.
+ */
+MAYAUSD_CORE_PUBLIC
+std::string encodeBase64(const std::string& bytes);
+
+/*! \brief Decodes the base64 \p text into \p bytes. Returns false if \p text
+    is not valid base64.
+ */
+MAYAUSD_CORE_PUBLIC
+bool decodeBase64(const std::string& text, std::string* bytes);
+
 /*! \brief Utility function to update the file path attribute on the proxy shape
     when an anonymous root layer gets exported to disk.
  */
@@ -21,6 +21,7 @@
 
 #include <pxr/base/gf/interval.h>
 #include <pxr/base/tf/type.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/imaging/hd/tokens.h>
 #include <pxr/imaging/pxOsd/tokens.h>
 #include <pxr/pxr.h>
@@ -30,12 +31,14 @@
 #include <maya/MFloatArray.h>
 #include <maya/MFnMesh.h>
 #include <maya/MIntArray.h>
-#include <maya/MItMeshPolygon.h>
 #include <maya/MNodeMessage.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPolyMessage.h>
 
+#include <algorithm>
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 namespace {
@@ -133,6 +136,19 @@ public:
         HdMayaAdapter::RemoveCallbacks();
     }
 
+    void MarkDirty(HdDirtyBits dirtyBits) override
+    {
+        HdMayaShapeAdapter::MarkDirty(dirtyBits);
+        if (dirtyBits & HdChangeTracker::DirtyTopology) {
+            _faceVertexCounts = {};
+            _faceVertexIndices = {};
+            _faceVertexOffsets.clear();
+        }
+        if (dirtyBits & (HdChangeTracker::DirtyTopology | HdChangeTracker::DirtyPrimvar)) {
+            _uvs = {};
+        }
+    }
+
     bool IsSupported() const override
     {
         return GetDelegate()->GetRenderIndex().IsRprimTypeSupported(HdPrimTypeTokens->mesh);
@@ -140,23 +156,70 @@ public:
 
     VtValue GetUVs()
     {
+        if (!_uvs.IsEmpty()) {
+            return _uvs;
+        }
+
         MStatus status;
         MFnMesh mesh(GetDagPath(), &status);
-        if (ARCH_UNLIKELY(!status)) {
+        if (ARCH_UNLIKELY(!status) || !_UpdateTopology(mesh)) {
             return {};
         }
-        VtArray<GfVec2f> uvs;
-        uvs.reserve(static_cast<size_t>(mesh.numFaceVertices()));
-        for (MItMeshPolygon pit(GetDagPath()); !pit.isDone(); pit.next()) {
-            const auto vertexCount = pit.polygonVertexCount();
-            for (auto i = decltype(vertexCount) { 0 }; i < vertexCount; ++i) {
-                float2 uv = { 0.0f, 0.0f };
-                pit.getUV(i, uv);
-                uvs.push_back(GfVec2f(uv[0], uv[1]));
-            }
+
+        // UVs are face varying: faces without UVs assigned get (0, 0) for each of their
+        // vertices.
+        MIntArray uvCounts;
+        MIntArray uvIds;
+        if (!mesh.getAssignedUVs(uvCounts, uvIds)) {
+            return {};
+        }
+        MFloatArray us;
+        MFloatArray vs;
+        mesh.getUVs(us, vs);
+
+        const size_t numPolygons = _faceVertexCounts.size();
+        if (!TF_VERIFY(uvCounts.length() == numPolygons)) {
+            return {};
+        }
+        std::vector<int>   ids(uvIds.length());
+        std::vector<float> u(us.length());
+        std::vector<float> v(vs.length());
+        uvIds.get(ids.data());
+        us.get(u.data());
+        vs.get(v.data());
+
+        // Offset of the UV ids of each face, or -1 if the face does not have UVs assigned.
+        const int*       counts = _faceVertexCounts.cdata();
+        std::vector<int> uvOffsets(numPolygons);
+        int              uvOffset = 0;
+        for (size_t face = 0; face < numPolygons; ++face) {
+            const int uvCount = uvCounts[face];
+            uvOffsets[face] = uvCount == counts[face] ? uvOffset : -1;
+            uvOffset += uvCount;
         }
 
-        return VtValue(uvs);
+        VtVec2fArray uvs(_faceVertexIndices.size());
+        GfVec2f*     dst = uvs.data();
+        const int*   offsets = _faceVertexOffsets.data();
+        const int    numUVs = static_cast<int>(std::min(u.size(), v.size()));
+        WorkParallelForN(numPolygons, [&](size_t begin, size_t end) {
+            for (size_t face = begin; face < end; ++face) {
+                GfVec2f*  faceUVs = dst + offsets[face];
+                const int count = counts[face];
+                if (uvOffsets[face] < 0) {
+                    std::fill(faceUVs, faceUVs + count, GfVec2f(0.0f));
+                    continue;
+                }
+                const int* faceIds = ids.data() + uvOffsets[face];
+                for (int i = 0; i < count; ++i) {
+                    const int id = faceIds[i];
+                    faceUVs[i] = (id >= 0 && id < numUVs) ? GfVec2f(u[id], v[id]) : GfVec2f(0.0f);
+                }
+            }
+        });
+
+        _uvs = VtValue(uvs);
+        return _uvs;
     }
 
     VtValue GetPoints(const MFnMesh& mesh)
@@ -217,18 +280,9 @@ public:
 
     HdMeshTopology GetMeshTopology() override
     {
-        MFnMesh    mesh(GetDagPath());
-        const auto numPolygons = mesh.numPolygons();
-        VtIntArray faceVertexCounts;
-        faceVertexCounts.reserve(static_cast<size_t>(numPolygons));
-        VtIntArray faceVertexIndices;
-        faceVertexIndices.reserve(static_cast<size_t>(mesh.numFaceVertices()));
-        for (MItMeshPolygon pit(GetDagPath()); !pit.isDone(); pit.next()) {
-            const auto vc = pit.polygonVertexCount();
-            faceVertexCounts.push_back(vc);
-            for (auto i = decltype(vc) { 0 }; i < vc; ++i) {
-                faceVertexIndices.push_back(pit.vertexIndex(i));
-            }
+        MFnMesh mesh(GetDagPath());
+        if (!_UpdateTopology(mesh)) {
+            return {};
         }
 
         // TODO: Maybe we could use the flat shading of the display style?
@@ -243,8 +297,8 @@ public:
 #endif
 
             UsdGeomTokens->rightHanded,
-            faceVertexCounts,
-            faceVertexIndices);
+            _faceVertexCounts,
+            _faceVertexIndices);
     }
 
     HdDisplayStyle GetDisplayStyle() override
@@ -374,6 +428,35 @@ public:
     bool HasType(const TfToken& typeId) const override { return typeId == HdPrimTypeTokens->mesh; }
 
 private:
+    // Fills the cached topology from the bulk vertex arrays of the mesh, if it was dirtied
+    // since it was last computed. Returns false if the mesh could not be read.
+    bool _UpdateTopology(const MFnMesh& mesh)
+    {
+        if (!_faceVertexOffsets.empty() || mesh.numPolygons() == 0) {
+            return true;
+        }
+
+        MIntArray vertexCounts;
+        MIntArray vertexList;
+        if (!mesh.getVertices(vertexCounts, vertexList)) {
+            return false;
+        }
+
+        const size_t numPolygons = vertexCounts.length();
+        _faceVertexCounts.resize(numPolygons);
+        _faceVertexIndices.resize(vertexList.length());
+        vertexCounts.get(_faceVertexCounts.data());
+        vertexList.get(_faceVertexIndices.data());
+
+        _faceVertexOffsets.resize(numPolygons);
+        int offset = 0;
+        for (size_t face = 0; face < numPolygons; ++face) {
+            _faceVertexOffsets[face] = offset;
+            offset += _faceVertexCounts[face];
+        }
+        return true;
+    }
+
     static void NodeDirtiedCallback(MObject& node, MPlug& plug, void* clientData)
     {
         auto* adapter = reinterpret_cast<HdMayaMeshAdapter*>(clientData);
@@ -454,6 +537,13 @@ private:
     // To work around this, we register these callbacks specially, and only
     // remove them if the underlying node is currently valid.
     MCallbackIdArray _buggyCallbacks;
+
+    // Topology and UVs, cached until the topology or the primvars are dirtied, as they are
+    // expensive to extract from heavy meshes.
+    VtIntArray       _faceVertexCounts;
+    VtIntArray       _faceVertexIndices;
+    std::vector<int> _faceVertexOffsets;
+    VtValue          _uvs;
 };
 
 TF_REGISTRY_FUNCTION(TfType)
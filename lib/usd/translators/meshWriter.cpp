@@ -43,6 +43,7 @@
 #include <pxr/usd/usdUtils/pipeline.h>
 
 #include <maya/MFloatArray.h>
+#include <maya/MFloatVectorArray.h>
 #include <maya/MFnBlendShapeDeformer.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnGeometryFilter.h>
@@ -304,25 +305,74 @@ void PxrUsdTranslators_MeshWriter::PostExport()
     }
 }
 
-bool PxrUsdTranslators_MeshWriter::writeAnimatedMeshExtents(
-    const MObject&     deformedMesh,
-    const UsdTimeCode& usdTime)
+namespace {
+
+VtVec3fArray computeMeshExtents(const MObject& deformedMesh)
 {
-    // NOTE: (yliangsiew) We also cache the animated extents out here; this
-    // will be written at the SkelRoot level later on.
     TF_VERIFY(!deformedMesh.isNull());
     TF_VERIFY(deformedMesh.hasFn(MFn::kMesh));
     MStatus stat;
     MFnMesh fnMesh(deformedMesh, &stat);
-    CHECK_MSTATUS_AND_RETURN(stat, false);
+    CHECK_MSTATUS_AND_RETURN(stat, VtVec3fArray());
     unsigned int numVertices = fnMesh.numVertices();
     const float* meshPts = fnMesh.getRawPoints(&stat);
-    CHECK_MSTATUS_AND_RETURN(stat, false);
+    CHECK_MSTATUS_AND_RETURN(stat, VtVec3fArray());
 
     const GfVec3f* pVtMeshPts = reinterpret_cast<const GfVec3f*>(meshPts);
     VtVec3fArray   vtMeshPts(pVtMeshPts, pVtMeshPts + numVertices);
     VtVec3fArray   meshBBox(2);
     UsdGeomPointBased::ComputeExtent(vtMeshPts, &meshBBox);
+    return meshBBox;
+}
+
+// The tolerance of UsdUtilsSparseValueWriter for floating point values.
+constexpr double sparseSampleTolerance = 1e-6;
+
+template <typename T>
+bool isSameSample(const VtArray<T>& sample, const VtArray<T>& prevSample, bool /* exact */)
+{
+    return sample == prevSample;
+}
+
+bool isSameSample(const VtVec3fArray& sample, const VtVec3fArray& prevSample, bool exact)
+{
+    if (exact || sample.size() != prevSample.size()) {
+        return sample == prevSample;
+    }
+    const GfVec3f* values = sample.cdata();
+    const GfVec3f* prevValues = prevSample.cdata();
+    for (size_t i = 0; i < sample.size(); ++i) {
+        if (!GfIsClose(values[i], prevValues[i], sparseSampleTolerance)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Compares the prepared sample of an attribute to the last authored one. The
+// first sample is always authored.
+template <typename PreparedAttr> void updateIsChanged(PreparedAttr& preparedAttr, bool exact)
+{
+    preparedAttr.isChanged = preparedAttr.isPrepared
+        && (preparedAttr.prevTime.IsDefault()
+            || !isSameSample(preparedAttr.sample, preparedAttr.lastWrittenSample, exact));
+}
+
+} // namespace
+
+bool PxrUsdTranslators_MeshWriter::writeAnimatedMeshExtents(
+    const MObject&     deformedMesh,
+    const UsdTimeCode& usdTime)
+{
+    // NOTE: (yliangsiew) We also cache the animated extents out here; this
+    // will be written at the SkelRoot level later on.
+    const VtVec3fArray meshBBox = hasPreparedFrame(usdTime) && deformedMesh == GetDagPath().node()
+        ? _preparedExtent.sample
+        : computeMeshExtents(deformedMesh);
+    if (meshBBox.empty()) {
+        return false;
+    }
+
     bool bStat = true;
     if (meshBBox != this->_prevMeshExtentsSample) {
         bStat = this->_writeJobCtx.UpdateSkelBindingsWithExtent(
@@ -333,12 +383,142 @@ bool PxrUsdTranslators_MeshWriter::writeAnimatedMeshExtents(
     return bStat;
 }
 
+bool PxrUsdTranslators_MeshWriter::hasPreparedFrame(const UsdTimeCode& usdTime) const
+{
+    return !usdTime.IsDefault() && usdTime == _preparedFrameTime;
+}
+
+void PxrUsdTranslators_MeshWriter::PullFrame(const UsdTimeCode& usdTime)
+{
+    _preparedFrameTime = UsdTimeCode::Default();
+    _preparedPoints.isPrepared = false;
+    _preparedExtent.isPrepared = false;
+    _preparedNormals.isPrepared = false;
+    _preparedFaceVertexCounts.isPrepared = false;
+    _preparedFaceVertexIndices.isPrepared = false;
+
+    MStatus status;
+    MFnMesh finalMesh(GetDagPath(), &status);
+    if (!status) {
+        return;
+    }
+    const float* meshPts = finalMesh.getRawPoints(&status);
+    if (!status) {
+        return;
+    }
+
+    // Only copy the Maya data here, it is converted and compared to the
+    // previous samples by ConvertFrame() which runs in parallel with the other
+    // writers.
+    const GfVec3f* pVtMeshPts = reinterpret_cast<const GfVec3f*>(meshPts);
+    _preparedPoints.sample.assign(pVtMeshPts, pVtMeshPts + finalMesh.numVertices());
+    _preparedFrameTime = usdTime;
+
+    // The mesh attributes are only time-sampled when the mesh is animated, see
+    // writeMeshAttrs(). Otherwise, only the extent is used, for the skel
+    // extents.
+    if (!isMeshAnimated()) {
+        return;
+    }
+    _preparedPoints.isPrepared = true;
+    _preparedExtent.isPrepared = true;
+    _preparedFaceVertexCounts.isPrepared = UsdMayaMeshWriteUtils::getMeshFaceVertexData(
+        finalMesh, &_preparedFaceVertexCounts.sample, &_preparedFaceVertexIndices.sample);
+    _preparedFaceVertexIndices.isPrepared = _preparedFaceVertexCounts.isPrepared;
+
+    TfToken sdScheme = UsdMayaMeshWriteUtils::getSubdivScheme(finalMesh);
+    if (sdScheme.IsEmpty()) {
+        sdScheme = _GetExportArgs().defaultMeshScheme;
+    }
+    bool emitNormals = true;
+    UsdMayaMeshReadUtils::getEmitNormalsTag(finalMesh, &emitNormals);
+    if (sdScheme != UsdGeomTokens->none || !emitNormals || finalMesh.numNormals() == 0) {
+        return;
+    }
+
+    // The normals are expanded to face-varying by ConvertFrame(), as
+    // UsdMayaMeshWriteUtils::getMeshNormals() does.
+    MFloatVectorArray mayaNormals;
+    MIntArray         normalCounts;
+    MIntArray         normalIds;
+    if (!finalMesh.getNormals(mayaNormals) || !finalMesh.getNormalIds(normalCounts, normalIds)) {
+        return;
+    }
+    _pulledNormals.resize(mayaNormals.length());
+    for (unsigned int i = 0; i < mayaNormals.length(); ++i) {
+        _pulledNormals[i].Set(mayaNormals[i].x, mayaNormals[i].y, mayaNormals[i].z);
+    }
+    _pulledNormalIds.resize(normalIds.length());
+    normalIds.get(_pulledNormalIds.data());
+    _preparedNormals.isPrepared = true;
+}
+
+void PxrUsdTranslators_MeshWriter::ConvertFrame(const UsdTimeCode& usdTime)
+{
+    if (!hasPreparedFrame(usdTime)) {
+        return;
+    }
+    _preparedExtent.sample.resize(2);
+    UsdGeomPointBased::ComputeExtent(_preparedPoints.sample, &_preparedExtent.sample);
+
+    if (_preparedNormals.isPrepared) {
+        const GfVec3f* normals = _pulledNormals.cdata();
+        const int*     normalIds = _pulledNormalIds.cdata();
+        _preparedNormals.sample.resize(_pulledNormalIds.size());
+        GfVec3f* faceVaryingNormals = _preparedNormals.sample.data();
+        for (size_t i = 0; i < _pulledNormalIds.size(); ++i) {
+            faceVaryingNormals[i] = normals[normalIds[i]];
+        }
+        _pulledNormals = VtVec3fArray();
+        _pulledNormalIds = VtIntArray();
+    }
+
+    // Compare the samples here rather than in the sparse value writer, which
+    // is only used serially by Write(). Like the sparse value writer, the
+    // floating point values are compared with a tolerance, unless it hashes
+    // the samples.
+    const bool exact = _GetSparseValueWriter()->IsHashingSamples();
+    updateIsChanged(_preparedPoints, exact);
+    updateIsChanged(_preparedExtent, exact);
+    updateIsChanged(_preparedNormals, exact);
+    updateIsChanged(_preparedFaceVertexCounts, exact);
+    updateIsChanged(_preparedFaceVertexIndices, exact);
+}
+
+template <typename T>
+void PxrUsdTranslators_MeshWriter::writePreparedAttr(
+    const UsdAttribute& attr,
+    PreparedAttr<T>&    preparedAttr,
+    const UsdTimeCode&  usdTime)
+{
+    if (preparedAttr.isChanged) {
+        // End the run of identical samples with the last authored one.
+        if (!preparedAttr.didWritePrevSample) {
+            attr.Set(preparedAttr.lastWrittenSample, preparedAttr.prevTime);
+        }
+        attr.Set(preparedAttr.sample, usdTime);
+        preparedAttr.lastWrittenSample.swap(preparedAttr.sample);
+    }
+    preparedAttr.didWritePrevSample = preparedAttr.isChanged;
+    preparedAttr.prevTime = usdTime;
+    preparedAttr.sample = VtArray<T>();
+}
+
 void PxrUsdTranslators_MeshWriter::Write(const UsdTimeCode& usdTime)
 {
     UsdMayaPrimWriter::Write(usdTime);
 
     UsdGeomMesh primSchema(_usdPrim);
     writeMeshAttrs(usdTime, primSchema);
+
+    // The data was only prepared for this frame, don't keep a copy of every
+    // mesh until the next one.
+    _preparedFrameTime = UsdTimeCode::Default();
+    _preparedPoints.sample = VtVec3fArray();
+    _preparedExtent.sample = VtVec3fArray();
+    _preparedNormals.sample = VtVec3fArray();
+    _preparedFaceVertexCounts.sample = VtIntArray();
+    _preparedFaceVertexIndices.sample = VtIntArray();
 }
 
 bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
@@ -514,6 +694,10 @@ bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
         return true;
     }
 
+    // The data prepared by PullFrame() and ConvertFrame() is that of the final
+    // mesh.
+    const bool usePreparedFrame = hasPreparedFrame(usdTime) && geomMeshObj == GetDagPath().node();
+
     // Set mesh attrs ==========
     // Write points
     /*
@@ -587,13 +771,33 @@ bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
         // TODO: (yliangsiew) Any other deformers that get implemented in the future will have to
         // make sure that they don't just enter this scope; otherwise, their deformed point
         // positions will get "baked" into the pref pose as well.
-        UsdMayaMeshWriteUtils::writePointsData(
-            geomMesh, primSchema, usdTime, _GetSparseValueWriter());
+        if (usePreparedFrame && _preparedPoints.isPrepared) {
+            writePreparedAttr(primSchema.GetPointsAttr(), _preparedPoints, usdTime);
+            writePreparedAttr(primSchema.CreateExtentAttr(), _preparedExtent, usdTime);
+        } else {
+            UsdMayaMeshWriteUtils::writePointsData(
+                geomMesh, primSchema, usdTime, _GetSparseValueWriter());
+        }
     }
 
-    // Write faceVertexIndices
-    UsdMayaMeshWriteUtils::writeFaceVertexIndicesData(
-        geomMesh, primSchema, usdTime, _GetSparseValueWriter());
+    // Write faceVertexIndices. The face vertices are kept to compress the
+    // indices of the color sets.
+    VtIntArray faceVertexCounts;
+    VtIntArray faceVertexIndices;
+    bool       hasFaceVertexData = false;
+    if (usePreparedFrame && _preparedFaceVertexCounts.isPrepared) {
+        writePreparedAttr(primSchema.GetFaceVertexCountsAttr(), _preparedFaceVertexCounts, usdTime);
+        writePreparedAttr(
+            primSchema.GetFaceVertexIndicesAttr(), _preparedFaceVertexIndices, usdTime);
+        faceVertexCounts = _preparedFaceVertexCounts.lastWrittenSample;
+        faceVertexIndices = _preparedFaceVertexIndices.lastWrittenSample;
+        hasFaceVertexData = true;
+    } else if (UsdMayaMeshWriteUtils::getMeshFaceVertexData(
+                   geomMesh, &faceVertexCounts, &faceVertexIndices)) {
+        UsdMayaMeshWriteUtils::writeFaceVertexIndicesData(
+            faceVertexCounts, faceVertexIndices, primSchema, usdTime, _GetSparseValueWriter());
+        hasFaceVertexData = true;
+    }
 
     // Read subdiv scheme tagging. If not set, we default to defaultMeshScheme
     // flag (this is specified by the job args but defaults to catmullClark).
@@ -607,7 +811,10 @@ bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
         // Polygonal mesh - export normals.
         bool emitNormals = true; // Default to emitting normals if no tagging.
         UsdMayaMeshReadUtils::getEmitNormalsTag(finalMesh, &emitNormals);
-        if (emitNormals) {
+        if (usePreparedFrame && _preparedNormals.isPrepared) {
+            writePreparedAttr(primSchema.GetNormalsAttr(), _preparedNormals, usdTime);
+            primSchema.SetNormalsInterpolation(UsdGeomTokens->faceVarying);
+        } else if (emitNormals) {
             UsdMayaMeshWriteUtils::writeNormalsData(
                 geomMesh, primSchema, usdTime, _GetSparseValueWriter());
         }
@@ -663,6 +870,14 @@ bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
             &shadersAssignmentIndices);
     }
 
+    // The color sets are those of the final mesh, so its face vertices are only
+    // gathered again when the topology was written from another mesh, such as
+    // the skin cluster input, once for all the color sets.
+    if (!colorSetNames.empty() && geomMeshObj != finalMesh.object()) {
+        hasFaceVertexData = UsdMayaMeshWriteUtils::getMeshFaceVertexData(
+            finalMesh, &faceVertexCounts, &faceVertexIndices);
+    }
+
     for (const std::string& colorSetName : colorSetNames) {
 
         if (_excludeColorSets.count(colorSetName) > 0)
@@ -705,7 +920,9 @@ bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
                 &interpolation,
                 &assignmentIndices,
                 &colorSetRep,
-                &clamped)) {
+                &clamped,
+                hasFaceVertexData ? &faceVertexCounts : nullptr,
+                hasFaceVertexData ? &faceVertexIndices : nullptr)) {
             TF_WARN(
                 "Unable to retrieve colorSet data: %s on mesh: %s. "
                 "Skipping...",
@@ -55,6 +55,8 @@ public:
         UsdMayaWriteJobContext&  jobCtx);
 
     void Write(const UsdTimeCode& usdTime) override;
+    void PullFrame(const UsdTimeCode& usdTime) override;
+    void ConvertFrame(const UsdTimeCode& usdTime) override;
     bool ExportsGprims() const override;
     void PostExport() override;
 
@@ -89,6 +91,48 @@ private:
     /// The previous sample for the mesh extents. Cached between iterations.
     VtVec3fArray _prevMeshExtentsSample;
 
+    /// Whether PullFrame() and ConvertFrame() prepared the points and extent
+    /// of the final mesh for \p usdTime.
+    bool hasPreparedFrame(const UsdTimeCode& usdTime) const;
+
+    /// A time-sampled attribute of the final mesh, pulled by PullFrame() and
+    /// compared to the last authored sample by ConvertFrame(), so that Write()
+    /// only authors the samples that change, as the sparse value writer would.
+    template <typename T> struct PreparedAttr
+    {
+        /// Whether \p sample was prepared for _preparedFrameTime.
+        bool isPrepared = false;
+        /// Whether \p sample differs from \p lastWrittenSample.
+        bool isChanged = true;
+        /// Whether the sample of \p prevTime was authored.
+        bool didWritePrevSample = true;
+
+        VtArray<T>  sample;
+        VtArray<T>  lastWrittenSample;
+        UsdTimeCode prevTime = UsdTimeCode::Default();
+    };
+
+    /// Authors the sample prepared for \p usdTime to \p attr if it changed,
+    /// ending the previous run of identical samples first, and releases it.
+    template <typename T>
+    void writePreparedAttr(
+        const UsdAttribute& attr,
+        PreparedAttr<T>&    preparedAttr,
+        const UsdTimeCode&  usdTime);
+
+    /// Final mesh data for _preparedFrameTime, pulled by PullFrame() and
+    /// converted by ConvertFrame() ahead of Write(). The normals and topology
+    /// are only pulled for animated meshes, the extent is also used for the
+    /// skel extents.
+    UsdTimeCode           _preparedFrameTime = UsdTimeCode::Default();
+    PreparedAttr<GfVec3f> _preparedPoints;
+    PreparedAttr<GfVec3f> _preparedExtent;
+    PreparedAttr<GfVec3f> _preparedNormals;
+    PreparedAttr<int>     _preparedFaceVertexCounts;
+    PreparedAttr<int>     _preparedFaceVertexIndices;
+    VtVec3fArray          _pulledNormals;
+    VtIntArray            _pulledNormalIds;
+
     UsdSkelAnimation _skelAnim;
 
     /// Set of color sets that should be excluded.
@@ -121,16 +121,16 @@ template <typename T> void _resizeVectors(_strVecPairVec<T>& a, size_t size)
 
 template <typename T>
 inline void _addAttr(
-    UsdGeomPoints&             points,
-    const TfToken&             name,
-    const SdfValueTypeName&    typeName,
-    const VtArray<T>&          a,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    UsdGeomPoints&            points,
+    const TfToken&            name,
+    const SdfValueTypeName&   typeName,
+    const VtArray<T>&         a,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     auto    attr = points.GetPrim().CreateAttribute(name, typeName, false, SdfVariabilityVarying);
     VtValue val(a);
-    valueWriter->SetAttribute(attr, &val, usdTime);
+    UsdMayaWriteUtil::SetAttribute(attr, &val, usdTime, valueWriter);
 }
 
 const TfToken _rgbName("rgb");
@@ -141,11 +141,11 @@ const TfToken _massName("mass");
 
 template <typename T>
 void _addAttrVec(
-    UsdGeomPoints&             points,
-    const SdfValueTypeName&    typeName,
-    const _strVecPairVec<T>&   a,
-    const UsdTimeCode&         usdTime,
-    UsdUtilsSparseValueWriter* valueWriter)
+    UsdGeomPoints&            points,
+    const SdfValueTypeName&   typeName,
+    const _strVecPairVec<T>&  a,
+    const UsdTimeCode&        usdTime,
+    UsdMayaSparseValueWriter* valueWriter)
 {
     for (const auto& v : a) {
         _addAttr(points, v.first, typeName, *v.second, usdTime, valueWriter);
@@ -471,5 +471,37 @@ bool compareRGBAArray(
     const size_t       count,
     const float        eps = 1e-5f);
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  computes a 128bit hash of a block of memory, to detect identical data (for example two
+///         consecutive time samples of an array) without keeping a copy of it around. This is not
+///         a cryptographic hash. The result only depends on the bytes, their count and the seed,
+///         and is the same whatever instruction set is in use.
+/// \param  data the memory to hash
+/// \param  bytes the number of bytes to hash
+/// \param  seed a value mixed into the hash, e.g. to tell apart data of different types
+/// \param  result receives the two 64bit halves of the hash
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+void hash128(const void* const data, const size_t bytes, const uint64_t seed, uint64_t result[2]);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the name of the instruction set the functions above are currently dispatched
+///         to: "baseline", "avx2" or "avx512". By default the best instruction set supported by
+///         the CPU is chosen the first time one of the functions is called. The
+///         MAYAUSD_UTILS_DIFFCORE_ISA environment variable can be used to force a specific one.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+const char* diffCoreInstructionSet();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  forces the functions above to use the named instruction set. Mostly useful for tests
+///         and benchmarks that need to compare the different implementations.
+/// \param  name the instruction set to use: "baseline", "avx2" or "avx512"
+/// \return false if the instruction set is not built into this library or is not supported by
+///         the CPU, in which case the current instruction set is left unchanged.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+bool setDiffCoreInstructionSet(const char* name);
+
 //----------------------------------------------------------------------------------------------------------------------
 } // namespace MayaUsdUtils
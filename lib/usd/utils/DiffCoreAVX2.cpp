@@ -0,0 +1,20 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// The DiffCore kernels compiled for AVX2 and F16C, see DiffCoreKernels.h. Only built on x86-64 with
+// gcc or clang, since SIMD.h relies on the __SSE__ family of macros that MSVC does not define.
+#define MAYAUSD_UTILS_ISA_NAMESPACE Avx2
+#define MAYAUSD_UTILS_TARGET_AVX2
+#include "DiffCoreKernels.h"
@@ -0,0 +1,19 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// The DiffCore kernels compiled with the default flags of the library, i.e. SSE on x86-64 and
+// scalar code elsewhere.
+#define MAYAUSD_UTILS_ISA_NAMESPACE Baseline
+#include "DiffCoreKernels.h"
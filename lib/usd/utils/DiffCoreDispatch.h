@@ -0,0 +1,72 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef MAYAUSDUTILS_DIFFCOREDISPATCH_H
+#define MAYAUSDUTILS_DIFFCOREDISPATCH_H
+
+#include <pxr/base/gf/half.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A table of the DiffCore kernels compiled for one instruction set. The members follow
+///         the order of the declarations in DiffCore.h.
+//----------------------------------------------------------------------------------------------------------------------
+struct DiffCoreKernels
+{
+    bool (*vec2AreAllTheSameUV)(const float*, const float*, size_t);
+    bool (*vec2fAreAllTheSame)(const float*, size_t);
+    bool (*vec3fAreAllTheSame)(const float*, size_t);
+    bool (*vec4fAreAllTheSame)(const float*, size_t);
+    bool (*vec2dAreAllTheSame)(const double*, size_t);
+    bool (*vec3dAreAllTheSame)(const double*, size_t);
+    bool (*vec4dAreAllTheSame)(const double*, size_t);
+
+    bool (*compareHalfFloat)(const PXR_NS::GfHalf*, const float*, size_t, size_t, float);
+    bool (*compareHalfDouble)(const PXR_NS::GfHalf*, const double*, size_t, size_t, double);
+    bool (*compareDoubleFloat)(const double*, const float*, size_t, size_t, float);
+    bool (*compareDouble)(const double*, const double*, size_t, size_t, double);
+    bool (*compareFloat)(const float*, const float*, size_t, size_t, float);
+    bool (*compareInt8)(const int8_t*, const int8_t*, size_t, size_t);
+    bool (*compareInt32)(const int32_t*, const int32_t*, size_t, size_t);
+
+    bool (*compareUvArrays)(const float*, const float*, const float*, size_t, size_t, float);
+    bool (*compareUvToArrays)(float, float, const float*, const float*, size_t, float);
+    bool (*compareArray3Dto4D)(const float*, const float*, size_t, size_t, float);
+    bool (*compareArrayFloat3DtoDouble4D)(const float*, const double*, size_t, size_t, float);
+    bool (*compareRGBAArray)(float, float, float, float, const float*, size_t, float);
+
+    void (*hash128)(const void*, size_t, uint64_t, uint64_t*);
+};
+
+// One kernel table per instruction set, see DiffCoreKernels.h. The AVX2 and AVX-512 tables are
+// only built on x86-64, in which case the build defines MAYAUSD_UTILS_HAS_AVX2_KERNELS and
+// MAYAUSD_UTILS_HAS_AVX512_KERNELS.
+namespace Baseline {
+const DiffCoreKernels& diffCoreKernels();
+}
+namespace Avx2 {
+const DiffCoreKernels& diffCoreKernels();
+}
+namespace Avx512 {
+const DiffCoreKernels& diffCoreKernels();
+}
+
+} // namespace MayaUsdUtils
+
+#endif
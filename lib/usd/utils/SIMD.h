@@ -25,7 +25,33 @@
 
 #include <stdint.h>
 
-#ifdef __AVX2__
+// The instruction sets the wrappers below are compiled for. They follow the compiler flags,
+// except in the DiffCore kernel units that enable AVX2 or AVX-512 with a target pragma (see
+// DiffCoreKernels.h): g++ doesn't define the __AVX2__ family of macros under such a pragma, so
+// these units define MAYAUSD_UTILS_TARGET_AVX2 or MAYAUSD_UTILS_TARGET_AVX512 instead.
+#if defined(MAYAUSD_UTILS_TARGET_AVX512) && !defined(MAYAUSD_UTILS_TARGET_AVX2)
+#define MAYAUSD_UTILS_TARGET_AVX2
+#endif
+#if defined(__SSE4_1__) || defined(MAYAUSD_UTILS_TARGET_AVX2)
+#define MAYAUSD_UTILS_SIMD_SSE4_1
+#endif
+#if defined(__AVX__) || defined(MAYAUSD_UTILS_TARGET_AVX2)
+#define MAYAUSD_UTILS_SIMD_AVX
+#endif
+#if defined(__AVX2__) || defined(MAYAUSD_UTILS_TARGET_AVX2)
+#define MAYAUSD_UTILS_SIMD_AVX2
+#endif
+#if defined(__F16C__) || defined(MAYAUSD_UTILS_TARGET_AVX2)
+#define MAYAUSD_UTILS_SIMD_F16C
+#endif
+#if defined(__AVX512F__) || defined(MAYAUSD_UTILS_TARGET_AVX512)
+#define MAYAUSD_UTILS_SIMD_AVX512F
+#endif
+#if defined(__AVX512BW__) || defined(MAYAUSD_UTILS_TARGET_AVX512)
+#define MAYAUSD_UTILS_SIMD_AVX512BW
+#endif
+
+#if defined(MAYAUSD_UTILS_SIMD_AVX2) || defined(MAYAUSD_UTILS_SIMD_AVX512F)
 #include <immintrin.h>
 #endif
 
@@ -41,7 +67,7 @@
 #include <pmmintrin.h>
 #endif
 
-#ifdef __SSE4_1__
+#ifdef MAYAUSD_UTILS_SIMD_SSE4_1
 #include <smmintrin.h>
 #endif
 
@@ -61,6 +87,13 @@
 
 namespace MayaUsdUtils {
 
+// When a translation unit is compiled once per instruction set (see DiffCoreKernels.h), the
+// wrappers below are scoped per instruction set so the linker never merges an AVX-512 inline
+// definition with the baseline one.
+#ifdef MAYAUSD_UTILS_ISA_NAMESPACE
+namespace MAYAUSD_UTILS_ISA_NAMESPACE {
+#endif
+
 #if defined(__SSE__)
 typedef __m128  f128;
 typedef __m128i i128;
@@ -203,9 +236,12 @@ AL_DLL_HIDDEN inline f128 andnot4f(const f128 a, const f128 b) { return _mm_andn
 AL_DLL_HIDDEN inline i128 or4i(const i128 a, const i128 b) { return _mm_or_si128(a, b); }
 AL_DLL_HIDDEN inline i128 and4i(const i128 a, const i128 b) { return _mm_and_si128(a, b); }
 AL_DLL_HIDDEN inline i128 andnot4i(const i128 a, const i128 b) { return _mm_andnot_si128(a, b); }
+AL_DLL_HIDDEN inline i128 xor4i(const i128 a, const i128 b) { return _mm_xor_si128(a, b); }
 
 AL_DLL_HIDDEN inline f128 mul4f(const f128 a, const f128 b) { return _mm_mul_ps(a, b); }
 AL_DLL_HIDDEN inline d128 mul2d(const d128 a, const d128 b) { return _mm_mul_pd(a, b); }
+/// \brief  multiplies the low 32 bits of each 64bit lane, giving 64bit results.
+AL_DLL_HIDDEN inline i128 mul2u32(const i128 a, const i128 b) { return _mm_mul_epu32(a, b); }
 
 AL_DLL_HIDDEN inline f128 add4f(const f128 a, const f128 b) { return _mm_add_ps(a, b); }
 AL_DLL_HIDDEN inline i128 add4i(const i128 a, const i128 b) { return _mm_add_epi32(a, b); }
@@ -225,8 +261,8 @@ AL_DLL_HIDDEN inline i128 splat2i64(const int64_t f) { return _mm_set1_epi64x(f)
 AL_DLL_HIDDEN inline f128 unpacklo4f(const f128 a, const f128 b) { return _mm_unpacklo_ps(a, b); }
 AL_DLL_HIDDEN inline f128 unpackhi4f(const f128 a, const f128 b) { return _mm_unpackhi_ps(a, b); }
 
-#if !defined(__SSE4__) && !defined(__SSE4_1__) && !defined(__SSE4_2__) && !defined(__AVX__) \
-    && !defined(__AVX2__)
+#if !defined(__SSE4__) && !defined(MAYAUSD_UTILS_SIMD_SSE4_1) && !defined(__SSE4_2__) \
+    && !defined(MAYAUSD_UTILS_SIMD_AVX) && !defined(MAYAUSD_UTILS_SIMD_AVX2)
 AL_DLL_HIDDEN inline __m128 _mm_blendv_ps(__m128 a, __m128 b, __m128 c)
 {
     return _mm_or_ps(_mm_and_ps(c, b), _mm_andnot_ps(c, a));
@@ -246,8 +282,9 @@ AL_DLL_HIDDEN inline f128 select4f(const f128 falseResult, const f128 trueResult
 #define shiftBitsRight4i32(reg, count) _mm_srli_epi32(reg, count)
 #define shiftBitsLeft2i64(reg, count)  _mm_slli_epi64(reg, count)
 #define shiftBitsRight2i64(reg, count) _mm_srli_epi64(reg, count)
+#define swap2i64(reg)                  _mm_shuffle_epi32(reg, _MM_SHUFFLE(1, 0, 3, 2))
 
-#if defined(__SSE4_1__)
+#if defined(MAYAUSD_UTILS_SIMD_SSE4_1)
 AL_DLL_HIDDEN inline i128 cmpeq2i64(const i128 a, const i128 b) { return _mm_cmpeq_epi64(a, b); }
 #endif
 
@@ -258,7 +295,7 @@ inline d128 abs2d(const d128 v) { return _mm_andnot_pd(splat2d(-0.0), v); }
 
 #endif
 
-#if defined(__AVX2__)
+#if defined(MAYAUSD_UTILS_SIMD_AVX2)
 typedef __m256  f256;
 typedef __m256i i256;
 typedef __m256d d256;
@@ -401,9 +438,11 @@ AL_DLL_HIDDEN inline f256 andnot8f(const f256 a, const f256 b) { return _mm256_a
 AL_DLL_HIDDEN inline i256 or8i(const i256 a, const i256 b) { return _mm256_or_si256(a, b); }
 AL_DLL_HIDDEN inline i256 and8i(const i256 a, const i256 b) { return _mm256_and_si256(a, b); }
 AL_DLL_HIDDEN inline i256 andnot8i(const i256 a, const i256 b) { return _mm256_andnot_si256(a, b); }
+AL_DLL_HIDDEN inline i256 xor8i(const i256 a, const i256 b) { return _mm256_xor_si256(a, b); }
 
 AL_DLL_HIDDEN inline f256 mul8f(const f256 a, const f256 b) { return _mm256_mul_ps(a, b); }
 AL_DLL_HIDDEN inline d256 mul4d(const d256 a, const d256 b) { return _mm256_mul_pd(a, b); }
+AL_DLL_HIDDEN inline i256 mul4u32(const i256 a, const i256 b) { return _mm256_mul_epu32(a, b); }
 
 AL_DLL_HIDDEN inline f256 add8f(const f256 a, const f256 b) { return _mm256_add_ps(a, b); }
 AL_DLL_HIDDEN inline i256 add8i(const i256 a, const i256 b) { return _mm256_add_epi32(a, b); }
@@ -470,6 +509,7 @@ AL_DLL_HIDDEN inline f256 set2f128(const f128 lo, const f128 hi)
 #define shiftBitsRight8i32(reg, count) _mm256_srli_epi32(reg, count)
 #define shiftBitsLeft4i64(reg, count)  _mm256_slli_epi64(reg, count)
 #define shiftBitsRight4i64(reg, count) _mm256_srli_epi64(reg, count)
+#define swap4i64(reg)                  _mm256_shuffle_epi32(reg, _MM_SHUFFLE(1, 0, 3, 2))
 
 inline f256 cmpgt8f(const f256 a, const f256 b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
 inline d256 cmpgt4d(const d256 a, const d256 b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
@@ -518,8 +558,8 @@ inline i256 loadmask3i64(const void* const ptr, const size_t count)
 }
 #endif
 
-#ifdef __F16C__
-#ifdef __AVX__
+#ifdef MAYAUSD_UTILS_SIMD_F16C
+#ifdef MAYAUSD_UTILS_SIMD_AVX
 inline f256 cvtph8(const i128 a) { return _mm256_cvtph_ps(a); }
 inline i128 cvtph8(const f256 a) { return _mm256_cvtps_ph(a, _MM_FROUND_CUR_DIRECTION); }
 #else
@@ -528,7 +568,7 @@ inline i128               cvtph4(const f128 a) { return _mm_cvtps_ph(a, _MM_FROU
 #endif
 #endif
 
-#ifdef __AVX__
+#ifdef MAYAUSD_UTILS_SIMD_AVX
 /// \brief  loads up to 3 floating point values from ptr, and sets the other elements to zero.
 inline f128 loadmask3f(const void* const ptr, const size_t count)
 {
@@ -557,4 +597,106 @@ inline f128 loadmask3f(const void* const ptr, size_t count)
 }
 #endif
 
+#if defined(MAYAUSD_UTILS_SIMD_AVX512F)
+typedef __m512  f512;
+typedef __m512i i512;
+typedef __m512d d512;
+
+AL_DLL_HIDDEN inline f512 loadu16f(const void* const ptr) { return _mm512_loadu_ps(ptr); }
+AL_DLL_HIDDEN inline i512 loadu16i(const void* const ptr) { return _mm512_loadu_si512(ptr); }
+AL_DLL_HIDDEN inline d512 loadu8d(const void* const ptr) { return _mm512_loadu_pd(ptr); }
+
+AL_DLL_HIDDEN inline void storeu16i(void* const ptr, const i512 reg)
+{
+    _mm512_storeu_si512(ptr, reg);
+}
+
+AL_DLL_HIDDEN inline f512 splat16f(const float f) { return _mm512_set1_ps(f); }
+AL_DLL_HIDDEN inline d512 splat8d(const double f) { return _mm512_set1_pd(f); }
+AL_DLL_HIDDEN inline i512 splat16i(const int32_t f) { return _mm512_set1_epi32(f); }
+
+AL_DLL_HIDDEN inline f512 sub16f(const f512 a, const f512 b) { return _mm512_sub_ps(a, b); }
+AL_DLL_HIDDEN inline d512 sub8d(const d512 a, const d512 b) { return _mm512_sub_pd(a, b); }
+AL_DLL_HIDDEN inline i512 add8i64(const i512 a, const i512 b) { return _mm512_add_epi64(a, b); }
+AL_DLL_HIDDEN inline i512 xor16i(const i512 a, const i512 b) { return _mm512_xor_si512(a, b); }
+
+// The unmasked forms of these intrinsics merge into _mm512_undefined_epi32(), which gcc 12 reports
+// as maybe-uninitialized. The zero-masking forms with all lanes selected compile to the same
+// instructions.
+AL_DLL_HIDDEN inline i512 mul8u32(const i512 a, const i512 b)
+{
+    return _mm512_maskz_mul_epu32(0xFF, a, b);
+}
+
+#define shiftBitsLeft8i64(reg, count)  _mm512_maskz_slli_epi64(0xFF, reg, count)
+#define shiftBitsRight8i64(reg, count) _mm512_maskz_srli_epi64(0xFF, reg, count)
+#define swap8i64(reg)                  _mm512_maskz_shuffle_epi32(0xFFFF, reg, _MM_PERM_BADC)
+
+AL_DLL_HIDDEN inline f512 abs16f(const f512 v) { return _mm512_abs_ps(v); }
+AL_DLL_HIDDEN inline d512 abs8d(const d512 v) { return _mm512_abs_pd(v); }
+
+// AVX-512 comparisons return a bit mask (one bit per lane) rather than a vector register
+AL_DLL_HIDDEN inline __mmask16 cmpgt16f(const f512 a, const f512 b)
+{
+    return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+}
+AL_DLL_HIDDEN inline __mmask8 cmpgt8d(const d512 a, const d512 b)
+{
+    return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+}
+AL_DLL_HIDDEN inline __mmask16 cmpne16f(const f512 a, const f512 b)
+{
+    return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_OQ);
+}
+AL_DLL_HIDDEN inline __mmask16 cmpne16i(const i512 a, const i512 b)
+{
+    return _mm512_cmpneq_epi32_mask(a, b);
+}
+
+/// \brief  returns a mask selecting the first (count % 16) lanes of a 16 lane register.
+AL_DLL_HIDDEN inline __mmask16 lanemask16(const size_t count)
+{
+    return __mmask16((1u << (count & 0xF)) - 1u);
+}
+
+/// \brief  repeats the 4 floats a, b, c, d in each of the 4 lanes of a 512bit register.
+AL_DLL_HIDDEN inline f512 set4x4f(const float a, const float b, const float c, const float d)
+{
+    return _mm512_setr4_ps(a, b, c, d);
+}
+
+/// \brief  loads up to 15 floating point values from ptr, and sets the other elements to zero.
+///         Masked out elements are never read, so this is safe at the end of an allocation.
+AL_DLL_HIDDEN inline f512 loadmask15f(const void* const ptr, const size_t count)
+{
+    return _mm512_maskz_loadu_ps(lanemask16(count), ptr);
+}
+/// \brief  loads up to 15 integer values from ptr, and sets the other elements to zero.
+AL_DLL_HIDDEN inline i512 loadmask15i(const void* const ptr, const size_t count)
+{
+    return _mm512_maskz_loadu_epi32(lanemask16(count), ptr);
+}
+/// \brief  loads up to 7 double values from ptr, and sets the other elements to zero.
+AL_DLL_HIDDEN inline d512 loadmask7d(const void* const ptr, const size_t count)
+{
+    return _mm512_maskz_loadu_pd(__mmask8((1u << (count & 0x7)) - 1u), ptr);
+}
+
+#if defined(MAYAUSD_UTILS_SIMD_AVX512BW)
+AL_DLL_HIDDEN inline __mmask64 cmpne64i8(const i512 a, const i512 b)
+{
+    return _mm512_cmpneq_epi8_mask(a, b);
+}
+/// \brief  loads up to 63 int8 values from ptr, and sets the other elements to zero.
+AL_DLL_HIDDEN inline i512 loadmask63i8(const void* const ptr, const size_t count)
+{
+    return _mm512_maskz_loadu_epi8(__mmask64((1ULL << (count & 0x3F)) - 1ULL), ptr);
+}
+#endif
+#endif
+
+#ifdef MAYAUSD_UTILS_ISA_NAMESPACE
+} // namespace MAYAUSD_UTILS_ISA_NAMESPACE
+#endif
+
 } // namespace MayaUsdUtils
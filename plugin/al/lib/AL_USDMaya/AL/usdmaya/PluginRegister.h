@@ -274,6 +274,7 @@ template <typename AFnPlugin> MStatus registerPlugin(AFnPlugin& plugin)
     AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::TranslatePrim);
     AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::LayerManager);
     AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::SyncFileIOGui);
+    AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::Profiler);
     AL_REGISTER_COMMAND(plugin, AL::usdmaya::fileio::ImportCommand);
     AL_REGISTER_COMMAND(plugin, AL::usdmaya::fileio::ExportCommand);
     AL_REGISTER_TRANSLATOR(plugin, AL::usdmaya::fileio::ImportTranslator);
@@ -438,6 +439,7 @@ template <typename AFnPlugin> MStatus unregisterPlugin(AFnPlugin& plugin)
         }
     }
 
+    AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::Profiler);
     AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::SyncFileIOGui);
     AL_UNREGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiListGen);
     AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::InternalProxyShapeSelect);
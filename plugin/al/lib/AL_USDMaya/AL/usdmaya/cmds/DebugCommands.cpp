@@ -202,6 +202,51 @@ const char* const UsdDebugCommand::g_helpText = R"(
 
 )";
 
+//----------------------------------------------------------------------------------------------------------------------
+AL_MAYA_DEFINE_COMMAND(Profiler, AL_usdmaya);
+
+//----------------------------------------------------------------------------------------------------------------------
+MSyntax Profiler::createSyntax()
+{
+    MSyntax syn = MayaUsd::ProfilerCommand::createSyntax();
+    syn.addFlag("-h", "-help", MSyntax::kNoArg);
+    return syn;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Profiler::doIt(const MArgList& argList)
+{
+    MStatus      status;
+    MArgDatabase args(syntax(), argList, &status);
+    if (!status)
+        return status;
+    AL_MAYA_COMMAND_HELP(args, g_helpText);
+    return MayaUsd::ProfilerCommand::doIt(argList);
+}
+
+const char* const Profiler::g_helpText = R"(
+    AL_usdmaya_Profiler Overview:
+
+      This command controls the profiler recording the AL_BEGIN_PROFILE_SECTION sections, and the mayaUsd
+      profiling scopes once enabled. The sections are recorded per thread, and can be exported at any time.
+
+      To record the mayaUsd profiling scopes as well, use the -e/-enable flag:
+
+        AL_usdmaya_Profiler -e true;
+
+      To write the recorded events to a file in the Chrome trace-event format (chrome://tracing, Perfetto), use the
+      -ct/-chromeTrace flag:
+
+        AL_usdmaya_Profiler -ct "/tmp/trace.json";
+
+      To return the statistics of each call path, merged over all threads, use the -st/-statistics flag, optionally
+      restricted to a category with the -cat/-category flag, and reset them with the -r/-reset flag:
+
+        AL_usdmaya_Profiler -st -cat "AL_USDMaya" -r;
+
+      To discard all the recorded events and statistics, use the -cl/-clear flag.
+)";
+
 //----------------------------------------------------------------------------------------------------------------------
 } // namespace cmds
 } // namespace usdmaya
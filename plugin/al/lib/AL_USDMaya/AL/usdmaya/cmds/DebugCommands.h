@@ -19,6 +19,8 @@
 #include <AL/maya/utils/MayaHelperMacros.h>
 #include <AL/usdmaya/Api.h>
 
+#include <mayaUsd/commands/profilerCommand.h>
+
 #include <maya/MPxCommand.h>
 
 namespace AL {
@@ -39,6 +41,20 @@ private:
     MStatus doIt(const MArgList& args) override;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The mayaUsdProfiler command, which controls the profiler fed by the
+///         AL_BEGIN_PROFILE_SECTION sections, available without the mayaUsd plugin.
+/// \ingroup commands
+//----------------------------------------------------------------------------------------------------------------------
+class Profiler : public MayaUsd::ProfilerCommand
+{
+public:
+    AL_MAYA_DECLARE_COMMAND();
+
+private:
+    MStatus doIt(const MArgList& args) override;
+};
+
 /// builds the GUI for the TfDebug notices
 AL_USDMAYA_PUBLIC
 void constructDebugCommandGuis();
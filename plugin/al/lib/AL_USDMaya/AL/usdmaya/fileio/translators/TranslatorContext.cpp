@@ -18,10 +18,18 @@
 #include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
 
+#include <mayaUsd/utils/utilSerialization.h>
+
 #include <maya/MFnDagNode.h>
+#include <maya/MFnDependencyNode.h>
 #include <maya/MSelectionList.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace AL {
 namespace usdmaya {
@@ -43,8 +51,8 @@ UsdStageRefPtr TranslatorContext::getUsdStage() const
 void TranslatorContext::validatePrims()
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::validatePrims ** VALIDATE PRIMS **\n");
-    for (auto it : m_primMapping) {
-        if (it.objectHandle().isValid() && it.objectHandle().isAlive()) {
+    for (const auto& it : m_primMapping) {
+        if (it.isResolved() && it.objectHandle().isValid() && it.objectHandle().isAlive()) {
             TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                 .Msg(
                     "TranslatorContext::validatePrims ** VALID HANDLE DETECTED %s **\n",
@@ -57,7 +65,7 @@ void TranslatorContext::validatePrims()
 bool TranslatorContext::getTransform(const SdfPath& path, MObjectHandle& object)
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getTransform %s\n", path.GetText());
-    auto it = find(path);
+    auto it = findResolved(path);
     if (it != m_primMapping.end()) {
         if (!it->objectHandle().isValid()) {
             TF_DEBUG(ALUSDMAYA_TRANSLATORS)
@@ -81,6 +89,7 @@ void TranslatorContext::updatePrimTypes()
         if (!prim) {
             it = m_primMapping.erase(it);
             modifiedIt = true;
+            m_isDirty = true;
         } else {
             std::string translatorId
                 = m_proxyShape->translatorManufacture().generateTranslatorId(prim);
@@ -101,7 +110,7 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObject '%s' \n", path.GetText());
 
-    auto it = find(path);
+    auto it = findResolved(path);
     if (it != m_primMapping.end()) {
         const MTypeId zero(0);
         if (zero != typeId) {
@@ -146,7 +155,7 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObject '%s' \n", path.GetText());
 
-    auto it = find(path);
+    auto it = findResolved(path);
     if (it != m_primMapping.end()) {
         const MTypeId zero(0);
         if (MFn::kInvalid != type) {
@@ -189,7 +198,7 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& returned)
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObjects: %s\n", path.GetText());
-    auto it = find(path);
+    auto it = findResolved(path);
     if (it != m_primMapping.end()) {
         returned = it->createdNodes();
         return true;
@@ -216,8 +225,10 @@ void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
         iter
             = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), translatorId, object.object()));
     } else {
+        resolve(*iter);
         iter->setNode(object.object());
     }
+    m_isDirty = true;
 
     if (object.object() == MObject::kNullObj) {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
@@ -253,6 +264,9 @@ void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
             : "schematype:" + prim.GetTypeName().GetString();
 
         iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), translatorId, MObject()));
+        m_isDirty = true;
+    } else {
+        resolve(*iter);
     }
 
     if (object.object() == MObject::kNullObj) {
@@ -260,6 +274,7 @@ void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
     }
 
     iter->createdNodes().push_back(object);
+    m_isDirty = true;
 
     if (object.object() == MObject::kNullObj) {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
@@ -282,7 +297,7 @@ void TranslatorContext::removeItems(const SdfPath& path)
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS)
         .Msg("TranslatorContext::removeItems remove under primPath=%s\n", path.GetText());
-    auto it = find(path);
+    auto it = findResolved(path);
     if (it != m_primMapping.end() && it->path() == path) {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
             .Msg("TranslatorContext::removeItems removing path=%s\n", it->path().GetText());
@@ -363,6 +378,7 @@ void TranslatorContext::removeItems(const SdfPath& path)
             AL_MAYA_CHECK_ERROR2(status, "failed to delete dag nodes");
         }
         m_primMapping.erase(it);
+        m_isDirty = true;
     }
     validatePrims();
 }
@@ -380,8 +396,229 @@ MString getNodeName(MObject obj)
     return fn.name();
 }
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+// The compact form of a serialised context starts with this prefix, the text form with a prim path.
+const char kCompactPrefix[] = "ALTrCtx1:";
+
+//----------------------------------------------------------------------------------------------------------------------
+void writeVarInt(std::string& bytes, uint64_t value)
+{
+    while (value >= 0x80) {
+        bytes.push_back(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(char(value));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Prim paths are sorted and node names are alike, so each string only stores what differs from
+// the previous one.
+void writeString(std::string& bytes, const std::string& value, std::string& previous)
+{
+    const size_t maxCommon = std::min(value.size(), previous.size());
+    size_t       common = 0;
+    while (common < maxCommon && value[common] == previous[common]) {
+        ++common;
+    }
+    writeVarInt(bytes, common);
+    writeVarInt(bytes, value.size() - common);
+    bytes.append(value, common, std::string::npos);
+    previous = value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void writeNode(
+    std::string&   bytes,
+    const MUuid&   uuid,
+    const MString& name,
+    std::string&   previousName)
+{
+    if (uuid.valid()) {
+        unsigned char uuidBytes[16];
+        uuid.get(uuidBytes);
+        bytes.push_back(1);
+        bytes.append(reinterpret_cast<const char*>(uuidBytes), sizeof(uuidBytes));
+    } else {
+        bytes.push_back(0);
+    }
+    writeString(bytes, name.asChar(), previousName);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void writeNode(std::string& bytes, const MObject& obj, std::string& previousName)
+{
+    if (obj.isNull()) {
+        writeNode(bytes, MUuid(), MString(), previousName);
+    } else {
+        writeNode(bytes, MFnDependencyNode(obj).uuid(), getNodeName(obj), previousName);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string serialiseCompact(const TranslatorContext::PrimLookups& primMapping)
+{
+    // The translator ids are shared by many prims, so they are only stored once.
+    std::vector<std::string>                     translatorIds;
+    std::unordered_map<std::string, std::size_t> translatorIdIndices;
+    for (const auto& lookup : primMapping) {
+        if (translatorIdIndices.emplace(lookup.translatorId(), translatorIds.size()).second) {
+            translatorIds.push_back(lookup.translatorId());
+        }
+    }
+
+    std::string bytes;
+    std::string previous;
+    writeVarInt(bytes, translatorIds.size());
+    for (const auto& translatorId : translatorIds) {
+        writeString(bytes, translatorId, previous);
+    }
+
+    std::string previousPath;
+    std::string previousName;
+    writeVarInt(bytes, primMapping.size());
+    for (const auto& lookup : primMapping) {
+        writeString(bytes, lookup.path().GetString(), previousPath);
+        writeVarInt(bytes, translatorIdIndices[lookup.translatorId()]);
+        writeVarInt(bytes, lookup.uniqueKey());
+        if (lookup.isResolved()) {
+            writeVarInt(bytes, 1 + lookup.createdNodes().size());
+            writeNode(bytes, lookup.object(), previousName);
+            for (const auto& node : lookup.createdNodes()) {
+                writeNode(bytes, node.object(), previousName);
+            }
+        } else {
+            // Nodes that weren't looked up since they were deserialised are written back as is.
+            writeVarInt(bytes, lookup.serialisedNodes().size());
+            for (const auto& node : lookup.serialisedNodes()) {
+                writeNode(bytes, node.uuid, node.name, previousName);
+            }
+        }
+    }
+    return bytes;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+struct CompactReader
+{
+    const std::string& bytes;
+    std::size_t        pos = 0;
+    bool               ok = true;
+
+    uint64_t readVarInt()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; ok && shift < 64; shift += 7) {
+            if (pos >= bytes.size()) {
+                break;
+            }
+            const uint8_t byte = uint8_t(bytes[pos++]);
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    void readString(std::string& previous)
+    {
+        const uint64_t common = readVarInt();
+        const uint64_t size = readVarInt();
+        if (!ok || common > previous.size() || size > bytes.size() - pos) {
+            ok = false;
+            return;
+        }
+        previous.resize(common);
+        previous.append(bytes, pos, size);
+        pos += size;
+    }
+
+    void readNode(TranslatorContext::SerialisedNode& node, std::string& previousName)
+    {
+        if (!ok || pos >= bytes.size()) {
+            ok = false;
+            return;
+        }
+        const bool hasUuid = bytes[pos++] != 0;
+        if (hasUuid) {
+            if (pos + 16 > bytes.size()) {
+                ok = false;
+                return;
+            }
+            node.uuid = MUuid(reinterpret_cast<const unsigned char*>(bytes.data() + pos));
+            pos += 16;
+        }
+        readString(previousName);
+        node.name = previousName.c_str();
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+bool deserialiseCompact(const std::string& bytes, TranslatorContext::PrimLookups& primMapping)
+{
+    CompactReader reader { bytes };
+
+    std::vector<std::string> translatorIds(reader.readVarInt());
+    std::string              previous;
+    for (std::size_t i = 0; reader.ok && i < translatorIds.size(); ++i) {
+        reader.readString(previous);
+        translatorIds[i] = previous;
+    }
+
+    std::string    previousPath;
+    std::string    previousName;
+    const uint64_t lookupCount = reader.readVarInt();
+    for (uint64_t i = 0; reader.ok && i < lookupCount; ++i) {
+        reader.readString(previousPath);
+        const uint64_t translatorIdIndex = reader.readVarInt();
+        const uint64_t uniqueKey = reader.readVarInt();
+        const uint64_t nodeCount = reader.readVarInt();
+        if (!reader.ok || translatorIdIndex >= translatorIds.size() || nodeCount == 0
+            || nodeCount > bytes.size()) {
+            return false;
+        }
+
+        TranslatorContext::PrimLookup lookup(
+            SdfPath(previousPath), translatorIds[translatorIdIndex], MObject());
+        lookup.setUniqueKey(std::size_t(uniqueKey));
+        lookup.serialisedNodes().resize(nodeCount);
+        for (auto& node : lookup.serialisedNodes()) {
+            reader.readNode(node, previousName);
+        }
+        primMapping.push_back(std::move(lookup));
+    }
+    return reader.ok && reader.pos == bytes.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Nodes are looked up from their UUID first, as it isn't affected by renames. The copies of a file
+// referenced more than once share the UUIDs of their nodes though, so an ambiguous UUID falls back
+// to the name.
+MObject findSerialisedNode(const TranslatorContext::SerialisedNode& node)
+{
+    MObject obj;
+    if (node.uuid.valid()) {
+        MSelectionList sl;
+        if (sl.add(node.uuid) && sl.length() == 1 && sl.getDependNode(0, obj)) {
+            return obj;
+        }
+        obj = MObject::kNullObj;
+    }
+    if (node.name.length()) {
+        MSelectionList sl;
+        sl.add(node.name);
+        sl.getDependNode(0, obj);
+    }
+    return obj;
+}
+
+} // namespace
+
 //----------------------------------------------------------------------------------------------------------------------
-MString TranslatorContext::serialise() const
+MString TranslatorContext::serialise(bool compact) const
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:serialise\n");
     std::ostringstream oss;
@@ -391,14 +628,28 @@ MString TranslatorContext::serialise() const
 
     m_proxyShape->excludedTranslatedGeometryPlug().setString(MString(oss.str().c_str()));
 
+    if (compact) {
+        const std::string text
+            = kCompactPrefix + MayaUsd::utils::encodeBase64(serialiseCompact(m_primMapping));
+        return MString(text.c_str());
+    }
+
     oss.str("");
     oss.clear();
 
-    for (auto it : m_primMapping) {
+    for (const auto& it : m_primMapping) {
         oss << it.path() << "=" << it.translatorId() << ",";
-        oss << getNodeName(it.object());
-        for (uint32_t i = 0; i < it.createdNodes().size(); ++i) {
-            oss << "," << getNodeName(it.createdNodes()[i].object());
+        if (it.isResolved()) {
+            oss << getNodeName(it.object());
+            for (uint32_t i = 0; i < it.createdNodes().size(); ++i) {
+                oss << "," << getNodeName(it.createdNodes()[i].object());
+            }
+        } else {
+            const auto& nodes = it.serialisedNodes();
+            oss << nodes[0].name;
+            for (std::size_t i = 1; i < nodes.size(); ++i) {
+                oss << "," << nodes[i].name;
+            }
         }
         if (it.uniqueKey()) {
             oss << ",uniquekey:" << it.uniqueKey();
@@ -412,53 +663,67 @@ MString TranslatorContext::serialise() const
 void TranslatorContext::deserialise(const MString& string)
 {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:deserialise\n");
-    MStringArray strings;
-    string.split(';', strings);
-
-    for (uint32_t i = 0; i < strings.length(); ++i) {
-        MStringArray strings2;
-        strings[i].split('=', strings2);
-
-        MStringArray strings3;
-        strings2[1].split(',', strings3);
 
-        MObject obj;
-        {
-            MSelectionList sl;
-            sl.add(strings3[1].asChar());
-            sl.getDependNode(0, obj);
-        }
-
-        PrimLookup lookup(SdfPath(strings2[0].asChar()), strings3[0].asChar(), obj);
-
-        static const MString uniqueKeyPrefix("uniquekey:");
-
-        for (uint32_t j = 2; j < strings3.length(); ++j) {
-            if (strings3[j].substring(0, 10) == uniqueKeyPrefix) {
-                auto keyStr(strings3[j].substring(10, strings3[j].length()));
-                if (keyStr.length()) {
-                    try {
-                        lookup.setUniqueKey(std::stoul(keyStr.asChar()));
-                    } catch (std::logic_error&) {
-                        TF_DEBUG(ALUSDMAYA_TRANSLATORS)
-                            .Msg(
-                                "TranslatorContext:deserialise ignored invalid hash value for "
-                                "prim='%s' [hash='%s']\n",
-                                lookup.path().GetText(),
-                                keyStr.asChar());
+    const std::size_t compactPrefixLength = sizeof(kCompactPrefix) - 1;
+    m_isSerialisedCompact = string.length() >= compactPrefixLength
+        && string.substring(0, compactPrefixLength - 1) == kCompactPrefix;
+
+    if (m_isSerialisedCompact) {
+        const std::string text(string.asChar() + compactPrefixLength);
+        std::string       bytes;
+        PrimLookups       primMapping;
+        if (MayaUsd::utils::decodeBase64(text, &bytes) && deserialiseCompact(bytes, primMapping)) {
+            m_primMapping.insert(
+                m_primMapping.end(),
+                std::make_move_iterator(primMapping.begin()),
+                std::make_move_iterator(primMapping.end()));
+        } else {
+            MGlobal::displayError(
+                MString("TranslatorContext::deserialise could not read the translator context of ")
+                + m_proxyShape->name());
+        }
+    } else {
+        MStringArray strings;
+        string.split(';', strings);
+
+        for (uint32_t i = 0; i < strings.length(); ++i) {
+            MStringArray strings2;
+            strings[i].split('=', strings2);
+
+            MStringArray strings3;
+            strings2[1].split(',', strings3);
+
+            PrimLookup lookup(SdfPath(strings2[0].asChar()), strings3[0].asChar(), MObject());
+            lookup.serialisedNodes().push_back(SerialisedNode { MUuid(), strings3[1] });
+
+            static const MString uniqueKeyPrefix("uniquekey:");
+
+            for (uint32_t j = 2; j < strings3.length(); ++j) {
+                if (strings3[j].substring(0, 10) == uniqueKeyPrefix) {
+                    auto keyStr(strings3[j].substring(10, strings3[j].length()));
+                    if (keyStr.length()) {
+                        try {
+                            lookup.setUniqueKey(std::stoul(keyStr.asChar()));
+                        } catch (std::logic_error&) {
+                            TF_DEBUG(ALUSDMAYA_TRANSLATORS)
+                                .Msg(
+                                    "TranslatorContext:deserialise ignored invalid hash value for "
+                                    "prim='%s' [hash='%s']\n",
+                                    lookup.path().GetText(),
+                                    keyStr.asChar());
+                        }
                     }
+                    continue;
                 }
-                continue;
+
+                lookup.serialisedNodes().push_back(SerialisedNode { MUuid(), strings3[j] });
             }
 
-            MSelectionList sl;
-            sl.add(strings3[j].asChar());
-            MObject obj;
-            sl.getDependNode(0, obj);
-            lookup.createdNodes().push_back(obj);
+            // The text form identifies the nodes by their DAG path, which renaming or reparenting
+            // them or their ancestors invalidates, so they are looked up while it is still valid.
+            resolveSerialisedNodes(lookup);
+            m_primMapping.push_back(lookup);
         }
-
-        m_primMapping.push_back(lookup);
     }
 
     SdfPathVector vec = m_proxyShape->getPrimPathsFromCommaJoinedString(
@@ -466,6 +731,23 @@ void TranslatorContext::deserialise(const MString& string)
     for (auto& it : vec) {
         m_excludedGeometry.emplace(it, it);
     }
+
+    m_isDirty = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::resolveSerialisedNodes(PrimLookup& lookup)
+{
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS)
+        .Msg("TranslatorContext::resolveSerialisedNodes %s\n", lookup.path().GetText());
+
+    std::vector<SerialisedNode> nodes;
+    nodes.swap(lookup.serialisedNodes());
+
+    lookup.setNode(findSerialisedNode(nodes[0]));
+    for (std::size_t i = 1; i < nodes.size(); ++i) {
+        lookup.createdNodes().push_back(findSerialisedNode(nodes[i]));
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -513,6 +795,7 @@ void TranslatorContext::preRemoveEntry(
                     primPath.GetText());
         } else {
             itemsToRemove.push_back(node.path());
+            resolve(node);
             auto prim = stage->GetPrimAtPath(node.path());
             if (prim && callPreUnload) {
                 preUnloadPrim(prim, node.object());
@@ -541,6 +824,7 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
             ++iter;
             continue;
         }
+        resolve(*node);
         bool isInTransformChain = isPrimInTransformChain(path);
 
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
@@ -553,6 +837,7 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
         if (node != m_primMapping.end() && node->path() == path) {
             // remove nodes from map
             m_primMapping.erase(node);
+            m_isDirty = true;
         }
 
         if (isInTransformChain) {
@@ -583,7 +868,10 @@ void TranslatorContext::updateUniqueKeys()
                         "uniqueKey='%lu'\n",
                         lookup.path().GetText(),
                         key);
-                lookup.setUniqueKey(key);
+                if (lookup.uniqueKey() != key) {
+                    lookup.setUniqueKey(key);
+                    m_isDirty = true;
+                }
             }
         }
     }
@@ -614,7 +902,10 @@ void TranslatorContext::updateUniqueKey(const UsdPrim& prim)
                     path.GetText(),
                     key,
                     it->uniqueKey());
-            it->setUniqueKey(key);
+            if (it->uniqueKey() != key) {
+                it->setUniqueKey(key);
+                m_isDirty = true;
+            }
         }
     }
 }
@@ -838,6 +1129,7 @@ bool TranslatorContext::addExcludedGeometry(const SdfPath& newPath)
             m_excludedGeometry.emplace(newPath, newPath);
         }
         m_isExcludedGeometryDirty = true;
+        m_isDirty = true;
         return true;
     }
     return false;
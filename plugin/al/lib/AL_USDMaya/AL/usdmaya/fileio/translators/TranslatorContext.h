@@ -31,6 +31,7 @@
 #include <maya/MObjectArray.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPxData.h>
+#include <maya/MUuid.h>
 
 #include <string>
 #include <vector>
@@ -272,16 +273,35 @@ public:
     AL_USDMAYA_PUBLIC
     void registerItem(const UsdPrim& prim, MObjectHandle object);
 
-    /// \brief  serialises the content of the translator context to a text string.
+    /// \brief  serialises the content of the translator context to a string.
+    /// \param  compact if true, the context is serialised into a compact binary form (base64
+    ///         encoded), which older versions of the plug-in can't read. The maya nodes are then
+    ///         identified by their UUID, and only fall back to their name.
     /// \return the translator context serialised into a string
     AL_USDMAYA_PUBLIC
-    MString serialise() const;
+    MString serialise(bool compact = false) const;
 
-    /// \brief  deserialises the string back into the translator context
-    /// \param  string the string to deserialised
+    /// \brief  deserialises the string back into the translator context. In the compact form, the
+    ///         maya nodes of each prim are only looked up when the prim is first accessed.
+    /// \param  string the string to deserialised, in either form
     AL_USDMAYA_PUBLIC
     void deserialise(const MString& string);
 
+    /// \brief  returns true if the context changed since it was last serialised or deserialised.
+    inline bool isDirty() const { return m_isDirty; }
+
+    /// \brief  call this once the result of serialise() has been stored, so that a compact
+    ///         serialisation is only done again once the context changes.
+    /// \param  compact the form the context was serialised into
+    inline void markSerialised(bool compact)
+    {
+        m_isDirty = false;
+        m_isSerialisedCompact = compact;
+    }
+
+    /// \brief  returns true if the context was last serialised or deserialised in the compact form
+    inline bool isSerialisedCompact() const { return m_isSerialisedCompact; }
+
     /// \brief  debugging utility to help keep track of prims during a variant switch
     AL_USDMAYA_PUBLIC
     void validatePrims();
@@ -341,6 +361,14 @@ public:
     AL_USDMAYA_PUBLIC
     void updateUniqueKey(const UsdPrim& prim);
 
+    /// \brief  A maya node read back from a serialised context, which is only looked up when the
+    ///         prim it belongs to is first accessed.
+    struct SerialisedNode
+    {
+        MUuid   uuid;
+        MString name;
+    };
+
     /// \brief  An internal structure used to store a mapping between an SdfPath, the type of prim
     /// found at that location,
     ///         the maya transform that may have been created (assuming the translator plugin
@@ -404,13 +432,26 @@ public:
         /// \return the created maya nodes for this prim translator
         const MObjectHandleArray& createdNodes() const { return m_createdNodes; }
 
+        /// \brief  get the deserialised maya nodes that haven't been looked up yet
+        /// \return the transform followed by the created nodes, or nothing once they are resolved
+        std::vector<SerialisedNode>& serialisedNodes() { return m_serialisedNodes; }
+
+        /// \brief  get the deserialised maya nodes that haven't been looked up yet
+        /// \return the transform followed by the created nodes, or nothing once they are resolved
+        const std::vector<SerialisedNode>& serialisedNodes() const { return m_serialisedNodes; }
+
+        /// \brief  returns true once the maya nodes are known, i.e. unless deserialised and not yet
+        ///         accessed
+        bool isResolved() const { return m_serialisedNodes.empty(); }
+
     private:
-        SdfPath            m_path;
-        std::string        m_translatorId;
-        std::size_t        m_uniqueKey;
-        TfToken            m_type;
-        MObjectHandle      m_object;
-        MObjectHandleArray m_createdNodes;
+        SdfPath                     m_path;
+        std::string                 m_translatorId;
+        std::size_t                 m_uniqueKey;
+        TfToken                     m_type;
+        MObjectHandle               m_object;
+        MObjectHandleArray          m_createdNodes;
+        std::vector<SerialisedNode> m_serialisedNodes;
     };
 
     /// a sorted array of prim mappings
@@ -443,7 +484,11 @@ public:
     };
 
     /// \brief  This is used for testing only. Do not call.
-    void clearPrimMappings() { m_primMapping.clear(); }
+    void clearPrimMappings()
+    {
+        m_primMapping.clear();
+        m_isDirty = true;
+    }
 
     /// \brief  add geometry to the exclusion list
     /// \param  newPath the path to add as an excluded translator path
@@ -465,6 +510,7 @@ public:
         }
         m_excludedGeometry.erase(newPath);
         m_isExcludedGeometryDirty = true;
+        m_isDirty = true;
         return true;
     }
 
@@ -510,6 +556,26 @@ private:
         return end;
     }
 
+    /// \brief  same as find(), but also looks up the maya nodes of a deserialised prim
+    inline PrimLookups::iterator findResolved(const SdfPath& path)
+    {
+        PrimLookups::iterator it = find(path);
+        if (it != m_primMapping.end()) {
+            resolve(*it);
+        }
+        return it;
+    }
+
+    /// \brief  looks up the maya nodes of a deserialised prim, if it hasn't been done yet
+    inline void resolve(PrimLookup& lookup)
+    {
+        if (!lookup.isResolved()) {
+            resolveSerialisedNodes(lookup);
+        }
+    }
+
+    void resolveSerialisedNodes(PrimLookup& lookup);
+
     inline PrimLookups::iterator findLocation(const SdfPath& path)
     {
         PrimLookups::iterator end = m_primMapping.end();
@@ -534,6 +600,10 @@ private:
     SdfInstanceMap m_excludedGeometry;
     bool           m_isExcludedGeometryDirty;
 
+    // true if the context changed since it was last serialised or deserialised
+    bool m_isDirty = false;
+    bool m_isSerialisedCompact = false;
+
 public:
     void setForceDefaultRead(bool forceDefaultRead) { m_forceDefaultRead = forceDefaultRead; }
 
@@ -28,6 +28,9 @@
 #include <maya/MFnMesh.h>
 #include <maya/MTime.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -86,6 +89,9 @@ MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
     MTime       inTimeVal = inputTimeValue(data, m_inTime);
     UsdTimeCode usdTime(inTimeVal.value());
 
+    // The points and normals are written into the input mesh. If it has not been re-evaluated
+    // since the last compute, it still holds the values copied then.
+    const bool  inputChanged = !data.isClean(m_inMesh);
     MDataHandle inputHandle = data.inputValue(m_inMesh, &status);
     MDataHandle outputHandle = data.outputValue(m_outMesh, &status);
 
@@ -93,36 +99,121 @@ MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
 
     UsdStageRefPtr stage = getStage();
     if (stage) {
-        UsdPrim     prim = stage->GetPrimAtPath(m_cachePath);
-        UsdGeomMesh mesh(prim);
+        if (m_queriesDirty || m_queryStage != UsdStageWeakPtr(stage)) {
+            updateAttributeQueries(stage);
+        }
+        const UsdInterpolationType interpolation = stage->GetInterpolationType();
 
         MFnMesh      fnMesh(obj);
         float* const ptr = (float*)fnMesh.getRawPoints(&status);
         if (ptr) {
-            UsdAttribute points = mesh.GetPointsAttr();
-            if (points.GetNumTimeSamples() > 1) {
-                VtArray<GfVec3f> pointData;
-                points.Get(&pointData, usdTime);
-                const size_t numPoints = pointData.size();
-                std::memcpy(ptr, pointData.cdata(), sizeof(float) * 3 * numPoints);
-            }
+            copyAnimatedAttribute(
+                m_points, usdTime, interpolation, inputChanged, ptr, fnMesh.numVertices());
         }
 
         float* const nptr = (float*)fnMesh.getRawNormals(&status);
         if (nptr) {
-            UsdAttribute normals = mesh.GetNormalsAttr();
-            if (normals.GetNumTimeSamples() > 1) {
-                VtArray<GfVec3f> normalData;
-                normals.Get(&normalData, usdTime);
-                const size_t numNormals = normalData.size();
-                std::memcpy(nptr, normalData.cdata(), sizeof(float) * 3 * numNormals);
-            }
+            copyAnimatedAttribute(
+                m_normals, usdTime, interpolation, inputChanged, nptr, fnMesh.numNormals());
         }
         outputHandle.set(obj);
     }
     return status;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::copyAnimatedAttribute(
+    AnimatedAttribute&   attribute,
+    UsdTimeCode          time,
+    UsdInterpolationType interpolation,
+    bool                 inputChanged,
+    float*               dst,
+    size_t               count)
+{
+    if (!attribute.query.IsValid() || !attribute.query.ValueMightBeTimeVarying()) {
+        return;
+    }
+
+    // When the time resolves to a single time sample (held interpolation, or a time on or outside
+    // of the sampled range), the value is the one of that sample. Skip it if it has already been
+    // copied into the mesh.
+    double lower = 0, upper = 0;
+    bool   hasTimeSamples = false;
+    bool   held = false;
+    if (attribute.query.GetBracketingTimeSamples(time.GetValue(), &lower, &upper, &hasTimeSamples)
+        && hasTimeSamples) {
+        held = lower == upper || interpolation == UsdInterpolationTypeHeld;
+        if (held && !inputChanged && attribute.hasHeldSample
+            && attribute.heldSampleTime == lower) {
+            TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER)
+                .Msg("MeshAnimDeformer::compute skipping unchanged sample at %f\n", lower);
+            return;
+        }
+    }
+
+    attribute.hasHeldSample = false;
+    if (!attribute.query.Get(&attribute.values, time)) {
+        return;
+    }
+
+    // never write past the end of the Maya buffer, even if the topology of the input mesh
+    // does not match the cache.
+    const size_t numValues = std::min(attribute.values.size(), count);
+    std::memcpy(dst, attribute.values.cdata(), sizeof(GfVec3f) * numValues);
+    attribute.hasHeldSample = held;
+    attribute.heldSampleTime = lower;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::updateAttributeQueries(const UsdStageRefPtr& stage)
+{
+    TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimDeformer::updateAttributeQueries\n");
+
+    // clear the flag first, so that a change notified while the queries are rebuilt is not lost.
+    m_queriesDirty = false;
+
+    if (m_queryStage != UsdStageWeakPtr(stage)) {
+        TfNotice::Revoke(m_objectsChangedNoticeKey);
+        m_objectsChangedNoticeKey = TfNotice::Register(
+            TfCreateWeakPtr(this), &MeshAnimDeformer::onObjectsChanged, UsdStageWeakPtr(stage));
+        m_queryStage = stage;
+    }
+
+    UsdGeomMesh mesh(stage->GetPrimAtPath(m_cachePath));
+    m_points = AnimatedAttribute();
+    m_normals = AnimatedAttribute();
+    if (mesh) {
+        m_points.query = UsdAttributeQuery(mesh.GetPointsAttr());
+        m_normals.query = UsdAttributeQuery(mesh.GetNormalsAttr());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::onObjectsChanged(
+    UsdNotice::ObjectsChanged const& notice,
+    UsdStageWeakPtr const&)
+{
+    if (m_queriesDirty || m_cachePath.IsEmpty()) {
+        return;
+    }
+
+    // a resync of the mesh or of one of its ancestors invalidates the queries
+    for (const SdfPath& path : notice.GetResyncedPaths()) {
+        if (m_cachePath.HasPrefix(path.GetPrimPath())) {
+            m_queriesDirty = true;
+            return;
+        }
+    }
+
+    // as does a change of the samples of its attributes.
+    for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+        if (path.GetPrimPath() == m_cachePath) {
+            m_queriesDirty = true;
+            return;
+        }
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MeshAnimDeformer::connectionMade(const MPlug& plug, const MPlug& otherPlug, bool asSrc)
 {
@@ -191,6 +282,7 @@ void MeshAnimDeformer::onAttributeChanged(
             } else {
                 deformer->m_cachePath = SdfPath();
             }
+            deformer->m_queriesDirty = true;
         }
     }
 }
@@ -17,12 +17,20 @@
 #include "AL/maya/utils/MayaHelperMacros.h"
 #include "AL/maya/utils/NodeHelper.h"
 
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/weakBase.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/usd/usd/attributeQuery.h>
+#include <pxr/usd/usd/notice.h>
 #include <pxr/usd/usd/stage.h>
 
 #include <maya/MNodeMessage.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPxNode.h>
 
+#include <atomic>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
@@ -32,10 +40,14 @@ namespace nodes {
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief   This node is a simple deformer that modifies
 /// \ingroup nodes
+/// \note    The queries on the points and normals attributes are cached, and only rebuilt when
+///          the prim (or one of its ancestors) is resynced, or when its attributes are edited.
+///          Frames resolving to the time sample of the previous evaluation are not read again.
 //----------------------------------------------------------------------------------------------------------------------
 class MeshAnimDeformer
     : public MPxNode
     , public AL::maya::utils::NodeHelper
+    , public TfWeakBase
 {
 public:
     /// \brief  ctor
@@ -45,7 +57,11 @@ public:
     {
     }
 
-    inline ~MeshAnimDeformer() { MNodeMessage::removeCallback(m_attributeChanged); }
+    inline ~MeshAnimDeformer()
+    {
+        MNodeMessage::removeCallback(m_attributeChanged);
+        TfNotice::Revoke(m_objectsChangedNoticeKey);
+    }
 
     //--------------------------------------------------------------------------------------------------------------------
     /// Type Info & Registration
@@ -63,17 +79,49 @@ public:
     AL_DECL_ATTRIBUTE(outMesh);
 
 private:
+    /// \brief  An animated attribute read by the deformer, along with the time sample last copied
+    ///         into the mesh.
+    struct AnimatedAttribute
+    {
+        UsdAttributeQuery query;
+        VtArray<GfVec3f>  values;
+        double            heldSampleTime = 0;
+        bool              hasHeldSample = false;
+    };
+
     void           postConstructor() override;
     MStatus        connectionMade(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
     MStatus        connectionBroken(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
     static void    onAttributeChanged(MNodeMessage::AttributeMessage, MPlug&, MPlug&, void*);
     MStatus        compute(const MPlug& plug, MDataBlock& data) override;
     UsdStageRefPtr getStage();
+    void           onObjectsChanged(UsdNotice::ObjectsChanged const&, UsdStageWeakPtr const&);
+    void           updateAttributeQueries(const UsdStageRefPtr& stage);
+
+    /// \brief  copies the value of an animated attribute at the given time into the Maya buffer
+    /// \param  attribute the attribute to read
+    /// \param  time the time to read the attribute at
+    /// \param  interpolation the interpolation type of the stage
+    /// \param  inputChanged true if the input mesh has been re-evaluated since the last compute
+    /// \param  dst the Maya buffer to copy the values into
+    /// \param  count the number of elements in the Maya buffer
+    static void copyAnimatedAttribute(
+        AnimatedAttribute&   attribute,
+        UsdTimeCode          time,
+        UsdInterpolationType interpolation,
+        bool                 inputChanged,
+        float*               dst,
+        size_t               count);
 
 private:
-    SdfPath       m_cachePath;
-    MObjectHandle proxyShapeHandle;
-    MCallbackId   m_attributeChanged = 0;
+    SdfPath           m_cachePath;
+    MObjectHandle     proxyShapeHandle;
+    MCallbackId       m_attributeChanged = 0;
+    TfNotice::Key     m_objectsChangedNoticeKey;
+    UsdStageWeakPtr   m_queryStage;
+    AnimatedAttribute m_points;
+    AnimatedAttribute m_normals;
+    std::atomic<bool> m_queriesDirty { true };
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -83,7 +83,18 @@ void ProxyShape::serialiseTranslatorContext()
     triggerEvent("PreSerialiseContext");
 
     context()->updateUniqueKeys();
-    serializedTrCtxPlug().setValue(context()->serialise());
+
+    // The plug keeps the last compact serialisation, which is still valid unless the context
+    // changed, as it identifies the nodes by UUID. The text form stores the DAG paths of the nodes,
+    // which renaming or reparenting them or their ancestors changes, so it is always rewritten.
+    const bool compact = MGlobal::optionVarIntValue("AL_usdmaya_compactTranslatorContext");
+    if (!compact || context()->isDirty() || !context()->isSerialisedCompact()) {
+        serializedTrCtxPlug().setValue(context()->serialise(compact));
+        context()->markSerialised(compact);
+    } else {
+        TF_DEBUG(ALUSDMAYA_TRANSLATORS)
+            .Msg("ProxyShape::serialiseTranslatorContext %s is unchanged\n", name().asChar());
+    }
 
     triggerEvent("PostSerialiseContext");
 }
@@ -964,8 +975,6 @@ void ProxyShape::processChangedObjects(
 {
     TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::processChangedObjects - processing changes\n");
 
-    bool shouldCleanBBoxCache = false;
-
     if (!m_stage) {
         TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::processChangedObjects - Invalid stage\n");
         return;
@@ -991,44 +1000,16 @@ void ProxyShape::processChangedObjects(
                 continue;
             tmm->setPrim(
                 newPrim, tm); // Might be (invalid/nullptr) but that's OK at least it won't crash
-        } else {
-            UsdPrim newPrim = m_stage->GetPrimAtPath(path);
-            if (!newPrim.IsValid()) {
-                TF_DEBUG(ALUSDMAYA_EVENTS)
-                    .Msg(
-                        "ProxyShape::processChangedObjects - resyncedPaths (2) contains invalid "
-                        "path %s\n",
-                        path.GetText());
-                continue;
-            }
-            if (newPrim && newPrim.IsA<UsdGeomXformable>()) {
-                shouldCleanBBoxCache = true;
-            }
-        }
-    }
-
-    // check to see if any transform ops have been modified (update the bounds accordingly)
-    if (!shouldCleanBBoxCache) {
-        for (const SdfPath& path : changedOnlyPaths) {
-            UsdPrim changedPrim = m_stage->GetPrimAtPath(path);
-            if (path.IsPrimPropertyPath()) {
-                const std::string tokenString = path.GetElementString();
-                if (std::strncmp(tokenString.c_str(), ".xformOp", 8) == 0) {
-                    shouldCleanBBoxCache = true;
-                    break;
-                }
-            }
         }
     }
 
-    // do we need to clear the bounding box cache?
-    if (shouldCleanBBoxCache) {
-        clearBoundingBoxCache();
+    // Only drop the cached bounds of the edited subtrees and of their ancestors: a transform
+    // edit on a single prim doesn't require the bounds of the whole stage to be computed again.
+    invalidateBoundingBoxCache(m_stage, resyncedPaths, changedOnlyPaths);
 
-        // Ideally we want to have a way to force maya to call ProxyShape::boundingBox() again to
-        // update the bbox attributes. This may lead to a delay in the bbox updates (e.g. usually
-        // you need to reselect the proxy before the bounds will be updated).
-    }
+    // Ideally we want to have a way to force maya to call ProxyShape::boundingBox() again to
+    // update the bbox attributes. This may lead to a delay in the bbox updates (e.g. usually
+    // you need to reselect the proxy before the bounds will be updated).
 
     if (isLockPrimFeatureActive()) {
         processChangedMetaData(resyncedPaths, changedOnlyPaths);
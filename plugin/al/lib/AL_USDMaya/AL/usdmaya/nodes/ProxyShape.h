@@ -593,11 +593,14 @@ public:
     /// \name   Plug-in Translator node methods
     //--------------------------------------------------------------------------------------------------------------------
 
-    /// \brief  serialises the translator context
+    /// \brief  serialises the translator context. The compact binary form is used when the
+    ///         AL_usdmaya_compactTranslatorContext optionVar is set, and is only serialised again
+    ///         once the context changed.
     AL_USDMAYA_PUBLIC
     void serialiseTranslatorContext();
 
-    /// \brief  deserialises the translator context
+    /// \brief  deserialises the translator context. In the compact form, the maya nodes of a prim
+    ///         are only looked up when the prim is first accessed.
     AL_USDMAYA_PUBLIC
     void deserialiseTranslatorContext();
 
@@ -0,0 +1,157 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/ProxyShape.h"
+#include "test_usdmaya.h"
+
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/mesh.h>
+
+#include <maya/MDGModifier.h>
+#include <maya/MFileIO.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnMesh.h>
+#include <maya/MPlug.h>
+#include <maya/MPoint.h>
+#include <maya/MTime.h>
+
+#include <chrono>
+#include <iostream>
+
+using AL::maya::test::buildTempPath;
+
+namespace {
+
+// a grid of kGridSize x kGridSize points, translated by the frame number along Y
+const int    kGridSize = 200;
+const double kStartFrame = 1.0;
+const double kEndFrame = 48.0;
+
+UsdStageRefPtr buildAnimatedGrid()
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    stage->SetStartTimeCode(kStartFrame);
+    stage->SetEndTimeCode(kEndFrame);
+
+    UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath("/grid"));
+
+    VtArray<int>     faceVertexCounts;
+    VtArray<int>     faceVertexIndices;
+    VtArray<GfVec3f> points;
+    for (int i = 0; i < kGridSize; ++i) {
+        for (int j = 0; j < kGridSize; ++j) {
+            points.push_back(GfVec3f(float(i), 0.0f, float(j)));
+            if (i + 1 < kGridSize && j + 1 < kGridSize) {
+                const int v = i * kGridSize + j;
+                faceVertexCounts.push_back(4);
+                faceVertexIndices.push_back(v);
+                faceVertexIndices.push_back(v + 1);
+                faceVertexIndices.push_back(v + kGridSize + 1);
+                faceVertexIndices.push_back(v + kGridSize);
+            }
+        }
+    }
+    mesh.GetFaceVertexCountsAttr().Set(faceVertexCounts);
+    mesh.GetFaceVertexIndicesAttr().Set(faceVertexIndices);
+
+    UsdAttribute pointsAttr = mesh.GetPointsAttr();
+    for (double frame = kStartFrame; frame <= kEndFrame; frame += 1.0) {
+        VtArray<GfVec3f> framePoints = points;
+        for (GfVec3f& point : framePoints) {
+            point[1] = float(frame);
+        }
+        pointsAttr.Set(framePoints, UsdTimeCode(frame));
+    }
+    return stage;
+}
+
+// evaluate the output mesh of the deformer at the given frame, and return its first point
+MPoint evaluate(const MObject& deformer, double frame)
+{
+    MFnDependencyNode fn(deformer);
+    fn.findPlug("inTime", true).setValue(MTime(frame, MTime::uiUnit()));
+
+    MObject mesh;
+    fn.findPlug("outMesh", true).getValue(mesh);
+
+    MPoint point;
+    MFnMesh(mesh).getPoint(0, point);
+    return point;
+}
+
+} // namespace
+
+// Deform a mesh created from USD, and time the evaluation of the deformer per frame.
+TEST(MeshAnimDeformer, deformAndBenchmark)
+{
+    MFileIO::newFile(true);
+
+    const std::string temp_path = buildTempPath("AL_USDMayaTests_meshAnimDeformer.usda");
+
+    MObject                         shape;
+    AL::usdmaya::nodes::ProxyShape* proxy
+        = CreateMayaProxyShape(buildAnimatedGrid, temp_path, &shape);
+    ASSERT_TRUE(proxy);
+
+    MFnDependencyNode fnCreator, fnDeformer;
+    MObject           creator = fnCreator.create("AL_usdmaya_MeshAnimCreator");
+    MObject           deformer = fnDeformer.create("AL_usdmaya_MeshAnimDeformer");
+    fnCreator.findPlug("primPath", true).setString("/grid");
+    fnDeformer.findPlug("primPath", true).setString("/grid");
+
+    // the creator is not animated: the deformer modifies the mesh it outputs
+    MPlug       outStageData = MFnDependencyNode(shape).findPlug("outStageData", true);
+    MDGModifier modifier;
+    modifier.connect(outStageData, fnCreator.findPlug("inStageData", true));
+    modifier.connect(outStageData, fnDeformer.findPlug("inStageData", true));
+    modifier.connect(fnCreator.findPlug("outMesh", true), fnDeformer.findPlug("inMesh", true));
+    ASSERT_EQ(MStatus(MS::kSuccess), modifier.doIt());
+
+    // on a time sample, between two samples (interpolated) and past the last one (held)
+    EXPECT_NEAR(10.0, evaluate(deformer, 10.0).y, 1e-5);
+    EXPECT_NEAR(10.5, evaluate(deformer, 10.5).y, 1e-5);
+    EXPECT_NEAR(kEndFrame, evaluate(deformer, kEndFrame + 1.0).y, 1e-5);
+    EXPECT_NEAR(kEndFrame, evaluate(deformer, kEndFrame + 2.0).y, 1e-5);
+    EXPECT_NEAR(2.0, evaluate(deformer, 2.0).y, 1e-5);
+
+    using clock = std::chrono::steady_clock;
+    auto timePerFrame = [&](double start, double end, double step) {
+        size_t     frames = 0;
+        const auto begin = clock::now();
+        for (double frame = start; frame <= end; frame += step, ++frames) {
+            evaluate(deformer, frame);
+        }
+        const std::chrono::duration<double, std::milli> elapsed = clock::now() - begin;
+        return elapsed.count() / frames;
+    };
+
+    const double sampled = timePerFrame(kStartFrame, kEndFrame, 1.0);
+    const double interpolated = timePerFrame(kStartFrame + 0.5, kEndFrame, 1.0);
+    const double held = timePerFrame(kEndFrame + 1.0, kEndFrame + 48.0, 1.0);
+    std::cout << "MeshAnimDeformer (" << kGridSize * kGridSize << " points): " << sampled
+              << " ms/frame on samples, " << interpolated << " ms/frame interpolated, " << held
+              << " ms/frame held" << std::endl;
+
+    // editing the points must be picked up by the cached attribute queries
+    UsdStageRefPtr stage = proxy->usdStage();
+    ASSERT_TRUE(stage);
+    UsdGeomMesh      mesh(stage->GetPrimAtPath(SdfPath("/grid")));
+    UsdAttribute     pointsAttr = mesh.GetPointsAttr();
+    VtArray<GfVec3f> points;
+    pointsAttr.Get(&points, UsdTimeCode(kEndFrame));
+    points[0][1] = 100.0f;
+    pointsAttr.Set(points, UsdTimeCode(kEndFrame));
+    EXPECT_NEAR(100.0, evaluate(deformer, kEndFrame + 3.0).y, 1e-5);
+}
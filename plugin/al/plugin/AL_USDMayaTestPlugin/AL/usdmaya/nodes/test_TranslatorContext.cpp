@@ -104,8 +104,11 @@ TEST(TranslatorContext, value_compare)
 // void TranslatorContext::removeItems(const UsdPrim& prim);
 // void TranslatorContext::removeItems(const SdfPath& path);
 // TfToken TranslatorContext::getTypeForPath(SdfPath path) const
-// MString TranslatorContext::serialise() const;
+// MString TranslatorContext::serialise(bool compact) const;
 // void TranslatorContext::deserialise(const MString& string);
+// bool TranslatorContext::isDirty() const;
+// void TranslatorContext::markSerialised(bool compact);
+// void ProxyShape::serialiseTranslatorContext();
 TEST(TranslatorContext, TranslatorContext)
 {
     const MString     temp_ma_path = buildTempPath("AL_USDMayaTests_cube.ma");
@@ -240,6 +243,79 @@ TEST(TranslatorContext, TranslatorContext)
             context->removeItems(SdfPath("/root/rig"));
         }
 
+        {
+            obj = fnd.create("polyCube");
+            context->registerItem(prim, transformHandle);
+            context->insertItem(prim, obj);
+            EXPECT_TRUE(context->isDirty());
+            MString text = context->serialise(true);
+            context->markSerialised(true);
+            EXPECT_FALSE(context->isDirty());
+
+            // nodes are found from their UUID, even once renamed
+            MFnDependencyNode(obj).setName("renamedPolyCube");
+            context->clearPrimMappings();
+            context->deserialise(text);
+            EXPECT_FALSE(context->isDirty());
+            EXPECT_TRUE(context->isSerialisedCompact());
+
+            // the prims that weren't accessed are serialised back as they were read
+            EXPECT_TRUE(context->serialise(true) == text);
+            {
+                AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+                context->getMObjects(SdfPath("/root/rig"), handles);
+                ASSERT_EQ(handles.size(), 1u);
+                EXPECT_TRUE(handles[0].object() == obj);
+            }
+            translatorId = context->getTranslatorIdForPath(SdfPath("/root/rig"));
+            EXPECT_TRUE("schematype:ALMayaReference" == translatorId);
+            {
+                MObjectHandle handle;
+                context->getTransform(SdfPath("/root/rig"), handle);
+                EXPECT_TRUE(handle.object() == rigObj);
+            }
+            EXPECT_FALSE(context->isDirty());
+            context->removeItems(SdfPath("/root/rig"));
+            EXPECT_TRUE(context->isDirty());
+        }
+
+        {
+            obj = fnd.create("polyCube");
+            context->registerItem(prim, transformHandle);
+            context->insertItem(prim, obj);
+            proxy->serialiseTranslatorContext();
+            MString text = proxy->serializedTrCtxPlug().asString();
+            context->clearPrimMappings();
+            context->deserialise(text);
+            EXPECT_FALSE(context->isDirty());
+            EXPECT_FALSE(context->isSerialisedCompact());
+
+            // the text form identifies nodes by their DAG path, they are still found once renamed
+            MFnDependencyNode(obj).setName("renamedTextPolyCube");
+            MFnDependencyNode(rigObj).setName("renamedRig");
+            {
+                AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+                context->getMObjects(SdfPath("/root/rig"), handles);
+                ASSERT_EQ(handles.size(), 1u);
+                EXPECT_TRUE(handles[0].object() == obj);
+            }
+            {
+                MObjectHandle handle;
+                context->getTransform(SdfPath("/root/rig"), handle);
+                EXPECT_TRUE(handle.object() == rigObj);
+            }
+
+            // and the context is serialised again with their new paths, although it didn't change
+            EXPECT_FALSE(context->isDirty());
+            proxy->serialiseTranslatorContext();
+            text = proxy->serializedTrCtxPlug().asString();
+            EXPECT_NE(-1, text.indexW("renamedTextPolyCube"));
+            EXPECT_NE(-1, text.indexW("|renamedRig"));
+
+            MFnDependencyNode(rigObj).setName("rig");
+            context->removeItems(SdfPath("/root/rig"));
+        }
+
         {
             obj = fnd.create("polyCube");
             context->registerItem(prim, transformHandle);
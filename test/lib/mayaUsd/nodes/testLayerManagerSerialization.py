@@ -157,6 +157,50 @@ class testLayerManagerSerialization(unittest.TestCase):
 
         shutil.rmtree(self._currentTestDir)
 
+    @unittest.skipUnless(ufeUtils.ufeFeatureSetVersion() >= 2, 'testSaveAllToMayaBinary is available only in UFE v2 or greater.')
+    def testSaveAllToMayaBinary(self):
+        '''
+        Verify that all USD edits are saved into the Maya file as binary data.
+        '''
+        stage = self.copyTestFilesAndMakeEdits()
+
+        cmds.optionVar(intValue=('mayaUsd_SerializedUsdEditsLocation', 2))
+        cmds.optionVar(intValue=('mayaUsd_SerializedUsdEditsBinaryFormat', 1))
+
+        cmds.file(save=True, force=True)
+
+        # Saving again without any edit reuses the previous serialization.
+        cmds.file(save=True, force=True)
+
+        # An edit after a save is saved with the next one.
+        stage.DefinePrim("/ChangeAfterSave", "xform")
+        cmds.file(save=True, force=True)
+        cmds.file(new=True, force=True)
+
+        cmds.file(self._tempMayaFile, open=True)
+
+        stage = mayaUsd.ufe.getStage(
+            "|SerializationTest|SerializationTestShape")
+        stack = stage.GetLayerStack()
+        self.assertEqual(6, len(stack))
+
+        newPrimPath = "/ChangeInRoot"
+        self.assertTrue(stage.GetPrimAtPath(newPrimPath))
+
+        newPrimPath = "/ChangeInLayer_1_1"
+        self.assertTrue(stage.GetPrimAtPath(newPrimPath))
+
+        newPrimPath = "/ChangeInSessionLayer"
+        self.assertTrue(stage.GetPrimAtPath(newPrimPath))
+
+        newPrimPath = "/ChangeAfterSave"
+        self.assertTrue(stage.GetPrimAtPath(newPrimPath))
+
+        self.confirmEditsSavedStatus(False, False)
+
+        cmds.optionVar(remove='mayaUsd_SerializedUsdEditsBinaryFormat')
+        shutil.rmtree(self._currentTestDir)
+
     @unittest.skipUnless(ufeUtils.ufeFeatureSetVersion() >= 2, 'testSaveAllToUsd is available only in UFE v2 or greater.')
     def testSaveAllToUsd(self):
         '''
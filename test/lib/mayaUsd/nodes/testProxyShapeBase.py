@@ -17,7 +17,7 @@
 
 from maya import cmds
 from maya import standalone
-from pxr import Usd, Sdf
+from pxr import Gf, Sdf, Usd, UsdGeom
 
 import fixturesUtils
 
@@ -50,6 +50,151 @@ class testProxyShapeBase(unittest.TestCase):
         bboxSize = cmds.getAttr('Cube_usd.boundingBoxSize')[0]
         self.assertEqual(bboxSize, (1.0, 1.0, 1.0))
 
+    def testBoundingBoxCacheInvalidation(self):
+        '''
+        Verify the cached bounds follow time-varying and edited stages.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShape = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.ufe.getStage(str(ufe.PathString.path(proxyShape)))
+
+        xform = UsdGeom.Xform.Define(stage, '/Xform')
+        cube = UsdGeom.Cube.Define(stage, '/Xform/Cube')
+        cube.CreateExtentAttr([(-1, -1, -1), (1, 1, 1)])
+
+        # Static stage: the same bound is returned for every frame.
+        cmds.currentTime(1)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 1.0))
+        cmds.currentTime(10)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 1.0))
+
+        # Animating a transform makes the bound time-varying.
+        translateOp = xform.AddTranslateOp()
+        translateOp.Set(Gf.Vec3d(0, 0, 0), 1)
+        translateOp.Set(Gf.Vec3d(0, 10, 0), 10)
+        cmds.currentTime(1)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 1.0))
+        cmds.currentTime(10)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 11.0, 1.0))
+
+        # Editing the extent of a descendant invalidates the cached bounds.
+        cube.GetExtentAttr().Set([(-2, -2, -2), (2, 2, 2)])
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (2.0, 12.0, 2.0))
+
+    def testBoundingBoxSubtreeInvalidation(self):
+        '''
+        Verify that the bounds cached per subtree follow edits to a single prim.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShape = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.ufe.getStage(str(ufe.PathString.path(proxyShape)))
+
+        cubes = []
+        for name in ['A', 'B']:
+            UsdGeom.Xform.Define(stage, '/Group/' + name)
+            cube = UsdGeom.Cube.Define(stage, '/Group/%s/Cube' % name)
+            cube.CreateExtentAttr([(-1, -1, -1), (1, 1, 1)])
+            cubes.append(cube)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 1.0))
+
+        # Moving a nested prim only updates the bounds of its ancestors.
+        UsdGeom.Xformable(cubes[0]).AddTranslateOp().Set(Gf.Vec3d(5, 0, 0))
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (6.0, 1.0, 1.0))
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMin')[0], (-1.0, -1.0, -1.0))
+
+        # Moving its parent too.
+        UsdGeom.Xform.Get(stage, '/Group/A').AddTranslateOp().Set(Gf.Vec3d(0, 3, 0))
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (6.0, 4.0, 1.0))
+
+        # Hiding a subtree removes it from the bounds.
+        UsdGeom.Imageable.Get(stage, '/Group/A').MakeInvisible()
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 1.0))
+
+        # Adding a prim to the other subtree.
+        UsdGeom.Cube.Define(stage, '/Group/B/Cube2').CreateExtentAttr(
+            [(-1, -1, -1), (1, 1, 4)])
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 4.0))
+
+    def testBoundingBoxComputedExtent(self):
+        '''
+        Verify that the bounds follow the attributes the extent of a boundable
+        is computed from when it has no authored extent.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShape = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.ufe.getStage(str(ufe.PathString.path(proxyShape)))
+
+        cube = UsdGeom.Cube.Define(stage, '/Cube')
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 1.0))
+
+        # Editing the size.
+        cube.CreateSizeAttr(4.0)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (2.0, 2.0, 2.0))
+
+        # Animating the size makes the bound time-varying.
+        cube.GetSizeAttr().Set(2.0, 1)
+        cube.GetSizeAttr().Set(6.0, 10)
+        cmds.currentTime(1)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (1.0, 1.0, 1.0))
+        cmds.currentTime(10)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (3.0, 3.0, 3.0))
+
+        # Editing the radius of another boundable.
+        sphere = UsdGeom.Sphere.Define(stage, '/Sphere')
+        sphere.CreateRadiusAttr(5.0)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (5.0, 5.0, 5.0))
+        sphere.GetRadiusAttr().Set(7.0)
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (7.0, 7.0, 7.0))
+
+    def testBoundingBoxSubtreeInvalidationWithPrimPath(self):
+        '''
+        Verify that the bounds cached per subtree of a prim other than the pseudo-root include
+        the typeless prims and follow the edits to the prototypes of its instances.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShape = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.ufe.getStage(str(ufe.PathString.path(proxyShape)))
+
+        # The instances reference a class outside of the proxy's prim.
+        stage.CreateClassPrim('/CubeClass')
+        UsdGeom.Cube.Define(stage, '/CubeClass/Cube').CreateExtentAttr(
+            [(-1, -1, -1), (1, 1, 1)])
+        for name, offset in [('A', 0), ('B', 5)]:
+            instance = UsdGeom.Xform.Define(stage, '/World/Instances/' + name)
+            instance.GetPrim().GetReferences().AddInternalReference('/CubeClass')
+            instance.GetPrim().SetInstanceable(True)
+            instance.AddTranslateOp().Set(Gf.Vec3d(offset, 0, 0))
+
+        # A typeless prim grouping a gprim.
+        stage.DefinePrim('/World/Typeless')
+        cube = UsdGeom.Cube.Define(stage, '/World/Typeless/Cube')
+        cube.CreateExtentAttr([(-1, -1, -1), (1, 1, 1)])
+        cube.AddTranslateOp().Set(Gf.Vec3d(0, 0, -5))
+
+        # A prim outside of the proxy's prim doesn't contribute.
+        UsdGeom.Cube.Define(stage, '/Outside').CreateExtentAttr([(-9, -9, -9), (9, 9, 9)])
+
+        cmds.setAttr(proxyShape + '.primPath', '/World', type='string')
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMin')[0], (-1.0, -1.0, -6.0))
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (6.0, 1.0, 1.0))
+
+        # Editing the prototype updates the bounds of every instance.
+        stage.GetPrimAtPath('/CubeClass/Cube').GetAttribute('extent').Set(
+            [(-1, -1, -1), (1, 3, 1)])
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMax')[0], (6.0, 3.0, 1.0))
+
+        # Moving a prim under the typeless prim.
+        cube.GetOrderedXformOps()[0].Set(Gf.Vec3d(0, 0, -7))
+        self.assertEqual(cmds.getAttr(proxyShape + '.boundingBoxMin')[0], (-1.0, -1.0, -8.0))
+
     @unittest.skipUnless(ufeUtils.ufeFeatureSetVersion() >= 2, 'testDuplicateProxyStageAnonymous only available in UFE v2 or greater.')
     def testDuplicateProxyStageAnonymous(self):
         '''
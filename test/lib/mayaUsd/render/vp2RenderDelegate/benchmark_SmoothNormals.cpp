@@ -0,0 +1,160 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone benchmark of the CPU smooth normals of deforming meshes in the VP2 render delegate.
+// Every frame moves the points of a grid and computes their smooth normals, either with the
+// vertex adjacency cached in the mesh shared data, as done while the topology doesn't change, or
+// with the adjacency rebuilt first, as done when the topology is animated and as was done on every
+// frame before the adjacency was cached. The frames are timed for a range of mesh sizes, keeping
+// the best of a few runs. Both versions must compute the same normals.
+//
+// usage: SmoothNormalsBenchmark [frameCount] [maxQuadsPerSide]
+//
+// By default, 48 frames are timed for grids of up to 1024 x 1024 quads.
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/imaging/hd/bufferSource.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/imaging/hd/smoothNormals.h>
+#include <pxr/imaging/hd/vertexAdjacency.h>
+#include <pxr/imaging/pxOsd/tokens.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+HdMeshTopology createGrid(int quadsPerSide)
+{
+    const int pointsPerSide = quadsPerSide + 1;
+
+    VtIntArray faceVertexCounts(size_t(quadsPerSide) * quadsPerSide, 4);
+    VtIntArray faceVertexIndices;
+    for (int y = 0; y < quadsPerSide; ++y) {
+        for (int x = 0; x < quadsPerSide; ++x) {
+            faceVertexIndices.push_back(y * pointsPerSide + x);
+            faceVertexIndices.push_back(y * pointsPerSide + x + 1);
+            faceVertexIndices.push_back((y + 1) * pointsPerSide + x + 1);
+            faceVertexIndices.push_back((y + 1) * pointsPerSide + x);
+        }
+    }
+
+    return HdMeshTopology(
+        PxOsdOpenSubdivTokens->none,
+        PxOsdOpenSubdivTokens->rightHanded,
+        faceVertexCounts,
+        faceVertexIndices);
+}
+
+// Moves the points of the grid as a wave, which changes every frame.
+void deformGrid(int quadsPerSide, int frame, VtVec3fArray& points)
+{
+    const int pointsPerSide = quadsPerSide + 1;
+
+    points.resize(size_t(pointsPerSide) * pointsPerSide);
+    GfVec3f* data = points.data();
+    for (int y = 0; y < pointsPerSide; ++y) {
+        for (int x = 0; x < pointsPerSide; ++x) {
+            const float z = std::sin(0.1f * (x + frame)) * std::cos(0.1f * y);
+            data[y * pointsPerSide + x] = GfVec3f(float(x), float(y), z);
+        }
+    }
+}
+
+Hd_VertexAdjacencySharedPtr buildAdjacency(const HdMeshTopology& topology)
+{
+    Hd_VertexAdjacencySharedPtr adjacency(new Hd_VertexAdjacency());
+    HdBufferSourceSharedPtr     adjacencyComputation
+        = adjacency->GetSharedAdjacencyBuilderComputation(&topology);
+    adjacencyComputation->Resolve();
+    return adjacency;
+}
+
+VtVec3fArray computeNormals(const Hd_VertexAdjacency& adjacency, const VtVec3fArray& points)
+{
+    return Hd_SmoothNormals::ComputeSmoothNormals(&adjacency, points.size(), points.cdata());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int frameCount = argc > 1 ? std::atoi(argv[1]) : 48;
+    const int maxQuadsPerSide = argc > 2 ? std::atoi(argv[2]) : 1024;
+
+    // The versions are timed alternately and the best run of each is kept, so that other
+    // processes and frequency changes don't favor one of them.
+    const int runCount = 5;
+
+    std::printf("%d frames\n", frameCount);
+
+    bool sameNormals = true;
+    for (int quadsPerSide = 16; quadsPerSide <= maxQuadsPerSide; quadsPerSide *= 4) {
+        const HdMeshTopology              topology = createGrid(quadsPerSide);
+        const Hd_VertexAdjacencySharedPtr cachedAdjacency = buildAdjacency(topology);
+
+        VtVec3fArray points;
+        VtVec3fArray rebuiltNormals;
+        VtVec3fArray cachedNormals;
+        double       rebuiltSeconds = std::numeric_limits<double>::max();
+        double       cachedSeconds = std::numeric_limits<double>::max();
+        for (int run = 0; run < runCount; ++run) {
+            Clock::time_point start = Clock::now();
+            for (int frame = 0; frame < frameCount; ++frame) {
+                deformGrid(quadsPerSide, frame, points);
+                rebuiltNormals = computeNormals(*buildAdjacency(topology), points);
+            }
+            rebuiltSeconds = std::min(rebuiltSeconds, secondsSince(start));
+
+            start = Clock::now();
+            for (int frame = 0; frame < frameCount; ++frame) {
+                deformGrid(quadsPerSide, frame, points);
+                cachedNormals = computeNormals(*cachedAdjacency, points);
+            }
+            cachedSeconds = std::min(cachedSeconds, secondsSince(start));
+
+            sameNormals = sameNormals && rebuiltNormals == cachedNormals;
+        }
+
+        std::printf(
+            "%10zu points: rebuilt adjacency %8.3f ms/frame, cached adjacency %8.3f ms/frame, "
+            "%5.2fx\n",
+            points.size(),
+            1000.0 * rebuiltSeconds / frameCount,
+            1000.0 * cachedSeconds / frameCount,
+            cachedSeconds > 0.0 ? rebuiltSeconds / cachedSeconds : 0.0);
+    }
+
+    if (!sameNormals) {
+        std::printf("The cached adjacency doesn't give the same normals.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
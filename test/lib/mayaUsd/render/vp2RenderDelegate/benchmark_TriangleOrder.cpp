@@ -0,0 +1,176 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone tool reporting the average cache miss ratio (ACMR) of meshes triangulated as the VP2
+// render delegate does, in authored face order and in the order computed for the post-transform
+// vertex cache when MAYAUSD_VP2_OPTIMIZE_TRIANGLE_ORDER is set. The ACMR is the number of
+// vertices missing a FIFO cache per triangle, reported for common cache sizes, along with the
+// time to compute the order. The meshes are read from the given USD files; without files, a grid
+// is reported in row order and with its faces shuffled, as scans often are. The optimized order
+// must contain every triangle once.
+//
+// usage: TriangleOrderBenchmark [quadsPerSide | file.usd ...]
+//
+// By default, grids of 512 x 512 quads are reported.
+
+#include "meshTriangleOrder.h"
+
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/imaging/hd/meshUtil.h>
+#include <pxr/imaging/pxOsd/tokens.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/mesh.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// The cache sizes the ACMR is reported for.
+const size_t cacheSizes[] = { 16, 32 };
+
+HdMeshTopology createGrid(int quadsPerSide, bool shuffled)
+{
+    const int pointsPerSide = quadsPerSide + 1;
+
+    std::vector<int> quads;
+    for (int y = 0; y < quadsPerSide; ++y) {
+        for (int x = 0; x < quadsPerSide; ++x) {
+            quads.push_back(y * quadsPerSide + x);
+        }
+    }
+    if (shuffled) {
+        std::shuffle(quads.begin(), quads.end(), std::mt19937(0));
+    }
+
+    VtIntArray faceVertexCounts(quads.size(), 4);
+    VtIntArray faceVertexIndices;
+    for (int quad : quads) {
+        const int x = quad % quadsPerSide;
+        const int y = quad / quadsPerSide;
+        faceVertexIndices.push_back(y * pointsPerSide + x);
+        faceVertexIndices.push_back(y * pointsPerSide + x + 1);
+        faceVertexIndices.push_back((y + 1) * pointsPerSide + x + 1);
+        faceVertexIndices.push_back((y + 1) * pointsPerSide + x);
+    }
+
+    return HdMeshTopology(
+        PxOsdOpenSubdivTokens->none,
+        PxOsdOpenSubdivTokens->rightHanded,
+        faceVertexCounts,
+        faceVertexIndices);
+}
+
+// Reports one mesh, returns false if the optimized order isn't a permutation of the triangles.
+bool report(const std::string& name, const HdMeshTopology& topology, const SdfPath& id)
+{
+    HdMeshUtil   meshUtil(&topology, id);
+    VtVec3iArray triangles;
+    VtIntArray   primitiveParam;
+    meshUtil.ComputeTriangleIndices(&triangles, &primitiveParam, nullptr);
+
+    const Clock::time_point start = Clock::now();
+    const std::vector<int>  order = HdVP2TriangleOrder::Compute(triangles);
+    const double            seconds = secondsSince(start);
+
+    VtVec3iArray      orderedTriangles(order.size());
+    std::vector<bool> used(triangles.size(), false);
+    bool              isPermutation = order.size() == triangles.size();
+    for (size_t i = 0; i < order.size() && isPermutation; ++i) {
+        isPermutation = order[i] >= 0 && size_t(order[i]) < triangles.size() && !used[order[i]];
+        if (isPermutation) {
+            used[order[i]] = true;
+            orderedTriangles[i] = triangles[order[i]];
+        }
+    }
+
+    std::printf("%s: %zu triangles, ordered in %.3f s\n", name.c_str(), triangles.size(), seconds);
+    for (size_t cacheSize : cacheSizes) {
+        std::printf(
+            "    ACMR with %2zu vertices: authored %.3f, optimized %.3f\n",
+            cacheSize,
+            HdVP2TriangleOrder::ComputeACMR(triangles, cacheSize),
+            HdVP2TriangleOrder::ComputeACMR(orderedTriangles, cacheSize));
+    }
+
+    if (!isPermutation) {
+        std::printf("    The optimized order doesn't contain every triangle once.\n");
+    }
+    return isPermutation;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool valid = true;
+
+    const bool isGrid = argc < 2 || std::isdigit(static_cast<unsigned char>(argv[1][0]));
+    if (isGrid) {
+        const int quadsPerSide = argc < 2 ? 512 : std::atoi(argv[1]);
+        valid = report("grid", createGrid(quadsPerSide, false), SdfPath("/grid")) && valid;
+        valid = report("shuffled grid", createGrid(quadsPerSide, true), SdfPath("/shuffled"))
+            && valid;
+    }
+
+    for (int i = 1; i < argc && !isGrid; ++i) {
+        UsdStageRefPtr stage = UsdStage::Open(argv[i]);
+        if (!stage) {
+            std::printf("Failed to open %s\n", argv[i]);
+            valid = false;
+            continue;
+        }
+
+        for (const UsdPrim& prim : stage->Traverse()) {
+            const UsdGeomMesh mesh(prim);
+            if (!mesh) {
+                continue;
+            }
+
+            VtIntArray faceVertexCounts;
+            VtIntArray faceVertexIndices;
+            mesh.GetFaceVertexCountsAttr().Get(&faceVertexCounts);
+            mesh.GetFaceVertexIndicesAttr().Get(&faceVertexIndices);
+
+            const HdMeshTopology topology(
+                PxOsdOpenSubdivTokens->none,
+                PxOsdOpenSubdivTokens->rightHanded,
+                faceVertexCounts,
+                faceVertexIndices);
+            valid = report(prim.GetPath().GetString(), topology, prim.GetPath()) && valid;
+        }
+    }
+
+    return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,226 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone benchmark of the kernels filling the VP2 vertex buffers of meshes from their
+// primvars, compared to the per-element loops they replaced, which check every index and write
+// through casted pointers. For a deforming mesh with the unshared vertex layout, every frame
+// gathers the points into the positions buffer, copies the face-varying UVs and gathers a
+// per-point color and a constant opacity into the channels of the color buffer. The frames are
+// timed for a range of mesh sizes, below and above the parallel threshold, keeping the best of a
+// few runs. Both versions must fill the same buffers. Set PXR_WORK_THREAD_LIMIT=1 to time the
+// kernels serially.
+//
+// usage: VertexBufferFillBenchmark [frameCount] [maxQuadsPerSide]
+//
+// By default, 48 frames are timed for grids of up to 1024 x 1024 quads.
+
+#include "vertexBufferFill.h"
+
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec4f.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// The source data of one mesh, with the unshared vertex layout.
+struct Mesh
+{
+    std::vector<int>     renderingToScenePoints; // the face vertex indices
+    std::vector<GfVec3f> points;
+    std::vector<GfVec3f> colors;
+    std::vector<GfVec2f> uvs; // face-varying
+    float                opacity = 0.5f;
+};
+
+struct VertexBuffers
+{
+    std::vector<GfVec3f> positions;
+    std::vector<GfVec2f> uvs;
+    std::vector<GfVec4f> colors;
+
+    explicit VertexBuffers(size_t numVertices)
+        : positions(numVertices)
+        , uvs(numVertices)
+        , colors(numVertices)
+    {
+    }
+
+    bool operator==(const VertexBuffers& other) const
+    {
+        return positions == other.positions && uvs == other.uvs && colors == other.colors;
+    }
+};
+
+Mesh createMesh(int quadsPerSide)
+{
+    const int pointsPerSide = quadsPerSide + 1;
+
+    Mesh mesh;
+    for (int y = 0; y < pointsPerSide; ++y) {
+        for (int x = 0; x < pointsPerSide; ++x) {
+            mesh.points.emplace_back(float(x), float(y), 0.0f);
+            mesh.colors.emplace_back(float(x) / quadsPerSide, float(y) / quadsPerSide, 0.5f);
+        }
+    }
+    for (int y = 0; y < quadsPerSide; ++y) {
+        for (int x = 0; x < quadsPerSide; ++x) {
+            const int corners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+            for (const auto& corner : corners) {
+                mesh.renderingToScenePoints.push_back(
+                    (y + corner[1]) * pointsPerSide + x + corner[0]);
+                mesh.uvs.emplace_back(
+                    float(x + corner[0]) / quadsPerSide, float(y + corner[1]) / quadsPerSide);
+            }
+        }
+    }
+    return mesh;
+}
+
+// The loops of _FillPrimvarData before the kernels.
+template <class DEST_TYPE, class SRC_TYPE>
+void scalarGather(
+    DEST_TYPE*                   vertexBuffer,
+    size_t                       numVertices,
+    size_t                       channelOffset,
+    const std::vector<SRC_TYPE>& source,
+    const std::vector<int>&      indices)
+{
+    const unsigned int dataSize = source.size();
+    for (size_t v = 0; v < numVertices; v++) {
+        unsigned int index = indices[v];
+        if (index < dataSize) {
+            SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
+                reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
+            *pointer = source[index];
+        }
+    }
+}
+
+template <class DEST_TYPE, class SRC_TYPE>
+void scalarBroadcast(
+    DEST_TYPE*      vertexBuffer,
+    size_t          numVertices,
+    size_t          channelOffset,
+    const SRC_TYPE& value)
+{
+    for (size_t v = 0; v < numVertices; v++) {
+        SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
+            reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
+        *pointer = value;
+    }
+}
+
+void fillScalar(const Mesh& mesh, VertexBuffers& buffers)
+{
+    const size_t numVertices = mesh.renderingToScenePoints.size();
+    const std::vector<int>& indices = mesh.renderingToScenePoints;
+    scalarGather(buffers.positions.data(), numVertices, 0, mesh.points, indices);
+    memcpy(buffers.uvs.data(), mesh.uvs.data(), sizeof(GfVec2f) * numVertices);
+    scalarGather(buffers.colors.data(), numVertices, 0, mesh.colors, indices);
+    scalarBroadcast(buffers.colors.data(), numVertices, 3, mesh.opacity);
+}
+
+bool fillKernels(const Mesh& mesh, VertexBuffers& buffers)
+{
+    namespace Fill = HdVP2VertexBufferFill;
+
+    const size_t numVertices = mesh.renderingToScenePoints.size();
+    const int*   indices = mesh.renderingToScenePoints.data();
+    size_t       numSkipped = Fill::Gather(
+        buffers.positions.data(),
+        numVertices,
+        0,
+        mesh.points.data(),
+        mesh.points.size(),
+        indices);
+    Fill::Copy(buffers.uvs.data(), numVertices, 0, mesh.uvs.data());
+    numSkipped += Fill::Gather(
+        buffers.colors.data(), numVertices, 0, mesh.colors.data(), mesh.colors.size(), indices);
+    Fill::Broadcast(buffers.colors.data(), numVertices, 3, mesh.opacity);
+    return numSkipped == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int frameCount = argc > 1 ? std::atoi(argv[1]) : 48;
+    const int maxQuadsPerSide = argc > 2 ? std::atoi(argv[2]) : 1024;
+
+    // The versions are timed alternately and the best run of each is kept, so that other
+    // processes and frequency changes don't favor one of them.
+    const int runCount = 5;
+
+    std::printf(
+        "%d frames, parallel from %zu vertices\n",
+        frameCount,
+        HdVP2VertexBufferFill::kParallelThreshold);
+
+    bool sameBuffers = true;
+    for (int quadsPerSide = 16; quadsPerSide <= maxQuadsPerSide; quadsPerSide *= 4) {
+        const Mesh   mesh = createMesh(quadsPerSide);
+        const size_t numVertices = mesh.renderingToScenePoints.size();
+
+        VertexBuffers scalarBuffers(numVertices);
+        VertexBuffers kernelBuffers(numVertices);
+        double        scalarSeconds = std::numeric_limits<double>::max();
+        double        kernelSeconds = std::numeric_limits<double>::max();
+        for (int run = 0; run < runCount; ++run) {
+            Clock::time_point start = Clock::now();
+            for (int frame = 0; frame < frameCount; ++frame) {
+                fillScalar(mesh, scalarBuffers);
+            }
+            scalarSeconds = std::min(scalarSeconds, secondsSince(start));
+
+            start = Clock::now();
+            for (int frame = 0; frame < frameCount; ++frame) {
+                sameBuffers = fillKernels(mesh, kernelBuffers) && sameBuffers;
+            }
+            kernelSeconds = std::min(kernelSeconds, secondsSince(start));
+        }
+
+        sameBuffers = sameBuffers && scalarBuffers == kernelBuffers;
+        std::printf(
+            "%10zu vertices: scalar %8.3f ms/frame, kernels %8.3f ms/frame, %5.2fx\n",
+            numVertices,
+            1000.0 * scalarSeconds / frameCount,
+            1000.0 * kernelSeconds / frameCount,
+            kernelSeconds > 0.0 ? scalarSeconds / kernelSeconds : 0.0);
+    }
+
+    if (!sameBuffers) {
+        std::printf("The kernels don't fill the same vertex buffers.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
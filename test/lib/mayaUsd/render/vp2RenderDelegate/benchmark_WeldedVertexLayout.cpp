@@ -0,0 +1,240 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone benchmark of the vertex layouts of the VP2 render delegate for meshes with
+// face-varying primvars. Each mesh is a bumpy grid of quads, with face-varying normals as
+// exported from Maya and face-varying UVs cut into square shells, so that only the shell borders
+// are UV seams. The unshared layout, with one rendering vertex per face vertex, is compared to
+// the welded layout, which only splits the face vertices along the seams. The number of rendering
+// vertices, the size of the position, normal and UV vertex buffers, the time to build the layout
+// and the time to fill the vertex buffers, as done before uploading them, are reported. Both
+// layouts must give every face vertex the same attributes.
+//
+// usage: WeldedVertexLayoutBenchmark [meshCount] [quadsPerSide] [quadsPerShell]
+//
+// By default, 16 meshes of 256 x 256 quads with UV shells of 32 x 32 quads are reported.
+
+#include "meshVertexLayout.h"
+
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/imaging/pxOsd/tokens.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Mesh
+{
+    HdMeshTopology topology;
+    VtVec3fArray   points;
+    VtVec3fArray   normals; // face-varying
+    VtVec2fArray   uvs;     // face-varying
+};
+
+// The interleaved attributes of a rendering vertex, as VP2 gets them in separate vertex buffers.
+struct Vertex
+{
+    GfVec3f position;
+    GfVec3f normal;
+    GfVec2f uv;
+};
+
+Mesh createMesh(int quadsPerSide, int quadsPerShell, int seed)
+{
+    const int    pointsPerSide = quadsPerSide + 1;
+    const size_t numQuads = size_t(quadsPerSide) * quadsPerSide;
+
+    Mesh mesh;
+    mesh.points.resize(size_t(pointsPerSide) * pointsPerSide);
+    VtVec3fArray pointNormals(mesh.points.size());
+    for (int y = 0; y < pointsPerSide; ++y) {
+        for (int x = 0; x < pointsPerSide; ++x) {
+            const float z = 0.1f * std::sin(0.3f * x + seed) * std::cos(0.2f * y);
+            const float dx = 0.03f * std::cos(0.3f * x + seed) * std::cos(0.2f * y);
+            const float dy = -0.02f * std::sin(0.3f * x + seed) * std::sin(0.2f * y);
+            mesh.points[y * pointsPerSide + x] = GfVec3f(float(x), float(y), z);
+            pointNormals[y * pointsPerSide + x] = GfVec3f(-dx, -dy, 1.0f).GetNormalized();
+        }
+    }
+
+    VtIntArray faceVertexCounts(numQuads, 4);
+    VtIntArray faceVertexIndices(numQuads * 4);
+    mesh.normals.resize(numQuads * 4);
+    mesh.uvs.resize(numQuads * 4);
+    size_t i = 0;
+    for (int y = 0; y < quadsPerSide; ++y) {
+        for (int x = 0; x < quadsPerSide; ++x) {
+            // Each shell is laid out on its own in UV space, with a margin.
+            const GfVec2f shellOrigin(
+                float(x / quadsPerShell) * (quadsPerShell + 1),
+                float(y / quadsPerShell) * (quadsPerShell + 1));
+            const int corners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+            for (const auto& corner : corners) {
+                const int px = x + corner[0];
+                const int py = y + corner[1];
+                faceVertexIndices[i] = py * pointsPerSide + px;
+                mesh.normals[i] = pointNormals[py * pointsPerSide + px];
+                mesh.uvs[i] = shellOrigin
+                    + GfVec2f(float(x % quadsPerShell + corner[0]),
+                              float(y % quadsPerShell + corner[1]));
+                ++i;
+            }
+        }
+    }
+
+    mesh.topology = HdMeshTopology(
+        PxOsdOpenSubdivTokens->none,
+        PxOsdOpenSubdivTokens->rightHanded,
+        faceVertexCounts,
+        faceVertexIndices);
+    return mesh;
+}
+
+// Fills the vertex buffers of a layout, as _FillPrimvarData does for each primvar.
+void fillVertices(
+    const Mesh&          mesh,
+    const VtIntArray&    renderingToScenePoints,
+    const VtIntArray&    renderingToSceneFaceVaryingIds,
+    std::vector<Vertex>* vertices)
+{
+    const size_t numVertices = renderingToScenePoints.size();
+    vertices->resize(numVertices);
+    for (size_t v = 0; v < numVertices; ++v) {
+        (*vertices)[v].position = mesh.points[renderingToScenePoints[v]];
+    }
+    for (size_t v = 0; v < numVertices; ++v) {
+        const int faceVertex
+            = renderingToSceneFaceVaryingIds.empty() ? int(v) : renderingToSceneFaceVaryingIds[v];
+        (*vertices)[v].normal = mesh.normals[faceVertex];
+    }
+    for (size_t v = 0; v < numVertices; ++v) {
+        const int faceVertex
+            = renderingToSceneFaceVaryingIds.empty() ? int(v) : renderingToSceneFaceVaryingIds[v];
+        (*vertices)[v].uv = mesh.uvs[faceVertex];
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int meshCount = argc > 1 ? std::atoi(argv[1]) : 16;
+    const int quadsPerSide = argc > 2 ? std::atoi(argv[2]) : 256;
+    const int quadsPerShell = argc > 3 ? std::max(1, std::atoi(argv[3])) : 32;
+
+    std::printf(
+        "%d meshes of %d x %d quads, UV shells of %d x %d quads\n",
+        meshCount,
+        quadsPerSide,
+        quadsPerSide,
+        quadsPerShell,
+        quadsPerShell);
+
+    std::vector<Mesh> meshes;
+    for (int i = 0; i < meshCount; ++i) {
+        meshes.push_back(createMesh(quadsPerSide, quadsPerShell, i));
+    }
+
+    size_t unsharedVertexCount = 0;
+    size_t weldedVertexCount = 0;
+    double unsharedBuildSeconds = 0.0;
+    double weldedBuildSeconds = 0.0;
+    double unsharedFillSeconds = 0.0;
+    double weldedFillSeconds = 0.0;
+    bool   sameAttributes = true;
+
+    std::vector<Vertex> unsharedVertices;
+    std::vector<Vertex> weldedVertices;
+    for (const Mesh& mesh : meshes) {
+        // Unshared layout, as built by HdVP2Mesh::Sync().
+        Clock::time_point start = Clock::now();
+        const VtIntArray  unsharedToScenePoints = mesh.topology.GetFaceVertexIndices();
+        VtIntArray        unsharedFaceVertexIndices(unsharedToScenePoints.size());
+        std::iota(unsharedFaceVertexIndices.begin(), unsharedFaceVertexIndices.end(), 0);
+        unsharedBuildSeconds += secondsSince(start);
+
+        start = Clock::now();
+        fillVertices(mesh, unsharedToScenePoints, VtIntArray(), &unsharedVertices);
+        unsharedFillSeconds += secondsSince(start);
+        unsharedVertexCount += unsharedVertices.size();
+
+        // Welded layout.
+        std::vector<HdVP2WeldedPrimvar> primvars(2);
+        primvars[0].data = reinterpret_cast<const char*>(mesh.normals.cdata());
+        primvars[0].elementSize = sizeof(GfVec3f);
+        primvars[1].data = reinterpret_cast<const char*>(mesh.uvs.cdata());
+        primvars[1].elementSize = sizeof(GfVec2f);
+
+        start = Clock::now();
+        HdVP2WeldedVertexLayout layout;
+        layout.Build(mesh.topology, primvars);
+        weldedBuildSeconds += secondsSince(start);
+
+        start = Clock::now();
+        fillVertices(
+            mesh,
+            layout.renderingToScenePoints,
+            layout.renderingToSceneFaceVaryingIds,
+            &weldedVertices);
+        weldedFillSeconds += secondsSince(start);
+        weldedVertexCount += weldedVertices.size();
+
+        for (size_t i = 0; i < unsharedVertices.size() && sameAttributes; ++i) {
+            const Vertex& welded = weldedVertices[layout.renderingFaceVertexIndices[i]];
+            sameAttributes = std::memcmp(&welded, &unsharedVertices[i], sizeof(Vertex)) == 0;
+        }
+    }
+
+    const double mb = 1024.0 * 1024.0;
+    std::printf(
+        "unshared %10zu vertices, %8.1f MB vertex buffers, built in %7.3f s, filled in %7.3f s\n",
+        unsharedVertexCount,
+        unsharedVertexCount * sizeof(Vertex) / mb,
+        unsharedBuildSeconds,
+        unsharedFillSeconds);
+    std::printf(
+        "welded   %10zu vertices, %8.1f MB vertex buffers, built in %7.3f s, filled in %7.3f s\n",
+        weldedVertexCount,
+        weldedVertexCount * sizeof(Vertex) / mb,
+        weldedBuildSeconds,
+        weldedFillSeconds);
+
+    if (!sameAttributes) {
+        std::printf("The welded layout doesn't give the face vertices their attributes.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
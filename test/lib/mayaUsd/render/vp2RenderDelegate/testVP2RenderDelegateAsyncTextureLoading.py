@@ -0,0 +1,179 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import fixturesUtils
+import imageUtils
+import mayaUtils
+
+from maya import cmds
+import maya.utils
+
+from pxr import Sdf
+from pxr import UsdGeom
+from pxr import UsdShade
+
+import PySide2.QtGui
+
+import os
+import time
+
+
+class testVP2RenderDelegateAsyncTextureLoading(imageUtils.ImageDiffingTestCase):
+    """
+    Tests the textures decoded by background workers, which the other tests
+    disable with MAYAUSD_VP2_ASYNC_TEXTURE_LOADING=0 to take their snapshots
+    right after loading their stages.
+    """
+
+    # Time given to the background workers to decode a texture, in seconds.
+    TIMEOUT = 30.0
+
+    # The test runs with MAYAUSD_VP2_TEXTURE_CACHE_SIZE=1, i.e. a 1 MB cache of
+    # decoded images, which a 1024 x 1024 RGBA texture exceeds on its own.
+    LARGE_TEXTURE_SIZE = 1024
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__, initializeStandalone=False, loadPlugin=False)
+
+        cls._testDir = os.path.abspath('.')
+
+    def setUp(self):
+        # Decoded images are shared by all the stages, so each test uses its
+        # own textures to have them decoded again.
+        self._redTexture = self._createTexture('red', PySide2.QtGui.QColor(255, 0, 0))
+        self._blueTexture = self._createTexture('blue', PySide2.QtGui.QColor(0, 0, 255))
+
+    def _createTexture(self, colorName, color, size=64):
+        image = PySide2.QtGui.QImage(size, size, PySide2.QtGui.QImage.Format_RGB32)
+        image.fill(color)
+        path = os.path.join(self._testDir, '%s_%s.png' % (self._testMethodName, colorName))
+        image.save(path)
+        return path
+
+    def _createTexturedPlane(self, texturePath):
+        '''Creates a plane facing the camera, with its diffuse color read from the texture.'''
+        cmds.file(force=True, new=True)
+        mayaUtils.loadPlugin("mayaUsdPlugin")
+
+        cmds.xform('persp', t=(0, 0, 20))
+        cmds.xform('persp', ro=(0, 0, 0), ws=True)
+
+        _, stage = mayaUtils.createProxyAndStage()
+
+        mesh = UsdGeom.Mesh.Define(stage, '/Plane')
+        mesh.CreatePointsAttr([(-5, -5, 0), (5, -5, 0), (5, 5, 0), (-5, 5, 0)])
+        mesh.CreateFaceVertexCountsAttr([4])
+        mesh.CreateFaceVertexIndicesAttr([0, 1, 2, 3])
+        UsdGeom.PrimvarsAPI(mesh).CreatePrimvar(
+            'st', Sdf.ValueTypeNames.TexCoord2fArray, UsdGeom.Tokens.varying).Set(
+            [(0, 0), (1, 0), (1, 1), (0, 1)])
+
+        material = UsdShade.Material.Define(stage, '/Material')
+        surface = UsdShade.Shader.Define(stage, '/Material/Surface')
+        surface.CreateIdAttr('UsdPreviewSurface')
+        material.CreateSurfaceOutput().ConnectToSource(surface.ConnectableAPI(), 'surface')
+
+        reader = UsdShade.Shader.Define(stage, '/Material/Reader')
+        reader.CreateIdAttr('UsdPrimvarReader_float2')
+        reader.CreateInput('varname', Sdf.ValueTypeNames.Token).Set('st')
+
+        texture = UsdShade.Shader.Define(stage, '/Material/Texture')
+        texture.CreateIdAttr('UsdUVTexture')
+        texture.CreateInput('st', Sdf.ValueTypeNames.Float2).ConnectToSource(
+            reader.ConnectableAPI(), 'result')
+        surface.CreateInput('diffuseColor', Sdf.ValueTypeNames.Color3f).ConnectToSource(
+            texture.ConnectableAPI(), 'rgb')
+
+        fileInput = texture.CreateInput('file', Sdf.ValueTypeNames.Asset)
+        fileInput.Set(texturePath)
+
+        UsdShade.MaterialBindingAPI(mesh.GetPrim()).Bind(material)
+        return fileInput
+
+    def _centerColor(self):
+        '''Draws the viewport and returns the color at its center.'''
+        snapshotImage = os.path.join(self._testDir, 'snapshot.png')
+        imageUtils.snapshot(snapshotImage, width=200, height=200)
+        image = PySide2.QtGui.QImage(snapshotImage)
+        return image.pixelColor(image.width() // 2, image.height() // 2)
+
+    def _waitForColor(self, isExpectedColor):
+        '''Draws the viewport until the plane shows the expected texture.'''
+        start = time.time()
+        while True:
+            # Run the viewport refresh scheduled by the background workers.
+            maya.utils.processIdleEvents()
+            color = self._centerColor()
+            if isExpectedColor(color):
+                return color
+            if time.time() - start > self.TIMEOUT:
+                self.fail('The texture was not loaded, the plane is %s' % color.name())
+            time.sleep(0.1)
+
+    @staticmethod
+    def _isRed(color):
+        return color.red() > 2 * max(color.green(), color.blue())
+
+    @staticmethod
+    def _isBlue(color):
+        return color.blue() > 2 * max(color.red(), color.green())
+
+    def testTextureIsLoaded(self):
+        self._createTexturedPlane(self._redTexture)
+        self._waitForColor(self._isRed)
+
+        # The plane keeps its texture on later draws.
+        self.assertTrue(self._isRed(self._centerColor()))
+
+    def testTexturePathChange(self):
+        fileInput = self._createTexturedPlane(self._redTexture)
+        self._waitForColor(self._isRed)
+
+        fileInput.Set(self._blueTexture)
+        self._waitForColor(self._isBlue)
+
+    def testTexturePathChangeWhileLoading(self):
+        fileInput = self._createTexturedPlane(self._redTexture)
+
+        # Draw once so that the red texture is requested, then change the path
+        # before it is picked up: the red texture must not replace the blue one
+        # once it has been decoded.
+        self._centerColor()
+        fileInput.Set(self._blueTexture)
+        self._waitForColor(self._isBlue)
+
+        for _ in range(5):
+            maya.utils.processIdleEvents()
+            time.sleep(0.1)
+            self.assertTrue(self._isBlue(self._centerColor()))
+
+    def testTextureLargerThanCache(self):
+        # A decoded image larger than the whole cache is kept until the
+        # material picks it up, rather than being decoded again and again.
+        largeTexture = self._createTexture(
+            'largeRed', PySide2.QtGui.QColor(255, 0, 0), size=self.LARGE_TEXTURE_SIZE)
+        fileInput = self._createTexturedPlane(largeTexture)
+        self._waitForColor(self._isRed)
+
+        # The small texture fits in the cache once the large one is shown.
+        fileInput.Set(self._blueTexture)
+        self._waitForColor(self._isBlue)
+
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -103,3 +103,87 @@ class TestUsdUndoManager(unittest.TestCase):
 
         # expect to have 2 items on the undo queue
         self.assertEqual(cmds.undoInfo(q=True), nbCmds+2)
+
+    def testCoalescedEdits(self):
+        '''
+            Editing the same value many times inside an UsdUndoBlock only keeps
+            the value it had before the block.
+        '''
+        # start with a new file
+        cmds.file(force=True, new=True)
+
+        nbPoints = 100000
+        with mayaUsdLib.UsdUndoBlock():
+            mesh = UsdGeom.Mesh.Define(self.stage, '/Mesh')
+            points = mesh.CreatePointsAttr([Gf.Vec3f(0.0)] * nbPoints)
+
+        usageBefore = mayaUsdLib.UsdUndoManager.memoryUsage()
+        with mayaUsdLib.UsdUndoBlock():
+            for i in range(1, 51):
+                points.Set([Gf.Vec3f(i)] * nbPoints)
+                points.Set([Gf.Vec3f(i)] * nbPoints, Usd.TimeCode(i))
+                points.Set([Gf.Vec3f(i)] * nbPoints, Usd.TimeCode(1))
+
+        # the block keeps the default value and the time samples before it,
+        # not a copy of the array per edit.
+        arrayByteSize = nbPoints * 12
+        usage = mayaUsdLib.UsdUndoManager.memoryUsage() - usageBefore
+        self.assertLess(usage, 2 * arrayByteSize)
+
+        self.assertEqual(points.Get()[0], Gf.Vec3f(50.0))
+        self.assertEqual(points.Get(Usd.TimeCode(1))[0], Gf.Vec3f(50.0))
+        self.assertEqual(points.Get(Usd.TimeCode(10))[0], Gf.Vec3f(10.0))
+
+        cmds.undo()
+        self.assertEqual(points.Get()[0], Gf.Vec3f(0.0))
+        self.assertEqual(points.GetTimeSamples(), [])
+
+        cmds.redo()
+        self.assertEqual(points.Get()[0], Gf.Vec3f(50.0))
+        self.assertEqual(points.Get(Usd.TimeCode(1))[0], Gf.Vec3f(50.0))
+        self.assertEqual(points.Get(Usd.TimeCode(10))[0], Gf.Vec3f(10.0))
+
+    def testMemoryBudget(self):
+        '''
+            The edits of the least recent undoable items are discarded when
+            over the undo memory budget.
+        '''
+        # start with a new file
+        cmds.file(force=True, new=True)
+
+        budget = mayaUsdLib.UsdUndoManager.memoryBudget()
+
+        nbPoints = 100000
+        with mayaUsdLib.UsdUndoBlock():
+            mesh = UsdGeom.Mesh.Define(self.stage, '/Mesh')
+            points = mesh.CreatePointsAttr([Gf.Vec3f(0.0)] * nbPoints)
+
+        try:
+            # room for a single array
+            mayaUsdLib.UsdUndoManager.setMemoryBudget(nbPoints * 12 * 3 // 2)
+
+            with mayaUsdLib.UsdUndoBlock():
+                points.Set([Gf.Vec3f(1.0)] * nbPoints)
+            with mayaUsdLib.UsdUndoBlock():
+                points.Set([Gf.Vec3f(2.0)] * nbPoints)
+
+            self.assertLessEqual(mayaUsdLib.UsdUndoManager.memoryUsage(), nbPoints * 12 * 3 // 2)
+
+            # the last edit can be undone, not the one before.
+            cmds.undo()
+            self.assertEqual(points.Get()[0], Gf.Vec3f(1.0))
+            cmds.undo()
+            self.assertEqual(points.Get()[0], Gf.Vec3f(1.0))
+
+            # the edits done before the discarded ones can't be undone either.
+            cmds.undo()
+            self.assertTrue(self.stage.GetPrimAtPath('/Mesh'))
+            self.assertEqual(points.Get()[0], Gf.Vec3f(1.0))
+
+            # nor can the undone edits be redone.
+            for _ in range(3):
+                cmds.redo()
+                self.assertTrue(self.stage.GetPrimAtPath('/Mesh'))
+                self.assertEqual(points.Get()[0], Gf.Vec3f(1.0))
+        finally:
+            mayaUsdLib.UsdUndoManager.setMemoryBudget(budget)
@@ -0,0 +1,107 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone benchmark of UsdMayaUtil::MergeEquivalentIndexedValues. Face-varying data is
+// generated the way Maya exports it: one value per face-vertex, where neighboring faces share
+// about half of their values. The throughput is reported in millions of face-vertices per second.
+//
+// usage: MergeEquivalentIndexedValuesBenchmark [faceVertexCount...]
+
+#include <mayaUsd/utils/util.h>
+
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec4f.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+template <typename T> T makeValue(std::mt19937& generator)
+{
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    T                                     value;
+    for (size_t i = 0; i < T::dimension; ++i) {
+        value[i] = distribution(generator);
+    }
+    return value;
+}
+
+template <> float makeValue<float>(std::mt19937& generator)
+{
+    return std::uniform_real_distribution<float>(0.0f, 1.0f)(generator);
+}
+
+template <typename T> void benchmark(const char* typeName, size_t count)
+{
+    // Every face-vertex has its own value, copied from a pool half its size.
+    std::mt19937   generator(42);
+    std::vector<T> pool(count / 2 + 1);
+    for (T& value : pool) {
+        value = makeValue<T>(generator);
+    }
+    std::uniform_int_distribution<size_t> poolIndex(0, pool.size() - 1);
+
+    VtArray<T> values(count);
+    VtIntArray indices(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = pool[poolIndex(generator)];
+        indices[i] = static_cast<int>(i);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    UsdMayaUtil::MergeEquivalentIndexedValues(&values, &indices);
+    const double seconds
+        = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf(
+        "%-6s %10zu face-vertices -> %10zu values in %7.3f s, %7.2f M/s\n",
+        typeName,
+        count,
+        values.size(),
+        seconds,
+        count / seconds / 1e6);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; ++i) {
+        counts.push_back(std::strtoull(argv[i], nullptr, 10));
+    }
+    if (counts.empty()) {
+        counts = { 1000000, 10000000, 50000000 };
+    }
+
+    for (const size_t count : counts) {
+        benchmark<float>("float", count);
+        benchmark<GfVec2f>("vec2f", count);
+        benchmark<GfVec3f>("vec3f", count);
+        benchmark<GfVec4f>("vec4f", count);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone benchmark of the sparse value writers used by the export, with and without hashed
+// samples. Every frame, fresh points and normals arrays are set on a set of meshes, the way the
+// prim writers pull them from Maya. The meshes only deform on some of the frames, so that most
+// samples are redundant. The time spent in the writers, the resident memory growth of the process
+// and the number of authored time samples are reported. Both writers must author the same samples.
+// Memory freed by the first run may be reused by the second one, run a single mode to compare the
+// memory growth.
+//
+// usage: SparseValueWriterBenchmark [meshCount] [pointCount] [frameCount] [copied|hashed|both]
+
+#include <mayaUsd/fileio/utils/sparseValueWriter.h>
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/mesh.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// Resident memory of the process, in MB, or 0 when unknown.
+double residentMemory()
+{
+#if defined(__linux__)
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0.0;
+    }
+    long size = 0;
+    long resident = 0;
+    const int read = std::fscanf(statm, "%ld %ld", &size, &resident);
+    std::fclose(statm);
+    return read == 2 ? double(resident) * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0) : 0.0;
+#else
+    return 0.0;
+#endif
+}
+
+// The meshes deform during the first frame of every block of 4.
+bool isDeforming(int frame) { return frame % 4 == 0; }
+
+VtVec3fArray makePoints(size_t pointCount, int mesh, int frame)
+{
+    const float  offset = isDeforming(frame) ? 0.1f * frame : 0.1f * (frame & ~3);
+    VtVec3fArray points(pointCount);
+    for (size_t i = 0; i < pointCount; ++i) {
+        const float x = float(i % 1024);
+        const float y = float(i / 1024);
+        points[i] = GfVec3f(x, y, float(mesh) + std::sin(x * 0.01f + offset));
+    }
+    return points;
+}
+
+size_t run(bool hashSamples, int meshCount, size_t pointCount, int frameCount)
+{
+    UsdStageRefPtr           stage = UsdStage::CreateInMemory();
+    std::vector<UsdGeomMesh> meshes;
+    for (int i = 0; i < meshCount; ++i) {
+        meshes.push_back(UsdGeomMesh::Define(stage, SdfPath(TfStringPrintf("/Mesh_%d", i))));
+        meshes.back().CreatePointsAttr();
+        meshes.back().CreateNormalsAttr();
+    }
+
+    // One writer per mesh, as there is one per prim writer.
+    std::vector<std::unique_ptr<UsdMayaSparseValueWriter>> writers;
+    for (int i = 0; i < meshCount; ++i) {
+        writers.emplace_back(new UsdMayaSparseValueWriter(hashSamples));
+    }
+
+    const double memoryBefore = residentMemory();
+    double       seconds = 0.0;
+    for (int frame = 0; frame < frameCount; ++frame) {
+        for (int i = 0; i < meshCount; ++i) {
+            // Generating the arrays stands for reading them from Maya, it is not timed.
+            VtValue points(makePoints(pointCount, i, frame));
+            VtValue normals(makePoints(pointCount, -i, frame));
+
+            const auto start = std::chrono::steady_clock::now();
+            writers[i]->SetAttribute(meshes[i].GetPointsAttr(), &points, UsdTimeCode(frame));
+            writers[i]->SetAttribute(meshes[i].GetNormalsAttr(), &normals, UsdTimeCode(frame));
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                           .count();
+        }
+    }
+    const double memoryAfter = residentMemory();
+
+    size_t sampleCount = 0;
+    for (const UsdGeomMesh& mesh : meshes) {
+        sampleCount += mesh.GetPointsAttr().GetNumTimeSamples();
+        sampleCount += mesh.GetNormalsAttr().GetNumTimeSamples();
+    }
+
+    std::printf(
+        "%-7s %8zu samples in %7.3f s, %8.1f MB resident memory growth\n",
+        hashSamples ? "hashed" : "copied",
+        sampleCount,
+        seconds,
+        memoryAfter - memoryBefore);
+    return sampleCount;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int    meshCount = argc > 1 ? std::atoi(argv[1]) : 64;
+    const size_t pointCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    const int    frameCount = argc > 3 ? std::atoi(argv[3]) : 48;
+    const char*  mode = argc > 4 ? argv[4] : "both";
+
+    std::printf("%d meshes, %zu points, %d frames\n", meshCount, pointCount, frameCount);
+    if (std::strcmp(mode, "both") != 0) {
+        run(std::strcmp(mode, "hashed") == 0, meshCount, pointCount, frameCount);
+        return EXIT_SUCCESS;
+    }
+
+    const size_t copiedCount = run(false, meshCount, pointCount, frameCount);
+    const size_t hashedCount = run(true, meshCount, pointCount, frameCount);
+    return copiedCount == hashedCount ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,200 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone benchmark of UsdMayaStageBvh. An in-memory stage is filled with a grid of bumpy
+// meshes under an animated transform, then the build, refit and ray intersection times are
+// reported. The first hits are checked against a brute force intersection of every triangle.
+//
+// usage: StageBvhBenchmark [meshesPerSide] [quadsPerSide] [rayCount]
+
+#include <mayaUsd/utils/stageBvh.h>
+
+#include <pxr/base/gf/ray.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xform.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+UsdStageRefPtr createStage(int meshesPerSide, int quadsPerSide)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+
+    // The whole grid moves, so that every mesh is refit when the time changes.
+    UsdGeomXform   grid = UsdGeomXform::Define(stage, SdfPath("/Grid"));
+    UsdGeomXformOp translate = grid.AddTranslateOp();
+    translate.Set(GfVec3d(0.0), UsdTimeCode(0.0));
+    translate.Set(GfVec3d(0.0, 0.0, 1.0), UsdTimeCode(1.0));
+
+    const int  vertsPerSide = quadsPerSide + 1;
+    VtIntArray faceVertexCounts(quadsPerSide * quadsPerSide, 4);
+    VtIntArray faceVertexIndices;
+    for (int y = 0; y < quadsPerSide; ++y) {
+        for (int x = 0; x < quadsPerSide; ++x) {
+            const int corner = y * vertsPerSide + x;
+            faceVertexIndices.push_back(corner);
+            faceVertexIndices.push_back(corner + 1);
+            faceVertexIndices.push_back(corner + vertsPerSide + 1);
+            faceVertexIndices.push_back(corner + vertsPerSide);
+        }
+    }
+
+    for (int j = 0; j < meshesPerSide; ++j) {
+        for (int i = 0; i < meshesPerSide; ++i) {
+            VtVec3fArray points;
+            points.reserve(vertsPerSide * vertsPerSide);
+            for (int y = 0; y < vertsPerSide; ++y) {
+                for (int x = 0; x < vertsPerSide; ++x) {
+                    const float u = float(x) / quadsPerSide;
+                    const float v = float(y) / quadsPerSide;
+                    points.push_back(GfVec3f(
+                        i + u, j + v, 0.25f * std::sin(6.0f * (i + u)) * std::cos(6.0f * (j + v))));
+                }
+            }
+
+            UsdGeomMesh mesh = UsdGeomMesh::Define(
+                stage, SdfPath(TfStringPrintf("/Grid/Mesh_%d_%d", i, j)));
+            mesh.CreateFaceVertexCountsAttr(VtValue(faceVertexCounts));
+            mesh.CreateFaceVertexIndicesAttr(VtValue(faceVertexIndices));
+            mesh.CreatePointsAttr(VtValue(points));
+        }
+    }
+
+    return stage;
+}
+
+// Reference intersection, testing every triangle of every mesh in double precision.
+bool bruteForceIntersect(const UsdStageRefPtr& stage, UsdTimeCode time, const GfRay& ray, double* t)
+{
+    *t = std::numeric_limits<double>::infinity();
+    for (const UsdPrim& prim : stage->Traverse()) {
+        const UsdGeomMesh mesh(prim);
+        if (!mesh) {
+            continue;
+        }
+        VtIntArray   counts;
+        VtIntArray   indices;
+        VtVec3fArray points;
+        mesh.GetFaceVertexCountsAttr().Get(&counts, time);
+        mesh.GetFaceVertexIndicesAttr().Get(&indices, time);
+        mesh.GetPointsAttr().Get(&points, time);
+        const GfMatrix4d localToWorld = mesh.ComputeLocalToWorldTransform(time);
+
+        size_t offset = 0;
+        for (const int count : counts) {
+            const GfVec3d p0 = localToWorld.Transform(GfVec3d(points[indices[offset]]));
+            for (int i = 1; i + 1 < count; ++i) {
+                const GfVec3d p1 = localToWorld.Transform(GfVec3d(points[indices[offset + i]]));
+                const GfVec3d p2
+                    = localToWorld.Transform(GfVec3d(points[indices[offset + i + 1]]));
+                double distance;
+                if (ray.Intersect(p0, p1, p2, &distance) && distance < *t) {
+                    *t = distance;
+                }
+            }
+            offset += count;
+        }
+    }
+    return *t != std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int    meshesPerSide = argc > 1 ? std::atoi(argv[1]) : 32;
+    const int    quadsPerSide = argc > 2 ? std::atoi(argv[2]) : 32;
+    const size_t rayCount = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000000;
+
+    const UsdStageRefPtr stage = createStage(meshesPerSide, quadsPerSide);
+    const TfTokenVector  purposes { UsdGeomTokens->default_ };
+
+    UsdMayaStageBvh bvh;
+    auto            start = Clock::now();
+    bvh.Update(stage->GetPseudoRoot(), UsdTimeCode(0.0), purposes, SdfPathVector());
+    std::printf(
+        "build:  %zu meshes, %zu triangles in %.3f s\n",
+        bvh.GetMeshCount(),
+        bvh.GetTriangleCount(),
+        secondsSince(start));
+
+    start = Clock::now();
+    bvh.Update(stage->GetPseudoRoot(), UsdTimeCode(1.0), purposes, SdfPathVector());
+    std::printf("refit:  %.3f s\n", secondsSince(start));
+
+    // Rays shot down at the grid, slightly tilted so that they are not axis aligned.
+    std::mt19937                           generator(42);
+    std::uniform_real_distribution<double> coordinate(0.0, meshesPerSide);
+    std::vector<GfRay>                     rays;
+    rays.reserve(rayCount);
+    for (size_t i = 0; i < rayCount; ++i) {
+        rays.emplace_back(
+            GfVec3d(coordinate(generator), coordinate(generator), 10.0),
+            GfVec3d(0.01, 0.02, -1.0));
+    }
+
+    size_t               hitCount = 0;
+    UsdMayaStageBvh::Hit hit;
+    start = Clock::now();
+    for (const GfRay& ray : rays) {
+        hitCount += bvh.Intersect(ray, &hit);
+    }
+    const double seconds = secondsSince(start);
+    std::printf(
+        "rays:   %zu hits out of %zu in %.3f s, %.2f Mrays/s\n",
+        hitCount,
+        rayCount,
+        seconds,
+        rayCount / seconds / 1e6);
+
+    size_t       mismatchCount = 0;
+    const size_t checkCount = std::min<size_t>(rayCount, 200);
+    for (size_t i = 0; i < checkCount; ++i) {
+        double     expected;
+        const bool expectedHit = bruteForceIntersect(stage, UsdTimeCode(1.0), rays[i], &expected);
+        const bool actualHit = bvh.Intersect(rays[i], &hit);
+        if (expectedHit != actualHit
+            || (actualHit && std::fabs(hit.distance - expected) > 1e-4 * (1.0 + expected))) {
+            ++mismatchCount;
+        }
+    }
+    std::printf("check:  %zu mismatches out of %zu rays\n", mismatchCount, checkCount);
+
+    return mismatchCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
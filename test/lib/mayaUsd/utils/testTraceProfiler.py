@@ -0,0 +1,116 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import mayaUsd
+
+from pxr import UsdGeom
+
+from maya import cmds
+from maya import standalone
+
+import fixturesUtils
+
+import json
+import os
+import tempfile
+import unittest
+
+
+class testTraceProfiler(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def setUp(self):
+        cmds.file(new=True, force=True)
+        cmds.mayaUsdProfiler(enable=False, clear=True)
+
+    def tearDown(self):
+        cmds.mayaUsdProfiler(enable=False, clear=True)
+
+    def _ComputeProxyShapeBounds(self):
+        transform = cmds.createNode('transform', name='stage')
+        shape = cmds.createNode('mayaUsdProxyShape', name='stageShape', parent=transform)
+        stage = mayaUsd.ufe.getStage(cmds.ls(shape, long=True)[0])
+        UsdGeom.Cube.Define(stage, '/cube')
+        cmds.exactWorldBoundingBox(shape)
+
+    def testEnable(self):
+        """
+        Tests that the profiling scopes are only recorded once enabled.
+        """
+        self.assertFalse(cmds.mayaUsdProfiler(query=True, enable=True))
+        self._ComputeProxyShapeBounds()
+        self.assertNotIn('Compute USD Stage BoundingBox',
+            cmds.mayaUsdProfiler(statistics=True))
+
+        cmds.file(new=True, force=True)
+        cmds.mayaUsdProfiler(enable=True)
+        self.assertTrue(cmds.mayaUsdProfiler(query=True, enable=True))
+        self._ComputeProxyShapeBounds()
+        self.assertIn('Compute USD Stage BoundingBox',
+            cmds.mayaUsdProfiler(statistics=True))
+
+    def testStatistics(self):
+        """
+        Tests the statistics reported, filtered by category and reset.
+        """
+        cmds.mayaUsdProfiler(enable=True)
+        self._ComputeProxyShapeBounds()
+
+        report = cmds.mayaUsdProfiler(statistics=True, category='ProxyShapeBase')
+        self.assertIn('Compute USD Stage BoundingBox', report)
+        self.assertIn('call', report)
+        self.assertFalse(cmds.mayaUsdProfiler(statistics=True, category='AL_USDMaya'))
+
+        cmds.mayaUsdProfiler(reset=True)
+        self.assertFalse(cmds.mayaUsdProfiler(statistics=True))
+
+    def testChromeTrace(self):
+        """
+        Tests the export of the recorded events in the Chrome trace-event format.
+        """
+        cmds.mayaUsdProfiler(enable=True)
+        self._ComputeProxyShapeBounds()
+
+        tracePath = os.path.join(tempfile.mkdtemp(), 'trace.json')
+        cmds.mayaUsdProfiler(chromeTrace=tracePath)
+        with open(tracePath) as traceFile:
+            trace = json.load(traceFile)
+
+        events = [e for e in trace['traceEvents'] if e['ph'] == 'X']
+        names = [e['name'] for e in events]
+        self.assertIn('Compute USD Stage BoundingBox', names)
+        for event in events:
+            self.assertGreaterEqual(event['dur'], 0.0)
+        self.assertEqual(cmds.mayaUsdProfiler(query=True, droppedEvents=True), 0)
+
+        # Clearing discards the events.
+        cmds.mayaUsdProfiler(clear=True)
+        cmds.mayaUsdProfiler(chromeTrace=tracePath)
+        with open(tracePath) as traceFile:
+            trace = json.load(traceFile)
+        self.assertFalse([e for e in trace['traceEvents'] if e['ph'] == 'X'])
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
@@ -0,0 +1,259 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <mayaUsd/utils/util.h>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/usd/usdGeom/tokens.h>
+
+#include <gtest/gtest.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+struct Mesh
+{
+    VtIntArray faceVertexCounts;
+    VtIntArray faceVertexIndices;
+    size_t     numVertices = 0u;
+};
+
+// The compression done by the MFnMesh overload before it used the bulk arrays: the face vertices
+// are visited in order, as MItMeshFaceVertex did, stopping as soon as no compression is possible.
+void legacyCompress(const Mesh& mesh, TfToken* interpolation, VtIntArray* assignmentIndices)
+{
+    // Use -2 as the initial "un-stored" sentinel value, since -1 is the
+    // default unauthored value index for primvars.
+    VtIntArray uniformAssignments(mesh.faceVertexCounts.size(), -2);
+    VtIntArray vertexAssignments(mesh.numVertices, -2);
+
+    bool   isConstant = true;
+    bool   isUniform = true;
+    bool   isVertex = true;
+    size_t fvi = 0;
+    for (size_t face = 0; face < mesh.faceVertexCounts.size(); ++face) {
+        for (int i = 0; i < mesh.faceVertexCounts[face]; ++i, ++fvi) {
+            const int vertexIndex = mesh.faceVertexIndices[fvi];
+            const int assignedIndex = (*assignmentIndices)[fvi];
+
+            if (isConstant && assignedIndex != (*assignmentIndices)[0]) {
+                isConstant = false;
+            }
+
+            if (isUniform) {
+                if (uniformAssignments[face] < -1) {
+                    uniformAssignments[face] = assignedIndex;
+                } else if (assignedIndex != uniformAssignments[face]) {
+                    isUniform = false;
+                }
+            }
+
+            if (isVertex) {
+                if (vertexAssignments[vertexIndex] < -1) {
+                    vertexAssignments[vertexIndex] = assignedIndex;
+                } else if (assignedIndex != vertexAssignments[vertexIndex]) {
+                    isVertex = false;
+                }
+            }
+
+            if (!isConstant && !isUniform && !isVertex) {
+                *interpolation = UsdGeomTokens->faceVarying;
+                return;
+            }
+        }
+    }
+
+    if (isConstant) {
+        assignmentIndices->resize(1);
+        *interpolation = UsdGeomTokens->constant;
+    } else if (isUniform) {
+        *assignmentIndices = uniformAssignments;
+        *interpolation = UsdGeomTokens->uniform;
+    } else if (isVertex) {
+        *assignmentIndices = vertexAssignments;
+        *interpolation = UsdGeomTokens->vertex;
+    } else {
+        *interpolation = UsdGeomTokens->faceVarying;
+    }
+}
+
+// Compresses the face-varying indices with both versions, checks that they give the same result
+// and returns the interpolation.
+TfToken expectSameAsLegacy(const Mesh& mesh, VtIntArray* assignmentIndices)
+{
+    TfToken    expectedInterpolation = UsdGeomTokens->faceVarying;
+    VtIntArray expectedIndices = *assignmentIndices;
+    legacyCompress(mesh, &expectedInterpolation, &expectedIndices);
+
+    TfToken interpolation = UsdGeomTokens->faceVarying;
+    UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
+        mesh.faceVertexCounts,
+        mesh.faceVertexIndices,
+        mesh.numVertices,
+        &interpolation,
+        assignmentIndices);
+    EXPECT_EQ(interpolation, expectedInterpolation);
+    EXPECT_EQ(*assignmentIndices, expectedIndices);
+    return interpolation;
+}
+
+// Two quads sharing the edge between vertices 1 and 4.
+//
+//   3---4---5
+//   |   |   |
+//   0---1---2
+Mesh twoQuads()
+{
+    return Mesh { VtIntArray { 4, 4 }, VtIntArray { 0, 1, 4, 3, 1, 2, 5, 4 }, 6u };
+}
+
+Mesh grid(int quadsPerSide)
+{
+    const int pointsPerSide = quadsPerSide + 1;
+
+    Mesh mesh;
+    mesh.faceVertexCounts.assign(size_t(quadsPerSide) * quadsPerSide, 4);
+    for (int y = 0; y < quadsPerSide; ++y) {
+        for (int x = 0; x < quadsPerSide; ++x) {
+            mesh.faceVertexIndices.push_back(y * pointsPerSide + x);
+            mesh.faceVertexIndices.push_back(y * pointsPerSide + x + 1);
+            mesh.faceVertexIndices.push_back((y + 1) * pointsPerSide + x + 1);
+            mesh.faceVertexIndices.push_back((y + 1) * pointsPerSide + x);
+        }
+    }
+    mesh.numVertices = size_t(pointsPerSide) * pointsPerSide;
+    return mesh;
+}
+
+} // namespace
+
+TEST(CompressFaceVaryingPrimvarIndices, constant)
+{
+    VtIntArray indices(8, 3);
+    EXPECT_EQ(expectSameAsLegacy(twoQuads(), &indices), UsdGeomTokens->constant);
+    EXPECT_EQ(indices, VtIntArray { 3 });
+}
+
+TEST(CompressFaceVaryingPrimvarIndices, uniform)
+{
+    VtIntArray indices { 0, 0, 0, 0, 1, 1, 1, 1 };
+    EXPECT_EQ(expectSameAsLegacy(twoQuads(), &indices), UsdGeomTokens->uniform);
+    EXPECT_EQ(indices, (VtIntArray { 0, 1 }));
+
+    // Unassigned faces are uniform too.
+    VtIntArray unassigned { 2, 2, 2, 2, -1, -1, -1, -1 };
+    EXPECT_EQ(expectSameAsLegacy(twoQuads(), &unassigned), UsdGeomTokens->uniform);
+    EXPECT_EQ(unassigned, (VtIntArray { 2, -1 }));
+}
+
+TEST(CompressFaceVaryingPrimvarIndices, vertex)
+{
+    const Mesh mesh = twoQuads();
+    VtIntArray indices = mesh.faceVertexIndices;
+    EXPECT_EQ(expectSameAsLegacy(mesh, &indices), UsdGeomTokens->vertex);
+    EXPECT_EQ(indices, (VtIntArray { 0, 1, 2, 3, 4, 5 }));
+
+    // Vertices not used by any face keep the sentinel value.
+    Mesh withUnusedVertex = twoQuads();
+    withUnusedVertex.numVertices = 7u;
+    VtIntArray unusedIndices = mesh.faceVertexIndices;
+    EXPECT_EQ(expectSameAsLegacy(withUnusedVertex, &unusedIndices), UsdGeomTokens->vertex);
+    EXPECT_EQ(unusedIndices, (VtIntArray { 0, 1, 2, 3, 4, 5, -2 }));
+}
+
+TEST(CompressFaceVaryingPrimvarIndices, faceVarying)
+{
+    VtIntArray indices { 0, 1, 2, 3, 4, 5, 6, 7 };
+    EXPECT_EQ(expectSameAsLegacy(twoQuads(), &indices), UsdGeomTokens->faceVarying);
+    EXPECT_EQ(indices, (VtIntArray { 0, 1, 2, 3, 4, 5, 6, 7 }));
+
+    // A mismatched size leaves the indices as they are.
+    VtIntArray mismatched { 0, 0, 0 };
+    TfToken    interpolation = UsdGeomTokens->faceVarying;
+    const Mesh mesh = twoQuads();
+    UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
+        mesh.faceVertexCounts,
+        mesh.faceVertexIndices,
+        mesh.numVertices,
+        &interpolation,
+        &mismatched);
+    EXPECT_EQ(interpolation, UsdGeomTokens->faceVarying);
+    EXPECT_EQ(mismatched, (VtIntArray { 0, 0, 0 }));
+}
+
+TEST(CompressFaceVaryingPrimvarIndices, zeroVertexFaces)
+{
+    // The quads of twoQuads() with an empty face between them, whose uniform value is unset.
+    const Mesh mesh { VtIntArray { 4, 0, 4 }, VtIntArray { 0, 1, 4, 3, 1, 2, 5, 4 }, 6u };
+
+    VtIntArray uniform { 5, 5, 5, 5, 6, 6, 6, 6 };
+    EXPECT_EQ(expectSameAsLegacy(mesh, &uniform), UsdGeomTokens->uniform);
+    EXPECT_EQ(uniform, (VtIntArray { 5, -2, 6 }));
+
+    VtIntArray constant(8, 1);
+    EXPECT_EQ(expectSameAsLegacy(mesh, &constant), UsdGeomTokens->constant);
+
+    VtIntArray vertex = mesh.faceVertexIndices;
+    EXPECT_EQ(expectSameAsLegacy(mesh, &vertex), UsdGeomTokens->vertex);
+
+    VtIntArray faceVarying { 0, 1, 2, 3, 4, 5, 6, 7 };
+    EXPECT_EQ(expectSameAsLegacy(mesh, &faceVarying), UsdGeomTokens->faceVarying);
+}
+
+TEST(CompressFaceVaryingPrimvarIndices, largeMesh)
+{
+    // Enough faces for them to be split in several ranges compressed in parallel.
+    const int  quadsPerSide = 256;
+    const Mesh mesh = grid(quadsPerSide);
+    const int  numFaces = quadsPerSide * quadsPerSide;
+
+    VtIntArray constant(mesh.faceVertexIndices.size(), 0);
+    EXPECT_EQ(expectSameAsLegacy(mesh, &constant), UsdGeomTokens->constant);
+
+    VtIntArray uniform(mesh.faceVertexIndices.size());
+    for (size_t fvi = 0; fvi < uniform.size(); ++fvi) {
+        uniform[fvi] = static_cast<int>(fvi / 4) % 7;
+    }
+    EXPECT_EQ(expectSameAsLegacy(mesh, &uniform), UsdGeomTokens->uniform);
+    EXPECT_EQ(uniform.size(), size_t(numFaces));
+
+    VtIntArray vertex = mesh.faceVertexIndices;
+    EXPECT_EQ(expectSameAsLegacy(mesh, &vertex), UsdGeomTokens->vertex);
+    EXPECT_EQ(vertex.size(), mesh.numVertices);
+
+    VtIntArray faceVarying(mesh.faceVertexIndices.size());
+    for (size_t fvi = 0; fvi < faceVarying.size(); ++fvi) {
+        faceVarying[fvi] = static_cast<int>(fvi);
+    }
+    EXPECT_EQ(expectSameAsLegacy(mesh, &faceVarying), UsdGeomTokens->faceVarying);
+
+    // Only the last face prevents the constant and vertex compressions, so that all the faces
+    // have to be compressed before knowing it.
+    VtIntArray lastFaceDiffers(mesh.faceVertexIndices.size(), 0);
+    for (size_t fvi = lastFaceDiffers.size() - 4; fvi < lastFaceDiffers.size(); ++fvi) {
+        lastFaceDiffers[fvi] = 1;
+    }
+    EXPECT_EQ(expectSameAsLegacy(mesh, &lastFaceDiffers), UsdGeomTokens->uniform);
+    EXPECT_EQ(lastFaceDiffers[numFaces - 1], 1);
+
+    // Only the last face vertex prevents the vertex compression.
+    VtIntArray lastVertexDiffers = mesh.faceVertexIndices;
+    lastVertexDiffers[lastVertexDiffers.size() - 1] = -1;
+    EXPECT_EQ(expectSameAsLegacy(mesh, &lastVertexDiffers), UsdGeomTokens->faceVarying);
+}
@@ -0,0 +1,201 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <mayaUsd/utils/util.h>
+
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec4f.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <map>
+#include <random>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+template <typename T> struct Components
+{
+    static constexpr size_t count = T::dimension;
+    static float&           at(T& value, size_t i) { return value[i]; }
+};
+
+template <> struct Components<float>
+{
+    static constexpr size_t count = 1;
+    static float&           at(float& value, size_t) { return value; }
+};
+
+// The merge done before it sorted the values: the values are numbered in the order of their
+// first assignment, through a map. Comparing the floats with < makes -0 and +0 equivalent, as
+// comparing them with GfIsClose() did.
+template <typename T> void legacyMerge(VtArray<T>* valueData, VtIntArray* assignmentIndices)
+{
+    const size_t numValues = valueData->size();
+    if (numValues == 0u) {
+        return;
+    }
+
+    std::map<std::array<float, Components<T>::count>, int> uniqueIndexOfValue;
+    VtArray<T>                                             uniqueValues;
+    VtIntArray                                             uniqueIndices;
+    for (const int index : *assignmentIndices) {
+        if (index < 0 || static_cast<size_t>(index) >= numValues) {
+            uniqueIndices.push_back(index);
+            continue;
+        }
+
+        T                                       value = (*valueData)[index];
+        std::array<float, Components<T>::count> key;
+        for (size_t i = 0; i < key.size(); ++i) {
+            key[i] = Components<T>::at(value, i);
+        }
+        const auto inserted
+            = uniqueIndexOfValue.emplace(key, static_cast<int>(uniqueValues.size()));
+        if (inserted.second) {
+            uniqueValues.push_back(value);
+        }
+        uniqueIndices.push_back(inserted.first->second);
+    }
+
+    if (uniqueValues.size() < numValues) {
+        *valueData = uniqueValues;
+        *assignmentIndices = uniqueIndices;
+    }
+}
+
+// Merges the values with both versions and checks that they give the same result.
+template <typename T>
+void expectSameAsLegacy(VtArray<T>* valueData, VtIntArray* assignmentIndices)
+{
+    VtArray<T> expectedValues = *valueData;
+    VtIntArray expectedIndices = *assignmentIndices;
+    legacyMerge(&expectedValues, &expectedIndices);
+
+    UsdMayaUtil::MergeEquivalentIndexedValues(valueData, assignmentIndices);
+    EXPECT_EQ(*valueData, expectedValues);
+    EXPECT_EQ(*assignmentIndices, expectedIndices);
+}
+
+// Values from a small pool, so that many of them are merged, with some negative zeros.
+template <typename T> VtArray<T> makeValues(size_t count, std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> pool(-8, 8);
+    VtArray<T>                         values(count);
+    for (T& value : values) {
+        for (size_t i = 0; i < Components<T>::count; ++i) {
+            const int component = pool(generator);
+            Components<T>::at(value, i) = component == -8 ? -0.0f : 0.5f * component;
+        }
+    }
+    return values;
+}
+
+template <typename T> void testLargeInput()
+{
+    // Enough values for the keys to be sorted in parallel, and some unknown indices.
+    const size_t                       numValues = 40000u;
+    std::mt19937                       generator(42);
+    std::uniform_int_distribution<int> index(-2, static_cast<int>(numValues) + 2);
+
+    VtArray<T> values = makeValues<T>(numValues, generator);
+    VtIntArray indices(2 * numValues);
+    for (int& i : indices) {
+        i = index(generator);
+    }
+
+    expectSameAsLegacy(&values, &indices);
+    EXPECT_LT(values.size(), numValues);
+}
+
+} // namespace
+
+TEST(MergeEquivalentIndexedValues, keepsFirstUseOrder)
+{
+    VtVec2fArray values { GfVec2f(1.0f, 0.0f),
+                          GfVec2f(2.0f, 0.0f),
+                          GfVec2f(3.0f, 0.0f),
+                          GfVec2f(1.0f, 0.0f),
+                          GfVec2f(2.0f, 0.0f) };
+    VtIntArray   indices { 4, 2, 0, 1, 3 };
+    expectSameAsLegacy(&values, &indices);
+
+    EXPECT_EQ(
+        values, (VtVec2fArray { GfVec2f(2.0f, 0.0f), GfVec2f(3.0f, 0.0f), GfVec2f(1.0f, 0.0f) }));
+    EXPECT_EQ(indices, (VtIntArray { 0, 1, 2, 0, 2 }));
+}
+
+TEST(MergeEquivalentIndexedValues, keepsUnknownIndices)
+{
+    VtFloatArray values { 0.5f, 0.5f };
+    VtIntArray   indices { -1, 0, 7, 1, -5, 2 };
+    expectSameAsLegacy(&values, &indices);
+
+    EXPECT_EQ(values, (VtFloatArray { 0.5f }));
+    EXPECT_EQ(indices, (VtIntArray { -1, 0, 7, 0, -5, 2 }));
+}
+
+TEST(MergeEquivalentIndexedValues, mergesNegativeZero)
+{
+    VtFloatArray values { -0.0f, 0.0f, 1.0f };
+    VtIntArray   indices { 1, 0, 2 };
+    expectSameAsLegacy(&values, &indices);
+    EXPECT_EQ(values.size(), 2u);
+    EXPECT_EQ(indices, (VtIntArray { 0, 0, 1 }));
+
+    VtVec3fArray vectors { GfVec3f(0.0f, 1.0f, -0.0f), GfVec3f(-0.0f, 1.0f, 0.0f) };
+    VtIntArray   vectorIndices { 0, 1 };
+    expectSameAsLegacy(&vectors, &vectorIndices);
+    EXPECT_EQ(vectors.size(), 1u);
+    EXPECT_EQ(vectorIndices, (VtIntArray { 0, 0 }));
+}
+
+TEST(MergeEquivalentIndexedValues, keepsDistinctValues)
+{
+    // Nothing to merge: the values and indices are left as they are, even though the values are
+    // not in the order of their first use.
+    VtVec4fArray values { GfVec4f(1.0f), GfVec4f(2.0f), GfVec4f(3.0f) };
+    VtIntArray   indices { 2, 1, 0, -1 };
+    expectSameAsLegacy(&values, &indices);
+    EXPECT_EQ(values, (VtVec4fArray { GfVec4f(1.0f), GfVec4f(2.0f), GfVec4f(3.0f) }));
+    EXPECT_EQ(indices, (VtIntArray { 2, 1, 0, -1 }));
+
+    // Unassigned values are dropped.
+    VtVec4fArray unassigned { GfVec4f(1.0f), GfVec4f(2.0f), GfVec4f(3.0f) };
+    VtIntArray   unassignedIndices { 2, 0 };
+    expectSameAsLegacy(&unassigned, &unassignedIndices);
+    EXPECT_EQ(unassigned, (VtVec4fArray { GfVec4f(3.0f), GfVec4f(1.0f) }));
+    EXPECT_EQ(unassignedIndices, (VtIntArray { 0, 1 }));
+
+    // Without values, the indices are left as they are.
+    VtFloatArray empty;
+    VtIntArray   emptyIndices { 0, 1 };
+    expectSameAsLegacy(&empty, &emptyIndices);
+    EXPECT_EQ(emptyIndices, (VtIntArray { 0, 1 }));
+}
+
+TEST(MergeEquivalentIndexedValues, largeInputs)
+{
+    testLargeInput<float>();
+    testLargeInput<GfVec2f>();
+    testLargeInput<GfVec3f>();
+    testLargeInput<GfVec4f>();
+}
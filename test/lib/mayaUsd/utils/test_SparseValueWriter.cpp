@@ -0,0 +1,167 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <mayaUsd/fileio/utils/sparseValueWriter.h>
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/tokens.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// The writer compares the samples by value, or by hash.
+const bool hashSampleModes[] = { false, true };
+
+VtVec3fArray pointsAt(float y)
+{
+    return VtVec3fArray { GfVec3f(0.0f, y, 0.0f), GfVec3f(1.0f, y, 0.0f) };
+}
+
+std::vector<double> timeSamples(const UsdAttribute& attr)
+{
+    std::vector<double> times;
+    attr.GetTimeSamples(&times);
+    return times;
+}
+
+VtVec3fArray pointsAtTime(const UsdAttribute& attr, UsdTimeCode time)
+{
+    VtVec3fArray points;
+    attr.Get(&points, time);
+    return points;
+}
+
+} // namespace
+
+TEST(SparseValueWriter, endsRunsWithHeldValue)
+{
+    for (const bool hashSamples : hashSampleModes) {
+        SCOPED_TRACE(hashSamples ? "hashed" : "copied");
+        UsdMayaSparseValueWriter writer(hashSamples);
+        ASSERT_EQ(writer.IsHashingSamples(), hashSamples);
+
+        const UsdStageRefPtr stage = UsdStage::CreateInMemory();
+        const UsdGeomMesh    mesh = UsdGeomMesh::Define(stage, SdfPath("/Mesh"));
+        const UsdAttribute   points = mesh.GetPointsAttr();
+        for (const double time : { 1.0, 2.0, 3.0 }) {
+            EXPECT_TRUE(writer.SetAttribute(points, pointsAt(1.0f), time));
+        }
+        for (const double time : { 4.0, 5.0 }) {
+            EXPECT_TRUE(writer.SetAttribute(points, pointsAt(2.0f), time));
+        }
+
+        // The run of identical samples ends with the held value at frame 3.
+        EXPECT_EQ(timeSamples(points), (std::vector<double> { 1.0, 3.0, 4.0 }));
+        EXPECT_EQ(pointsAtTime(points, 1.0), pointsAt(1.0f));
+        EXPECT_EQ(pointsAtTime(points, 3.0), pointsAt(1.0f));
+        EXPECT_EQ(pointsAtTime(points, 4.0), pointsAt(2.0f));
+        EXPECT_TRUE(pointsAtTime(points, UsdTimeCode::Default()).empty());
+    }
+}
+
+TEST(SparseValueWriter, skipsLeadingSamplesMatchingDefault)
+{
+    for (const bool hashSamples : hashSampleModes) {
+        SCOPED_TRACE(hashSamples ? "hashed" : "copied");
+        UsdMayaSparseValueWriter writer(hashSamples);
+
+        const UsdStageRefPtr stage = UsdStage::CreateInMemory();
+        const UsdGeomMesh    mesh = UsdGeomMesh::Define(stage, SdfPath("/Mesh"));
+        const UsdAttribute   points = mesh.GetPointsAttr();
+        ASSERT_TRUE(points.Set(pointsAt(1.0f)));
+
+        for (const double time : { 1.0, 2.0 }) {
+            EXPECT_TRUE(writer.SetAttribute(points, pointsAt(1.0f), time));
+        }
+        EXPECT_TRUE(timeSamples(points).empty());
+
+        // The held value is the existing default, authored at the end of the run.
+        EXPECT_TRUE(writer.SetAttribute(points, pointsAt(2.0f), 3.0));
+        EXPECT_EQ(timeSamples(points), (std::vector<double> { 2.0, 3.0 }));
+        EXPECT_EQ(pointsAtTime(points, 2.0), pointsAt(1.0f));
+        EXPECT_EQ(pointsAtTime(points, 3.0), pointsAt(2.0f));
+        EXPECT_EQ(pointsAtTime(points, UsdTimeCode::Default()), pointsAt(1.0f));
+    }
+}
+
+TEST(SparseValueWriter, skipsDefaultMatchingExistingValue)
+{
+    for (const bool hashSamples : hashSampleModes) {
+        SCOPED_TRACE(hashSamples ? "hashed" : "copied");
+        UsdMayaSparseValueWriter writer(hashSamples);
+
+        const UsdStageRefPtr stage = UsdStage::CreateInMemory();
+        const UsdGeomMesh    mesh = UsdGeomMesh::Define(stage, SdfPath("/Mesh"));
+
+        // A default value matching the fallback value isn't authored.
+        const UsdAttribute scheme = mesh.GetSubdivisionSchemeAttr();
+        EXPECT_TRUE(writer.SetAttribute(scheme, UsdGeomTokens->catmullClark));
+        EXPECT_FALSE(scheme.HasAuthoredValue());
+
+        // Nor is a default value matching the authored one, and the leading time samples
+        // matching it.
+        const UsdAttribute points = mesh.GetPointsAttr();
+        ASSERT_TRUE(points.Set(pointsAt(1.0f)));
+        EXPECT_TRUE(writer.SetAttribute(points, pointsAt(1.0f)));
+        EXPECT_TRUE(writer.SetAttribute(points, pointsAt(1.0f), 1.0));
+        EXPECT_TRUE(timeSamples(points).empty());
+
+        // Its run ends with the default value.
+        EXPECT_TRUE(writer.SetAttribute(points, pointsAt(2.0f), 2.0));
+        EXPECT_EQ(timeSamples(points), (std::vector<double> { 1.0, 2.0 }));
+        EXPECT_EQ(pointsAtTime(points, 1.0), pointsAt(1.0f));
+        EXPECT_EQ(pointsAtTime(points, 2.0), pointsAt(2.0f));
+    }
+}
+
+TEST(SparseValueWriter, authorsChangedDefault)
+{
+    for (const bool hashSamples : hashSampleModes) {
+        SCOPED_TRACE(hashSamples ? "hashed" : "copied");
+        UsdMayaSparseValueWriter writer(hashSamples);
+
+        const UsdStageRefPtr stage = UsdStage::CreateInMemory();
+        const UsdGeomMesh    mesh = UsdGeomMesh::Define(stage, SdfPath("/Mesh"));
+        const UsdAttribute   scheme = mesh.GetSubdivisionSchemeAttr();
+        EXPECT_TRUE(writer.SetAttribute(scheme, UsdGeomTokens->none));
+        TfToken schemeValue;
+        EXPECT_TRUE(scheme.Get(&schemeValue));
+        EXPECT_EQ(schemeValue, UsdGeomTokens->none);
+
+        // Without an existing value, the first value is always authored.
+        const UsdAttribute points = mesh.GetPointsAttr();
+        EXPECT_TRUE(writer.SetAttribute(points, pointsAt(1.0f)));
+        EXPECT_EQ(pointsAtTime(points, UsdTimeCode::Default()), pointsAt(1.0f));
+
+        const UsdAttribute counts = mesh.GetFaceVertexCountsAttr();
+        EXPECT_TRUE(writer.SetAttribute(counts, VtIntArray { 4 }, 1.0));
+        EXPECT_TRUE(writer.SetAttribute(counts, VtIntArray { 4 }, 2.0));
+        EXPECT_EQ(timeSamples(counts), (std::vector<double> { 1.0 }));
+        VtIntArray countsValue;
+        EXPECT_TRUE(counts.Get(&countsValue, 2.0));
+        EXPECT_EQ(countsValue, VtIntArray { 4 });
+    }
+}
@@ -0,0 +1,238 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <mayaUsd/utils/stageBvh.h>
+
+#include <pxr/base/gf/ray.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/weakBase.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xform.h>
+
+#include <gtest/gtest.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// Forwards the changes of a stage to a hierarchy, as the proxy shape does.
+class BvhListener : public TfWeakBase
+{
+public:
+    BvhListener(UsdMayaStageBvh& bvh, const UsdStageRefPtr& stage)
+        : _bvh(bvh)
+    {
+        _key = TfNotice::Register(TfCreateWeakPtr(this), &BvhListener::onObjectsChanged, stage);
+    }
+
+    ~BvhListener() { TfNotice::Revoke(_key); }
+
+    void onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr&)
+    {
+        _bvh.OnObjectsChanged(notice);
+    }
+
+private:
+    UsdMayaStageBvh& _bvh;
+    TfNotice::Key    _key;
+};
+
+// Defines a unit quad in the XY plane, from the origin.
+UsdGeomMesh defineQuad(const UsdStageRefPtr& stage, const SdfPath& path)
+{
+    UsdGeomMesh mesh = UsdGeomMesh::Define(stage, path);
+    mesh.CreateFaceVertexCountsAttr(VtValue(VtIntArray { 4 }));
+    mesh.CreateFaceVertexIndicesAttr(VtValue(VtIntArray { 0, 1, 2, 3 }));
+    mesh.CreatePointsAttr(VtValue(VtVec3fArray {
+        GfVec3f(0.0f, 0.0f, 0.0f),
+        GfVec3f(1.0f, 0.0f, 0.0f),
+        GfVec3f(1.0f, 1.0f, 0.0f),
+        GfVec3f(0.0f, 1.0f, 0.0f) }));
+    return mesh;
+}
+
+VtVec3fArray quadPointsAt(float z)
+{
+    return VtVec3fArray { GfVec3f(0.0f, 0.0f, z),
+                          GfVec3f(1.0f, 0.0f, z),
+                          GfVec3f(1.0f, 1.0f, z),
+                          GfVec3f(0.0f, 1.0f, z) };
+}
+
+// Casts a ray down the Z axis through the middle of the quads.
+bool intersectDown(const UsdMayaStageBvh& bvh, UsdMayaStageBvh::Hit* hit)
+{
+    return bvh.Intersect(GfRay(GfVec3d(0.5, 0.5, 10.0), GfVec3d(0.0, 0.0, -1.0)), hit);
+}
+
+const TfTokenVector defaultPurposes { UsdGeomTokens->default_ };
+
+} // namespace
+
+TEST(StageBvh, intersect)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/Root"));
+    defineQuad(stage, SdfPath("/Root/Quad"));
+
+    UsdMayaStageBvh bvh;
+    bvh.Update(stage->GetPrimAtPath(SdfPath("/Root")), UsdTimeCode(0.0), defaultPurposes, {});
+    EXPECT_EQ(bvh.GetMeshCount(), 1u);
+    EXPECT_EQ(bvh.GetTriangleCount(), 2u);
+
+    UsdMayaStageBvh::Hit hit;
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 0.0, 1e-6);
+    EXPECT_NEAR(hit.distance, 10.0, 1e-5);
+    EXPECT_NEAR(hit.normal[2], 1.0, 1e-6);
+    EXPECT_EQ(hit.primPath, SdfPath("/Root/Quad"));
+
+    EXPECT_FALSE(
+        bvh.Intersect(GfRay(GfVec3d(2.0, 2.0, 10.0), GfVec3d(0.0, 0.0, -1.0)), nullptr));
+}
+
+TEST(StageBvh, excludedAndPurposes)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    defineQuad(stage, SdfPath("/Root/Quad"));
+    UsdGeomMesh guide = defineQuad(stage, SdfPath("/Root/Guide"));
+    guide.CreatePurposeAttr(VtValue(UsdGeomTokens->guide));
+    guide.GetPointsAttr().Set(quadPointsAt(1.0f));
+
+    const UsdPrim   root = stage->GetPrimAtPath(SdfPath("/Root"));
+    UsdMayaStageBvh bvh;
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    EXPECT_EQ(bvh.GetMeshCount(), 1u);
+
+    UsdMayaStageBvh::Hit hit;
+    bvh.Update(root, UsdTimeCode(0.0), { UsdGeomTokens->default_, UsdGeomTokens->guide }, {});
+    EXPECT_EQ(bvh.GetMeshCount(), 2u);
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_EQ(hit.primPath, SdfPath("/Root/Guide"));
+
+    bvh.Update(
+        root,
+        UsdTimeCode(0.0),
+        { UsdGeomTokens->default_, UsdGeomTokens->guide },
+        { SdfPath("/Root/Guide") });
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_EQ(hit.primPath, SdfPath("/Root/Quad"));
+}
+
+TEST(StageBvh, refitWhenTimeChanges)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomMesh    quad = defineQuad(stage, SdfPath("/Root/Quad"));
+    quad.GetPointsAttr().Set(quadPointsAt(0.0f), UsdTimeCode(0.0));
+    quad.GetPointsAttr().Set(quadPointsAt(2.0f), UsdTimeCode(1.0));
+
+    const UsdPrim   root = stage->GetPrimAtPath(SdfPath("/Root"));
+    UsdMayaStageBvh bvh;
+
+    UsdMayaStageBvh::Hit hit;
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 0.0, 1e-6);
+
+    bvh.Update(root, UsdTimeCode(1.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 2.0, 1e-6);
+}
+
+TEST(StageBvh, editMakesPointsTimeVarying)
+{
+    UsdStageRefPtr  stage = UsdStage::CreateInMemory();
+    UsdGeomMesh     quad = defineQuad(stage, SdfPath("/Root/Quad"));
+    const UsdPrim   root = stage->GetPrimAtPath(SdfPath("/Root"));
+    UsdMayaStageBvh bvh;
+    BvhListener     listener(bvh, stage);
+
+    UsdMayaStageBvh::Hit hit;
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 0.0, 1e-6);
+
+    // Animating the points only changes the info of the attribute, which refits the hierarchy
+    // at the current time. The next time changes must refit it too.
+    quad.GetPointsAttr().Set(quadPointsAt(1.0f), UsdTimeCode(0.0));
+    quad.GetPointsAttr().Set(quadPointsAt(3.0f), UsdTimeCode(1.0));
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 1.0, 1e-6);
+
+    bvh.Update(root, UsdTimeCode(1.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 3.0, 1e-6);
+}
+
+TEST(StageBvh, editMakesTransformTimeVarying)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform   xform = UsdGeomXform::Define(stage, SdfPath("/Root"));
+    UsdGeomXformOp translate = xform.AddTranslateOp();
+    translate.Set(GfVec3d(0.0));
+    defineQuad(stage, SdfPath("/Root/Quad"));
+    const UsdPrim   root = stage->GetPrimAtPath(SdfPath("/Root"));
+    UsdMayaStageBvh bvh;
+    BvhListener     listener(bvh, stage);
+
+    UsdMayaStageBvh::Hit hit;
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 0.0, 1e-6);
+
+    // Animate the existing op of the root.
+    translate.Set(GfVec3d(0.0, 0.0, 1.0), UsdTimeCode(0.0));
+    translate.Set(GfVec3d(0.0, 0.0, 4.0), UsdTimeCode(1.0));
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 1.0, 1e-6);
+
+    bvh.Update(root, UsdTimeCode(1.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 4.0, 1e-6);
+
+    // Making it constant again stops the refits, which must keep the last positions.
+    translate.GetAttr().Clear();
+    translate.Set(GfVec3d(0.0, 0.0, 2.0));
+    bvh.Update(root, UsdTimeCode(1.0), defaultPurposes, {});
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    ASSERT_TRUE(intersectDown(bvh, &hit));
+    EXPECT_NEAR(hit.point[2], 2.0, 1e-6);
+}
+
+TEST(StageBvh, rebuildOnVisibilityEdit)
+{
+    UsdStageRefPtr  stage = UsdStage::CreateInMemory();
+    UsdGeomMesh     quad = defineQuad(stage, SdfPath("/Root/Quad"));
+    const UsdPrim   root = stage->GetPrimAtPath(SdfPath("/Root"));
+    UsdMayaStageBvh bvh;
+    BvhListener     listener(bvh, stage);
+
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    EXPECT_TRUE(intersectDown(bvh, nullptr));
+
+    quad.CreateVisibilityAttr(VtValue(UsdGeomTokens->invisible));
+    bvh.Update(root, UsdTimeCode(0.0), defaultPurposes, {});
+    EXPECT_EQ(bvh.GetMeshCount(), 0u);
+    EXPECT_FALSE(intersectDown(bvh, nullptr));
+}
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Standalone benchmark of the proxy shape to stage map with many proxy shapes,
+# the timing counterpart of testStageMap.py. It is not registered as a test,
+# run it manually with mayapy:
+#
+# usage: mayapy benchmarkStageMap.py [nbProxyShapes]
+#
+# By default, 2000 proxy shapes are created. The first lookup of all of them
+# populates the map by listing every proxy shape in the scene, which the map
+# used to do again whenever any proxy shape changed. The lookups following the
+# changes of a few proxy shapes only update their entries, so they must be much
+# faster than populating the map.
+
+from maya import cmds
+from maya import standalone
+
+import sys
+import timeit
+
+
+def createProxyShape(name):
+    '''Create a proxy shape with an in-memory stage, returning its path.'''
+    transform = cmds.createNode('transform', name=name)
+    shape = cmds.createNode('mayaUsdProxyShape', name=name + 'Shape', parent=transform)
+    return cmds.ls(shape, long=True)[0]
+
+
+def main(nbProxyShapes):
+    import mayaUsd
+
+    shapes = [createProxyShape('stage%d' % i) for i in range(nbProxyShapes)]
+
+    def lookupAll():
+        for shape in shapes:
+            if mayaUsd.ufe.getStage(shape) is None:
+                raise RuntimeError('%s is not mapped' % shape)
+
+    populate = timeit.timeit(lookupAll, number=1)
+    lookup = timeit.timeit(lookupAll, number=1)
+
+    def addRenameRemove():
+        createProxyShape('added')
+        cmds.rename('|stage0', 'renamed')
+        shapes[0] = '|renamed|stage0Shape'
+        cmds.delete('|added')
+        lookupAll()
+    update = timeit.timeit(addRenameRemove, number=1)
+
+    # A proxy shape loading another stage used to clear the whole map.
+    def changeStage():
+        cmds.setAttr(shapes[1] + '.shareStage', False)
+        lookupAll()
+    stageChange = timeit.timeit(changeStage, number=1)
+
+    print('%d proxy shapes' % nbProxyShapes)
+    print('    populate                   %8.3fs' % populate)
+    print('    lookup                     %8.3fs' % lookup)
+    print('    add, rename, remove, lookup %7.3fs, %6.1fx faster than populate' %
+          (update, populate / max(update, 1e-9)))
+    print('    stage change, lookup       %8.3fs, %6.1fx faster than populate' %
+          (stageChange, populate / max(stageChange, 1e-9)))
+
+
+if __name__ == '__main__':
+    standalone.initialize('usd')
+    try:
+        cmds.loadPlugin('mayaUsdPlugin', quiet=True)
+        main(int(sys.argv[1]) if len(sys.argv) > 1 else 2000)
+    finally:
+        standalone.uninitialize()
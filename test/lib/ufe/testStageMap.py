@@ -0,0 +1,151 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import fixturesUtils
+import mayaUtils
+
+import mayaUsd
+
+from maya import cmds
+from maya import standalone
+
+import unittest
+
+
+class StageMapTestCase(unittest.TestCase):
+    '''Verify the proxy shape to stage map follows the proxy shapes being
+    added, removed, renamed and reparented.
+    '''
+
+    pluginsLoaded = False
+
+    # Number of proxy shapes for the stress test.
+    NB_PROXY_SHAPES = 2000
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.readOnlySetUpClass(__file__, loadPlugin=False)
+
+        if not cls.pluginsLoaded:
+            cls.pluginsLoaded = mayaUtils.isMayaUsdPluginLoaded()
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def setUp(self):
+        ''' Called initially to set up the Maya test environment '''
+        self.assertTrue(self.pluginsLoaded)
+        cmds.file(new=True, force=True)
+
+    def createProxyShape(self, name):
+        '''Create a proxy shape with an in-memory stage, returning its path.'''
+        transform = cmds.createNode('transform', name=name)
+        shape = cmds.createNode('mayaUsdProxyShape', name=name + 'Shape', parent=transform)
+        return cmds.ls(shape, long=True)[0]
+
+    def assertMapped(self, shapePath):
+        stage = mayaUsd.ufe.getStage(shapePath)
+        self.assertIsNotNone(stage)
+        self.assertIs(stage, mayaUsd.lib.GetPrim(shapePath).GetStage())
+        self.assertEqual(mayaUsd.ufe.stagePath(stage), '|world' + shapePath)
+
+    def assertNotMapped(self, shapePath):
+        self.assertIsNone(mayaUsd.ufe.getStage(shapePath))
+
+    def testAddRemove(self):
+        '''Proxy shapes added and removed after the map was populated.'''
+        first = self.createProxyShape('first')
+        self.assertMapped(first)
+
+        second = self.createProxyShape('second')
+        self.assertMapped(second)
+
+        cmds.delete('|second')
+        self.assertNotMapped(second)
+        self.assertMapped(first)
+
+        cmds.undo()
+        self.assertMapped(second)
+
+        cmds.redo()
+        self.assertNotMapped(second)
+
+    def testRenameReparent(self):
+        '''Proxy shapes renamed, or one of their ancestors.'''
+        shape = self.createProxyShape('stage')
+        self.assertMapped(shape)
+
+        cmds.rename(shape, 'renamedShape')
+        self.assertNotMapped(shape)
+        self.assertMapped('|stage|renamedShape')
+
+        cmds.rename('|stage', 'renamed')
+        self.assertNotMapped('|stage|renamedShape')
+        self.assertMapped('|renamed|renamedShape')
+
+        group = cmds.group(empty=True, name='group')
+        cmds.parent('|renamed', group)
+        self.assertNotMapped('|renamed|renamedShape')
+        self.assertMapped('|group|renamed|renamedShape')
+
+        cmds.undo()
+        self.assertMapped('|renamed|renamedShape')
+
+    def testStageChange(self):
+        '''A proxy shape loading another stage.'''
+        shape = self.createProxyShape('stage')
+        other = self.createProxyShape('other')
+        stage = mayaUsd.ufe.getStage(shape)
+        self.assertMapped(other)
+
+        cmds.setAttr(shape + '.shareStage', False)
+        self.assertIsNot(mayaUsd.ufe.getStage(shape), stage)
+        self.assertMapped(shape)
+        self.assertMapped(other)
+
+    def testManyProxyShapes(self):
+        '''Lookups with many proxy shapes, while some of them change.
+
+        benchmarkStageMap.py times the same steps.
+        '''
+        shapes = [self.createProxyShape('stage%d' % i) for i in range(self.NB_PROXY_SHAPES)]
+
+        def lookupAll():
+            for shape in shapes:
+                self.assertIsNotNone(mayaUsd.ufe.getStage(shape))
+
+        # The first lookup populates the map, the second one only reads it.
+        lookupAll()
+        lookupAll()
+
+        # Adding, removing and renaming proxy shapes must only update the
+        # affected entries.
+        added = self.createProxyShape('added')
+        cmds.rename('|stage0', 'renamed')
+        shapes[0] = '|renamed|stage0Shape'
+        cmds.delete('|added')
+        self.assertNotMapped(added)
+        self.assertNotMapped('|stage0|stage0Shape')
+
+        for shape in shapes:
+            self.assertMapped(shape)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
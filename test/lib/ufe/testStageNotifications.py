@@ -0,0 +1,129 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import fixturesUtils
+import mayaUtils
+
+import mayaUsd
+
+from maya import cmds
+from maya import standalone
+
+from pxr import Sdf
+from pxr import Tf
+from pxr import Usd
+
+import ufe
+
+import unittest
+
+
+class SceneObserver(ufe.Observer):
+    def __init__(self):
+        super(SceneObserver, self).__init__()
+        self.reset()
+
+    def __call__(self, notification):
+        if isinstance(notification, ufe.SceneCompositeNotification):
+            self.composite += 1
+        elif isinstance(notification, ufe.SubtreeInvalidate):
+            self.subtreeInvalidate += 1
+
+    def reset(self):
+        self.composite = 0
+        self.subtreeInvalidate = 0
+
+
+class StageNotificationsTestCase(unittest.TestCase):
+    '''Verify the UFE notifications sent for USD stage changes are batched,
+    and that the redundant ones are suppressed.
+    '''
+
+    pluginsLoaded = False
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.readOnlySetUpClass(__file__, loadPlugin=False)
+
+        if not cls.pluginsLoaded:
+            cls.pluginsLoaded = mayaUtils.isMayaUsdPluginLoaded()
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def setUp(self):
+        ''' Called initially to set up the Maya test environment '''
+        self.assertTrue(self.pluginsLoaded)
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        self.proxyShape = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        self.stage = mayaUsd.ufe.getStage(self.proxyShape)
+
+        self.observer = SceneObserver()
+        ufe.Scene.addObserver(self.observer)
+
+    def tearDown(self):
+        ufe.Scene.removeObserver(self.observer)
+
+    def testResyncBatching(self):
+        '''Prims resynced by a single edit send one composite notification.'''
+        layer = self.stage.GetRootLayer()
+
+        # The prims resynced by the notice, which may or may not include the
+        # descendants of the resynced prims depending on the USD version.
+        resyncedPrimPaths = []
+        def onObjectsChanged(notice, sender):
+            resyncedPrimPaths.extend(
+                path for path in notice.GetResyncedPaths() if not path.IsPropertyPath())
+        listener = Tf.Notice.Register(Usd.Notice.ObjectsChanged, onObjectsChanged, self.stage)
+
+        mayaUsd.ufe.resetNotificationCounts()
+
+        with Sdf.ChangeBlock():
+            for path in ['/A', '/A/B', '/A/B/C', '/D', '/D/E']:
+                Sdf.CreatePrimInLayer(layer, path).specifier = Sdf.SpecifierDef
+
+        listener.Revoke()
+
+        # Only /A and /D are notified, their descendants are redundant.
+        topLevelPaths = Sdf.Path.RemoveDescendentPaths(resyncedPrimPaths)
+        self.assertEqual(sorted(topLevelPaths), [Sdf.Path('/A'), Sdf.Path('/D')])
+
+        counts = mayaUsd.ufe.getNotificationCounts()
+        self.assertEqual(counts['notices'], 1)
+        self.assertEqual(counts['composites'], 1)
+        self.assertEqual(counts['suppressed'], len(resyncedPrimPaths) - 2)
+        self.assertEqual(self.observer.composite, 1)
+        self.assertEqual(self.observer.subtreeInvalidate, 0)
+
+    def testSingleResync(self):
+        '''A lone notification is not wrapped in a composite notification.'''
+        mayaUsd.ufe.resetNotificationCounts()
+
+        self.stage.DefinePrim('/A')
+
+        counts = mayaUsd.ufe.getNotificationCounts()
+        self.assertEqual(counts['composites'], 0)
+        self.assertEqual(self.observer.composite, 0)
+        self.assertEqual(self.observer.subtreeInvalidate, 1)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
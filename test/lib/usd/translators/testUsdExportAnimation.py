@@ -22,7 +22,7 @@ import unittest
 import fixturesUtils
 from maya import cmds
 from maya import standalone
-from pxr import Usd
+from pxr import Usd, UsdGeom
 
 
 class testUsdExportAnimation(unittest.TestCase):
@@ -61,4 +61,60 @@ class testUsdExportAnimation(unittest.TestCase):
             prim = stage.GetPrimAtPath("/root")
             attr = prim.GetAttribute("xformOp:translate")
             num_samples = attr.GetNumTimeSamples()
-            self.assertEqual(num_samples, int(not state))
\ No newline at end of file
+            self.assertEqual(num_samples, int(not state))
+
+    def testExportDeformingMeshPoints(self):
+        # The points and extent of an animated mesh are pulled from Maya and
+        # converted ahead of the authoring pass, make sure every frame still
+        # gets its own values.
+        cmds.file(new=True, force=True)
+        cube, _ = cmds.polyCube(name="Cube")
+        shape = cmds.listRelatives(cube, shapes=True)[0]
+        cmds.setKeyframe('%s.pnts[0].pnty' % shape, v=0, time=1)
+        cmds.setKeyframe('%s.pnts[0].pnty' % shape, v=2, time=3)
+
+        path = os.path.join(self.temp_dir, "deformingMeshPoints.usda")
+        cmds.mayaUSDExport(f=path, frameRange=(1, 3))
+
+        stage = Usd.Stage.Open(path)
+        mesh = UsdGeom.Mesh(stage.GetPrimAtPath("/Cube"))
+        for frame in (1, 2, 3):
+            cmds.currentTime(frame)
+            expectedY = cmds.pointPosition('%s.vtx[0]' % cube, local=True)[1]
+            points = mesh.GetPointsAttr().Get(frame)
+            self.assertAlmostEqual(points[0][1], expectedY, places=5)
+
+            extent = mesh.GetExtentAttr().Get(frame)
+            expectedExtent = UsdGeom.PointBased.ComputeExtent(points)
+            self.assertEqual(extent, expectedExtent)
+
+    def testExportDeformingMeshSparseSamples(self):
+        # The samples prepared ahead of the authoring pass are compared to the
+        # previous ones, only the changed samples must be authored, and a run
+        # of identical samples ends with the held value.
+        cmds.file(new=True, force=True)
+        cube, _ = cmds.polyCube(name="Cube")
+        shape = cmds.listRelatives(cube, shapes=True)[0]
+        for time, value in ((1, 0), (2, 1), (4, 1), (5, 2)):
+            cmds.setKeyframe('%s.pnts[0].pnty' % shape, v=value, time=time,
+                             inTangentType='linear', outTangentType='linear')
+
+        path = os.path.join(self.temp_dir, "deformingMeshSparseSamples.usda")
+        cmds.mayaUSDExport(f=path, frameRange=(1, 6), defaultMeshScheme='none')
+
+        stage = Usd.Stage.Open(path)
+        mesh = UsdGeom.Mesh(stage.GetPrimAtPath("/Cube"))
+        for attr in (mesh.GetPointsAttr(), mesh.GetExtentAttr(), mesh.GetNormalsAttr()):
+            self.assertEqual(attr.GetTimeSamples(), [1.0, 2.0, 4.0, 5.0], attr.GetName())
+            self.assertEqual(attr.Get(4), attr.Get(2), attr.GetName())
+            self.assertNotEqual(attr.Get(5), attr.Get(4), attr.GetName())
+        self.assertEqual(mesh.GetNormalsInterpolation(), UsdGeom.Tokens.faceVarying)
+
+        # The topology doesn't change.
+        self.assertEqual(mesh.GetFaceVertexCountsAttr().GetTimeSamples(), [1.0])
+        self.assertEqual(mesh.GetFaceVertexIndicesAttr().GetTimeSamples(), [1.0])
+        self.assertEqual(list(mesh.GetFaceVertexCountsAttr().Get(6)), [4] * 6)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
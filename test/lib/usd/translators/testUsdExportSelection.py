@@ -36,17 +36,15 @@ class testUsdExportSelection(unittest.TestCase):
     def tearDownClass(cls):
         standalone.uninitialize()
 
-    def testExportWithSelection(self):
-
+    def _exportSelection(self, selection, usdFileName, **kwargs):
         mayaFilePath = os.path.join(self.inputPath, "UsdExportSelectionTest", "UsdExportSelectionTest.ma")
         cmds.file(mayaFilePath, force=True, open=True)
-  
-        selection = ['GroupA', 'Cube3', 'Cube6']
+
         cmds.select(selection)
 
-        usdFilePath = os.path.abspath('UsdExportSelectionTest_EXPORTED.usda')
+        usdFilePath = os.path.abspath(usdFileName)
         cmds.usdExport(mergeTransformAndShape=True, selection=True,
-            file=usdFilePath, shadingMode='none')
+            file=usdFilePath, shadingMode='none', **kwargs)
 
         stage = Usd.Stage.Open(usdFilePath)
         self.assertTrue(stage)
@@ -78,6 +76,41 @@ class testUsdExportSelection(unittest.TestCase):
             prim = stage.GetPrimAtPath(primPath)
             self.assertFalse(prim.IsValid())
 
+        return stage
+
+    def testExportWithSelection(self):
+        self._exportSelection(['GroupA', 'Cube3', 'Cube6'],
+            'UsdExportSelectionTest_EXPORTED.usda')
+
+    def testExportWithOverlappingSelection(self):
+        # Descendants of selected objects are exported once, with their selected ancestor.
+        # GroupA and Cube2, or Cube6 and its shape, don't make the export fail.
+        stage = self._exportSelection(
+            ['Cube2', 'GroupA', 'Cube3', 'Cube6', 'CubeShape6', 'Cube1'],
+            'UsdExportSelectionTest_Overlapping_EXPORTED.usda', verbose=True)
+        self.assertEqual(
+            len(stage.GetPrimAtPath('/UsdExportSelectionTest/Geom/GroupA').GetChildren()), 2)
+
+        # Each overlapping object is written once, at its own path: neither a
+        # second copy elsewhere nor a separate prim for the selected shape.
+        primPaths = [str(prim.GetPath()) for prim in stage.Traverse()]
+        self.assertEqual(sorted(primPaths), [
+            '/UsdExportSelectionTest',
+            '/UsdExportSelectionTest/Geom',
+            '/UsdExportSelectionTest/Geom/GroupA',
+            '/UsdExportSelectionTest/Geom/GroupA/Cube1',
+            '/UsdExportSelectionTest/Geom/GroupA/Cube2',
+            '/UsdExportSelectionTest/Geom/GroupB',
+            '/UsdExportSelectionTest/Geom/GroupB/Cube3',
+            '/UsdExportSelectionTest/Geom/GroupC',
+            '/UsdExportSelectionTest/Geom/GroupC/GroupD',
+            '/UsdExportSelectionTest/Geom/GroupC/GroupD/Cube6',
+        ])
+
+        layerText = stage.GetRootLayer().ExportToString()
+        for name in ['GroupA', 'Cube1', 'Cube2', 'Cube3', 'Cube6']:
+            self.assertEqual(layerText.count('"%s"' % name), 1, name)
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
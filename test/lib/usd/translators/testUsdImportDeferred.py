@@ -0,0 +1,214 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import unittest
+
+from pxr import Kind
+from pxr import Usd
+from pxr import UsdGeom
+
+from maya import cmds
+from maya import standalone
+
+import fixturesUtils
+
+class testUsdImportDeferred(unittest.TestCase):
+    """Test the deferred import, which creates placeholders for the component
+    models and only translates their subtree once they get selected."""
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__)
+
+        # World [Xform, assembly]
+        #     Asset1 [Xform, component]
+        #         Geom [Scope]
+        #             Cube [Mesh]
+        #     Asset2 [Xform, component]
+        #         Geom [Scope]
+        #             Cube [Mesh]
+        cls.usdFile = os.path.abspath('DeferredImportTest.usda')
+        stage = Usd.Stage.CreateNew(cls.usdFile)
+        world = UsdGeom.Xform.Define(stage, '/World')
+        Usd.ModelAPI(world).SetKind(Kind.Tokens.assembly)
+        stage.SetDefaultPrim(world.GetPrim())
+        for i, name in enumerate(['Asset1', 'Asset2']):
+            asset = UsdGeom.Xform.Define(stage, '/World/%s' % name)
+            Usd.ModelAPI(asset).SetKind(Kind.Tokens.component)
+            UsdGeom.XformCommonAPI(asset).SetTranslate((10.0 * i, 0.0, 0.0))
+            cls._defineCube(stage, '/World/%s' % name)
+        stage.Save()
+
+        # World [Xform, assembly]
+        #     Instance1 [Xform, component, instanceable] (references /Prototype)
+        #     Instance2 [Xform, component, instanceable] (references /Prototype)
+        # Prototype [Xform]
+        #     Geom [Scope]
+        #         Cube [Mesh]
+        cls.instancesFile = os.path.abspath('DeferredImportInstancesTest.usda')
+        stage = Usd.Stage.CreateNew(cls.instancesFile)
+        world = UsdGeom.Xform.Define(stage, '/World')
+        Usd.ModelAPI(world).SetKind(Kind.Tokens.assembly)
+        stage.SetDefaultPrim(world.GetPrim())
+        prototype = stage.CreateClassPrim('/Prototype')
+        cls._defineCube(stage, '/Prototype')
+        for i, name in enumerate(['Instance1', 'Instance2']):
+            instance = UsdGeom.Xform.Define(stage, '/World/%s' % name)
+            instance.GetPrim().GetReferences().AddInternalReference(prototype.GetPath())
+            instance.GetPrim().SetInstanceable(True)
+            Usd.ModelAPI(instance).SetKind(Kind.Tokens.component)
+            UsdGeom.XformCommonAPI(instance).SetTranslate((10.0 * i, 0.0, 0.0))
+        stage.Save()
+
+    @staticmethod
+    def _defineCube(stage, parentPath):
+        UsdGeom.Scope.Define(stage, parentPath + '/Geom')
+        cube = UsdGeom.Mesh.Define(stage, parentPath + '/Geom/Cube')
+        cube.CreatePointsAttr([(-1, -1, -1), (1, -1, -1), (-1, 1, -1), (1, 1, -1),
+                               (-1, -1, 1), (1, -1, 1), (-1, 1, 1), (1, 1, 1)])
+        cube.CreateFaceVertexCountsAttr([4, 4, 4, 4, 4, 4])
+        cube.CreateFaceVertexIndicesAttr([0, 1, 3, 2, 4, 6, 7, 5, 0, 4, 5, 1,
+                                          2, 3, 7, 6, 0, 2, 6, 4, 1, 5, 7, 3])
+        cube.CreateExtentAttr([(-1, -1, -1), (1, 1, 1)])
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def setUp(self):
+        cmds.file(new=True, force=True)
+
+    def assertIsPlaceholder(self, node, primPath, usdFile=None):
+        self.assertEqual(os.path.normcase(cmds.getAttr(node + '.USD_deferredFilePath')),
+                         os.path.normcase(usdFile or self.usdFile))
+        self.assertEqual(cmds.getAttr(node + '.USD_deferredPrimPath'), primPath)
+        self.assertFalse(cmds.listRelatives(node, allDescendents=True, type='mesh'))
+        self.assertEqual(len(cmds.listRelatives(node, shapes=True, type='nurbsCurve')), 1)
+
+    def testPlaceholders(self):
+        cmds.mayaUSDImport(file=self.usdFile, primPath='/', deferredImport=True)
+
+        self.assertTrue(cmds.objExists('|World'))
+        self.assertFalse(cmds.attributeQuery('USD_deferredPrimPath', node='|World', exists=True))
+        self.assertIsPlaceholder('|World|Asset1', '/World/Asset1')
+        self.assertIsPlaceholder('|World|Asset2', '/World/Asset2')
+
+        # The placeholders are the transforms of the models.
+        self.assertEqual(cmds.getAttr('|World|Asset2.translate'), [(10.0, 0.0, 0.0)])
+
+        # Their bounding box is the extent of the models.
+        bbox = cmds.exactWorldBoundingBox('|World|Asset2')
+        for actual, expected in zip(bbox, [9.0, -1.0, -1.0, 11.0, 1.0, 1.0]):
+            self.assertAlmostEqual(actual, expected)
+
+    def testSelectionExpands(self):
+        cmds.mayaUSDImport(file=self.usdFile, primPath='/', deferredImport=True)
+
+        cmds.select('|World|Asset1')
+
+        # The subtree of the selected placeholder is translated, under the
+        # placeholder itself.
+        self.assertTrue(cmds.objExists('|World|Asset1|Geom|Cube'))
+        self.assertEqual(cmds.nodeType('|World|Asset1|Geom|Cube|CubeShape'), 'mesh')
+        self.assertFalse(cmds.attributeQuery(
+            'USD_deferredPrimPath', node='|World|Asset1', exists=True))
+        self.assertFalse(cmds.listRelatives('|World|Asset1', shapes=True))
+
+        self.assertIsPlaceholder('|World|Asset2', '/World/Asset2')
+
+        # Selecting it again doesn't translate it twice.
+        cmds.select(clear=True)
+        cmds.select('|World|Asset1')
+        self.assertEqual(len(cmds.listRelatives('|World|Asset1', children=True)), 1)
+
+    def testUndoExpansion(self):
+        cmds.mayaUSDImport(file=self.usdFile, primPath='/', deferredImport=True)
+
+        cmds.undoInfo(state=True)
+        self.assertEqual(cmds.mayaUsdExpandDeferredImport('|World|Asset1', '|World|Asset2'), 2)
+        self.assertTrue(cmds.objExists('|World|Asset1|Geom|Cube'))
+        self.assertTrue(cmds.objExists('|World|Asset2|Geom|Cube'))
+
+        # Undoing the expansion restores the placeholders.
+        cmds.undo()
+        self.assertIsPlaceholder('|World|Asset1', '/World/Asset1')
+        self.assertIsPlaceholder('|World|Asset2', '/World/Asset2')
+
+        cmds.redo()
+        self.assertTrue(cmds.objExists('|World|Asset1|Geom|Cube'))
+        self.assertFalse(cmds.attributeQuery(
+            'USD_deferredPrimPath', node='|World|Asset1', exists=True))
+
+        # The restored placeholders can be expanded again.
+        cmds.undo()
+        self.assertEqual(cmds.mayaUsdExpandDeferredImport('|World|Asset2'), 1)
+        self.assertTrue(cmds.objExists('|World|Asset2|Geom|Cube'))
+        self.assertIsPlaceholder('|World|Asset1', '/World/Asset1')
+
+    def testExpandReopenedScene(self):
+        cmds.mayaUSDImport(file=self.usdFile, primPath='/', deferredImport=True)
+        sceneFile = os.path.abspath('DeferredImportTest.ma')
+        cmds.file(rename=sceneFile)
+        cmds.file(save=True, type='mayaAscii', force=True)
+
+        # The placeholders of the reopened scene are expanded from their
+        # attributes.
+        cmds.file(new=True, force=True)
+        cmds.file(sceneFile, open=True, force=True)
+        self.assertIsPlaceholder('|World|Asset1', '/World/Asset1')
+
+        cmds.select('|World|Asset1')
+        self.assertTrue(cmds.objExists('|World|Asset1|Geom|Cube'))
+        self.assertEqual(cmds.getAttr('|World|Asset2.translate'), [(10.0, 0.0, 0.0)])
+        self.assertIsPlaceholder('|World|Asset2', '/World/Asset2')
+
+    def testExpandInstances(self):
+        # Instances are either imported as Maya instances or flattened, and
+        # both translate the prototype under the placeholder.
+        for importInstances in ['true', 'false']:
+            cmds.file(new=True, force=True)
+            cmds.mayaUSDImport(file=self.instancesFile, primPath='/', deferredImport=True,
+                               importInstances=importInstances)
+            self.assertIsPlaceholder('|World|Instance1', '/World/Instance1', self.instancesFile)
+            self.assertIsPlaceholder('|World|Instance2', '/World/Instance2', self.instancesFile)
+
+            cmds.select('|World|Instance1')
+            self.assertEqual(cmds.nodeType('|World|Instance1|Geom|Cube|CubeShape'), 'mesh')
+            self.assertFalse(cmds.attributeQuery(
+                'USD_deferredPrimPath', node='|World|Instance1', exists=True))
+            self.assertFalse(cmds.listRelatives('|World|Instance1', shapes=True))
+            self.assertEqual(cmds.getAttr('|World|Instance2.translate'), [(10.0, 0.0, 0.0)])
+            self.assertIsPlaceholder('|World|Instance2', '/World/Instance2', self.instancesFile)
+
+            # The prototype imported by the expansion doesn't stay in the scene.
+            self.assertEqual(cmds.ls('|__*', type='transform'), [])
+
+            cmds.select('|World|Instance2')
+            self.assertTrue(cmds.objExists('|World|Instance2|Geom|Cube|CubeShape'))
+
+    def testNotDeferred(self):
+        cmds.mayaUSDImport(file=self.usdFile, primPath='/')
+
+        self.assertTrue(cmds.objExists('|World|Asset1|Geom|Cube'))
+        self.assertTrue(cmds.objExists('|World|Asset2|Geom|Cube'))
+        self.assertFalse(cmds.attributeQuery(
+            'USD_deferredPrimPath', node='|World|Asset1', exists=True))
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
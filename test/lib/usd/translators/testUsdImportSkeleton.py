@@ -279,6 +279,51 @@ class testUsdImportSkeleton(unittest.TestCase):
             usdSkelQuery=skelQuery,
             usdSkinningQuery=skinningQuery)
 
+    def test_SkelImportConstantChannels(self):
+        """
+        Only the joint channels that change over time are keyed, the other
+        ones are set to their value without an anim curve.
+        """
+        cmds.file(new=True, force=True)
+
+        path = os.path.join(self.inputPath, "UsdImportSkeleton", "skelAnimChannels.usda")
+
+        cmds.usdImport(file=path, readAnimData=True, primPath="/Root")
+
+        stage = Usd.Stage.Open(path)
+        skelCache = UsdSkel.Cache()
+
+        bindingSitePrim = stage.GetPrimAtPath("/Root")
+        if Usd.GetVersion() > (0, 20, 8):
+            skelCache.Populate(UsdSkel.Root(bindingSitePrim),
+                Usd.PrimDefaultPredicate)
+        else:
+            skelCache.Populate(UsdSkel.Root(bindingSitePrim))
+
+        skelQuery = skelCache.GetSkelQuery(
+            UsdSkel.Skeleton.Get(stage, "/Root/Skeleton"))
+        self.assertTrue(skelQuery)
+
+        joints = [_GetDepNode(n) for n in ["hip", "knee"]]
+        self._ValidateJointTransforms(skelQuery, joints)
+
+        # The knee only moves along X.
+        self.assertEqual(cmds.keyframe("knee.translateX", query=True,
+                                       timeChange=True), [1.0, 2.0, 3.0])
+        self.assertEqual(cmds.keyframe("knee.translateX", query=True,
+                                       valueChange=True), [0.0, 1.0, 2.0])
+
+        # The other channels keep their value, checked above, without keys.
+        constantPlugs = ["knee.translateY", "knee.translateZ"]
+        for joint in ["hip", "knee"]:
+            constantPlugs += ["%s.%s%s" % (joint, channel, axis)
+                              for channel in ["rotate", "scale"] for axis in "XYZ"]
+        constantPlugs += ["hip.translate%s" % axis for axis in "XYZ"]
+
+        for plug in constantPlugs:
+            self.assertFalse(cmds.listConnections(
+                plug, destination=False, source=True), plug)
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
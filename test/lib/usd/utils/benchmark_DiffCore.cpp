@@ -0,0 +1,145 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Standalone micro benchmark of the DiffCore kernels. For each instruction set supported by the
+// machine, every kernel is run over identical arrays (the worst case, since nothing allows an early
+// out) and the throughput is reported in GB/s of input read.
+//
+// usage: DiffCoreBenchmark [elementCount] [repeatCount]
+
+#include <mayaUsdUtils/ALHalf.h>
+#include <mayaUsdUtils/DiffCore.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace {
+
+struct Kernel
+{
+    const char*           name;
+    size_t                bytes;
+    std::function<bool()> run;
+};
+
+double benchmark(const Kernel& kernel, size_t repeats)
+{
+    // one untimed run to warm up the caches
+    bool result = kernel.run();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; ++i) {
+        result &= kernel.run();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    if (!result) {
+        std::printf("  %s returned false on identical inputs!\n", kernel.name);
+    }
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return double(kernel.bytes) * double(repeats) / seconds / 1e9;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 20;
+    const size_t repeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+
+    std::vector<float>   f0(count * 4), f1;
+    std::vector<double>  d0(count * 4), d1;
+    std::vector<int32_t> i0(count), i1;
+    std::vector<int8_t>  c0(count), c1;
+    std::vector<GfHalf>  h0(count);
+    std::vector<float>   vec3(count * 3), vec4(count * 4), u(count), v(count), uv(count * 2);
+    for (size_t i = 0; i < count * 4; ++i) {
+        f0[i] = float(i % 1024) / 1024.0f;
+        d0[i] = f0[i];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        i0[i] = int32_t(i);
+        c0[i] = int8_t(i);
+        h0[i] = GfHalf(f0[i]);
+        u[i] = uv[i * 2 + 0] = 0.25f;
+        v[i] = uv[i * 2 + 1] = 0.75f;
+        for (size_t j = 0; j < 3; ++j) {
+            vec3[i * 3 + j] = float(j);
+        }
+        for (size_t j = 0; j < 4; ++j) {
+            vec4[i * 4 + j] = float(j);
+        }
+    }
+    f1 = f0;
+    d1 = d0;
+    i1 = i0;
+    c1 = c0;
+
+    using namespace MayaUsdUtils;
+    const Kernel kernels[] = {
+        { "compareArray(float)",
+          count * 2 * sizeof(float),
+          [&] { return compareArray(f0.data(), f1.data(), count, count); } },
+        { "compareArray(double)",
+          count * 2 * sizeof(double),
+          [&] { return compareArray(d0.data(), d1.data(), count, count); } },
+        { "compareArray(half, float)",
+          count * (sizeof(GfHalf) + sizeof(float)),
+          [&] { return compareArray(h0.data(), f0.data(), count, count, 1e-2f); } },
+        { "compareArray(int32)",
+          count * 2 * sizeof(int32_t),
+          [&] { return compareArray(i0.data(), i1.data(), count, count); } },
+        { "compareArray(int8)",
+          count * 2 * sizeof(int8_t),
+          [&] { return compareArray(c0.data(), c1.data(), count, count); } },
+        { "compareArray3Dto4D",
+          count * 7 * sizeof(float),
+          [&] { return compareArray3Dto4D(vec3.data(), vec4.data(), count, count); } },
+        { "compareUvArray",
+          count * 4 * sizeof(float),
+          [&] { return compareUvArray(u.data(), v.data(), uv.data(), count, count); } },
+        { "vec3AreAllTheSame(float)",
+          count * 3 * sizeof(float),
+          [&] { return vec3AreAllTheSame(vec3.data(), count); } },
+        { "vec4AreAllTheSame(float)",
+          count * 4 * sizeof(float),
+          [&] { return vec4AreAllTheSame(vec4.data(), count); } },
+        { "hash128",
+          count * 4 * sizeof(float),
+          [&] {
+              uint64_t hash[2];
+              hash128(f0.data(), count * 4 * sizeof(float), 0, hash);
+              return hash[0] != 0 || hash[1] != 0;
+          } },
+    };
+
+    std::printf("%zu elements, %zu repeats\n", count, repeats);
+    for (const char* isa : { "baseline", "avx2", "avx512" }) {
+        if (!setDiffCoreInstructionSet(isa)) {
+            std::printf("\n%s: not available\n", isa);
+            continue;
+        }
+        std::printf("\n%s:\n", isa);
+        for (const Kernel& kernel : kernels) {
+            std::printf("  %-28s %8.2f GB/s\n", kernel.name, benchmark(kernel, repeats));
+        }
+    }
+    return 0;
+}
@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+
 static inline float  randFloat() { return float(rand()) / RAND_MAX; }
 static inline double randDouble() { return double(rand()) / RAND_MAX; }
 
@@ -481,3 +483,116 @@ TEST(DiffCore, compareUvArray)
     EXPECT_FALSE(MayaUsdUtils::compareUvArray(u.data(), v.data(), uv.data(), 47, 47, 1e-5f));
     u[22] -= 1.0f;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, hash128)
+{
+    std::vector<uint8_t> data(5000);
+    for (uint8_t& byte : data) {
+        byte = uint8_t(rand());
+    }
+
+    const std::string defaultIsa = MayaUsdUtils::diffCoreInstructionSet();
+    EXPECT_TRUE(MayaUsdUtils::setDiffCoreInstructionSet("baseline"));
+
+    // sizes around the 64 byte stripes and the 1024 byte blocks
+    const size_t sizes[] = { 0, 1, 7, 8, 63, 64, 65, 1023, 1024, 1025, 2048, 5000 };
+    std::vector<std::array<uint64_t, 2>> expected;
+    for (const size_t size : sizes) {
+        std::array<uint64_t, 2> hash;
+        MayaUsdUtils::hash128(data.data(), size, 0, hash.data());
+        expected.push_back(hash);
+    }
+
+    // the hash doesn't depend on the instruction set
+    for (const char* isa : { "avx2", "avx512" }) {
+        if (!MayaUsdUtils::setDiffCoreInstructionSet(isa)) {
+            continue;
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            std::array<uint64_t, 2> hash;
+            MayaUsdUtils::hash128(data.data(), sizes[i], 0, hash.data());
+            EXPECT_EQ(expected[i], hash) << isa << " " << sizes[i];
+        }
+    }
+
+    // but changes with the seed, the size and any of the bytes
+    std::array<uint64_t, 2> reference, hash;
+    MayaUsdUtils::hash128(data.data(), 300, 0, reference.data());
+    MayaUsdUtils::hash128(data.data(), 300, 1, hash.data());
+    EXPECT_NE(reference, hash);
+    MayaUsdUtils::hash128(data.data(), 299, 0, hash.data());
+    EXPECT_NE(reference, hash);
+    for (size_t i = 0; i < 300; ++i) {
+        data[i] ^= 1;
+        MayaUsdUtils::hash128(data.data(), 300, 0, hash.data());
+        EXPECT_NE(reference, hash) << i;
+        data[i] ^= 1;
+    }
+
+    const uint8_t zeros[8] = {};
+    MayaUsdUtils::hash128(zeros, 3, 0, reference.data());
+    MayaUsdUtils::hash128(zeros, 4, 0, hash.data());
+    EXPECT_NE(reference, hash);
+
+    EXPECT_TRUE(MayaUsdUtils::setDiffCoreInstructionSet(defaultIsa.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, instructionSets)
+{
+    const std::string defaultIsa = MayaUsdUtils::diffCoreInstructionSet();
+    EXPECT_FALSE(MayaUsdUtils::setDiffCoreInstructionSet("notAnInstructionSet"));
+    EXPECT_EQ(defaultIsa, MayaUsdUtils::diffCoreInstructionSet());
+    EXPECT_TRUE(MayaUsdUtils::setDiffCoreInstructionSet("baseline"));
+
+    // every instruction set available on this machine must agree, including on the tails that
+    // don't fill a whole register
+    for (const char* isa : { "baseline", "avx2", "avx512" }) {
+        if (!MayaUsdUtils::setDiffCoreInstructionSet(isa)) {
+            continue;
+        }
+        for (size_t count = 1; count < 70; ++count) {
+            std::vector<float>   f0(count), f1;
+            std::vector<double>  d0(count), d1;
+            std::vector<int32_t> i0(count), i1;
+            std::vector<int8_t>  c0(count), c1;
+            for (size_t i = 0; i < count; ++i) {
+                f0[i] = randFloat();
+                d0[i] = randDouble();
+                i0[i] = rand();
+                c0[i] = int8_t(rand());
+            }
+            f1 = f0;
+            d1 = d0;
+            i1 = i0;
+            c1 = c0;
+            EXPECT_TRUE(MayaUsdUtils::compareArray(f0.data(), f1.data(), count, count)) << isa;
+            EXPECT_TRUE(MayaUsdUtils::compareArray(d0.data(), d1.data(), count, count)) << isa;
+            EXPECT_TRUE(MayaUsdUtils::compareArray(i0.data(), i1.data(), count, count)) << isa;
+            EXPECT_TRUE(MayaUsdUtils::compareArray(c0.data(), c1.data(), count, count)) << isa;
+
+            f1[count - 1] += 1.0f;
+            d1[count - 1] += 1.0;
+            i1[count - 1] += 1;
+            c1[count - 1] += 1;
+            EXPECT_FALSE(MayaUsdUtils::compareArray(f0.data(), f1.data(), count, count)) << isa;
+            EXPECT_FALSE(MayaUsdUtils::compareArray(d0.data(), d1.data(), count, count)) << isa;
+            EXPECT_FALSE(MayaUsdUtils::compareArray(i0.data(), i1.data(), count, count)) << isa;
+            EXPECT_FALSE(MayaUsdUtils::compareArray(c0.data(), c1.data(), count, count)) << isa;
+
+            std::vector<float> vec4(count * 4);
+            for (size_t i = 0; i < vec4.size(); i += 4) {
+                vec4[i + 0] = 1.0f;
+                vec4[i + 1] = 2.0f;
+                vec4[i + 2] = 3.0f;
+                vec4[i + 3] = 4.0f;
+            }
+            EXPECT_TRUE(MayaUsdUtils::vec4AreAllTheSame(vec4.data(), count)) << isa;
+            vec4.back() = 5.0f;
+            EXPECT_EQ(count == 1, MayaUsdUtils::vec4AreAllTheSame(vec4.data(), count)) << isa;
+        }
+    }
+
+    EXPECT_TRUE(MayaUsdUtils::setDiffCoreInstructionSet(defaultIsa.c_str()));
+}